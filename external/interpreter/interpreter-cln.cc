@@ -9,6 +9,7 @@
 
 #include<iostream>
 #include<fstream>
+#include<sstream>
 
 #include<tuple>
 #include<vector>
@@ -16,12 +17,69 @@
 
 #include<cstdlib> 	// rand()
 #include<ctime>
+#include<cctype>
+#include<cstring>
+#include<string>
+#include<unistd.h>	// read(), write()
 
 #include<cln/cln.h>
 
 using namespace std;
 using namespace cln;
 
+// szybkie wejscie ( --fast ): bufor czytany przez read(), bez synchronizacji z cin
+struct FastIn
+{
+    char buf[1<<16];
+    size_t len = 0, pos = 0;
+
+    int get()
+    {
+	if( pos==len )
+	{
+	    ssize_t n = read( 0, buf, sizeof(buf) );
+	    if( n<=0 ) return -1;
+	    len = n;
+	    pos = 0;
+	}
+	return buf[pos++];
+    }
+
+    // kolejne slowo z wejscia, pusty napis gdy koniec wejscia
+    string word()
+    {
+	string w;
+	int c;
+	while( (c = get())!=-1 && isspace(c) );
+	while( c!=-1 && !isspace(c) ) { w.push_back( c ); c = get(); }
+	return w;
+    }
+};
+
+// szybkie wyjscie ( --fast ): bufor zapisywany przez write() przy HALT ( lub gdy jest pelny )
+struct FastOut
+{
+    string buf;
+
+    void put( const string &s )
+    {
+	buf += s;
+	if( buf.size()>=(1<<20) ) flush();
+    }
+
+    void flush()
+    {
+	size_t off = 0;
+	while( off<buf.size() )
+	{
+	    ssize_t n = write( 1, buf.data() + off, buf.size() - off );
+	    if( n<=0 ) break;
+	    off += n;
+	}
+	buf.clear();
+    }
+};
+
 enum Instructions { GET, PUT, LOAD, STORE, COPY, ADD, SUB, SHR, SHL, INC, DEC, ZERO, JUMP, JZERO, JODD, HALT, ERROR };
 
 int main(int argc, char* argv[])
@@ -39,17 +97,41 @@ int main(int argc, char* argv[])
     int i2, i3;
     string com;
 
-    if( argc!=2 )
+    // profilowanie ( gdy podano plik profilu )
+    const char *names[] = { "GET", "PUT", "LOAD", "STORE", "COPY", "ADD", "SUB", "SHR", "SHL", "INC", "DEC", "ZERO", "JUMP", "JZERO", "JODD", "HALT" };
+    const long long cost[] = { 100, 100, 10, 10, 1, 10, 10, 1, 1, 1, 1, 1, 1, 1, 1, 0 };
+    vector<long long> count, taken;
+    long long opcount[HALT+1] = { 0 };
+    map< cl_I, pair<long long,long long> > heat;	// adres -> ( odczyty, zapisy )
+    int pc;
+
+    // --fast: buforowane I/O, --prompt: zachowaj format "? " / "> " oraz komunikaty
+    bool fast = false, prompt = false;
+    vector<char*> args;
+    FastIn in;
+    FastOut out;
+
+    for( int a = 1; a<argc; a++ )
+	if( !strcmp(argv[a], "--fast") ) fast = true;
+	else if( !strcmp(argv[a], "--prompt") ) prompt = true;
+	else args.push_back( argv[a] );
+
+    if( !fast ) prompt = true;
+    ostream &info = prompt ? cout : cerr;	// bez promptow na wyjsciu sa tylko liczby
+
+    bool prof = ( args.size()==2 );
+
+    if( args.size()!=1 && args.size()!=2 )
     {
-	cout << "Sposób użycia programu: interpreter kod" << endl;
+	cout << "Sposób użycia programu: interpreter [--fast [--prompt]] kod [profil]" << endl;
 	return -1;
     }
 
-    cout << "Czytanie pliku " << argv[1] << endl;
-    ifstream plik( argv[1] );
+    info << "Czytanie pliku " << args[0] << endl;
+    ifstream plik( args[0] );
     if( !plik )
     {
-	cout << "Błąd: Nie można otworzyć pliku " << argv[1] << endl;
+	info << "Błąd: Nie można otworzyć pliku " << args[0] << endl;
 	return -1;
     }
     while( !plik.eof() )
@@ -79,10 +161,10 @@ int main(int argc, char* argv[])
 	if( com=="JODD"  ) { i1 = JODD; plik >> i2;  plik >> i3; }
 	if( com=="HALT"  ) { i1 = HALT; }
 
-	if( i1==ERROR ) { cout << "Błąd: Nieznana instrukcja w linii " << k << "." << endl; return -1; }
-        if( i2>reg-1 ) { cout << "Błąd: zły rejestr w instrukcji w linii " << k << endl; return -1; }
-        if( i2<0 ) { cout << "Błąd: Zły rejestr w instrukcji w linii " << k << endl; return -1; }
-        if( i3<0 ) { cout << "Błąd: Zły adress w instrukcji w linii " << k << endl; return -1; }
+	if( i1==ERROR ) { info << "Błąd: Nieznana instrukcja w linii " << k << "." << endl; return -1; }
+        if( i2>reg-1 ) { info << "Błąd: zły rejestr w instrukcji w linii " << k << endl; return -1; }
+        if( i2<0 ) { info << "Błąd: Zły rejestr w instrukcji w linii " << k << endl; return -1; }
+        if( i3<0 ) { info << "Błąd: Zły adress w instrukcji w linii " << k << endl; return -1; }
 
 	if( plik.good() )
 	{
@@ -91,19 +173,46 @@ int main(int argc, char* argv[])
 	k++;
     }
     plik.close();
-    cout << "Skończono czytanie pliku (" << program.size() << " linii)." << endl;
+    info << "Skończono czytanie pliku (" << program.size() << " linii)." << endl;
 
-    cout << "Uruchamianie programu." << endl;
+    info << "Uruchamianie programu." << endl;
     lr = 0;
+    if( prof )
+    {
+	count.assign( program.size(), 0 );
+	taken.assign( program.size(), 0 );
+    }
     srand(time(NULL));
     for(int i = 0; i<reg; i++ ) r[i] = rand();
     i = 0;
     while( get<0>(program[lr])!=HALT )	// HALT
     {
+	pc = lr;
+	if( prof )
+	{
+	    count[pc]++;
+	    opcount[get<0>(program[pc])]++;
+	    if( get<0>(program[pc])==LOAD || get<0>(program[pc])==ADD || get<0>(program[pc])==SUB ) heat[r[0]].first++;
+	    if( get<0>(program[pc])==STORE ) heat[r[0]].second++;
+	}
 	switch( get<0>(program[lr]) )
 	{
-	    case GET:	cout << "? "; cin >> r[get<1>(program[lr])]; i+=100; lr++; break;
-	    case PUT:	cout << "> " << r[get<1>(program[lr])] << endl; i+=100; lr++; break;
+	    case GET:	if( fast )
+			{
+			    if( prompt ) out.put( "? " );
+			    string w = in.word();
+			    r[get<1>(program[lr])] = w.empty() ? cl_I(0) : cl_I( w.c_str() );
+			}
+			else { cout << "? "; cin >> r[get<1>(program[lr])]; }
+			i+=100; lr++; break;
+	    case PUT:	if( fast )
+			{
+			    ostringstream s;
+			    s << ( prompt ? "> " : "" ) << r[get<1>(program[lr])] << "\n";
+			    out.put( s.str() );
+			}
+			else cout << "> " << r[get<1>(program[lr])] << endl;
+			i+=100; lr++; break;
 
 	    case LOAD:	r[get<1>(program[lr])] = pam[r[0]]; i+=10; lr++; break;
 	    case STORE:	pam[r[0]] = r[get<1>(program[lr])]; i+=10; lr++; break;
@@ -121,18 +230,43 @@ int main(int argc, char* argv[])
 	    case DEC:   if( r[get<1>(program[lr])]>0 ) r[get<1>(program[lr])]--; i+=1; lr++; break;
 	    case ZERO: r[get<1>(program[lr])] = 0; i+=1; lr++; break;
 
-	    case JUMP: 	lr = get<2>(program[lr]); i+=1; break;
-	    case JZERO:	if( r[get<1>(program[lr])]==0 ) lr = get<2>(program[lr]); else lr++; i+=1; break;
-	    case JODD:	if( oddp(r[get<1>(program[lr])]) ) lr = get<2>(program[lr]); else lr++; i+=1; break;
+	    case JUMP: 	if( prof ) taken[pc]++;
+			lr = get<2>(program[lr]); i+=1; break;
+	    case JZERO:	if( r[get<1>(program[lr])]==0 ) { if( prof ) taken[pc]++; lr = get<2>(program[lr]); } else lr++; i+=1; break;
+	    case JODD:	if( oddp(r[get<1>(program[lr])]) ) { if( prof ) taken[pc]++; lr = get<2>(program[lr]); } else lr++; i+=1; break;
 	    default: break;
 	}
 	if( lr<0 || lr>=(int)program.size() )
 	{
-	    cout << "Błąd: Wywołanie nieistniejącej instrukcji nr " << lr << "." << endl;
+	    out.flush();
+	    info << "Błąd: Wywołanie nieistniejącej instrukcji nr " << lr << "." << endl;
+	    return -1;
+	}
+    }
+    out.flush();	// jedyny zapis wyjscia w trybie --fast
+    info << "Skończono program (czas: " << i << ")." << endl;
+
+    if( prof )
+    {
+	count[lr]++;
+	opcount[HALT]++;
+
+	ofstream pout( args[1] );
+	if( !pout )
+	{
+	    info << "Błąd: Nie można otworzyć pliku " << args[1] << endl;
 	    return -1;
 	}
+	pout << "# profil: lines,N / linia,wykonania,skoki / op,nazwa,wykonania,koszt / mem,adres,odczyty,zapisy" << endl;
+	pout << "lines," << program.size() << endl;
+	for( size_t l = 0; l<program.size(); l++ )
+	    if( count[l] ) pout << l << "," << count[l] << "," << taken[l] << endl;
+	for( int o = GET; o<=HALT; o++ )
+	    if( opcount[o] ) pout << "op," << names[o] << "," << opcount[o] << "," << opcount[o]*cost[o] << endl;
+	for( auto &m : heat )
+	    pout << "mem," << m.first << "," << m.second.first << "," << m.second.second << endl;
+	pout.close();
     }
-    cout << "Skończono program (czas: " << i << ")." << endl;
 
     return 0;
 }
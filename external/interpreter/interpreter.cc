@@ -15,11 +15,110 @@
 
 #include<cstdlib> 	// rand()
 #include<ctime>
+#include<cctype>
+#include<cstring>
+#include<string>
+#include<unistd.h>	// read(), write()
 
 using namespace std;
 
+// szybkie wejscie ( --fast ): bufor czytany przez read(), bez synchronizacji z cin
+struct FastIn
+{
+    char buf[1<<16];
+    size_t len = 0, pos = 0;
+
+    int get()
+    {
+	if( pos==len )
+	{
+	    ssize_t n = read( 0, buf, sizeof(buf) );
+	    if( n<=0 ) return -1;
+	    len = n;
+	    pos = 0;
+	}
+	return buf[pos++];
+    }
+
+    // kolejne slowo z wejscia, pusty napis gdy koniec wejscia
+    string word()
+    {
+	string w;
+	int c;
+	while( (c = get())!=-1 && isspace(c) );
+	while( c!=-1 && !isspace(c) ) { w.push_back( c ); c = get(); }
+	return w;
+    }
+};
+
+// szybkie wyjscie ( --fast ): bufor zapisywany przez write() przy HALT ( lub gdy jest pelny )
+struct FastOut
+{
+    string buf;
+
+    void put( const string &s )
+    {
+	buf += s;
+	if( buf.size()>=(1<<20) ) flush();
+    }
+
+    void flush()
+    {
+	size_t off = 0;
+	while( off<buf.size() )
+	{
+	    ssize_t n = write( 1, buf.data() + off, buf.size() - off );
+	    if( n<=0 ) break;
+	    off += n;
+	}
+	buf.clear();
+    }
+};
+
 enum Instructions { GET, PUT, LOAD, STORE, COPY, ADD, SUB, SHR, SHL, INC, DEC, ZERO, JUMP, JZERO, JODD, HALT, ERROR };
 
+/*
+ * Slad wykonania ( --record plik ), binarny, natywny endian:
+ *   magic[8] ziarno:i64 linie:i64 co_ile:i64
+ *   potem rekordy, kazdy zaczyna sie znakiem:
+ *   'G' krok:i64 wartosc:i64				wczytana wartosc GET
+ *   'P' krok:i64 wartosc:i64				wypisana wartosc PUT
+ *   'C' krok:i64 lr:i64 koszt:i64 wejscia:i64 r[5]:i64 komorki:i64 ( adres:i64 wartosc:i64 )*
+ *							punkt kontrolny przed wykonaniem kroku
+ *   'H' krok:i64 koszt:i64				HALT
+ * krok to liczba wykonanych instrukcji, wejscia to liczba wczytanych GET przed punktem.
+ * Odtworzenie ( --replay plik ) wczytuje punkt kontrolny i wykonuje program dalej
+ * z wejsciem ze sladu, wiec nie trzeba liczyc od poczatku.
+*/
+#define TRACE_MAGIC "FLATTIR1"
+
+// punkt kontrolny w sladzie, pamiec czytana z pliku dopiero przy odtwarzaniu
+struct Checkpoint
+{
+    long long krok, lr, koszt, wejscia;
+    long long r[5];
+    long long komorki;
+    streampos pamiec;
+};
+
+static void put64( ostream &o, long long v )
+{
+    o.write( (const char*)&v, sizeof(v) );
+}
+
+static bool get64( istream &f, long long &v )
+{
+    return (bool)f.read( (char*)&v, sizeof(v) );
+}
+
+// stan maszyny ( --steps, koniec odtwarzania )
+static void stan( ostream &o, long long krok, int lr, long long koszt, const long long *r, int reg )
+{
+    o << "Stan: krok " << krok << ", lr " << lr << ", czas " << koszt << ", rejestry";
+    for( int j = 0; j<reg; j++ ) o << " " << r[j];
+    o << endl;
+}
+
 int main(int argc, char* argv[])
 {
     vector< tuple<Instructions,int,int> > program;
@@ -35,17 +134,62 @@ int main(int argc, char* argv[])
     int i2, i3;
     string com;
 
-    if( argc!=2 )
+    // profilowanie ( gdy podano plik profilu )
+    const char *names[] = { "GET", "PUT", "LOAD", "STORE", "COPY", "ADD", "SUB", "SHR", "SHL", "INC", "DEC", "ZERO", "JUMP", "JZERO", "JODD", "HALT" };
+    const long long cost[] = { 100, 100, 10, 10, 1, 10, 10, 1, 1, 1, 1, 1, 1, 1, 1, 0 };
+    vector<long long> count, taken;
+    long long opcount[HALT+1] = { 0 };
+    map< long long, pair<long long,long long> > heat;	// adres -> ( odczyty, zapisy )
+    int pc;
+
+    // --fast: buforowane I/O, --prompt: zachowaj format "? " / "> " oraz komunikaty
+    bool fast = false, prompt = false;
+    vector<char*> args;
+    FastIn in;
+    FastOut out;
+
+    // --seed: stale rejestry poczatkowe, --record / --replay: slad wykonania
+    long long seed = time(NULL);
+    const char *record = NULL, *replay = NULL;
+    long long every = 1000000, from_cp = -1, from_step = -1, steps_max = -1;
+    bool show = false, list = false;
+    ofstream trace;
+    vector<long long> gets;
+    vector<Checkpoint> cps;
+    size_t gi = 0;
+    long long krok = 0;
+
+    for( int a = 1; a<argc; a++ )
+	if( !strcmp(argv[a], "--fast") ) fast = true;
+	else if( !strcmp(argv[a], "--prompt") ) prompt = true;
+	else if( !strcmp(argv[a], "--seed") && a+1<argc ) seed = atoll( argv[++a] );
+	else if( !strcmp(argv[a], "--record") && a+1<argc ) record = argv[++a];
+	else if( !strcmp(argv[a], "--every") && a+1<argc ) every = atoll( argv[++a] );
+	else if( !strcmp(argv[a], "--replay") && a+1<argc ) replay = argv[++a];
+	else if( !strcmp(argv[a], "--checkpoint") && a+1<argc ) from_cp = atoll( argv[++a] );
+	else if( !strcmp(argv[a], "--step") && a+1<argc ) from_step = atoll( argv[++a] );
+	else if( !strcmp(argv[a], "--steps") && a+1<argc ) steps_max = atoll( argv[++a] );
+	else if( !strcmp(argv[a], "--show") ) show = true;
+	else if( !strcmp(argv[a], "--list") ) list = true;
+	else args.push_back( argv[a] );
+
+    if( !fast ) prompt = true;
+    ostream &info = prompt ? cout : cerr;	// bez promptow na wyjsciu sa tylko liczby
+
+    bool prof = ( args.size()==2 );
+
+    if( ( args.size()!=1 && args.size()!=2 ) || ( record && replay ) || every<=0 )
     {
-	cout << "Sposób użycia programu: interpreter kod" << endl;
+	cout << "Sposób użycia programu: interpreter [--fast [--prompt]] [--seed S] [--record slad [--every N]] kod [profil]" << endl;
+	cout << "                        interpreter [--fast [--prompt]] --replay slad [--checkpoint K | --step N] [--steps N] [--show] [--list] kod [profil]" << endl;
 	return -1;
     }
 
-    cout << "Czytanie pliku " << argv[1] << endl;
-    ifstream plik( argv[1] );
+    info << "Czytanie pliku " << args[0] << endl;
+    ifstream plik( args[0] );
     if( !plik )
     {
-	cout << "Błąd: Nie można otworzyć pliku " << argv[1] << endl;
+	info << "Błąd: Nie można otworzyć pliku " << args[0] << endl;
 	return -1;
     }
     while( !plik.eof() )
@@ -75,10 +219,10 @@ int main(int argc, char* argv[])
 	if( com=="JODD"  ) { i1 = JODD; plik >> i2;  plik >> i3; }
 	if( com=="HALT"  ) { i1 = HALT; }
 
-	if( i1==ERROR ) { cout << "Błąd: Nieznana instrukcja w linii " << k << "." << endl; return -1; }
-        if( i2>reg-1 ) { cout << "Błąd: zły rejestr w instrukcji w linii " << k << endl; return -1; }
-        if( i2<0 ) { cout << "Błąd: Zły rejestr w instrukcji w linii " << k << endl; return -1; }
-        if( i3<0 ) { cout << "Błąd: Zły adress w instrukcji w linii " << k << endl; return -1; }
+	if( i1==ERROR ) { info << "Błąd: Nieznana instrukcja w linii " << k << "." << endl; return -1; }
+        if( i2>reg-1 ) { info << "Błąd: zły rejestr w instrukcji w linii " << k << endl; return -1; }
+        if( i2<0 ) { info << "Błąd: Zły rejestr w instrukcji w linii " << k << endl; return -1; }
+        if( i3<0 ) { info << "Błąd: Zły adress w instrukcji w linii " << k << endl; return -1; }
 
 	if( plik.good() )
 	{
@@ -87,19 +231,183 @@ int main(int argc, char* argv[])
 	k++;
     }
     plik.close();
-    cout << "Skończono czytanie pliku (" << program.size() << " linii)." << endl;
+    info << "Skończono czytanie pliku (" << program.size() << " linii)." << endl;
 
-    cout << "Uruchamianie programu." << endl;
     lr = 0;
-    srand(time(NULL));
+    if( prof )
+    {
+	count.assign( program.size(), 0 );
+	taken.assign( program.size(), 0 );
+    }
+    srand(seed);
     for(int i = 0; i<reg; i++ ) r[i] = rand();
     i = 0;
+
+    if( replay )
+    {
+	ifstream f( replay, ios::binary );
+	char magic[8];
+	long long linie, v, krok_h = -1, koszt_h = 0;
+	char tag;
+	Checkpoint cp;
+
+	if( !f || !f.read( magic, 8 ) || memcmp( magic, TRACE_MAGIC, 8 ) || !get64( f, seed ) || !get64( f, linie ) || !get64( f, every ) )
+	{
+	    info << "Błąd: " << replay << " nie jest śladem" << endl;
+	    return -1;
+	}
+	if( linie!=(long long)program.size() )
+	{
+	    info << "Błąd: ślad nagrano dla programu o " << linie << " liniach" << endl;
+	    return -1;
+	}
+	while( f.get( tag ) )
+	{
+	    bool ok = true;
+	    if( tag=='G' || tag=='P' )
+	    {
+		ok = get64( f, krok ) && get64( f, v );
+		if( ok && tag=='G' ) gets.push_back( v );
+		if( ok && tag=='P' && list ) cout << "wyjście " << krok << " " << v << endl;
+	    }
+	    else if( tag=='C' )
+	    {
+		ok = get64( f, cp.krok ) && get64( f, cp.lr ) && get64( f, cp.koszt ) && get64( f, cp.wejscia );
+		for( int j = 0; ok && j<reg; j++ ) ok = get64( f, cp.r[j] );
+		ok = ok && get64( f, cp.komorki );
+		if( ok )
+		{
+		    cp.pamiec = f.tellg();
+		    ok = (bool)f.seekg( cp.komorki * 2 * sizeof(long long), ios::cur );
+		    if( list ) cout << "punkt " << cps.size() << " krok " << cp.krok << " lr " << cp.lr << " czas " << cp.koszt << " komórki " << cp.komorki << endl;
+		    cps.push_back( cp );
+		}
+	    }
+	    else if( tag=='H' )
+		ok = get64( f, krok_h ) && get64( f, koszt_h );
+	    else ok = false;
+	    if( !ok )
+	    {
+		info << "Błąd: uszkodzony ślad " << replay << endl;
+		return -1;
+	    }
+	}
+	if( list )
+	{
+	    if( krok_h>=0 ) cout << "HALT krok " << krok_h << " czas " << koszt_h << endl;
+	    return 0;
+	}
+	if( cps.empty() )
+	{
+	    info << "Błąd: brak punktów kontrolnych w " << replay << endl;
+	    return -1;
+	}
+
+	// --step: ostatni punkt nie pozniej niz krok, potem wykonanie do kroku, domyslnie punkt 0
+	if( from_step>=0 )
+	    for( from_cp = 0; from_cp+1<(long long)cps.size() && cps[from_cp+1].krok<=from_step; from_cp++ );
+	if( from_cp<0 ) from_cp = 0;
+	if( from_cp>=(long long)cps.size() )
+	{
+	    info << "Błąd: ślad ma " << cps.size() << " punktów kontrolnych" << endl;
+	    return -1;
+	}
+
+	cp = cps[from_cp];
+	f.clear();
+	f.seekg( cp.pamiec );
+	for( long long c = 0; c<cp.komorki; c++ )
+	{
+	    long long adres, wartosc;
+	    if( !get64( f, adres ) || !get64( f, wartosc ) )
+	    {
+		info << "Błąd: uszkodzony ślad " << replay << endl;
+		return -1;
+	    }
+	    pam[adres] = wartosc;
+	}
+	krok = cp.krok;
+	lr = cp.lr;
+	i = cp.koszt;
+	gi = cp.wejscia;
+	for( int j = 0; j<reg; j++ ) r[j] = cp.r[j];
+	if( lr<0 || lr>=(int)program.size() )
+	{
+	    info << "Błąd: uszkodzony ślad " << replay << endl;
+	    return -1;
+	}
+	info << "Odtwarzanie od punktu " << from_cp << " ( krok " << krok << " )." << endl;
+    }
+
+    if( record )
+    {
+	trace.open( record, ios::binary );
+	if( !trace )
+	{
+	    info << "Błąd: Nie można otworzyć pliku " << record << endl;
+	    return -1;
+	}
+	trace.write( TRACE_MAGIC, 8 );
+	put64( trace, seed );
+	put64( trace, program.size() );
+	put64( trace, every );
+    }
+
+    info << "Uruchamianie programu." << endl;
     while( get<0>(program[lr])!=HALT )	// HALT
     {
+	pc = lr;
+	// --step: do kroku N bez --show i --steps
+	bool live = krok>=from_step;
+	if( live && steps_max>=0 && steps_max--==0 ) break;
+	if( record && krok % every==0 )
+	{
+	    trace.put( 'C' );
+	    put64( trace, krok ); put64( trace, lr ); put64( trace, i ); put64( trace, gi );
+	    for( int j = 0; j<reg; j++ ) put64( trace, r[j] );
+	    put64( trace, pam.size() );
+	    for( auto &m : pam ) { put64( trace, m.first ); put64( trace, m.second ); }
+	}
+	if( show && live )
+	{
+	    info << krok << " " << lr << ": " << names[get<0>(program[lr])] << " " << get<1>(program[lr]) << " " << get<2>(program[lr]) << " |";
+	    for( int j = 0; j<reg; j++ ) info << " " << r[j];
+	    info << endl;
+	}
+	krok++;
+	if( prof )
+	{
+	    count[pc]++;
+	    opcount[get<0>(program[pc])]++;
+	    if( get<0>(program[pc])==LOAD || get<0>(program[pc])==ADD || get<0>(program[pc])==SUB ) heat[r[0]].first++;
+	    if( get<0>(program[pc])==STORE ) heat[r[0]].second++;
+	}
 	switch( get<0>(program[lr]) )
 	{
-	    case GET:	cout << "? "; cin >> r[get<1>(program[lr])]; i+=100; lr++; break;
-	    case PUT:	cout << "> " << r[get<1>(program[lr])] << endl; i+=100; lr++; break;
+	    case GET:	if( replay )
+			{
+			    if( gi>=gets.size() )
+			    {
+				out.flush();
+				info << "Błąd: Brak wejścia w śladzie w kroku " << krok << "." << endl;
+				return -1;
+			    }
+			    if( fast ) { if( prompt ) out.put( "? " + to_string( gets[gi] ) + "\n" ); }
+			    else cout << "? " << gets[gi] << endl;
+			    r[get<1>(program[lr])] = gets[gi++];
+			}
+			else if( fast )
+			{
+			    if( prompt ) out.put( "? " );
+			    r[get<1>(program[lr])] = atoll( in.word().c_str() );
+			}
+			else { cout << "? "; cin >> r[get<1>(program[lr])]; }
+			if( record ) { trace.put( 'G' ); put64( trace, krok ); put64( trace, r[get<1>(program[lr])] ); gi++; }
+			i+=100; lr++; break;
+	    case PUT:	if( record ) { trace.put( 'P' ); put64( trace, krok ); put64( trace, r[get<1>(program[lr])] ); }
+			if( fast ) out.put( ( prompt ? "> " : "" ) + to_string( r[get<1>(program[lr])] ) + "\n" );
+			else cout << "> " << r[get<1>(program[lr])] << endl;
+			i+=100; lr++; break;
 
 	    case LOAD:	r[get<1>(program[lr])] = pam[r[0]]; i+=10; lr++; break;
 	    case STORE:	pam[r[0]] = r[get<1>(program[lr])]; i+=10; lr++; break;
@@ -117,18 +425,57 @@ int main(int argc, char* argv[])
 	    case DEC:   if( r[get<1>(program[lr])]>0 ) r[get<1>(program[lr])]--; i+=1; lr++; break;
 	    case ZERO: r[get<1>(program[lr])] = 0; i+=1; lr++; break;
 
-	    case JUMP: 	lr = get<2>(program[lr]); i+=1; break;
-	    case JZERO:	if( r[get<1>(program[lr])]==0 ) lr = get<2>(program[lr]); else lr++; i+=1; break;
-	    case JODD:	if( r[get<1>(program[lr])] % 2 != 0 ) lr = get<2>(program[lr]); else lr++; i+=1; break;
+	    case JUMP: 	if( prof ) taken[pc]++;
+			lr = get<2>(program[lr]); i+=1; break;
+	    case JZERO:	if( r[get<1>(program[lr])]==0 ) { if( prof ) taken[pc]++; lr = get<2>(program[lr]); } else lr++; i+=1; break;
+	    case JODD:	if( r[get<1>(program[lr])] % 2 != 0 ) { if( prof ) taken[pc]++; lr = get<2>(program[lr]); } else lr++; i+=1; break;
 	    default: break;
 	}
 	if( lr<0 || lr>=(int)program.size() )
 	{
-	    cout << "Błąd: Wywołanie nieistniejącej instrukcji nr " << lr << "." << endl;
+	    out.flush();
+	    info << "Błąd: Wywołanie nieistniejącej instrukcji nr " << lr << "." << endl;
+	    return -1;
+	}
+    }
+    out.flush();	// jedyny zapis wyjscia w trybie --fast
+    if( get<0>(program[lr])!=HALT )
+    {
+	info << "Zatrzymano program." << endl;
+	stan( info, krok, lr, i, r, reg );
+	return 0;
+    }
+    info << "Skończono program (czas: " << i << ")." << endl;
+    if( record )
+    {
+	trace.put( 'H' );
+	put64( trace, krok );
+	put64( trace, i );
+	trace.close();
+    }
+    if( replay ) stan( info, krok, lr, i, r, reg );
+
+    if( prof )
+    {
+	count[lr]++;
+	opcount[HALT]++;
+
+	ofstream pout( args[1] );
+	if( !pout )
+	{
+	    info << "Błąd: Nie można otworzyć pliku " << args[1] << endl;
 	    return -1;
 	}
+	pout << "# profil: lines,N / linia,wykonania,skoki / op,nazwa,wykonania,koszt / mem,adres,odczyty,zapisy" << endl;
+	pout << "lines," << program.size() << endl;
+	for( size_t l = 0; l<program.size(); l++ )
+	    if( count[l] ) pout << l << "," << count[l] << "," << taken[l] << endl;
+	for( int o = GET; o<=HALT; o++ )
+	    if( opcount[o] ) pout << "op," << names[o] << "," << opcount[o] << "," << opcount[o]*cost[o] << endl;
+	for( auto &m : heat )
+	    pout << "mem," << m.first << "," << m.second.first << "," << m.second.second << endl;
+	pout.close();
     }
-    cout << "Skończono program (czas: " << i << ")." << endl;
 
     return 0;
 }
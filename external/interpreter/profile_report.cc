@@ -0,0 +1,206 @@
+/*
+ * Raport z profilu interpretera
+ *
+ * Author: Michal Kukowski
+ * email: michalkukowski10@gmail.com
+ *
+ * Laczy profil ( interpreter kod profil ) z kodem asm i opcjonalnie z mapa
+ * linii wygenerowana przez kompilator, wypisuje gdzie program traci czas.
+ *
+ * Mapa linii ( CSV ):
+ *  # komentarz
+ *  asm_first,asm_last,src_first,src_last,token
+*/
+
+#include<iostream>
+#include<fstream>
+#include<sstream>
+
+#include<string>
+#include<vector>
+#include<map>
+#include<algorithm>
+
+using namespace std;
+
+#define TOP 10
+
+struct Line
+{
+    string instr;
+    long long count;
+    long long taken;
+    long long cost;
+};
+
+static long long op_cost(const string &op)
+{
+    if( op=="GET" || op=="PUT" ) return 100;
+    if( op=="LOAD" || op=="STORE" || op=="ADD" || op=="SUB" ) return 10;
+    if( op=="HALT" ) return 0;
+
+    return 1;
+}
+
+int main(int argc, char* argv[])
+{
+    vector<Line> code;
+    map<string, pair<long long,long long> > ops;
+    vector< pair<string, pair<long long,long long> > > heat;
+    map<long long, pair<long long, string> > src;	// linia zrodla -> ( koszt, tokeny )
+
+    string str;
+    long long total = 0;
+
+    if( argc!=3 && argc!=4 )
+    {
+	cout << "Usage: profile_report kod profil [mapa]" << endl;
+	return -1;
+    }
+
+    ifstream asmf( argv[1] );
+    if( !asmf )
+    {
+	cout << "Cannot open " << argv[1] << endl;
+	return -1;
+    }
+
+    while( getline(asmf, str) )
+	if( !str.empty() )
+	    code.push_back( Line{ str, 0, 0, 0 } );
+
+    ifstream prof( argv[2] );
+    if( !prof )
+    {
+	cout << "Cannot open " << argv[2] << endl;
+	return -1;
+    }
+
+    while( getline(prof, str) )
+    {
+	if( str.empty() || str[0]=='#' )
+	    continue;
+
+	replace( str.begin(), str.end(), ',', ' ' );
+	istringstream in( str );
+
+	string first;
+	in >> first;
+
+	if( first=="lines" )
+	{
+	    size_t n;
+	    in >> n;
+	    if( n!=code.size() )
+	    {
+		cout << "Profile is from other code ( " << n << " lines, code has " << code.size() << " lines )" << endl;
+		return -1;
+	    }
+	}
+	else if( first=="op" )
+	{
+	    string name;
+	    long long c, t;
+	    in >> name >> c >> t;
+	    ops[name] = make_pair(c, t);
+	}
+	else if( first=="mem" )
+	{
+	    string addr;
+	    long long r, w;
+	    in >> addr >> r >> w;
+	    heat.push_back( make_pair(addr, make_pair(r, w)) );
+	}
+	else
+	{
+	    size_t l = stoull(first);
+	    if( l>=code.size() )
+	    {
+		cout << "Bad line " << l << " in profile" << endl;
+		return -1;
+	    }
+	    in >> code[l].count >> code[l].taken;
+	    code[l].cost = code[l].count * op_cost( code[l].instr.substr(0, code[l].instr.find(' ')) );
+	    total += code[l].cost;
+	}
+    }
+
+    cout << "TOTAL COST: " << total << endl << endl;
+
+    cout << "OPCODES" << endl;
+    cout << "op\tcount\tcost\t%" << endl;
+    for( auto &o : ops )
+	cout << o.first << "\t" << o.second.first << "\t" << o.second.second << "\t"
+	     << ( total ? 100.0 * o.second.second / total : 0.0 ) << endl;
+    cout << endl;
+
+    vector<size_t> hot;
+    for( size_t l = 0; l<code.size(); l++ )
+	if( code[l].count ) hot.push_back( l );
+
+    sort( hot.begin(), hot.end(), [&](size_t a, size_t b){ return code[a].cost > code[b].cost; } );
+
+    cout << "TOP " << TOP << " ASM LINES" << endl;
+    cout << "line\tcount\ttaken\tcost\tinstr" << endl;
+    for( size_t k = 0; k<hot.size() && k<TOP; k++ )
+	cout << hot[k] << "\t" << code[hot[k]].count << "\t" << code[hot[k]].taken << "\t"
+	     << code[hot[k]].cost << "\t" << code[hot[k]].instr << endl;
+    cout << endl;
+
+    if( argc==4 )
+    {
+	ifstream mapf( argv[3] );
+	if( !mapf )
+	{
+	    cout << "Cannot open " << argv[3] << endl;
+	    return -1;
+	}
+
+	while( getline(mapf, str) )
+	{
+	    if( str.empty() || str[0]=='#' )
+		continue;
+
+	    replace( str.begin(), str.end(), ',', ' ' );
+	    istringstream in( str );
+
+	    size_t first, last;
+	    long long line, line_last;
+	    string token;
+
+	    if( !(in >> first >> last >> line >> line_last >> token) )
+		continue;
+
+	    pair<long long, string> &s = src[line];
+	    for( size_t l = first; l<=last && l<code.size(); l++ )
+		s.first += code[l].cost;
+
+	    if( s.second.find(token)==string::npos )
+		s.second += s.second.empty() ? token : " " + token;
+	}
+
+	vector< pair<long long, pair<long long, string> > > lines( src.begin(), src.end() );
+	sort( lines.begin(), lines.end(), [](const pair<long long, pair<long long, string> > &a,
+					     const pair<long long, pair<long long, string> > &b)
+					  { return a.second.first > b.second.first; } );
+
+	cout << "SOURCE LINES" << endl;
+	cout << "line\tcost\t%\ttokens" << endl;
+	for( auto &l : lines )
+	    if( l.second.first )
+		cout << l.first << "\t" << l.second.first << "\t"
+		     << ( total ? 100.0 * l.second.first / total : 0.0 ) << "\t" << l.second.second << endl;
+	cout << endl;
+    }
+
+    sort( heat.begin(), heat.end(), [](const pair<string, pair<long long,long long> > &a,
+				       const pair<string, pair<long long,long long> > &b)
+				    { return a.second.first + a.second.second > b.second.first + b.second.second; } );
+
+    cout << "TOP " << TOP << " MEMORY CELLS" << endl;
+    cout << "addr\treads\twrites" << endl;
+    for( size_t k = 0; k<heat.size() && k<TOP; k++ )
+	cout << heat[k].first << "\t" << heat[k].second.first << "\t" << heat[k].second.second << endl;
+
+    return 0;
+}
@@ -11,29 +11,42 @@
 #define RIGHT_BIGGER   -1
 
 /*
-    Create new node with data and parent
+    Add new block of nodes to tree
 
     PARAMS
+    @IN tree - pointer to tree
+
+    RETURN:
+    0 if success
+    Positive value if failure
+*/
+static int avl_block_add(Avl *tree);
+
+/*
+    Create new node with data and parent, node is taken from free list or block of tree
+
+    PARAMS
+    @IN tree - pointer to tree
     @IN data - addr to data
-    @IN size_of - size of data in bytes
     @IN parent - node parent
 
     RETURN:
     NULL if failure
     Pointer to node if success
 */
-static Avl_node *avl_node_create(void *data,int size_of,Avl_node *parent);
+static Avl_node *avl_node_create(Avl *tree,void *data,Avl_node *parent);
 
 /*
-    Deallocate Avl node
+    Give back Avl node to free list of tree
 
     PARAMS
+    @IN tree - pointer to tree
     @IN node - pointer to bst node
 
     RETURN:
     This is a void function
 */
-static void avl_node_destroy(Avl_node *node);
+static void avl_node_destroy(Avl *tree,Avl_node *node);
 
 
 /*
@@ -161,40 +174,80 @@ static void avl_rotate_rl(Avl *tree,Avl_node *node);
 static int avl_insert_fixup(Avl *tree,Avl_node *new_node);
 
 /*
-    Fix AVL Properties after insert, start from node
+    Fix AVL Properties after delete, start from parent
 
     PARAMS
     @IN tree - pointer to tree
-    @IN parent - parent of deleted node
-    @IN node - pointer to node
+    @IN parent - parent of subtree which is lower after delete
+    @IN left - TRUE iff lower subtree is left son of parent
 
     RETURN:
     0 if success
     Positive value if failure
 */
-static int avl_delete_fixup(Avl *tree,Avl_node *parent,Avl_node *node);
+static int avl_delete_fixup(Avl *tree,Avl_node *parent,BOOL left);
+
+/*
+    Put node new in place of node old ( only link from parent of old is changed )
 
-static Avl_node *avl_node_create(void *data,int size_of,Avl_node *parent)
+    PARAMS
+    @IN tree - pointer to tree
+    @IN old - node in tree
+    @IN new - node which takes place of old ( might be NULL )
+
+    RETURN:
+    This is a void function
+*/
+static void avl_transplant(Avl *tree,Avl_node *old,Avl_node *new);
+
+static int avl_block_add(Avl *tree)
+{
+    Avl_block *block;
+    unsigned long long nodes;
+
+    TRACE("");
+
+    nodes = tree->block == NULL ? AVL_BLOCK_MIN_NODES : tree->block_nodes << 1;
+    if(nodes > AVL_BLOCK_MAX_NODES)
+        nodes = AVL_BLOCK_MAX_NODES;
+
+    block = (Avl_block*)malloc(sizeof(Avl_block) + nodes * tree->node_size);
+    if(block == NULL)
+        ERROR("malloc error\n", 1, "");
+
+    block->next = tree->block;
+
+    tree->block = block;
+    tree->block_nodes = nodes;
+    tree->block_free = nodes;
+
+    return 0;
+}
+
+static Avl_node *avl_node_create(Avl *tree,void *data,Avl_node *parent)
 {
     Avl_node *node;
 
     TRACE("");
 
-    if(data == NULL || size_of < 0)
-        ERROR("data == NULL || size_of < 0\n", NULL, "");
+    if(data == NULL)
+        ERROR("data == NULL\n", NULL, "");
 
-    node = (Avl_node*)malloc(sizeof(Avl_node));
-    if( node == NULL)
-        ERROR("malloc error\n", NULL, "");
+    if(tree->free_nodes != NULL)
+    {
+        node = tree->free_nodes;
+        tree->free_nodes = node->parent;
+    }
+    else
+    {
+        if(tree->block_free == 0 && avl_block_add(tree))
+            ERROR("avl_block_add error\n", NULL, "");
 
-    node->data = malloc(size_of);
-    if(node->data == NULL)
-	{
-		FREE(node);
-        ERROR("malloc error\n", NULL, "");
-	}
+        node = (Avl_node*)(tree->block->nodes + (tree->block_nodes - tree->block_free) * tree->node_size);
+        --tree->block_free;
+    }
 
-    __ASSIGN__(*(BYTE*)node->data,*(BYTE*)data,size_of);
+    __ASSIGN__(*(BYTE*)node->data,*(BYTE*)data,tree->size_of);
 
     node->parent = parent;
 
@@ -206,7 +259,7 @@ static Avl_node *avl_node_create(void *data,int size_of,Avl_node *parent)
     return node;
 }
 
-static void avl_node_destroy(Avl_node *node)
+static void avl_node_destroy(Avl *tree,Avl_node *node)
 {
     TRACE("");
 
@@ -216,8 +269,8 @@ static void avl_node_destroy(Avl_node *node)
         return;
     }
 
-    FREE(node->data);
-    FREE(node);
+    node->parent = tree->free_nodes;
+    tree->free_nodes = node;
 }
 
 static Avl_node *avl_successor(Avl_node *node)
@@ -267,6 +320,7 @@ static Avl_node *avl_predecessor(Avl_node *node)
 static Avl_node *avl_node_search(Avl *tree,void *data_key)
 {
     Avl_node *node;
+    int res;
 
     TRACE("");
 
@@ -277,9 +331,10 @@ static Avl_node *avl_node_search(Avl *tree,void *data_key)
 
     while( node != NULL )
     {
-        if( ! tree->cmp(node->data,data_key) )
+        res = tree->cmp(node->data,data_key);
+        if( ! res )
             return node;
-        else if( tree->cmp(node->data,data_key) == 1)
+        else if( res == 1)
             node = node->left_son;
         else
             node = node->right_son;
@@ -656,89 +711,92 @@ static int avl_insert_fixup(Avl *tree,Avl_node *new_node)
     return 0;
 }
 
-static int avl_delete_fixup(Avl *tree,Avl_node *parent,Avl_node *node)
+static int avl_delete_fixup(Avl *tree,Avl_node *parent,BOOL left)
 {
     Avl_node *ptr;
+    Avl_node *node;
 
     TRACE("");
 
     if( tree == NULL || tree->root == NULL || parent == NULL)
         ERROR("tree == NULL || tree->root == NULL || parent == NULL\n", 1, "");
 
-    ptr = NULL;
-
     while( parent != NULL)
-        /* tree was balanced */
+    {
+        /* tree was balanced, now other branch is bigger but hight not change */
         if( parent->bf == BALANCED )
         {
-            /* deleted from left, so now right is bigger */
-            if(parent->left_son == node)
-                parent->bf = RIGHT_BIGGER;
-            else /* symetric case */
-                parent->bf = LEFT_BIGGER;
-
-            /* tree is balanced, end fixup */
+            parent->bf = left ? RIGHT_BIGGER : LEFT_BIGGER;
             break;
         }
+
+        /* deleted node from bigger branch, parent is balanced and lower */
+        if( (parent->bf == LEFT_BIGGER && left) || (parent->bf == RIGHT_BIGGER && ! left) )
+        {
+            parent->bf = BALANCED;
+            node = parent;
+        }
+        /* deleted node from smaller branch, rotation is needed */
         else
         {
-            /* deleted node from bigger branch, parent is balanced */
-            if((parent->bf == LEFT_BIGGER && parent->left_son == node) || (parent->bf == RIGHT_BIGGER && parent->right_son == node))
+            /* brother of lower branch */
+            ptr = left ? parent->right_son : parent->left_son;
+
+            /* brother is balanced, need rotation but hight not change */
+            if( ptr->bf == BALANCED )
             {
-                parent->bf = BALANCED;
+                if(parent->bf == LEFT_BIGGER)
+                    avl_rotate_ll(tree,parent);
+                else
+                    avl_rotate_rr(tree,parent);
 
-                /* go upper */
-                node = parent;
-                parent= parent->parent;
+                break;
             }
-            /* deleted node from smaller branch, rotation is needed */
-            else
+
+            if( parent->bf == ptr->bf )
             {
-                /* save brother ptr ( need for replay path ) */
-                if(parent->left_son == node)
-                    ptr = parent->right_son;
+                if(parent->bf == LEFT_BIGGER)
+                    avl_rotate_ll(tree,parent);
                 else
-                    ptr = parent->left_son;
-
-                /* brother is balanced, need rotation but hight not change */
-                if(ptr->bf == BALANCED )
-                {
-                    if(parent->bf == LEFT_BIGGER)
-                        avl_rotate_ll(tree,parent);
-                    else
-                        avl_rotate_rr(tree,parent);
-
-                    /* hight not change, not need another fix */
-                    break;
-                }
-                else if(parent->bf == ptr->bf)
-                {
-                    if(parent->bf == LEFT_BIGGER)
-                        avl_rotate_ll(tree,parent);
-                    else
-                        avl_rotate_rr(tree,parent);
-
-                    /* go upper */
-                    node = ptr;
-                    parent = ptr->parent;
-                }
+                    avl_rotate_rr(tree,parent);
+
+                node = ptr;
+            }
+            else
+            {
+                if(parent->bf == LEFT_BIGGER)
+                    avl_rotate_lr(tree,parent);
                 else
-                {
-                    if(parent->bf == LEFT_BIGGER)
-                        avl_rotate_lr(tree,parent);
-                    else
-                        avl_rotate_rl(tree,parent);
-
-                    /* go upper */
-                    node = parent->parent;
-                    parent = node->parent;
-                }
+                    avl_rotate_rl(tree,parent);
+
+                node = parent->parent;
             }
         }
 
+        /* subtree with root node is lower, go upper */
+        parent = node->parent;
+        if( parent != NULL )
+            left = parent->left_son == node;
+    }
+
     return 0;
 }
 
+static void avl_transplant(Avl *tree,Avl_node *old,Avl_node *new)
+{
+    TRACE("");
+
+    if( new != NULL )
+        new->parent = old->parent;
+
+    if( old->parent == NULL )
+        tree->root = new;
+    else if( old->parent->left_son == old )
+        old->parent->left_son = new;
+    else
+        old->parent->right_son = new;
+}
+
 Avl* avl_create(int size_of,int (*cmp)(void* a,void *b))
 {
     Avl *tree;
@@ -758,34 +816,36 @@ Avl* avl_create(int size_of,int (*cmp)(void* a,void *b))
 
     tree->nodes = 0;
 
+    /* next node in block has to be aligned too */
+    tree->node_size = (int)sizeof(Avl_node) + ((size_of + AVL_ALIGN - 1) & ~(AVL_ALIGN - 1));
+
+    tree->free_nodes = NULL;
+    tree->block = NULL;
+    tree->block_free = 0;
+    tree->block_nodes = 0;
+
     return tree;
 }
 
 void avl_destroy(Avl *tree)
 {
-    Avl_node *node;
-    Avl_node *temp;
+    Avl_block *block;
 
     TRACE("");
 
-    if(tree == NULL || tree->root == NULL)
+    if(tree == NULL)
     {
-        LOG("tree == NULL || tree->root == NULL\n", "");
-
-        if(tree != NULL)
-            FREE(tree);
-
+        LOG("tree == NULL\n", "");
         return;
     }
 
-    /* destroy tree using inorder */
-    node = avl_min_node(tree->root);
-
-    while(node != NULL)
+    /* all nodes live in blocks, so tree is not walked */
+    while(tree->block != NULL)
     {
-        temp = node;
-        node = avl_successor(node);
-        avl_node_destroy(temp);
+        block = tree->block;
+        tree->block = block->next;
+
+        FREE(block);
     }
 
     FREE(tree);
@@ -796,6 +856,7 @@ int avl_insert(Avl *tree,void *data)
     Avl_node *node;
     Avl_node *parent;
     Avl_node *new_node;
+    int res;
 
     TRACE("");
 
@@ -805,7 +866,7 @@ int avl_insert(Avl *tree,void *data)
     /* special case - empty tree */
     if( tree->root == NULL)
     {
-        new_node = avl_node_create(data, tree->size_of, NULL);
+        new_node = avl_node_create(tree, data, NULL);
 		if(new_node == NULL)
 			ERROR("avl_node_create error\n", 1, "");
 
@@ -815,27 +876,29 @@ int avl_insert(Avl *tree,void *data)
     {
          parent = NULL;
          node = tree->root;
+         res = 0;
 
         /* find correct place to insert */
         while ( node != NULL )
         {
             parent = node;
-            if( ! tree->cmp(node->data,data) ) /* data exists in tree */
+            res = tree->cmp(node->data,data);
+            if( ! res ) /* data exists in tree */
             {
                 ERROR("data with this key exist in tree\n", 1, "");
             }
-            else if( tree->cmp(node->data,data) == 1)
+            else if( res == 1)
                 node = node->left_son;
             else
                 node = node->right_son;
         }
 
-        new_node = avl_node_create(data, tree->size_of, parent);
+        new_node = avl_node_create(tree, data, parent);
 		if(new_node == NULL)
 		      ERROR("avl_node_create error\n", 1, "");
 
         /* new node is the right son */
-        if( tree->cmp(new_node->data,parent->data) == 1 )
+        if( res != 1 )
             parent->right_son = new_node;
         else /* new_node is the left_node */
             parent->left_son = new_node;
@@ -853,8 +916,8 @@ int avl_delete(Avl *tree,void *data_key)
 {
     Avl_node *node;
     Avl_node *parent;
-    Avl_node *temp;
     Avl_node *successor;
+    BOOL left;
 
     TRACE("");
 
@@ -865,106 +928,50 @@ int avl_delete(Avl *tree,void *data_key)
     if( node == NULL )
         ERROR("data with this key doesn't exist in tree, nothing to delete\n", 1, "");
 
-    temp = NULL;
-    parent = node->parent;
-
-    /* case 1 node is leafnode */
-    if( node->left_son == NULL && node->right_son == NULL)
-    {
-        if( node->parent != NULL)
-        {
-            if(node->parent->left_son == node)
-                node->parent->left_son = NULL;
-            else
-                node->parent->right_son = NULL;
-        }
-        else
-            tree->root = NULL;
-    }
-    /* case 2 node has only left subtree */
-    else if( node->right_son == NULL)
+    /* case 1 node has at most one son, son takes place of node */
+    if( node->left_son == NULL || node->right_son == NULL)
     {
-        node->left_son->parent = node->parent;
-        temp = node->left_son;
+        parent = node->parent;
+        left = parent != NULL && parent->left_son == node;
 
-        if( node->parent != NULL)
-        {
-            if(node->parent->left_son == node)
-                node->parent->left_son = node->left_son;
-            else
-                node->parent->right_son = node->left_son;
-        }
-        else
-            tree->root = node->left_son;
-
-        if( parent != NULL && temp != NULL && avl_delete_fixup(tree,parent,temp) )
-            ERROR("avl_delete_fixup error\n", 1, "");
+        avl_transplant(tree, node, node->left_son != NULL ? node->left_son : node->right_son);
     }
-    /* case 3 node has only right subtree */
-    else if (node->left_son == NULL)
+    /* case 2 node has both children, successor ( without left son ) takes place of node */
+    else
     {
-        node->right_son->parent = node->parent;
-        temp = node->right_son;
+        successor = avl_min_node(node->right_son);
 
-        if( node->parent != NULL)
+        if( successor->parent == node )
         {
-            if(node->parent->left_son == node)
-                node->parent->left_son = node->right_son;
-            else
-                node->parent->right_son = node->right_son;
+            /* right subtree of successor is lower */
+            parent = successor;
+            left = FALSE;
         }
         else
-            tree->root = node->right_son;
-
-        if( parent != NULL && temp != NULL && avl_delete_fixup(tree,parent,temp) )
-            ERROR("avl_delete_fixup error\n", 1, "");
-    }
-    /* case 4 node has both children */
-    else
-    {
-        successor = avl_successor(node);
-
-        temp = successor->right_son;
-        parent = successor->parent;
-
-        /* delete successor */
-        if( successor->right_son != NULL)
-            successor->right_son->parent = successor->parent;
-
-        if(successor->parent->left_son == successor)
-            successor->parent->left_son = successor->right_son;
-        else
-            successor->parent->right_son = successor->right_son;
-
-       if( parent != NULL && temp != NULL && avl_delete_fixup(tree,parent,temp) )
-            ERROR("avl_delete_fixup error\n", 1, "");
-
-        successor->bf = node->bf;
+        {
+            /* successor is taken from left branch of its parent */
+            parent = successor->parent;
+            left = TRUE;
 
-        successor->left_son = node->left_son;
-        successor->right_son = node->right_son;
+            avl_transplant(tree, successor, successor->right_son);
 
-        if( successor->left_son != NULL)
-            successor->left_son->parent = successor;
-        if( successor->right_son != NULL)
+            successor->right_son = node->right_son;
             successor->right_son->parent = successor;
+        }
 
-        successor->parent = node->parent;
+        avl_transplant(tree, node, successor);
 
-        if( node->parent != NULL)
-        {
-            if(node->parent->left_son == node)
-                node->parent->left_son = successor;
-            else
-                node->parent->right_son = successor;
-        }
-        else
-            tree->root = successor;
+        successor->left_son = node->left_son;
+        successor->left_son->parent = successor;
+        successor->bf = node->bf;
     }
 
+    if( parent != NULL && avl_delete_fixup(tree, parent, left) )
+        ERROR("avl_delete_fixup error\n", 1, "");
+
     --tree->nodes;
 
-    avl_node_destroy(node);
+    avl_node_destroy(tree, node);
 
     return 0;
 }
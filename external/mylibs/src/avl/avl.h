@@ -8,6 +8,14 @@
     email: michalkukowski10@gmail.com
 
     LICENCE: GPL2.0+
+
+    Data is stored inside node, so node is one allocation and compare function
+    gets address of data without another jump in memory.
+    Nodes are taken from blocks owned by tree, deleted nodes go to free list of tree
+    and are reused by next insert, avl_destroy frees only blocks.
+
+    Node is not moved until it is deleted, so address of data in node is valid
+    until data is deleted ( see AVL_SEARCH_DEFINE ).
 */
 
 #ifndef ITI_MODE
@@ -28,17 +36,33 @@
     #define INT_8 char
 #endif
 
+/* alignment of data in node */
+#define AVL_ALIGN               __BIGGEST_ALIGNMENT__
+
+/* number of nodes in first block of tree, next blocks are twice bigger up to max */
+#define AVL_BLOCK_MIN_NODES     16
+#define AVL_BLOCK_MAX_NODES     4096
+
 typedef struct Avl_node
 {
-    void *data;
     struct Avl_node *left_son;
     struct Avl_node *right_son;
-    struct Avl_node *parent;
+    struct Avl_node *parent; /* next free node iff node is on free list */
 
     INT_8 bf; /* balanced factor */
 
+    char data[] __attribute__((aligned(AVL_ALIGN))); /* size_of bytes of data */
+
 }Avl_node;
 
+typedef struct Avl_block
+{
+    struct Avl_block *next;
+
+    char nodes[] __attribute__((aligned(AVL_ALIGN)));
+
+}Avl_block;
+
 typedef struct Avl_iterator
 {
     int size_of;
@@ -54,6 +78,13 @@ typedef struct Avl
     int size_of;
 
     int (*cmp)(void* a,void *b);
+
+    int node_size; /* size of node with data */
+
+    Avl_node *free_nodes; /* deleted nodes */
+    Avl_block *block; /* newest block, older blocks are on its list */
+    unsigned long long block_free; /* not used nodes in newest block */
+    unsigned long long block_nodes; /* nodes in newest block */
 }Avl;
 
 /*
@@ -262,4 +293,37 @@ int avl_iterator_get_data(Avl_iterator *iterator,void *val);
 */
 BOOL avl_iterator_end(Avl_iterator *iterator);
 
+/*
+    Define static function NAME which search in tree with data of TYPE by key of KEY_TYPE,
+    CMP is a macro ( or inline function ) so comparison is inlined instead of call by cmp pointer
+
+    CMP(data, key) gets TYPE *data from node and KEY_TYPE key and returns
+    negative value iff data < key, 0 iff data == key, positive value iff data > key
+    ( order has to be the same as order of cmp function of tree )
+
+    Defined function:
+    TYPE *NAME(Avl *tree, KEY_TYPE key)
+
+    RETURN:
+    NULL iff key doesn't exist in tree
+    Pointer to data in node iff key exists in tree
+*/
+#define AVL_SEARCH_DEFINE(NAME, TYPE, KEY_TYPE, CMP) \
+    static __inline__ TYPE *NAME(Avl *tree, KEY_TYPE key) \
+    { \
+        Avl_node *node = tree->root; \
+        int __res__; \
+        \
+        while(node != NULL) \
+        { \
+            __res__ = CMP((TYPE*)(void*)node->data, key); \
+            if(__res__ == 0) \
+                return (TYPE*)(void*)node->data; \
+            \
+            node = __res__ > 0 ? node->left_son : node->right_son; \
+        } \
+        \
+        return NULL; \
+    }
+
 #endif
@@ -9,6 +9,9 @@
 
 #define INIT_SIZE 1024
 
+/* radix sort is faster than introsort from this number of elements */
+#define RADIX_MIN 256
+
 /*
     PARAMS
     @IN darray - pointer to darray
@@ -387,6 +390,7 @@ Darray *darray_create(ARRAY_TYPE type,int size,int size_of,int (*cmp)(void *a,vo
     da->size_of = size_of;
     da->type = type;
     da->cmp = cmp;
+    da->key = DARRAY_KEY_CMP;
 
     da->array = malloc(da->size * da->size_of);
 
@@ -599,18 +603,52 @@ int darray_search_last(Darray *darray,void *val)
     }
 }
 
+int darray_set_key(Darray *darray,DARRAY_KEY key)
+{
+    TRACE("");
+
+    if( darray == NULL )
+    {
+        ERROR("darray == NULL\n",1,"");
+    }
+
+    if( key != DARRAY_KEY_CMP && key != DARRAY_KEY_UNSIGNED && key != DARRAY_KEY_SIGNED )
+    {
+        ERROR("key is invalid\n",1,"");
+    }
+
+    if( key != DARRAY_KEY_CMP && darray->size_of != 1 && darray->size_of != 2
+        && darray->size_of != 4 && darray->size_of != 8 )
+    {
+        ERROR("integer key needs size_of 1, 2, 4 or 8\n",1,"");
+    }
+
+    darray->key = key;
+
+    return 0;
+}
+
 int darray_sort(Darray *darray)
 {
     TRACE("");
 
-    if(darray == NULL || darray->array == NULL || darray->cmp == NULL)
+    if(darray == NULL || darray->array == NULL)
     {
-        ERROR("darray == NULL || darray->array == NULL || darray->cmp == NULL\n",1,"");
+        ERROR("darray == NULL || darray->array == NULL\n",1,"");
     }
 
     if( darray->type == SORTED )
         return 0;
 
+    if( darray->key != DARRAY_KEY_CMP && darray->num_entries >= RADIX_MIN )
+        return radixsort(darray->array,darray->num_entries,darray->size_of,
+                         darray->key == DARRAY_KEY_SIGNED);
+
+    if( darray->cmp == NULL )
+    {
+        ERROR("darray->cmp == NULL\n",1,"");
+    }
+
     return sort(darray->array,darray->num_entries,darray->cmp,darray->size_of);
 }
 
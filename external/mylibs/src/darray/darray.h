@@ -20,6 +20,14 @@
 #define SORTED 0
 #define UNSORTED 1
 
+/*
+    Key of elements used by darray_sort
+*/
+#define DARRAY_KEY unsigned char
+#define DARRAY_KEY_CMP 0 /* only cmp can compare elements */
+#define DARRAY_KEY_UNSIGNED 1 /* elements are unsigned integers or pointers */
+#define DARRAY_KEY_SIGNED 2 /* elements are signed integers */
+
 /*
 	Iterator Init Mode
 */
@@ -48,6 +56,7 @@ typedef struct Darray
 
     int (*cmp)(void *a,void*b); /* pointer to compare function */
     ARRAY_TYPE type; /* type of array ( sorted or unsorted ) */
+    DARRAY_KEY key; /* key of elements, integer keys can be sorted without cmp */
 
 }Darray;
 
@@ -267,7 +276,21 @@ int darray_search_first(Darray *darray,void *val);
 int darray_search_last(Darray *darray,void *val);
 
 /*
-    If array is unsorted sort the array
+    Set key of elements, order of integers has to be the same as order of cmp
+
+    PARAMS
+    @IN darray - pointer to darray
+    @IN key - DARRAY_KEY_CMP, DARRAY_KEY_UNSIGNED or DARRAY_KEY_SIGNED ( size_of 1, 2, 4 or 8 )
+
+    RETURN
+    %0 if success
+    %Non-zero value if failure
+*/
+int darray_set_key(Darray *darray,DARRAY_KEY key);
+
+/*
+    If array is unsorted sort the array,
+    radix sort for big array with integer key, sort ( insort / introsort ) for others
 
     PARAMS
     @IN darray -pointer to darray
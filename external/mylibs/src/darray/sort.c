@@ -5,6 +5,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdint.h>
 
 #define FREE(PTR) do{ if( PTR != NULL) { free(PTR); PTR = NULL; } }while(0)
 #define MIN(a,b) ( (a) < (b) ? (a) : (b) )
@@ -17,8 +18,12 @@
 #define TUKEY_MIN 41
 #define MEDIAN_MIN 16
 
+#define INTROSORT_CUTOFF 16
+
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+
 #define __INSORT__ 32
-#define __BINSORT__ 128
 
 /*
     Merge 2 subarrays of t array and write it to buffer so in buffer we got merged array
@@ -117,6 +122,68 @@ static int partition_bentley(   void *t,
 */
 static int _quicksort(void *t,int offset_left,int offset_right,int(*cmp)(void *a,void *b),int size_of);
 
+/*
+    Main body of introsort, the same as quicksort but after @depth partitions
+    part of array is sorted by heapsort
+
+    PARAMS
+    @IN t- array
+    @IN offset_left - 1st index of array
+    @IN offset_right - last index of array
+    @IN cmp - compare function
+    @IN size_of - size of element
+    @IN depth - max depth of partitions
+
+    RETURN:
+    %0 if success
+    %Non-zero value if failure
+*/
+static int _introsort(void *t,int offset_left,int offset_right,int(*cmp)(void *a,void *b),int size_of,int depth);
+
+/*
+    Move element t[offset_root] down in heap t[0;offset_end)
+
+    PARAMS
+    @IN t - array ( heap )
+    @IN offset_root - element to sift down ( byte offset )
+    @IN offset_end - end of heap ( byte offset )
+    @IN cmp - compare function
+    @IN size_of - size of element
+
+    RETURN:
+    This is a void function
+*/
+static void sift_down(BYTE *t,int offset_root,int offset_end,int(*cmp)(void *a,void *b),int size_of);
+
+/*
+    Check if array is already sorted
+
+    PARAMS
+    @IN t - array ( at least 2 elements )
+    @IN num_elements - number of elements
+    @IN cmp - compare function
+    @IN size_of - size of element
+
+    RETURN:
+    %1 iff array is sorted
+    %-1 iff array is sorted backward ( without equal elements )
+    %0 iff array is not sorted
+*/
+static int sorted_run(BYTE *t,int num_elements,int(*cmp)(void *a,void *b),int size_of);
+
+/*
+    Key of integer for radix sort, signed integer is mapped to unsigned with the same order
+
+    PARAMS
+    @IN p - addr of integer
+    @IN size_of - size of integer ( 1, 2, 4 or 8 )
+    @IN sign - TRUE iff integer is signed
+
+    RETURN:
+    Key of integer
+*/
+static uint64_t radix_key(const BYTE *p,int size_of,BOOL sign);
+
 
 static int merge(void *t,int offset_left,int offset_middle,int offset_right,int(*cmp)(void *a,void *b),int size_of,void *buffer)
 {
@@ -478,6 +545,180 @@ static int _quicksort(void *t,int offset_left,int offset_right,int(*cmp)(void *a
     return 0;
 }
 
+static int _introsort(void *t,int offset_left,int offset_right,int(*cmp)(void *a,void *b),int size_of,int depth)
+{
+    BYTE *_t;
+    int m;
+
+    int offset_left_index;
+    int offset_right_index;
+
+    TRACE("");
+
+    if( t == NULL || cmp == NULL || offset_left < 0
+        || offset_right < 0 || offset_left >= offset_right|| size_of < 0 )
+    {
+        ERROR("t == NULL || cmp == NULL || offset_left < 0 "
+        			"|| offset_right < 0 || offset_left >= offset_right|| size_of < 0\n",1,"");
+    }
+
+    _t = (BYTE*)t;
+
+    while( (offset_right - offset_left) / size_of >= INTROSORT_CUTOFF)
+    {
+        int range = (offset_right - offset_left) / size_of + 1;
+
+        /* too many bad partitions, quicksort would be O(n^2) */
+        if( depth-- == 0 )
+            return heapsort(_t + offset_left,range,cmp,size_of);
+
+        if( range < TUKEY_MIN )
+        {
+            if( medians_of_3( _t,
+                                offset_left,
+                               ((offset_left / size_of + offset_right / size_of) >> 1) * size_of,
+                                offset_right,
+                                cmp,
+                                &m) )
+            {
+                ERROR("medians_of_3 error\n",1,"");
+            }
+        }
+        else
+        {
+            if( tukey_medians(_t,offset_left,offset_right,EPSILON(range,size_of),cmp,size_of,&m) )
+            {
+                ERROR("tukey_medians error\n",1,"");
+            }
+        }
+
+        __SWAP__(_t[m],_t[offset_left],size_of);
+
+        if( partition_bentley(_t,offset_left,offset_right,cmp,size_of,&offset_left_index,&offset_right_index) )
+        {
+            ERROR("partition_bentley error\n",1,"");
+        }
+
+        /* recursion for smaller part, loop for bigger */
+        if(  (offset_left_index - offset_left) < (offset_right - offset_right_index) )
+        {
+            if( offset_left_index > offset_left)
+                if( _introsort(_t,offset_left,offset_left_index,cmp,size_of,depth) )
+                {
+                    ERROR("_introsort error\n",1,"");
+                }
+
+            offset_left = offset_right_index;
+        }
+        else
+        {
+            if( offset_right > offset_right_index)
+                if( _introsort(_t,offset_right_index,offset_right,cmp,size_of,depth) )
+                {
+                    ERROR("_introsort error\n",1,"");
+                }
+
+            offset_right = offset_left_index;
+        }
+    }
+
+    if( offset_right > offset_left
+        && insort(_t + offset_left,(offset_right - offset_left) / size_of + 1,cmp,size_of))
+    {
+        ERROR("insort error\n",1,"");
+    }
+
+    return 0;
+}
+
+static void sift_down(BYTE *t,int offset_root,int offset_end,int(*cmp)(void *a,void *b),int size_of)
+{
+    BYTE buffer[MAXWORD];
+    int offset_child;
+
+    __ASSIGN__(buffer[0],t[offset_root],size_of);
+
+    /* child of i is 2i + 1 */
+    while( (offset_child = (offset_root << 1) + size_of) < offset_end )
+    {
+        if( offset_child + size_of < offset_end
+            && cmp((void*)&t[offset_child],(void*)&t[offset_child + size_of]) == -1 )
+            offset_child += size_of;
+
+        if( cmp((void*)buffer,(void*)&t[offset_child]) != -1 )
+            break;
+
+        __ASSIGN__(t[offset_root],t[offset_child],size_of);
+        offset_root = offset_child;
+    }
+
+    __ASSIGN__(t[offset_root],buffer[0],size_of);
+}
+
+static int sorted_run(BYTE *t,int num_elements,int(*cmp)(void *a,void *b),int size_of)
+{
+    int offset;
+    int size;
+
+    size = num_elements * size_of;
+
+    if( cmp((void*)&t[0],(void*)&t[size_of]) != 1 )
+    {
+        for(offset = size_of; offset + size_of < size; offset += size_of)
+            if( cmp((void*)&t[offset],(void*)&t[offset + size_of]) == 1 )
+                return 0;
+
+        return 1;
+    }
+
+    for(offset = size_of; offset + size_of < size; offset += size_of)
+        if( cmp((void*)&t[offset],(void*)&t[offset + size_of]) != 1 )
+            return 0;
+
+    return -1;
+}
+
+static uint64_t radix_key(const BYTE *p,int size_of,BOOL sign)
+{
+    uint8_t k8;
+    uint16_t k16;
+    uint32_t k32;
+    uint64_t key;
+
+    switch(size_of)
+    {
+        case 1:
+        {
+            memcpy(&k8,p,sizeof(k8));
+            key = k8;
+            break;
+        }
+        case 2:
+        {
+            memcpy(&k16,p,sizeof(k16));
+            key = k16;
+            break;
+        }
+        case 4:
+        {
+            memcpy(&k32,p,sizeof(k32));
+            key = k32;
+            break;
+        }
+        default:
+        {
+            memcpy(&key,p,sizeof(key));
+            break;
+        }
+    }
+
+    /* flip sign bit, so negative numbers are before positive */
+    if( sign )
+        key ^= (uint64_t)1 << ((size_of << 3) - 1);
+
+    return key;
+}
+
 int insort(void *t,int num_elements,int(*cmp)(void *a,void *b),int size_of)
 {
     /* we use buffer instead of temporary variable */
@@ -727,6 +968,162 @@ int quicksort(void *t,int num_elements,int(*cmp)(void *a,void *b),int size_of)
     return _quicksort(t,0,(num_elements - 1) * size_of,cmp,size_of);
 }
 
+int heapsort(void *t,int num_elements,int(*cmp)(void *a,void *b),int size_of)
+{
+    BYTE *_t;
+    int offset;
+    int size;
+
+    TRACE("");
+
+    if( t == NULL || cmp == NULL || num_elements < 0 || size_of < 0)
+    {
+        ERROR("t == NULL || cmp == NULL || num_elements < 0 || size_of < 0\n",1,"");
+    }
+
+    _t = (BYTE*)t;
+    size = num_elements * size_of;
+
+    /* build max heap */
+    for(offset = ((num_elements >> 1) - 1) * size_of; offset >= 0; offset -= size_of)
+        sift_down(_t,offset,size,cmp,size_of);
+
+    /* move max to the end of array */
+    for(offset = size - size_of; offset > 0; offset -= size_of)
+    {
+        __SWAP__(_t[0],_t[offset],size_of);
+        sift_down(_t,0,offset,cmp,size_of);
+    }
+
+    return 0;
+}
+
+int introsort(void *t,int num_elements,int(*cmp)(void *a,void *b),int size_of)
+{
+    BYTE *_t;
+    int depth;
+    int n;
+    int run;
+    int offset_i;
+    int offset_j;
+
+    TRACE("");
+
+    if( t == NULL || cmp == NULL || num_elements < 0 || size_of < 0)
+    {
+        ERROR("t == NULL || cmp == NULL || num_elements < 0 || size_of < 0\n",1,"");
+    }
+
+    if( num_elements < 2 )
+        return 0;
+
+    _t = (BYTE*)t;
+
+    run = sorted_run(_t,num_elements,cmp,size_of);
+    if( run == 1 )
+        return 0;
+
+    if( run == -1 )
+    {
+        for(offset_i = 0, offset_j = (num_elements - 1) * size_of; offset_i < offset_j;
+            offset_i += size_of, offset_j -= size_of)
+            __SWAP__(_t[offset_i],_t[offset_j],size_of);
+
+        return 0;
+    }
+
+    depth = 0;
+    for(n = num_elements; n > 1; n >>= 1)
+        depth += 2;
+
+    return _introsort(_t,0,(num_elements - 1) * size_of,cmp,size_of,depth);
+}
+
+int radixsort(void *t,int num_elements,int size_of,BOOL sign)
+{
+    int count[sizeof(uint64_t)][RADIX_BUCKETS];
+
+    BYTE *_t;
+    BYTE *buffer;
+    BYTE *from;
+    BYTE *to;
+
+    uint64_t key;
+    int size;
+    int offset;
+    int shift;
+    int sum;
+    int c;
+    int d;
+    int i;
+
+    TRACE("");
+
+    if( t == NULL || num_elements < 0
+        || (size_of != 1 && size_of != 2 && size_of != 4 && size_of != 8) )
+    {
+        ERROR("t == NULL || num_elements < 0 || size_of is not 1, 2, 4 or 8\n",1,"");
+    }
+
+    if( num_elements < 2 )
+        return 0;
+
+    _t = (BYTE*)t;
+    size = num_elements * size_of;
+
+    buffer = (BYTE*)malloc(size);
+    if( buffer == NULL )
+    {
+        ERROR("malloc error\n",1,"");
+    }
+
+    /* histograms of all digits in one pass */
+    memset(count,0,sizeof(count));
+    for(offset = 0; offset < size; offset += size_of)
+    {
+        key = radix_key(&_t[offset],size_of,sign);
+        for(d = 0; d < size_of; ++d)
+            ++count[d][(key >> (d * RADIX_BITS)) & (RADIX_BUCKETS - 1)];
+    }
+
+    from = _t;
+    to = buffer;
+    for(d = 0; d < size_of; ++d)
+    {
+        shift = d * RADIX_BITS;
+
+        /* all elements have the same digit, pass doesn't change order */
+        if( count[d][(radix_key(&from[0],size_of,sign) >> shift) & (RADIX_BUCKETS - 1)] == num_elements )
+            continue;
+
+        sum = 0;
+        for(i = 0; i < RADIX_BUCKETS; ++i)
+        {
+            c = count[d][i];
+            count[d][i] = sum;
+            sum += c;
+        }
+
+        for(offset = 0; offset < size; offset += size_of)
+        {
+            key = radix_key(&from[offset],size_of,sign);
+            i = (int)((key >> shift) & (RADIX_BUCKETS - 1));
+
+            __ASSIGN__(to[count[d][i] * size_of],from[offset],size_of);
+            ++count[d][i];
+        }
+
+        SWAP(from,to);
+    }
+
+    if( from != _t )
+        memcpy(_t,from,size);
+
+    FREE(buffer);
+
+    return 0;
+}
+
 int sort(void *t,int num_elements,int(*cmp)(void *a,void *b),int size_of)
 {
     TRACE("");
@@ -738,8 +1135,6 @@ int sort(void *t,int num_elements,int(*cmp)(void *a,void *b),int size_of)
 
 	if( num_elements < __INSORT__)
 		return insort(t,num_elements,cmp,size_of);
-	else if( num_elements < __BINSORT__ )
-		return binsort(t,num_elements,cmp,size_of);
 	else
-		return quicksort(t,num_elements,cmp,size_of);
+		return introsort(t,num_elements,cmp,size_of);
 }
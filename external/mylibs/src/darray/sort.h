@@ -1,6 +1,8 @@
 #ifndef SORT_H
 #define SORT_H
 
+#include <stddef.h>
+
 /*
     Author Michal Kukowski
     email: michalkukowski10@gmail.com
@@ -35,8 +37,23 @@
 
     LICENCE: GPL3
 
+    If type is known, please use SORT_DEFINE, comparison is inlined so sort
+    doesn't call cmp by pointer and doesn't copy elements byte by byte.
+
 */
 
+#ifndef BOOL
+    #define BOOL char
+    #define TRUE 1
+    #define FALSE 0
+#endif
+
+/* sort cutoff to insort in typed sort */
+#define SORT_INSORT_CUTOFF  16
+
+/* array with at least this number of elements uses tukey median in typed sort */
+#define SORT_TUKEY_MIN      128
+
 /*
     Define for insort, please check insort funciton description
 */
@@ -121,12 +138,79 @@ int mergesort(void *t,int num_elements,int(*cmp)(void *a,void *b),int size_of);
 int quicksort(void *t,int num_elements,int(*cmp)(void *a,void *b),int size_of);
 
 /*
-    Define for quicksort, please check quicksort funciton description
+    Define for heapsort, please check heapsort funciton description
+*/
+#define HEAPSORT(ARRAY,NUM,CMP,TYPE) ( heapsort(ARRAY,NUM,CMP,sizeof(TYPE)) )
+
+/*
+    Classic heapsort, O(n log n) in every case, used by introsort when recursion is too deep
+
+    PARAMS
+    @t - array
+    @num_element - number of element in array t
+    @cmp - function to compare 2 element in array t ( see example of cmp function )
+    @size_of - size of element in array t
+
+    RETURN:
+    %0 if success
+    %Non-zero value if failure
+*/
+int heapsort(void *t,int num_elements,int(*cmp)(void *a,void *b),int size_of);
+
+
+/*
+    Define for introsort, please check introsort funciton description
+*/
+#define INTROSORT(ARRAY,NUM,CMP,TYPE) ( introsort(ARRAY,NUM,CMP,sizeof(TYPE)) )
+
+/*
+    Introsort: quicksort ( tukey, bentley partition, cut off to insort ) with depth limit
+    2 * log2(n), deeper parts are sorted by heapsort so O(n log n) is guaranteed.
+    Array which is already sorted ( or sorted backward ) is detected by one pass.
+
+    PARAMS
+    @t - array
+    @num_element - number of element in array t
+    @cmp - function to compare 2 element in array t ( see example of cmp function )
+    @size_of - size of element in array t
+
+    RETURN:
+    %0 if success
+    %Non-zero value if failure
+*/
+int introsort(void *t,int num_elements,int(*cmp)(void *a,void *b),int size_of);
+
+
+/*
+    Define for radixsort, please check radixsort funciton description
+*/
+#define RADIXSORT(ARRAY,NUM,TYPE,SIGN) ( radixsort(ARRAY,NUM,sizeof(TYPE),SIGN) )
+
+/*
+    LSD radix sort ( 8 bits per pass ) of integers or pointers, cmp is not needed.
+    Passes where all elements have the same digit are skipped.
+
+    PARAMS
+    @t - array of integers or pointers
+    @num_element - number of element in array t
+    @size_of - size of element in array t ( 1, 2, 4 or 8 )
+    @sign - TRUE iff elements are signed integers
+
+    RETURN:
+    %0 if success
+    %Non-zero value if failure
+*/
+int radixsort(void *t,int num_elements,int size_of,BOOL sign);
+
+
+/*
+    Define for sort, please check sort funciton description
 */
 #define SORT(ARRAY,NUM,CMP,TYPE) ( sort(ARRAY,NUM,CMP,sizeof(TYPE)) )
 
 /*
-    optimal sort (depeneds on number of entries to sort )
+    optimal sort (depeneds on number of entries to sort ),
+    insort for small arrays, introsort for others
 
     PARAMS
     @t - array
@@ -140,4 +224,175 @@ int quicksort(void *t,int num_elements,int(*cmp)(void *a,void *b),int size_of);
 */
 int sort(void *t,int num_elements,int(*cmp)(void *a,void *b),int size_of);
 
+/*
+    Define static function NAME which sorts array of TYPE ( introsort ),
+    LESS is a macro ( or inline function ) so comparison is inlined instead of call by cmp pointer
+
+    LESS(a, b) gets TYPE *a and TYPE *b and returns non-zero value iff *a < *b
+
+    Defined function:
+    int NAME(TYPE *t, int num_elements)
+
+    RETURN:
+    %0 if success
+    %Non-zero value if failure
+
+    e.i
+    #define INT_LESS(a, b) ( *(a) < *(b) )
+    SORT_DEFINE(int_sort, int, INT_LESS)
+
+    int_sort(t, size);
+*/
+#define SORT_DEFINE(NAME, TYPE, LESS) \
+    static __inline__ void NAME##_insort(TYPE *t, long n) \
+    { \
+        long i; \
+        long j; \
+        TYPE __temp__; \
+        \
+        for(i = 1; i < n; ++i) \
+        { \
+            __temp__ = t[i]; \
+            for(j = i; j > 0 && LESS(&__temp__, &t[j - 1]); --j) \
+                t[j] = t[j - 1]; \
+            \
+            t[j] = __temp__; \
+        } \
+    } \
+    \
+    static __inline__ void NAME##_sift(TYPE *t, long root, long n) \
+    { \
+        long child; \
+        TYPE __temp__ = t[root]; \
+        \
+        while( (child = (root << 1) + 1) < n ) \
+        { \
+            if(child + 1 < n && LESS(&t[child], &t[child + 1])) \
+                ++child; \
+            \
+            if( ! LESS(&__temp__, &t[child]) ) \
+                break; \
+            \
+            t[root] = t[child]; \
+            root = child; \
+        } \
+        \
+        t[root] = __temp__; \
+    } \
+    \
+    static __inline__ void NAME##_heapsort(TYPE *t, long n) \
+    { \
+        long i; \
+        TYPE __temp__; \
+        \
+        for(i = (n >> 1) - 1; i >= 0; --i) \
+            NAME##_sift(t, i, n); \
+        \
+        for(i = n - 1; i > 0; --i) \
+        { \
+            __temp__ = t[0]; \
+            t[0] = t[i]; \
+            t[i] = __temp__; \
+            NAME##_sift(t, 0, i); \
+        } \
+    } \
+    \
+    /* position of median of t[a], t[b], t[c] */ \
+    static __inline__ long NAME##_median3(TYPE *t, long a, long b, long c) \
+    { \
+        if( LESS(&t[a], &t[b]) ) \
+            return LESS(&t[b], &t[c]) ? b : LESS(&t[a], &t[c]) ? c : a; \
+        \
+        return LESS(&t[c], &t[b]) ? b : LESS(&t[c], &t[a]) ? c : a; \
+    } \
+    \
+    static void NAME##_introsort(TYPE *t, long n, int depth) \
+    { \
+        long i; \
+        long j; \
+        long m; \
+        long e; \
+        TYPE __temp__; \
+        TYPE __pivot__; \
+        \
+        while(n > SORT_INSORT_CUTOFF) \
+        { \
+            if(depth-- == 0) \
+            { \
+                NAME##_heapsort(t, n); \
+                return; \
+            } \
+            \
+            m = n >> 1; \
+            if(n < SORT_TUKEY_MIN) \
+                m = NAME##_median3(t, 0, m, n - 1); \
+            else \
+            { \
+                e = n >> 3; \
+                m = NAME##_median3(t, NAME##_median3(t, 0, e, e << 1), \
+                                      NAME##_median3(t, m - e, m, m + e), \
+                                      NAME##_median3(t, n - 1 - (e << 1), n - 1 - e, n - 1)); \
+            } \
+            \
+            __pivot__ = t[m]; \
+            t[m] = t[0]; \
+            t[0] = __pivot__; \
+            \
+            /* elements equal to pivot stop both indexes, so they are split evenly */ \
+            i = 0; \
+            j = n; \
+            for(;;) \
+            { \
+                do \
+                    ++i; \
+                while(i < n && LESS(&t[i], &__pivot__)); \
+                \
+                do \
+                    --j; \
+                while(LESS(&__pivot__, &t[j])); \
+                \
+                if(i >= j) \
+                    break; \
+                \
+                __temp__ = t[i]; \
+                t[i] = t[j]; \
+                t[j] = __temp__; \
+            } \
+            \
+            t[0] = t[j]; \
+            t[j] = __pivot__; \
+            \
+            /* recursion for smaller part, loop for bigger */ \
+            if(j < n - j - 1) \
+            { \
+                NAME##_introsort(t, j, depth); \
+                t += j + 1; \
+                n -= j + 1; \
+            } \
+            else \
+            { \
+                NAME##_introsort(t + j + 1, n - j - 1, depth); \
+                n = j; \
+            } \
+        } \
+        \
+        NAME##_insort(t, n); \
+    } \
+    \
+    static __inline__ int NAME(TYPE *t, int num_elements) \
+    { \
+        int depth = 0; \
+        int n; \
+        \
+        if(t == NULL || num_elements < 0) \
+            return 1; \
+        \
+        for(n = num_elements; n > 1; n >>= 1) \
+            depth += 2; \
+        \
+        NAME##_introsort(t, (long)num_elements, depth); \
+        \
+        return 0; \
+    }
+
 #endif
@@ -0,0 +1,552 @@
+#include "hashmap.h"
+#include "generic.h"
+#include "log.h"
+
+#include <stdlib.h>
+
+#ifdef __SSE2__
+    #include <emmintrin.h>
+#endif
+
+#define FREE(T) do{ if( T != NULL) { free(T); T = NULL; } }while(0)
+
+#define FNV_OFFSET      0xcbf29ce484222325ull
+#define FNV_PRIME       0x100000001b3ull
+
+/* 7 bits of hash in control byte, rest of hash selects group */
+#define HASH_H1(H)      ((H) >> 7)
+#define HASH_H2(H)      ((int8_t)((H) & 0x7f))
+
+#define IS_FULL(C)      ((C) >= 0)
+
+/* max load is 7/8 of slots ( with DELETED ) */
+#define NEED_REHASH(M)  (((M)->length + (M)->deleted + 1) * 8 > (M)->size * 7)
+
+#define ENTRY(M, I)     ((BYTE*)(M)->entries + (size_t)(I) * (size_t)(M)->size_of)
+
+/*
+    Mask of slots in group with control byte equals @c
+
+    PARAMS
+    @IN ctrl - first control byte of group
+    @IN c - control byte
+
+    RETURN:
+    Bit i is set iff ctrl[i] == c
+*/
+static __inline__ unsigned int group_match(const int8_t *ctrl, int8_t c);
+
+/*
+    Mask of EMPTY or DELETED slots in group
+
+    PARAMS
+    @IN ctrl - first control byte of group
+
+    RETURN:
+    Bit i is set iff slot i is not full
+*/
+static __inline__ unsigned int group_match_free(const int8_t *ctrl);
+
+/*
+    Search for slot with data, key is compared by @cmp or @cmp_key ( one of them is not NULL )
+
+    PARAMS
+    @IN map - pointer to map
+    @IN hash - hash of key
+    @IN key - addr of data with key iff cmp, key iff cmp_key
+    @IN cmp - compare function of data
+    @IN cmp_key - compare function of data and key
+
+    RETURN:
+    -1 iff key doesn't exist in map
+    Slot iff key exists in map
+*/
+static long long hashmap_slot(Hashmap *map, uint64_t hash, const void *key,
+                              int (*cmp)(void *a, void *b),
+                              int (*cmp_key)(void *data, const void *key));
+
+/*
+    Get first EMPTY or DELETED slot in probe sequence of hash
+
+    PARAMS
+    @IN map - pointer to map
+    @IN hash - hash of data
+
+    RETURN:
+    Free slot ( map is never full )
+*/
+static unsigned long long hashmap_free_slot(Hashmap *map, uint64_t hash);
+
+/*
+    Move all entries to new slots
+
+    PARAMS
+    @IN map - pointer to map
+    @IN size - new number of slots
+
+    RETURN:
+    0 if success
+    Positive value if failure
+*/
+static int hashmap_rehash(Hashmap *map, unsigned long long size);
+
+static __inline__ unsigned int group_match(const int8_t *ctrl, int8_t c)
+{
+#ifdef __SSE2__
+    __m128i group = _mm_loadu_si128((const __m128i*)ctrl);
+
+    return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(c)));
+#else
+    unsigned int mask = 0;
+    int i;
+
+    for(i = 0; i < HASHMAP_GROUP; ++i)
+        mask |= (unsigned int)(ctrl[i] == c) << i;
+
+    return mask;
+#endif
+}
+
+static __inline__ unsigned int group_match_free(const int8_t *ctrl)
+{
+#ifdef __SSE2__
+    /* EMPTY and DELETED are negative */
+    return (unsigned int)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)ctrl));
+#else
+    unsigned int mask = 0;
+    int i;
+
+    for(i = 0; i < HASHMAP_GROUP; ++i)
+        mask |= (unsigned int)(! IS_FULL(ctrl[i])) << i;
+
+    return mask;
+#endif
+}
+
+static long long hashmap_slot(Hashmap *map, uint64_t hash, const void *key,
+                              int (*cmp)(void *a, void *b),
+                              int (*cmp_key)(void *data, const void *key))
+{
+    unsigned long long groups = map->size / HASHMAP_GROUP;
+    unsigned long long group = HASH_H1(hash) & (groups - 1);
+    unsigned long long slot;
+    unsigned long long i;
+
+    const int8_t *ctrl;
+    unsigned int mask;
+
+    for(i = 0; i < groups; ++i)
+    {
+        ctrl = map->ctrl + group * HASHMAP_GROUP;
+
+        mask = group_match(ctrl, HASH_H2(hash));
+        while(mask)
+        {
+            slot = group * HASHMAP_GROUP + (unsigned long long)__builtin_ctz(mask);
+
+            if(map->hashes[slot] == hash)
+            {
+                if(cmp != NULL && ! cmp((void*)ENTRY(map, slot), (void*)key))
+                    return (long long)slot;
+
+                if(cmp_key != NULL && ! cmp_key((void*)ENTRY(map, slot), key))
+                    return (long long)slot;
+            }
+
+            mask &= mask - 1;
+        }
+
+        /* key would be in this group */
+        if(group_match(ctrl, HASHMAP_EMPTY))
+            return -1;
+
+        /* triangular probing visits each group */
+        group = (group + i + 1) & (groups - 1);
+    }
+
+    return -1;
+}
+
+static unsigned long long hashmap_free_slot(Hashmap *map, uint64_t hash)
+{
+    unsigned long long groups = map->size / HASHMAP_GROUP;
+    unsigned long long group = HASH_H1(hash) & (groups - 1);
+    unsigned long long i;
+
+    unsigned int mask;
+
+    for(i = 0; ; ++i)
+    {
+        mask = group_match_free(map->ctrl + group * HASHMAP_GROUP);
+        if(mask)
+            return group * HASHMAP_GROUP + (unsigned long long)__builtin_ctz(mask);
+
+        group = (group + i + 1) & (groups - 1);
+    }
+}
+
+static int hashmap_rehash(Hashmap *map, unsigned long long size)
+{
+    int8_t *ctrl = map->ctrl;
+    uint64_t *hashes = map->hashes;
+    void *entries = map->entries;
+    unsigned long long old_size = map->size;
+
+    unsigned long long i;
+    unsigned long long slot;
+
+    TRACE("");
+
+    map->ctrl = (int8_t*)malloc((size_t)size);
+    map->hashes = (uint64_t*)malloc((size_t)size * sizeof(uint64_t));
+    map->entries = malloc((size_t)size * (size_t)map->size_of);
+
+    if(map->ctrl == NULL || map->hashes == NULL || map->entries == NULL)
+    {
+        FREE(map->ctrl);
+        FREE(map->hashes);
+        FREE(map->entries);
+
+        map->ctrl = ctrl;
+        map->hashes = hashes;
+        map->entries = entries;
+
+        ERROR("malloc error\n", 1, "");
+    }
+
+    memset(map->ctrl, HASHMAP_EMPTY, (size_t)size);
+
+    map->size = size;
+    map->deleted = 0;
+
+    /* hashes are kept, so they are not computed again */
+    for(i = 0; i < old_size; ++i)
+        if(IS_FULL(ctrl[i]))
+        {
+            slot = hashmap_free_slot(map, hashes[i]);
+
+            map->ctrl[slot] = ctrl[i];
+            map->hashes[slot] = hashes[i];
+            memcpy(ENTRY(map, slot), (BYTE*)entries + (size_t)i * (size_t)map->size_of, (size_t)map->size_of);
+        }
+
+    FREE(ctrl);
+    FREE(hashes);
+    FREE(entries);
+
+    return 0;
+}
+
+uint64_t hashmap_hash_str(const char *str)
+{
+    uint64_t hash = FNV_OFFSET;
+
+    while(*str)
+    {
+        hash ^= (uint8_t)*str++;
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+Hashmap *hashmap_create(int size_of, uint64_t (*hash)(void *data), int (*cmp)(void *a, void *b))
+{
+    Hashmap *map;
+
+    TRACE("");
+
+    if(size_of < 1 || hash == NULL || cmp == NULL)
+        ERROR("size_of < 1 || hash == NULL || cmp == NULL\n", NULL, "");
+
+    map = (Hashmap*)malloc(sizeof(Hashmap));
+    if(map == NULL)
+        ERROR("malloc error\n", NULL, "");
+
+    map->ctrl = (int8_t*)malloc(HASHMAP_INIT_SIZE);
+    map->hashes = (uint64_t*)malloc(HASHMAP_INIT_SIZE * sizeof(uint64_t));
+    map->entries = malloc(HASHMAP_INIT_SIZE * (size_t)size_of);
+
+    if(map->ctrl == NULL || map->hashes == NULL || map->entries == NULL)
+    {
+        FREE(map->ctrl);
+        FREE(map->hashes);
+        FREE(map->entries);
+        FREE(map);
+
+        ERROR("malloc error\n", NULL, "");
+    }
+
+    memset(map->ctrl, HASHMAP_EMPTY, HASHMAP_INIT_SIZE);
+
+    map->size = HASHMAP_INIT_SIZE;
+    map->length = 0;
+    map->deleted = 0;
+
+    map->size_of = size_of;
+    map->hash = hash;
+    map->cmp = cmp;
+
+    return map;
+}
+
+void hashmap_destroy(Hashmap *map)
+{
+    TRACE("");
+
+    if(map == NULL)
+    {
+        LOG("map == NULL\n", "");
+        return;
+    }
+
+    FREE(map->ctrl);
+    FREE(map->hashes);
+    FREE(map->entries);
+    FREE(map);
+}
+
+int hashmap_insert(Hashmap *map, void *data)
+{
+    uint64_t hash;
+    unsigned long long slot;
+
+    TRACE("");
+
+    if(map == NULL || data == NULL)
+        ERROR("map == NULL || data == NULL\n", 1, "");
+
+    hash = map->hash(data);
+
+    if(hashmap_slot(map, hash, data, map->cmp, NULL) != -1)
+        ERROR("data with this key exist in map\n", 1, "");
+
+    if(NEED_REHASH(map))
+    {
+        /* grow iff map is full of entries, otherwise only clean DELETED slots */
+        if(hashmap_rehash(map, (map->length + 1) * 2 > map->size ? map->size << 1 : map->size))
+            ERROR("hashmap_rehash error\n", 1, "");
+    }
+
+    slot = hashmap_free_slot(map, hash);
+    if(map->ctrl[slot] == HASHMAP_DELETED)
+        --map->deleted;
+
+    map->ctrl[slot] = HASH_H2(hash);
+    map->hashes[slot] = hash;
+    __ASSIGN__(*ENTRY(map, slot), *(BYTE*)data, map->size_of);
+
+    ++map->length;
+
+    return 0;
+}
+
+int hashmap_search(Hashmap *map, void *data_key, void *data_out)
+{
+    long long slot;
+
+    TRACE("");
+
+    if(map == NULL || data_key == NULL)
+        ERROR("map == NULL || data_key == NULL\n", 1, "");
+
+    slot = hashmap_slot(map, map->hash(data_key), data_key, map->cmp, NULL);
+    if(slot == -1)
+        ERROR("data with this key doesn't exist in map\n", 1, "");
+
+    if(data_out != NULL)
+        __ASSIGN__(*(BYTE*)data_out, *ENTRY(map, slot), map->size_of);
+
+    return 0;
+}
+
+void *hashmap_search_hash(Hashmap *map, uint64_t hash, const void *key,
+                          int (*cmp_key)(void *data, const void *key))
+{
+    long long slot;
+
+    TRACE("");
+
+    if(map == NULL || key == NULL || cmp_key == NULL)
+        ERROR("map == NULL || key == NULL || cmp_key == NULL\n", NULL, "");
+
+    slot = hashmap_slot(map, hash, key, NULL, cmp_key);
+    if(slot == -1)
+        return NULL;
+
+    return (void*)ENTRY(map, slot);
+}
+
+BOOL hashmap_key_exist(Hashmap *map, void *data_key)
+{
+    TRACE("");
+
+    if(map == NULL || data_key == NULL)
+        ERROR("map == NULL || data_key == NULL\n", FALSE, "");
+
+    return hashmap_slot(map, map->hash(data_key), data_key, map->cmp, NULL) != -1;
+}
+
+int hashmap_delete(Hashmap *map, void *data_key)
+{
+    long long slot;
+    unsigned long long group;
+
+    TRACE("");
+
+    if(map == NULL || data_key == NULL)
+        ERROR("map == NULL || data_key == NULL\n", 1, "");
+
+    slot = hashmap_slot(map, map->hash(data_key), data_key, map->cmp, NULL);
+    if(slot == -1)
+        ERROR("data with this key doesn't exist in map, nothing to delete\n", 1, "");
+
+    group = (unsigned long long)slot / HASHMAP_GROUP * HASHMAP_GROUP;
+
+    /* search stops on this group anyway, so slot can be EMPTY */
+    if(group_match(map->ctrl + group, HASHMAP_EMPTY))
+        map->ctrl[slot] = HASHMAP_EMPTY;
+    else
+    {
+        map->ctrl[slot] = HASHMAP_DELETED;
+        ++map->deleted;
+    }
+
+    --map->length;
+
+    return 0;
+}
+
+int hashmap_to_array(Hashmap *map, void *array, int *size)
+{
+    BYTE *t;
+    unsigned long long i;
+    size_t offset;
+
+    TRACE("");
+
+    if(map == NULL || array == NULL || size == NULL)
+        ERROR("map == NULL || array == NULL || size == NULL\n", 1, "");
+
+    /* malloc(0) may return NULL */
+    t = (BYTE*)malloc((size_t)(map->length + 1) * (size_t)map->size_of);
+    if(t == NULL)
+        ERROR("malloc error\n", 1, "");
+
+    offset = 0;
+    for(i = 0; i < map->size; ++i)
+        if(IS_FULL(map->ctrl[i]))
+        {
+            __ASSIGN__(t[offset], *ENTRY(map, i), map->size_of);
+            offset += (size_t)map->size_of;
+        }
+
+    *(void**)array = t;
+    *size = (int)map->length;
+
+    return 0;
+}
+
+Hashmap_iterator *hashmap_iterator_create(Hashmap *map, ITI_MODE mode)
+{
+    Hashmap_iterator *iterator;
+
+    TRACE("");
+
+    iterator = (Hashmap_iterator*)malloc(sizeof(Hashmap_iterator));
+    if(iterator == NULL)
+        ERROR("malloc error\n", NULL, "");
+
+    if(hashmap_iterator_init(map, iterator, mode))
+    {
+        FREE(iterator);
+        ERROR("hashmap_iterator_init error\n", NULL, "");
+    }
+
+    return iterator;
+}
+
+int hashmap_iterator_init(Hashmap *map, Hashmap_iterator *iterator, ITI_MODE mode)
+{
+    TRACE("");
+
+    if(map == NULL || iterator == NULL || (mode != ITI_BEGIN && mode != ITI_END))
+        ERROR("map || iterator == NULL || (mode != ITI_BEGIN && mode != ITI_END)\n", 1, "");
+
+    iterator->map = map;
+
+    if(mode == ITI_BEGIN)
+    {
+        iterator->index = -1;
+        return hashmap_iterator_next(iterator);
+    }
+
+    iterator->index = (long long)map->size;
+    return hashmap_iterator_prev(iterator);
+}
+
+void hashmap_iterator_destroy(Hashmap_iterator *iterator)
+{
+    TRACE("");
+
+    if(iterator == NULL)
+    {
+        LOG("iterator == NULL\n", "");
+        return;
+    }
+
+    FREE(iterator);
+}
+
+int hashmap_iterator_next(Hashmap_iterator *iterator)
+{
+    TRACE("");
+
+    if(iterator == NULL)
+        ERROR("iterator == NULL\n", 1, "");
+
+    do
+        ++iterator->index;
+    while(iterator->index < (long long)iterator->map->size && ! IS_FULL(iterator->map->ctrl[iterator->index]));
+
+    return 0;
+}
+
+int hashmap_iterator_prev(Hashmap_iterator *iterator)
+{
+    TRACE("");
+
+    if(iterator == NULL)
+        ERROR("iterator == NULL\n", 1, "");
+
+    do
+        --iterator->index;
+    while(iterator->index >= 0 && ! IS_FULL(iterator->map->ctrl[iterator->index]));
+
+    return 0;
+}
+
+int hashmap_iterator_get_data(Hashmap_iterator *iterator, void *val)
+{
+    TRACE("");
+
+    if(iterator == NULL || val == NULL)
+        ERROR("iterator == NULL || val == NULL\n", 1, "");
+
+    if(hashmap_iterator_end(iterator))
+        ERROR("iterator is out of map\n", 1, "");
+
+    __ASSIGN__(*(BYTE*)val, *ENTRY(iterator->map, iterator->index), iterator->map->size_of);
+
+    return 0;
+}
+
+BOOL hashmap_iterator_end(Hashmap_iterator *iterator)
+{
+    TRACE("");
+
+    if(iterator == NULL)
+        ERROR("iterator == NULL\n", TRUE, "");
+
+    return iterator->index < 0 || iterator->index >= (long long)iterator->map->size;
+}
@@ -0,0 +1,276 @@
+#ifndef HASHMAP_H
+#define HASHMAP_H
+
+/*
+    Hash map with open addressing
+
+    Author: Michal Kukowski
+    email: michalkukowski10@gmail.com
+
+    LICENCE: GPL2.0+
+
+    Slots are split into groups of HASHMAP_GROUP, each slot has control byte:
+    EMPTY, DELETED or 7 low bits of hash of entry. Search compares 7 bits of hash
+    with whole group of control bytes at once ( SSE2 iff available ), full hash
+    is kept for each slot, so cmp is called only for entries with the same hash
+    and hashes are not computed again while table grows.
+
+    Groups are probed in triangular sequence, search stops on group with EMPTY slot.
+    Iteration order is not defined ( order of slots ).
+*/
+
+#include <stdint.h>
+
+#ifndef ITI_MODE
+    #define ITI_MODE unsigned char
+#endif
+
+#define ITI_BEGIN   0
+#define ITI_END     1
+
+#ifndef BOOL
+    #define BOOL    char
+    #define TRUE    1
+    #define FALSE   0
+#endif
+
+#define HASHMAP_GROUP       16
+#define HASHMAP_INIT_SIZE   HASHMAP_GROUP
+
+/* control bytes, full slot has 7 bits of hash ( 0 - 127 ) */
+#define HASHMAP_EMPTY       ((int8_t)-128)
+#define HASHMAP_DELETED     ((int8_t)-2)
+
+typedef struct Hashmap
+{
+    int8_t *ctrl; /* control bytes */
+    uint64_t *hashes; /* hash of entry in slot */
+    void *entries; /* size_of bytes for each slot */
+
+    unsigned long long size; /* number of slots, power of 2, multiple of HASHMAP_GROUP */
+    unsigned long long length; /* number of entries */
+    unsigned long long deleted; /* number of DELETED slots */
+
+    int size_of;
+
+    uint64_t (*hash)(void *data);
+    int (*cmp)(void *a, void *b); /* 0 iff a == b */
+
+}Hashmap;
+
+typedef struct Hashmap_iterator
+{
+    Hashmap *map;
+    long long index; /* slot */
+
+}Hashmap_iterator;
+
+/*
+    Hash of string ( FNV-1a 64 ), can be used by hash function of entries with name
+
+    PARAMS
+    @IN str - string
+
+    RETURN:
+    Hash of string
+*/
+uint64_t hashmap_hash_str(const char *str);
+
+/*
+    Create hash map
+
+    PARAMS
+    @IN size_of - size of data in map
+    @IN hash - hash function of data
+    @IN cmp - compare function, 0 iff data have the same key
+
+    RETURN:
+    NULL if failure
+    Pointer to map if success
+*/
+Hashmap *hashmap_create(int size_of, uint64_t (*hash)(void *data), int (*cmp)(void *a, void *b));
+
+#define HASHMAP_CREATE(PTR,TYPE,HASH,CMP) do{ PTR = hashmap_create(sizeof(TYPE),HASH,CMP); }while(0)
+
+/*
+    Destroy map
+
+    PARAMS
+    @IN map - pointer to map
+
+    RETURN:
+    This is a void function
+*/
+void hashmap_destroy(Hashmap *map);
+
+/*
+    Insert data to map IFF data with key ( using cmp ) is not in map
+
+    PARAMS
+    @IN map - pointer to map
+    @IN data - addr of data
+
+    RETURN:
+    0 if success
+    Positive value if failure
+*/
+int hashmap_insert(Hashmap *map, void *data);
+
+/*
+    Search for data with key equals key @data_key ( using cmp )
+
+    PARAMS
+    @IN map - pointer to map
+    @IN data_key - addr of data with search key
+    @OUT data_out - returned data by addr ( can be NULL )
+
+    RETURN:
+    0 if success
+    Positive value if failure
+*/
+int hashmap_search(Hashmap *map, void *data_key, void *data_out);
+
+/*
+    Search for data by precomputed hash and key of other type than data
+
+    PARAMS
+    @IN map - pointer to map
+    @IN hash - hash of key, the same as hash of data with this key
+    @IN key - key
+    @IN cmp_key - compare function of data and key, 0 iff data has key
+
+    RETURN:
+    NULL if key doesn't exist in map
+    Pointer to data in map if success ( valid until next insert or delete )
+*/
+void *hashmap_search_hash(Hashmap *map, uint64_t hash, const void *key,
+                          int (*cmp_key)(void *data, const void *key));
+
+/*
+	Check existing of key in map
+
+ 	PARAMS
+    @IN map - pointer to map
+    @IN data_key - addr of data with search key
+
+	RETURN:
+	FALSE iff key doesn't exist in map
+	TRUE iff key exists in map
+*/
+BOOL hashmap_key_exist(Hashmap *map, void *data_key);
+
+/*
+    Delete data with key equals @data_key ( using cmp )
+
+    PARAMS
+    @IN map - pointer to map
+    @IN data_key = addr of data with key to delete
+
+    RETURN:
+    0 if success
+    Positive value if failure
+*/
+int hashmap_delete(Hashmap *map, void *data_key);
+
+/*
+    Copy data from map to array ( order of slots )
+
+    PARAMS
+    @IN map - pointer to map
+    @OUT array - addr of array
+    @OUT size - size of array
+
+    RETURN:
+    0 if success
+    Positive value if failure
+*/
+int hashmap_to_array(Hashmap *map, void *array, int *size);
+
+/*
+    Init iterator
+
+    PARAMS
+    @IN map - pointer to map
+    @IN mode - iterator init mode
+
+    RETURN:
+    NULL if failure
+    Pointer to new iterator if success
+*/
+Hashmap_iterator *hashmap_iterator_create(Hashmap *map, ITI_MODE mode);
+
+/*
+    Init iterator
+
+    PARAMS
+    @IN map - pointer to map
+    @IN iterator - pointer to iterator
+    @IN mode - iterator init mode
+
+    RETURN:
+    0 if success
+    Positive value if failure
+*/
+int hashmap_iterator_init(Hashmap *map, Hashmap_iterator *iterator, ITI_MODE mode);
+
+/*
+    Deallocate memory
+
+    PARAMS
+    @iterator - pointer to iterator
+
+    RETURN:
+    This is void function
+*/
+void hashmap_iterator_destroy(Hashmap_iterator *iterator);
+
+/*
+    Go to the next value
+
+    PARAMS
+    @IN iterator - pointer iterator
+
+    RETURN:
+    0 if success
+    Positive value if failure
+*/
+int hashmap_iterator_next(Hashmap_iterator *iterator);
+
+/*
+    Go to the prev value
+
+    PARAMS
+    @IN iterator - pointer iterator
+
+    RETURN:
+    0 if success
+    Positive value if failure
+*/
+int hashmap_iterator_prev(Hashmap_iterator *iterator);
+
+/*
+    data getter using iterator
+
+    PARAMS
+    @IN - pointer iterator
+    @OUT val - pointer to value
+
+    RETURN:
+    0 if success
+    Positive value if failure
+*/
+int hashmap_iterator_get_data(Hashmap_iterator *iterator, void *val);
+
+/*
+    Check the end of map
+
+    PARAMS
+    @IN iterator - pointer to iterator
+
+    RETURN:
+    FALSE if not end
+    TRUE if end
+*/
+BOOL hashmap_iterator_end(Hashmap_iterator *iterator);
+
+#endif
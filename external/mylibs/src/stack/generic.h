@@ -43,7 +43,8 @@
 
 #endif
 
-BYTE __buffer__[MAXWORD];
+/* temp for __SWAP__, thread local so structures can be used by many threads */
+static __thread BYTE __buffer__[MAXWORD] __attribute__((unused));
 
 #define __SWAP__(A,B,S) do{ \
                             if( &A != &B) \
@@ -2,6 +2,234 @@
 #include <stdio.h>
 #include <stdarg.h>
 
+#ifdef TRACE_EVENTS
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+typedef struct Trace_event
+{
+	uint64_t ts; /* monotonic time in ns */
+	const char *func;
+	uint64_t type; /* TRACE_EVENT_BEGIN or TRACE_EVENT_END */
+
+}Trace_event;
+
+/* ring buffer of thread, never freed, so it is dumped after end of thread */
+typedef struct Trace_ring
+{
+	struct Trace_ring *next;
+	uint64_t tid;
+	uint64_t head; /* number of events written, event i is in events[i % TRACE_RING_SIZE] */
+
+	Trace_event events[TRACE_RING_SIZE];
+
+}Trace_ring;
+
+static __thread Trace_ring *ring = NULL;
+
+/* rings of all threads */
+static Trace_ring *rings = NULL;
+
+/*
+	Create ring buffer of thread and add it to rings
+
+	PARAMS
+	NO PARAMS
+
+	RETURN:
+	NULL iff failure
+	Pointer to ring iff success
+*/
+static Trace_ring *trace_ring_create(void);
+
+/*
+	Write event to ring buffer of thread
+
+	PARAMS
+	@IN func - name of function
+	@IN type - TRACE_EVENT_BEGIN or TRACE_EVENT_END
+
+	RETURN:
+	This is a void function
+*/
+static void trace_event(const char *func, uint64_t type);
+
+/*
+	Compare pointers to names, for qsort and bsearch
+
+	PARAMS
+	@IN a - pointer to name
+	@IN b - pointer to name
+
+	RETURN:
+	-1 iff a < b
+	0 iff a == b
+	1 iff a > b
+*/
+static int trace_name_cmp(const void *a, const void *b);
+
+/*
+	Dump rings of all threads to file from FLATT_TRACE env at exit
+
+	File format ( binary, native endian ):
+	magic[8]
+	names:u64 then for each name: len:u32 name[len]
+	rings:u64 then for each ring: tid:u64 events:u64 then events from the oldest:
+	    ts:u64 name:u32 type:u32
+
+	PARAMS
+	NO PARAMS
+
+	RETURN:
+	This is a void function
+*/
+static void trace_dump(void) __attribute__((destructor));
+
+static Trace_ring *trace_ring_create(void)
+{
+	Trace_ring *r;
+
+	r = (Trace_ring*)malloc(sizeof(Trace_ring));
+	if(r == NULL)
+		return NULL;
+
+	r->tid = (uint64_t)syscall(SYS_gettid);
+	r->head = 0;
+
+	/* threads start at once, so list is changed without lock */
+	r->next = __atomic_load_n(&rings, __ATOMIC_RELAXED);
+	while( ! __atomic_compare_exchange_n(&rings, &r->next, r, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED) )
+		;
+
+	return r;
+}
+
+static void trace_event(const char *func, uint64_t type)
+{
+	struct timespec ts;
+	Trace_event *event;
+
+	if(ring == NULL)
+	{
+		ring = trace_ring_create();
+		if(ring == NULL)
+			return;
+	}
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	event = &ring->events[ring->head & (TRACE_RING_SIZE - 1)];
+	event->ts = (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+	event->func = func;
+	event->type = type;
+
+	++ring->head;
+}
+
+static int trace_name_cmp(const void *a, const void *b)
+{
+	uintptr_t x = (uintptr_t)*(const char *const *)a;
+	uintptr_t y = (uintptr_t)*(const char *const *)b;
+
+	return x < y ? -1 : x > y;
+}
+
+static void trace_dump(void)
+{
+	const char *file;
+	const char **names;
+	const char **name;
+	FILE *f;
+	Trace_ring *r;
+	Trace_event *event;
+	uint64_t nnames = 0;
+	uint64_t nrings = 0;
+	uint64_t first;
+	uint64_t count;
+	uint64_t i;
+	uint64_t n;
+	uint32_t len;
+	uint32_t id;
+	uint32_t type;
+
+	file = getenv(TRACE_FILE_ENV);
+	if(file == NULL)
+		file = TRACE_FILE_DEFAULT;
+
+	/* names are pointers to __func__, collect them from all events */
+	for(r = __atomic_load_n(&rings, __ATOMIC_ACQUIRE); r != NULL; r = r->next)
+	{
+		nnames += r->head < TRACE_RING_SIZE ? r->head : TRACE_RING_SIZE;
+		++nrings;
+	}
+
+	names = (const char**)malloc(sizeof(const char*) * (nnames + 1));
+	if(names == NULL)
+		return;
+
+	n = 0;
+	for(r = rings; r != NULL; r = r->next)
+		for(i = 0; i < r->head && i < TRACE_RING_SIZE; ++i)
+			names[n++] = r->events[i].func;
+
+	qsort(names, n, sizeof(const char*), trace_name_cmp);
+
+	/* unique names */
+	nnames = 0;
+	for(i = 0; i < n; ++i)
+		if(nnames == 0 || names[nnames - 1] != names[i])
+			names[nnames++] = names[i];
+
+	f = fopen(file, "w");
+	if(f == NULL)
+	{
+		fprintf(stderr, "cannot open trace file %s\n", file);
+		free(names);
+		return;
+	}
+
+	fwrite(TRACE_MAGIC, sizeof(char), strlen(TRACE_MAGIC), f);
+
+	fwrite(&nnames, sizeof(uint64_t), 1, f);
+	for(i = 0; i < nnames; ++i)
+	{
+		len = (uint32_t)strlen(names[i]);
+		fwrite(&len, sizeof(uint32_t), 1, f);
+		fwrite(names[i], sizeof(char), len, f);
+	}
+
+	fwrite(&nrings, sizeof(uint64_t), 1, f);
+	for(r = rings; r != NULL; r = r->next)
+	{
+		count = r->head < TRACE_RING_SIZE ? r->head : TRACE_RING_SIZE;
+		first = r->head - count;
+
+		fwrite(&r->tid, sizeof(uint64_t), 1, f);
+		fwrite(&count, sizeof(uint64_t), 1, f);
+
+		for(i = first; i < r->head; ++i)
+		{
+			event = &r->events[i & (TRACE_RING_SIZE - 1)];
+
+			name = (const char**)bsearch(&event->func, names, nnames, sizeof(const char*), trace_name_cmp);
+			id = (uint32_t)(name - names);
+			type = (uint32_t)event->type;
+
+			fwrite(&event->ts, sizeof(uint64_t), 1, f);
+			fwrite(&id, sizeof(uint32_t), 1, f);
+			fwrite(&type, sizeof(uint32_t), 1, f);
+		}
+	}
+
+	fclose(f);
+	free(names);
+}
+#endif
+
 void __log__(const char *msg, ...)
 {
 	#ifdef DEBUG_MODE
@@ -11,6 +239,8 @@ void __log__(const char *msg, ...)
 		vfprintf(stderr,msg,args);
 
 		va_end(args);
+	#else
+		(void)msg;
 	#endif
 }
 
@@ -23,5 +253,25 @@ void __trace_call__(const char *msg, ...)
 		vfprintf(stderr,msg,args);
 
 		va_end(args);
+	#else
+		(void)msg;
+	#endif
+}
+
+const char *__trace_begin__(const char *func)
+{
+	#ifdef TRACE_EVENTS
+		trace_event(func, TRACE_EVENT_BEGIN);
+	#endif
+
+	return func;
+}
+
+void __trace_end__(const char **scope)
+{
+	#ifdef TRACE_EVENTS
+		trace_event(*scope, TRACE_EVENT_END);
+	#else
+		(void)scope;
 	#endif
 }
@@ -0,0 +1,372 @@
+#include "vector.h"
+#include "log.h"
+#include "generic.h"
+#include <stdlib.h>
+
+#define FREE(PTR) do{ if( PTR != NULL) { free(PTR); PTR = NULL; } }while(0)
+
+/* address of element at @POS */
+#define VECTOR_AT(V,POS) ((BYTE*)(V)->array + (size_t)(POS) * (size_t)(V)->size_of)
+
+/*
+    Make place for @n more elements, array is grown twice
+
+    PARAMS
+    @IN vector - pointer to vector
+    @IN n - number of new elements
+
+    RETURN:
+    0 if success
+    Non-zero value if failure
+*/
+static int vector_reserve(Vector *vector, unsigned long long n);
+
+static int vector_reserve(Vector *vector, unsigned long long n)
+{
+    unsigned long long size;
+    void *array;
+
+    TRACE("");
+
+    if(vector->length + n <= vector->size)
+        return 0;
+
+    size = vector->size;
+    while(size < vector->length + n)
+        size <<= 1;
+
+    array = realloc(vector->array, (size_t)size * (size_t)vector->size_of);
+    if(array == NULL)
+        ERROR("realloc error\n", 1, "");
+
+    vector->array = array;
+    vector->size = size;
+
+    return 0;
+}
+
+Vector_iterator *vector_iterator_create(Vector *vector, ITI_MODE mode)
+{
+    Vector_iterator *iterator;
+
+    TRACE("");
+
+    if( vector == NULL || (mode != ITI_BEGIN && mode != ITI_END))
+        ERROR("vector == NULL || (mode != ITI_BEGIN && mode != ITI_END)\n", NULL, "");
+
+    iterator = (Vector_iterator*)malloc(sizeof(Vector_iterator));
+    if(iterator == NULL)
+        ERROR("malloc error\n", NULL, "");
+
+    if(vector_iterator_init(vector, iterator, mode))
+    {
+        FREE(iterator);
+        ERROR("vector_iterator_init error\n", NULL, "");
+    }
+
+    return iterator;
+}
+
+void vector_iterator_destroy(Vector_iterator *iterator)
+{
+    TRACE("");
+
+    if(iterator == NULL)
+    {
+        LOG("iterator == NULL\n", "");
+        return;
+    }
+
+    FREE(iterator);
+}
+
+int vector_iterator_init(Vector *vector, Vector_iterator *iterator, ITI_MODE mode)
+{
+    TRACE("");
+
+    if( vector == NULL || iterator == NULL || (mode != ITI_BEGIN && mode != ITI_END))
+        ERROR("vector || iterator == NULL || (mode != ITI_BEGIN && mode != ITI_END)\n", 1, "");
+
+    iterator->vector = vector;
+
+    if(mode == ITI_BEGIN)
+        iterator->index = 0;
+    else
+        iterator->index = (long long)vector->length - 1;
+
+    return 0;
+}
+
+int vector_iterator_init_pos(Vector *vector, Vector_iterator *iterator, unsigned long long pos)
+{
+    TRACE("");
+
+    if( vector == NULL || iterator == NULL)
+        ERROR("vector || iterator == NULL\n", 1, "");
+
+    if(pos > vector->length)
+        ERROR("invalid pos\n", 1, "");
+
+    iterator->vector = vector;
+    iterator->index = (long long)pos;
+
+    return 0;
+}
+
+int vector_iterator_next(Vector_iterator *iterator)
+{
+    TRACE("");
+
+    if( iterator == NULL )
+        ERROR("iterator == NULL\n", 1, "");
+
+    ++iterator->index;
+
+    return 0;
+}
+
+int vector_iterator_prev(Vector_iterator *iterator)
+{
+    TRACE("");
+
+    if( iterator == NULL )
+        ERROR("iterator == NULL\n", 1, "");
+
+    --iterator->index;
+
+    return 0;
+}
+
+int vector_iterator_get_data(Vector_iterator *iterator, void *val)
+{
+    TRACE("");
+
+    if( iterator == NULL || val == NULL)
+        ERROR("iterator || val  == NULL\n", 1, "");
+
+    if(vector_iterator_end(iterator))
+        ERROR("iterator is out of vector\n", 1, "");
+
+    __ASSIGN__(*(BYTE*)val, *VECTOR_AT(iterator->vector, iterator->index), iterator->vector->size_of);
+
+    return 0;
+}
+
+BOOL vector_iterator_end(Vector_iterator *iterator)
+{
+    TRACE("");
+
+    if( iterator == NULL)
+        ERROR("iterator ==NULL\n", TRUE, "");
+
+    return iterator->index < 0 || (unsigned long long)iterator->index >= iterator->vector->length;
+}
+
+Vector *vector_create(int size_of)
+{
+    Vector *vector;
+
+    TRACE("");
+
+    if( size_of < 1)
+        ERROR("size_of < 1\n", NULL, "");
+
+    vector = (Vector*)malloc(sizeof(Vector));
+    if( vector == NULL )
+        ERROR("malloc error\n", NULL, "");
+
+    vector->array = malloc((size_t)VECTOR_INIT_SIZE * (size_t)size_of);
+    if( vector->array == NULL )
+    {
+        FREE(vector);
+        ERROR("malloc error\n", NULL, "");
+    }
+
+    vector->size_of = size_of;
+    vector->length = 0;
+    vector->size = VECTOR_INIT_SIZE;
+
+    return vector;
+}
+
+void vector_destroy(Vector *vector)
+{
+    TRACE("");
+
+    if( vector == NULL)
+    {
+        LOG("vector == NULL\n", "");
+        return;
+    }
+
+    FREE(vector->array);
+    FREE(vector);
+}
+
+int vector_insert_first(Vector *vector, void *data)
+{
+    TRACE("");
+
+    return vector_insert_pos(vector, 0, data);
+}
+
+int vector_insert_last(Vector *vector, void *data)
+{
+    TRACE("");
+
+    if(vector == NULL || data == NULL)
+        ERROR("vector == NULL || data == NULL\n", 1, "");
+
+    if(vector_reserve(vector, 1))
+        ERROR("vector_reserve error\n", 1, "");
+
+    __ASSIGN__(*VECTOR_AT(vector, vector->length), *(BYTE*)data, vector->size_of);
+    ++vector->length;
+
+    return 0;
+}
+
+int vector_insert_pos(Vector *vector, unsigned long long pos, void *data)
+{
+    TRACE("");
+
+    if(vector == NULL || data == NULL)
+        ERROR("vector == NULL || data == NULL\n", 1, "");
+
+    if(pos > vector->length)
+        ERROR("invalid pos\n", 1, "");
+
+    if(vector_reserve(vector, 1))
+        ERROR("vector_reserve error\n", 1, "");
+
+    /* move tail one place to the right */
+    memmove(VECTOR_AT(vector, pos + 1), VECTOR_AT(vector, pos),
+            (size_t)(vector->length - pos) * (size_t)vector->size_of);
+
+    __ASSIGN__(*VECTOR_AT(vector, pos), *(BYTE*)data, vector->size_of);
+    ++vector->length;
+
+    return 0;
+}
+
+int vector_delete_first(Vector *vector)
+{
+    TRACE("");
+
+    return vector_delete_pos(vector, 0);
+}
+
+int vector_delete_last(Vector *vector)
+{
+    TRACE("");
+
+    if(vector == NULL)
+        ERROR("vector == NULL\n", 1, "");
+
+    if(vector->length == 0)
+        ERROR("vector is empty, nothing to delete\n", 1, "");
+
+    --vector->length;
+
+    return 0;
+}
+
+int vector_delete_pos(Vector *vector, unsigned long long pos)
+{
+    TRACE("");
+
+    if(vector == NULL)
+        ERROR("vector == NULL\n", 1, "");
+
+    if(pos >= vector->length)
+        ERROR("invalid pos\n", 1, "");
+
+    /* move tail one place to the left */
+    memmove(VECTOR_AT(vector, pos), VECTOR_AT(vector, pos + 1),
+            (size_t)(vector->length - pos - 1) * (size_t)vector->size_of);
+
+    --vector->length;
+
+    return 0;
+}
+
+int vector_get_pos(Vector *vector, unsigned long long pos, void *data)
+{
+    TRACE("");
+
+    if(vector == NULL || data == NULL)
+        ERROR("vector == NULL || data == NULL\n", 1, "");
+
+    if(pos >= vector->length)
+        ERROR("invalid pos\n", 1, "");
+
+    __ASSIGN__(*(BYTE*)data, *VECTOR_AT(vector, pos), vector->size_of);
+
+    return 0;
+}
+
+void *vector_get_ptr(Vector *vector, unsigned long long pos)
+{
+    TRACE("");
+
+    if(vector == NULL)
+        ERROR("vector == NULL\n", NULL, "");
+
+    if(pos >= vector->length)
+        ERROR("invalid pos\n", NULL, "");
+
+    return (void*)VECTOR_AT(vector, pos);
+}
+
+Vector *vector_merge(Vector *vector1, Vector *vector2)
+{
+    Vector *result;
+
+    TRACE("");
+
+    if(vector1 == NULL || vector2 == NULL)
+        ERROR("vector1 == NULL || vector2 == NULL\n", NULL, "");
+
+    if(vector1->size_of != vector2->size_of)
+        ERROR("vector1->size_of != vector2->size_of\n", NULL, "");
+
+    result = vector_create(vector1->size_of);
+    if(result == NULL)
+        ERROR("vector_create error\n", NULL, "");
+
+    if(vector_reserve(result, vector1->length + vector2->length))
+    {
+        vector_destroy(result);
+        ERROR("vector_reserve error\n", NULL, "");
+    }
+
+    memcpy(VECTOR_AT(result, 0), vector1->array, (size_t)vector1->length * (size_t)vector1->size_of);
+    memcpy(VECTOR_AT(result, vector1->length), vector2->array, (size_t)vector2->length * (size_t)vector2->size_of);
+
+    result->length = vector1->length + vector2->length;
+
+    return result;
+}
+
+int vector_to_array(Vector *vector, void *array, int *size)
+{
+    BYTE *t;
+
+    TRACE("");
+
+    if( vector == NULL || array == NULL || size == NULL)
+        ERROR("vector == NULL || array == NULL || size  == NULL\n", 1, "");
+
+    /* malloc(0) may return NULL */
+    t = (BYTE*)malloc((size_t)(vector->length + 1) * (size_t)vector->size_of);
+    if( t == NULL )
+        ERROR("malloc error\n", 1, "");
+
+    memcpy(t, vector->array, (size_t)vector->length * (size_t)vector->size_of);
+
+    *(void**)array = t;
+
+    *size = (int)vector->length;
+
+    return 0;
+}
@@ -0,0 +1,321 @@
+#ifndef VECTOR_H
+#define VECTOR_H
+
+
+/*
+    Vector [ Unsorted List in one contiguous array ]
+
+    Author: Michal Kukowski
+    email: michalkukowski10@gmail.com
+
+    LICENCE: GPL 2.0+
+
+    API is the same as in Arraylist, but elements are stored one by one in one array
+    ( grown twice on overflow ), so walking through the list does not jump in memory
+    and vector_get_pos is O(1).
+
+    Position of element is stable until element is inserted or deleted before it,
+    so index can be used as a handle of element ( pointers returned by vector_get_ptr
+    are valid only until next insertion ).
+*/
+
+#ifndef ITI_MODE
+    #define ITI_MODE    unsigned char
+#endif
+
+#define ITI_BEGIN   0
+#define ITI_END     1
+
+#ifndef BOOL
+    #define BOOL    char
+    #define TRUE    1
+    #define FALSE   0
+#endif
+
+#define VECTOR_INIT_SIZE    16
+
+/*
+   Vector_iterator, index instead of pointer so vector can grow during iteration
+*/
+typedef struct Vector_iterator
+{
+    struct Vector *vector;
+    long long index;
+
+}Vector_iterator;
+
+typedef struct Vector
+{
+    void *array; /* main array */
+
+    int size_of; /* size of element */
+    unsigned long long length; /* length of list */
+    unsigned long long size; /* allocated entries */
+
+}Vector;
+
+/*
+    Init iterator
+
+    PARAMS
+    @IN vector - pointer to vector
+    @IN mode - iterator mode
+
+    RETURN:
+    NULL if failure
+    Pointer to new iterator if success
+*/
+Vector_iterator *vector_iterator_create(Vector *vector, ITI_MODE mode);
+
+/*
+    Init iterator
+
+    PARAMS
+    @IN vector - pointer to vector
+    @IN iterator - pointer to iterator
+    @IN mode - iterator mode
+
+    RETURN:
+    0 if success
+	Non-zero value if failure
+*/
+int vector_iterator_init(Vector *vector, Vector_iterator *iterator, ITI_MODE mode);
+
+/*
+    Init iterator at @pos
+
+    PARAMS
+    @IN vector - pointer to vector
+    @IN iterator - pointer to iterator
+    @IN pos - position of element
+
+    RETURN:
+    0 if success
+	Non-zero value if failure
+*/
+int vector_iterator_init_pos(Vector *vector, Vector_iterator *iterator, unsigned long long pos);
+
+/*
+    Deallocate memory
+
+    PARAMS
+    @iterator - pointer to iterator
+
+    RETURN:
+    This is void function
+*/
+void vector_iterator_destroy(Vector_iterator *iterator);
+
+/*
+    Go to the next value
+
+    PARAMS
+    @IN iterator - pointer iterator
+
+    RETURN:
+   	0 if success
+	Non-zero value if failure
+*/
+int vector_iterator_next(Vector_iterator *iterator);
+
+/*
+    Go to the prev value
+
+    PARAMS
+    @IN iterator - pointer iterator
+
+    RETURN:
+   	0 if success
+	Non-zero value if failure
+*/
+int vector_iterator_prev(Vector_iterator *iterator);
+
+/*
+    list data getter using iterator
+
+    PARAMS
+    @IN - pointer iterator
+    @OUT val - pointer to value
+
+    RETURN:
+    0 if success
+	Non-zero value if failure
+*/
+int vector_iterator_get_data(Vector_iterator *iterator, void *val);
+
+/*
+    Check the end of vector
+
+    PARAMS
+    @IN iterator - pointer to iterator
+
+    RETURN:
+    FALSE if not end
+    TRUE if end
+*/
+BOOL vector_iterator_end(Vector_iterator *iterator);
+
+/*
+    Macro for create a vector, please see function description
+
+    PARAMS
+	@OUT PTR - pointer to vector
+    @IN TYPE - type of element of list
+*/
+#define VECTOR_CREATE(PTR,TYPE) do{ PTR = vector_create(sizeof(TYPE)); }while(0)
+
+/*
+    Create vector
+
+    PARAMS
+    @IN size_of - size of element in list
+
+    RETURN:
+    NULL if failure
+    Pointer if success
+*/
+Vector *vector_create(int size_of);
+
+/*
+    Destroy vector
+
+    PARAMS
+    @IN vector - pointer to list
+
+	RETURN:
+	This is a void function
+*/
+void vector_destroy(Vector *vector);
+
+/*
+    Insert Data at the begining of the vector
+
+    PARAMS
+    @IN vector - pointer to vector
+    @IN data - addr of data
+
+    RETURN:
+    0 iff success
+    Non-zero value of failure
+*/
+int vector_insert_first(Vector *vector, void *data);
+
+/*
+    Insert Data at the end of the vector
+
+    PARAMS
+    @IN vector - pointer to vector
+    @IN data - addr of data
+
+    RETURN:
+    0 iff success
+    Non-zero value of failure
+*/
+int vector_insert_last(Vector *vector, void *data);
+
+/*
+    Insert Data at @pos
+
+    PARAMS
+    @IN vector - pointer to vector
+    @IN pos - posision where we insert data
+    @IN data - addr of data
+
+    RETURN:
+    0 iff success
+    Non-zero value of failure
+*/
+int vector_insert_pos(Vector *vector, unsigned long long pos, void *data);
+
+/*
+    Delete first data od vector
+
+    PARAMS
+    @IN vector - pointer to vector
+
+    RETURN:
+    0 iff success
+    Non-zero value of failure
+*/
+int vector_delete_first(Vector *vector);
+
+/*
+    Delete last data od vector
+
+    PARAMS
+    @IN vector - pointer to vector
+
+    RETURN:
+    0 iff success
+    Non-zero value of failure
+*/
+int vector_delete_last(Vector *vector);
+
+/*
+    Delete data on @pos
+
+    PARAMS
+    @IN vector - pointer to vector
+    @IN pos - pos from we delete data
+
+    RETURN:
+    0 iff success
+    Non-zero value of failure
+*/
+int vector_delete_pos(Vector *vector, unsigned long long pos);
+
+/*
+    Get data from @pos
+
+    PARAMS
+    @IN vector - pointer to vector
+    @IN pos - posision
+    @OUT data - addr of data
+
+    RETURN:
+    0 iff success
+    Non-zero value of failure
+*/
+int vector_get_pos(Vector *vector, unsigned long long pos, void *data);
+
+/*
+    Get address of element at @pos, valid until next insertion
+
+    PARAMS
+    @IN vector - pointer to vector
+    @IN pos - posision
+
+    RETURN:
+    NULL if failure
+    Pointer to element if success
+*/
+void *vector_get_ptr(Vector *vector, unsigned long long pos);
+
+/*
+    Allocate new vector and merge vector1 & vector2 to the new vector
+
+    PARAMS
+    @IN vector1 - pointer to first list
+    @IN vector2 - pointer to second list
+
+    RETURN:
+    NULL if failure
+    Pointer to vector if success
+*/
+Vector *vector_merge(Vector *vector1, Vector *vector2);
+
+/*
+    Create array from vector
+
+    PARAMS
+    @IN vector - pointer to vector
+    @OUT array - pointer to array
+    @OUT size - size of  returned array
+
+    RETURN:
+    0 if success
+	Non-zero value if failure
+*/
+int vector_to_array(Vector *vector, void *array, int *size);
+
+#endif
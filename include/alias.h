@@ -0,0 +1,99 @@
+#ifndef ALIAS_H
+#define ALIAS_H
+
+#include <common.h>
+#include <tokens.h>
+#include <vector.h>
+
+/*
+    Compile-time tracking of array elements and ranges of variables
+
+    Author: Michal Kukowski
+    email: michalkukowski10@gmail.com
+
+    Value of element of small array ( ARRAY section ) is known after store of
+    known value with known offset in straight code ( outside of loops and IFs ).
+    Knowledge is kept in var_arr of element ( value and symbolic flag ).
+
+    Possible range of variable is taken from:
+        value of variable ( iff variable is not symbolic )
+        FOR bounds for iterator
+        IF condition in THEN and ELSE body ( until variable is changed )
+        ranges of operands of last assignment ( until variable is changed )
+
+    Store t[i] forgets only elements which may be aliased by t[i].
+
+    Before loop, all elements which may be written in loop body are forgotten
+    and ranges of variables changed in loop body are forgotten,
+    so what is known at begin of loop is valid in whole loop.
+
+    Read of known element is replaced by const value in token,
+    IF condition decided by ranges is replaced by const condition,
+    original token is restored after compilation.
+    Ranges of operands are used by MULT, DIV and MOD to skip checks.
+*/
+
+/*
+    Prepare analysis of new program
+
+    PARAMS
+    NO PARAMS
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+int alias_init(void);
+
+/*
+    Destroy analysis data
+
+    PARAMS
+    NO PARAMS
+
+    RETURN:
+    This is a void function
+*/
+void alias_destroy(void);
+
+/*
+    Analyze token before compilation:
+    update ranges of indexes, forget aliased elements,
+    replace reads of known elements by const values and remember stored value
+
+    PARAMS
+    @IN tokens - token list
+    @IN pos - position of token in list
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+int alias_token_begin(Vector *tokens, uint64_t pos) __nonull__(1);
+
+/*
+    Restore token changed by alias_token_begin after compilation
+
+    PARAMS
+    NO PARAMS
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+int alias_token_end(void);
+
+/*
+    Get possible values of operand of current ASSIGN token
+
+    PARAMS
+    @IN left - TRUE for left operand, FALSE for right operand
+    @OUT lo - min value
+    @OUT hi - max value ( UINT64_MAX iff value is not bounded )
+
+    RETURN:
+    This is a void function
+*/
+void alias_operand_range(BOOL left, uint64_t *lo, uint64_t *hi) __nonull__(2, 3);
+
+#endif
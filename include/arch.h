@@ -4,6 +4,7 @@
 #include <common.h>
 #include <asm.h>
 #include <avl.h>
+#include <vector.h>
 
 /*
     File contains spec of architecture described by Maciek Gebala
@@ -104,8 +105,13 @@ typedef struct operation_cost
 
 /***** MEMORY *****/
 
+/* max len of array in ARRAYS section, compiler chooses threshold up to this len */
 #define ARRAY_MAX_LEN   (1 << 10)
 
+/* access to array in loop is ARRAY_LOOP_WEIGHT times more important ( up to ARRAY_LOOP_DEPTH loops ) */
+#define ARRAY_LOOP_WEIGHT   10
+#define ARRAY_LOOP_DEPTH    6
+
 typedef struct mem_chunk
 {
     struct Value *val;
@@ -143,6 +149,12 @@ typedef struct Memory
     uint64_t arrays_last_addr;
     uint64_t arrays_allocated;
 
+    /* Array* in ARRAYS section sorted by addr, elements are allocated on first touch */
+    Vector *arrays;
+
+    /* longer arrays are in BIG ARRAYS section */
+    uint64_t array_max_len;
+
     /* mem space for arrays */
     mpz_t big_arrays_first_addr;
     mpz_t big_arrays_allocated;
@@ -205,13 +217,24 @@ int free_loop_section(Memory *memory) __nonull__(1);
 /***** BOARD *****/
 
 /* Machine CPU */
-extern CPU *cpu;
+extern __thread CPU *cpu;
 
 /* Machine RAM */
-extern Memory *memory;
+extern __thread Memory *memory;
 
 extern const operation_cost op_cost;
 
+/*
+    Get cost of instruction
+
+    PARAMS
+    @IN opcode - opcode
+
+    RETURN:
+    cost of instruction with @opcode
+*/
+uint32_t opcode_get_cost(uint8_t opcode);
+
 /*
     INIT board
 
@@ -259,6 +282,18 @@ __inline__ int get_free_reg(CPU *cpu)
     return -1;
 }
 
+/*
+    Alloc memory chunk for element of array in ARRAYS section on first touch
+
+    PARAMS
+    @IN addr - mem addr
+
+    RETURN
+    NULL iff failure ( addr is not in any array )
+    Pointer to memchunk iff success
+*/
+mem_chunk *memory_array_chunk(uint64_t addr);
+
 /*
     GET memory chunk by address
 
@@ -271,19 +306,15 @@ __inline__ int get_free_reg(CPU *cpu)
 */
 __inline__ mem_chunk* memory_get_chunk(uint64_t addr)
 {
-    mem_chunk *in;
+    mem_chunk key;
+    mem_chunk *in = &key;
     mem_chunk *out;
 
-    in = (mem_chunk*)malloc(sizeof(mem_chunk));
-    if(in == NULL)
-        ERROR("malloc error\n", NULL, "");
-
-    in->addr = addr;
+    key.addr = addr;
 
+    /* element of array is not in memory until first touch */
     if(avl_search(memory->memory, (void*)&in, (void*)&out))
-        ERROR("avl_search error\n", NULL, "");
-
-    FREE(in);
+        return memory_array_chunk(addr);
 
     return out;
 }
@@ -0,0 +1,221 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <common.h>
+
+/*
+    Bump allocator for objects which live as long as one compilation
+
+    Author: Michal Kukowski
+    email: michalkukowski10@gmail.com
+
+    main_compile creates compile_arena, so tokens, values, variables and parser variables
+    are taken from big chunks instead of malloc one by one, whole arena is released in one shot
+    at the end of compilation ( token list is not walked ).
+
+    Compiler creates and destroys a lot of temporary values, so destroyed objects are not lost:
+    small objects go back to free list of their size class and are reused by next allocation.
+    Objects which own memory outside arena ( mpz_t ) register release function by arena_defer.
+
+    Without arena ( tests, tools which use tokens directly ) objects are malloced as before.
+*/
+
+#define ARENA_CHUNK_SIZE    (1 << 16)
+#define ARENA_ALIGN         16
+
+/* free lists, size classes are multiplies of ARENA_ALIGN */
+#define ARENA_CLASSES       8
+#define ARENA_POOL_VAR      ARENA_CLASSES /* var_normal with initialized mpz_t */
+#define ARENA_POOLS         (ARENA_CLASSES + 1)
+#define ARENA_NO_POOL       -1
+
+#define ARENA_POOL_CLASS(size) \
+    ((size) != 0 && (size) <= ARENA_CLASSES * ARENA_ALIGN ? (int)(((size) - 1) / ARENA_ALIGN) : ARENA_NO_POOL)
+
+typedef struct Arena_chunk
+{
+    struct Arena_chunk *next;
+    size_t size;
+    size_t used;
+
+    uint8_t data[];
+
+}Arena_chunk;
+
+typedef struct Arena_defer
+{
+    void (*release)(void *ptr);
+    void *ptr;
+
+    struct Arena_defer *next;
+
+}Arena_defer;
+
+typedef struct Arena
+{
+    Arena_chunk *chunk; /* current chunk, older chunks are on its list */
+    Arena_defer *defer; /* release functions, called from the last registered */
+
+    void *pool[ARENA_POOLS]; /* free lists, next object is in first bytes of object */
+
+    uint64_t allocs; /* number of allocations */
+    uint64_t reused; /* allocations taken from free lists */
+    uint64_t bytes; /* bytes taken from chunks */
+    uint64_t chunks; /* malloced chunks */
+
+}Arena;
+
+/* arena of current compilation, NULL iff objects are malloced */
+extern __thread Arena *compile_arena;
+
+/*
+    Create arena
+
+    PARAMS
+    NO PARAMS
+
+    RETURN:
+    NULL iff failure
+    Pointer to arena iff success
+*/
+Arena *arena_create(void);
+
+/*
+    Call release functions and free all chunks of arena
+
+    PARAMS
+    @IN arena - pointer to arena
+
+    RETURN:
+    This is a void function
+*/
+void arena_destroy(Arena *arena);
+
+/*
+    Call release functions and make arena empty, newest chunk is kept for next compilation
+
+    PARAMS
+    @IN arena - pointer to arena
+
+    RETURN:
+    This is a void function
+*/
+void arena_reset(Arena *arena) __nonull__(1);
+
+/*
+    Allocate memory from free list or from chunk, memory is aligned to ARENA_ALIGN
+
+    PARAMS
+    @IN arena - pointer to arena
+    @IN pool - free list or ARENA_NO_POOL
+    @IN size - bytes
+    @OUT reused - TRUE iff object was taken from free list ( can be NULL )
+
+    RETURN:
+    NULL iff failure
+    Pointer iff success
+*/
+void *arena_get(Arena *arena, int pool, size_t size, BOOL *reused) __nonull__(1);
+
+/*
+    Put object to free list, object is reused by arena_get from the same pool
+
+    PARAMS
+    @IN arena - pointer to arena
+    @IN pool - free list or ARENA_NO_POOL ( object is lost until arena_destroy )
+    @IN ptr - object
+
+    RETURN:
+    This is a void function
+*/
+void arena_put(Arena *arena, int pool, void *ptr) __nonull__(1, 3);
+
+/*
+    Register release function of object, called by arena_destroy
+
+    PARAMS
+    @IN arena - pointer to arena
+    @IN release - release function
+    @IN ptr - object
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+int arena_defer(Arena *arena, void (*release)(void *ptr), void *ptr) __nonull__(1, 2);
+
+/*
+    Allocate object from compile_arena or by malloc iff there is no arena
+
+    PARAMS
+    @IN size - bytes
+
+    RETURN:
+    NULL iff failure
+    Pointer iff success
+*/
+__inline__ void *node_alloc(size_t size)
+{
+    if(compile_arena == NULL)
+        return malloc(size);
+
+    return arena_get(compile_arena, ARENA_POOL_CLASS(size), size, NULL);
+}
+
+/*
+    Give back object taken by node_alloc
+
+    PARAMS
+    @IN ptr - object
+    @IN size - size of object, the same as in node_alloc
+
+    RETURN:
+    This is a void function
+*/
+__inline__ void node_free(void *ptr, size_t size)
+{
+    if(ptr == NULL)
+        return;
+
+    if(compile_arena == NULL)
+        free(ptr);
+    else
+        arena_put(compile_arena, ARENA_POOL_CLASS(size), ptr);
+}
+
+/*
+    Copy string to object taken by node_alloc
+
+    PARAMS
+    @IN str - string
+
+    RETURN:
+    NULL iff failure
+    Copy of string iff success
+*/
+__inline__ char *node_strdup(const char *str)
+{
+    size_t len = strlen(str) + 1;
+    char *copy;
+
+    copy = (char*)node_alloc(len);
+    if(copy == NULL)
+        return NULL;
+
+    return (char*)memcpy(copy, str, len);
+}
+
+#define NODE_FREE(PTR) \
+    do{ \
+        node_free((void*)(PTR), sizeof(*(PTR))); \
+        PTR = NULL; \
+    }while(0)
+
+#define NODE_FREE_STR(STR) \
+    do{ \
+        if((STR) != NULL) \
+            node_free((void*)(STR), strlen(STR) + 1); \
+        STR = NULL; \
+    }while(0)
+
+#endif
@@ -10,6 +10,7 @@
 
 #include <common.h>
 #include <darray.h>
+#include <hashmap.h>
 
 /* extern definisions of structures from arch.h */
 struct Register;
@@ -77,6 +78,44 @@ typedef struct Opcodes
 
 extern const Opcodes opcodes;
 
+/* parsed line of asm code */
+typedef struct Asm_line
+{
+    uint64_t reg;
+    uint64_t target; /* only for jumps */
+
+    uint8_t opcode;
+
+}Asm_line;
+
+/*
+    Parse asm code line
+
+    PARAMS
+    @IN str - asm line i.e "JZERO 1 20"
+    @OUT line - parsed line
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+int asm_line_parse(const char *str, Asm_line *line) __nonull__(1, 2);
+
+/*
+    Is opcode a jump ?
+
+    PARAMS
+    @IN opcode - opcode
+
+    RETURN:
+    TRUE iff opcode is JUMP, JZERO or JODD
+    FALSE iff not
+*/
+__inline__ BOOL opcode_is_jump(uint8_t opcode)
+{
+    return opcode == opcodes.jump || opcode == opcodes.jzero || opcode == opcodes.jodd;
+}
+
 
 /***** VARIABLES *****/
 
@@ -110,10 +149,12 @@ typedef struct Array
 
     VAR_TYPE type;
 
-    /* array of var_arr */
-    Darray *arr;
-
-    struct mem_chunk *chunk;
+    /*
+        var_arr of elements touched by compiler ( key is offset ), only for ARRAY.
+        Element is created on first touch, so untouched elements cost nothing
+        ( NULL iff no element was touched )
+    */
+    Hashmap *elems;
 
 }Array;
 
@@ -599,17 +640,44 @@ int __inline__ value_reset_symbolic(Value *val)
 int value_copy(Value **dst, Value *src) __nonull__(1, 2);
 
 /*
-    Create Array
+    Create Array, elements are created on first touch ( see array_elem_touch )
 
     PARAMS
     @IN name - array name
     @IN len - array len
+    @IN max_len - array is ARRAY iff len <= max_len, BIG_ARRAY otherwise
 
     RETURN:
     %NULL iff failure
     %Pointer iff success
 */
-Array *array_create(const char *name, uint64_t len) __nonull__(1);
+Array *array_create(const char *name, uint64_t len, uint64_t max_len) __nonull__(1);
+
+/*
+    Get element of array if it was touched
+
+    PARAMS
+    @IN array - pointer to array
+    @IN offset - offset of element
+
+    RETURN:
+    %NULL iff element wasn't touched
+    %Pointer to element iff success
+*/
+var_arr *array_elem_get(Array *array, uint64_t offset) __nonull__(1);
+
+/*
+    Get element of array, create it on first touch
+
+    PARAMS
+    @IN array - pointer to array ( ARRAY )
+    @IN offset - offset of element
+
+    RETURN:
+    %NULL iff failure
+    %Pointer to element iff success
+*/
+var_arr *array_elem_touch(Array *array, uint64_t offset) __nonull__(1);
 
 /*
     Destroy array
@@ -0,0 +1,329 @@
+#ifndef AVL_H
+#define AVL_H
+
+/*
+    AVL tree implementation without recursive function, but with parent pointer
+
+    Author: Michal Kukowski
+    email: michalkukowski10@gmail.com
+
+    LICENCE: GPL2.0+
+
+    Data is stored inside node, so node is one allocation and compare function
+    gets address of data without another jump in memory.
+    Nodes are taken from blocks owned by tree, deleted nodes go to free list of tree
+    and are reused by next insert, avl_destroy frees only blocks.
+
+    Node is not moved until it is deleted, so address of data in node is valid
+    until data is deleted ( see AVL_SEARCH_DEFINE ).
+*/
+
+#ifndef ITI_MODE
+    #define ITI_MODE unsigned char
+#endif
+
+#define ITI_BEGIN   0
+#define ITI_END     1
+#define ITI_ROOT    2
+
+#ifndef BOOL
+    #define BOOL    char
+    #define TRUE    1
+    #define FALSE   0
+#endif
+
+#ifndef INT_8
+    #define INT_8 char
+#endif
+
+/* alignment of data in node */
+#define AVL_ALIGN               __BIGGEST_ALIGNMENT__
+
+/* number of nodes in first block of tree, next blocks are twice bigger up to max */
+#define AVL_BLOCK_MIN_NODES     16
+#define AVL_BLOCK_MAX_NODES     4096
+
+typedef struct Avl_node
+{
+    struct Avl_node *left_son;
+    struct Avl_node *right_son;
+    struct Avl_node *parent; /* next free node iff node is on free list */
+
+    INT_8 bf; /* balanced factor */
+
+    char data[] __attribute__((aligned(AVL_ALIGN))); /* size_of bytes of data */
+
+}Avl_node;
+
+typedef struct Avl_block
+{
+    struct Avl_block *next;
+
+    char nodes[] __attribute__((aligned(AVL_ALIGN)));
+
+}Avl_block;
+
+typedef struct Avl_iterator
+{
+    int size_of;
+    Avl_node *node;
+}Avl_iterator;
+
+typedef struct Avl
+{
+    Avl_node *root;
+
+    unsigned long long nodes;
+
+    int size_of;
+
+    int (*cmp)(void* a,void *b);
+
+    int node_size; /* size of node with data */
+
+    Avl_node *free_nodes; /* deleted nodes */
+    Avl_block *block; /* newest block, older blocks are on its list */
+    unsigned long long block_free; /* not used nodes in newest block */
+    unsigned long long block_nodes; /* nodes in newest block */
+}Avl;
+
+/*
+    Create AVL
+
+    PARAMS
+    @IN size_of - size_of data in tree
+    @IN cmp - cmp function
+
+    RETURN:
+    NULL if failure
+    Pointer to bst if success
+*/
+Avl* avl_create(int size_of,int (*cmp)(void* a,void *b));
+
+#define AVL_CREATE(PTR,TYPE,CMP) do{ PTR = avl_create(sizeof(TYPE),CMP); }while(0)
+
+/*
+    Destroy all nodes in tree
+
+    PARAMS
+    @IN tree - pointer to AVL
+
+    RETURN:
+    This is a void function
+*/
+void avl_destroy(Avl *tree);
+
+/*
+    Insert data to AVL IFF data with key ( using cmp ) is not in tree
+
+    PARAMS
+    @IN tree - pointer to tree
+    @IN data - addr of data
+
+    RETURN:
+    0 if success
+    Positive value if failure
+*/
+int avl_insert(Avl *tree,void *data);
+
+/*
+    Getter of min value ( using cmp ) in tree
+
+    PARAMS
+    @IN tree - pointer to tree
+    @OUT data - returned data by addr
+
+    RETURN:
+    0 if success
+    Positive value if failure
+*/
+int avl_min(Avl *tree,void *data);
+
+/*
+    Getter of max value ( using cmp ) in tree
+
+    PARAMS
+    @IN tree - pointer to tree
+    @OUT data - returned data by addr
+
+    RETURN:
+    0 if success
+    Positive value if failure
+*/
+int avl_max(Avl *tree,void *data);
+
+/*
+    Search for data with key equals key @data_key ( using cmp )
+
+    PARAMS
+    @IN tree - pointer to tree
+    @IN data_key - addr of data with search key
+    @OUT data_out - returned data by addr
+
+    RETURN:
+    0 if success
+    Positive value if failure
+*/
+ int avl_search(Avl *tree,void *data_key,void *data_out);
+
+/*
+	Check existing of key in tree
+
+ 	PARAMS
+    @IN tree - pointer to tree
+    @IN data_key - addr of data with search key
+
+	RETURN:
+	FALSE iff key doesn't exist in tree
+	TRUE iff key exists in tree
+*/
+BOOL avl_key_exist(Avl *tree, void *data_key);
+
+/*
+    Delete data with key equals @data_key ( using cmp )
+
+    PARAMS
+    @IN tree - pointer to tree
+    @IN data_key = addr of data with key to delete
+
+    RETURN:
+    0 if success
+    Positive value if failure
+*/
+int avl_delete(Avl *tree,void *data_key);
+
+/*
+    Convert bst to sorted array
+
+    PARAMS
+    @IN tree - pointer to tree
+    @OUT addr of array
+    @IN / OUT - size - size of array
+
+    RETURN:
+    0 if success
+    Positive value if failure
+*/
+int avl_to_array(Avl *tree,void *array,int *size);
+
+/*
+    Init iterator
+
+    PARAMS
+    @IN tree - pointer to AVL
+    @IN mode - iterator init mode
+
+    RETURN:
+    NULL if failure
+    Pointer to new iterator if success
+*/
+Avl_iterator *avl_iterator_create(Avl *tree,ITI_MODE mode);
+
+/*
+    Init iterator
+
+    PARAMS
+    @IN tree - pointer to AVL
+    @IN iterator - pointer to iterator
+    @IN mode - iterator init mode
+
+    RETURN:
+    0 if failure
+    Positive value if success
+*/
+int avl_iterator_init(Avl *tree,Avl_iterator *iterator,ITI_MODE mode);
+
+/*
+    Deallocate memory
+
+    PARAMS
+    @iterator - pointer to iterator
+
+    RETURN:
+    This is void function
+*/
+void avl_iterator_destroy(Avl_iterator *iterator);
+
+/*
+    Go to the next value
+
+    PARAMS
+    @IN iterator - pointer iterator
+
+    RETURN:
+    0 if failure
+    Positive value if success
+*/
+int avl_iterator_next(Avl_iterator *iterator);
+
+/*
+    Go to the prev value
+
+    PARAMS
+    @IN iterator - pointer iterator
+
+    RETURN:
+    0 if failure
+    Positive value if success
+*/
+int avl_iterator_prev(Avl_iterator *iterator);
+
+/*
+    data getter using iterator
+
+    PARAMS
+    @IN - pointer iterator
+    @OUT val - pointer to value
+
+    RETURN:
+    0 if failure
+    Positive value if success
+*/
+int avl_iterator_get_data(Avl_iterator *iterator,void *val);
+
+/*
+    Check the end of AVL
+
+    PARAMS
+    @IN iterator - pointer to iterator
+
+    RETURN:
+    FALSE if not end
+    TRUE if end
+*/
+BOOL avl_iterator_end(Avl_iterator *iterator);
+
+/*
+    Define static function NAME which search in tree with data of TYPE by key of KEY_TYPE,
+    CMP is a macro ( or inline function ) so comparison is inlined instead of call by cmp pointer
+
+    CMP(data, key) gets TYPE *data from node and KEY_TYPE key and returns
+    negative value iff data < key, 0 iff data == key, positive value iff data > key
+    ( order has to be the same as order of cmp function of tree )
+
+    Defined function:
+    TYPE *NAME(Avl *tree, KEY_TYPE key)
+
+    RETURN:
+    NULL iff key doesn't exist in tree
+    Pointer to data in node iff key exists in tree
+*/
+#define AVL_SEARCH_DEFINE(NAME, TYPE, KEY_TYPE, CMP) \
+    static __inline__ TYPE *NAME(Avl *tree, KEY_TYPE key) \
+    { \
+        Avl_node *node = tree->root; \
+        int __res__; \
+        \
+        while(node != NULL) \
+        { \
+            __res__ = CMP((TYPE*)(void*)node->data, key); \
+            if(__res__ == 0) \
+                return (TYPE*)(void*)node->data; \
+            \
+            node = __res__ > 0 ? node->left_son : node->right_son; \
+        } \
+        \
+        return NULL; \
+    }
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <common.h>
+#include <compiler.h>
+
+/*
+    Content addressed cache of compiled code
+
+    Author: Michal Kukowski
+    email: michalkukowski10@gmail.com
+
+    Key is FNV-1a 128 hash of compiler stamp ( COMPILER_VERSION and compiler binary ),
+    options which change output ( Wall, Werror, O, tokens ) and bytes of source code.
+    Entry is a file DIR/<key> with asm code ( token list with --tokens ), on hit parser
+    and compiler are not called, entry is copied to output file.
+
+    Only successful compilations are cached, warnings are printed only when code is compiled.
+    Codes compiled with --profile-use, --line-map, --cost-report or --emitter-map are not cached.
+
+    Cache is bounded by size, the least recently used entries are evicted.
+    DIR/stats contains hits, misses, evictions, DIR/lock serializes processes and threads.
+*/
+
+#define CACHE_DEFAULT_SIZE  (64ull << 20) /* 64 MiB */
+#define CACHE_KEY_LEN       16
+#define CACHE_STATS_FILE    "stats"
+#define CACHE_LOCK_FILE     "lock"
+
+typedef struct Cache_key
+{
+    uint8_t hash[CACHE_KEY_LEN];
+    char hex[(CACHE_KEY_LEN << 1) + 1]; /* hash as string, name of entry */
+
+}Cache_key;
+
+typedef struct Cache_stats
+{
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+
+    uint64_t entries; /* counted from DIR */
+    uint64_t size; /* bytes of all entries */
+
+}Cache_stats;
+
+/*
+    Compute key of compilation
+
+    PARAMS
+    @IN opt - options with input file
+    @OUT key - cache key
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+int cache_key(const Option *opt, Cache_key *key) __nonull__(1, 2);
+
+/*
+    Copy cached code to output file iff entry exists, count hit or miss
+
+    PARAMS
+    @IN dir - cache directory
+    @IN key - cache key
+    @IN output - output file
+
+    RETURN:
+    0 iff hit ( output is written )
+    Non-zero value iff miss or failure
+*/
+int cache_get(const char *dir, const Cache_key *key, const char *output) __nonull__(1, 2, 3);
+
+/*
+    Store compiled code in cache and evict old entries iff cache is bigger than max_size
+
+    PARAMS
+    @IN dir - cache directory ( created iff not exists )
+    @IN max_size - max size of all entries in bytes
+    @IN key - cache key
+    @IN output - compiled output file
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+int cache_put(const char *dir, uint64_t max_size, const Cache_key *key, const char *output) __nonull__(1, 3, 4);
+
+/*
+    Read statistics of cache
+
+    PARAMS
+    @IN dir - cache directory
+    @OUT stats - statistics
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+int cache_stats(const char *dir, Cache_stats *stats) __nonull__(1, 2);
+
+#endif
@@ -3,11 +3,15 @@
 
 #include <common.h>
 #include <tokens.h>
-#include <arraylist.h>
+#include <vector.h>
 #include <avl.h>
+#include <hashmap.h>
 #include <stack.h>
+#include <darray.h>
 #include <compiler_algo.h>
 #include <arch.h>
+#include <time_report.h>
+#include <arena.h>
 
 /*
     Compiler for fake machine described by Maciek Gebala
@@ -17,24 +21,50 @@
 
 */
 
+/* change it iff generated code changes, old cached code is not used then */
+#define COMPILER_VERSION    "1.1"
+
 typedef struct Option
 {
     uint8_t    wall:1;
     uint8_t    werr:1;
     uint8_t    optimal:2;
     uint8_t    tokens:1;
-    uint8_t    padding:3;
+    uint8_t    time_report:1; /* print time and memory of phases to stderr */
+    uint8_t    eval:1; /* run tokens by reference evaluator instead of compiling */
+    uint8_t    padding:1;
 
     char *input_file;
     char *output_file;
+    char *profile_file; /* profile for code layout, NULL iff not used */
+    char *map_file; /* asm to source line map, NULL iff not used */
+    char *cost_file; /* static cost report, NULL iff not used */
+    char *emitter_file; /* asm to emitter map, NULL iff not used */
+    char *cache_dir; /* cache of compiled code, NULL iff not used */
+    uint64_t cache_size; /* max size of cache in bytes */
 
 }Option;
 
-extern Option option;
+/*
+    One compilation job
+
+    Compiler state is thread local, so jobs can be compiled in parallel,
+    each job on its own thread from begin to end
+*/
+typedef struct CompilerContext
+{
+    Option option; /* options of this job with own input and output file */
+    Arena *arena; /* arena of thread reset after job, NULL iff job creates own arena */
+    int ret; /* 0 iff job compiled */
+
+}CompilerContext;
 
-extern Arraylist *asmcode;
-extern Avl* compiler_variables;
-extern Stack *labels;
+extern __thread Option option;
+
+extern __thread Vector *asmcode;
+extern __thread Hashmap* compiler_variables;
+extern __thread Stack *labels;
+extern __thread Darray *emitter_map;
 
 typedef struct Cvar
 {
@@ -70,6 +100,29 @@ typedef struct Cfor
 #define FOR_INC 0
 #define FOR_DEC 1
 
+/* asm lines generated from one token */
+typedef struct Line_map
+{
+    uint64_t asm_first;
+    uint64_t asm_last;
+
+    Token *token;
+
+}Line_map;
+
+/*
+    asm lines generated by one call of emitter ( do_mult, do_div ... )
+    emitter can call other emitter, so ranges are nested
+*/
+typedef struct Emitter_map
+{
+    uint64_t asm_first;
+    uint64_t asm_last;
+
+    const char *emitter;
+
+}Emitter_map;
+
 /* start with | because is > than 'z' */
 #define PTR_NAME        "|PTR"
 #define TEMP_ADDR_NAME  "|TEMPADDR"
@@ -85,7 +138,7 @@ typedef struct Cfor
 
 typedef struct Label
 {
-    Arraylist_node *ptr;
+    uint64_t line; /* index of asm line with jump to LABEL */
     int8_t type;
 
 }Label;
@@ -94,14 +147,14 @@ typedef struct Label
     Create Label
 
     PARAMS
-    @IN ptr to line where we have code jump to LABEL
+    @IN line - index of asm line where we have code jump to LABEL
     @IN type - label type
 
     RETURN
     NULL iff failure
     Pointer to Label iff success
 */
-Label *label_create(Arraylist_node *ptr, int8_t type) __nonull__(1);
+Label *label_create(uint64_t line, int8_t type);
 
 /*
     Destroy Label
@@ -218,6 +271,17 @@ void cvar_destroy(Cvar *cvar) __nonull__(1);
 */
 int cvar_cmp(void *a, void *b) __nonull__(1, 2);
 
+/*
+    Hash function for cvar ( hash of name )
+
+    PARAMS
+    @IN cvar - addr of cvar
+
+    RETURN:
+    Hash of cvar name
+*/
+uint64_t cvar_hash(void *cvar) __nonull__(1);
+
 /*
     Get cvar by Value
 
@@ -303,20 +367,20 @@ __inline__ void set_array_to_vararr(Value *val)
     RETURN
     Number of memory chunks needed for loops
 */
-uint64_t calc_loop_mem_section(Arraylist *tokens) __nonull__(1);
+uint64_t calc_loop_mem_section(Vector *tokens) __nonull__(1);
 
 /*
     calc memory section and write result to mem struct
 
     PARAMS
-    @IN vars - avl with pvars
+    @IN vars - map with pvars
     @IN tokens - tokens list
 
     RETURN
     0 iff success
     Non-zero value iff failure
 */
-int prepare_mem_sections(Avl *vars, Arraylist *tokens) __nonull__(1, 2);
+int prepare_mem_sections(Hashmap *vars, Vector *tokens) __nonull__(1, 2);
 
 /*
     Main compiler function,
@@ -331,16 +395,41 @@ int prepare_mem_sections(Avl *vars, Arraylist *tokens) __nonull__(1, 2);
 */
 int main_compile(void);
 
+/*
+    Compile job on current thread
+
+    Errors which stop compiler stop only this job
+
+    PARAMS
+    @IN / @OUT ctx - pointer to CompilerContext, result is set in ctx->ret
+
+    RETURN
+    0 iff success
+    Non-zero value iff failure
+*/
+int compile_context(CompilerContext *ctx) __nonull__(1);
+
+/*
+    Stop compiler after error
+
+    Inside compile_context stop only current job, otherwise exit process
+
+    PARAMS
+    @IN status - exit status
+
+    RETURN
+    This function doesn't return
+*/
+void compiler_exit(int status) __attribute__((noreturn));
+
 /*
     Set Fake label
 */
 __inline__ int label_fake(void)
 {
     Label *label;
-    Arraylist_node *fake = *(&fake);
 
-
-    label = label_create(fake, LABEL_FAKE);
+    label = label_create(0, LABEL_FAKE);
     if(label == NULL)
         ERROR("label_create error\n", 1, "");
 
@@ -355,7 +444,11 @@ __inline__ int label_fake(void)
 __inline__ int label_to_line(uint64_t line)
 {
     Label *label;
+    char **code;
     char *old;
+    Phase_mark mark;
+
+    PHASE_BEGIN(mark);
 
     if(stack_pop(labels, (void*)&label))
         ERROR("stack_pop error\n", 1, "");
@@ -366,20 +459,28 @@ __inline__ int label_to_line(uint64_t line)
         LOG("FAKE LABEL ONLY DESTROY\n", "");
 
         label_destroy(label);
+
+        PHASE_END(PHASE_LABELS, mark);
         return 0;
     }
 
-    old = *(char**)label->ptr->data;
+    code = (char**)vector_get_ptr(asmcode, label->line);
+    if(code == NULL)
+        ERROR("vector_get_ptr error\n", 1, "");
+
+    old = *code;
 
     LOG("NORMAL LABEL CHANGE %s to...\n", old);
-    if(asprintf(label->ptr->data, "%s%ju\n", old, line) == -1)
+    if(asprintf(code, "%s%ju\n", old, line) == -1)
         ERROR("asprintf error\n", 1, "");
 
-    LOG("... %s", *(char**)label->ptr->data);
+    LOG("... %s", *code);
 
     FREE(old);
     label_destroy(label);
 
+    PHASE_END(PHASE_LABELS, mark);
+
     return 0;
 }
 
@@ -6,7 +6,7 @@
 #include <tokens.h>
 #include <asm.h>
 #include <arch.h>
-#include <arraylist.h>
+#include <vector.h>
 #include <stack.h>
 
 /*
@@ -28,9 +28,9 @@ __inline int32_t BPUMP_COST(mpz_t n)
     return (int32_t)(mpz_sizeinbase(n, 2) +  mpz_popcount(n));
 }
 
-extern Stack *labels;
-extern Arraylist *token_list;
-extern uint64_t token_list_pos;
+extern __thread Stack *labels;
+extern __thread Vector *token_list;
+extern __thread uint64_t token_list_pos;
 
 /*
     Get the best register for value @val iff we are in pos @pos in tokens list
@@ -44,7 +44,7 @@ extern uint64_t token_list_pos;
     -1 iff failure
     Reg number iff success
 */
-int get_register(Arraylist *tokens, uint64_t pos, Value *val) __nonull__(1);
+int get_register(Vector *tokens, uint64_t pos, Value *val) __nonull__(1);
 
 /*
     Call get_register, synchronize memory iff needed
@@ -60,7 +60,7 @@ int get_register(Arraylist *tokens, uint64_t pos, Value *val) __nonull__(1);
     -1 iff failure
 */
 
-int do_get_register(Arraylist *tokens, uint64_t pos, Value *val, BOOL force_sync) __nonull__(1, 3);
+int do_get_register(Vector *tokens, uint64_t pos, Value *val, BOOL force_sync) __nonull__(1, 3);
 
 /*
     Better is get reg for val1 or val2 ?
@@ -76,7 +76,7 @@ int do_get_register(Arraylist *tokens, uint64_t pos, Value *val, BOOL force_sync
     0 iff doesn't matter
     1 iff better val2
 */
-int better_reg(Arraylist *tokens, uint64_t pos, Value *val1, Value *val2) __nonull__(1 ,3 ,4);
+int better_reg(Vector *tokens, uint64_t pos, Value *val1, Value *val2) __nonull__(1 ,3 ,4);
 
 /*
     Check loop for iterator usage
@@ -90,7 +90,7 @@ int better_reg(Arraylist *tokens, uint64_t pos, Value *val1, Value *val2) __nonu
     TRUE iff iterator is needed
     FALSE iff not
 */
-BOOL is_iterator_needed(Arraylist *tokens, uint64_t pos, Value *it) __nonull__(1, 3);
+BOOL is_iterator_needed(Vector *tokens, uint64_t pos, Value *it) __nonull__(1, 3);
 
 /*
     set reg value to 0
@@ -246,7 +246,9 @@ int do_add(Register *reg, BOOL trace) __nonull__(1);
 int do_sub(Register *reg, BOOL trace) __nonull__(1);
 
 /*
-    REG = REG2 * REG3
+    REG = REG2 * REG3,
+    registers have operands of current ASSIGN token, so checks are skipped
+    using ranges of operands ( see alias.h )
 
     PARAMS
     @IN res - pointer to register
@@ -262,7 +264,9 @@ int do_mult(Register *res, Register *left, Register *right, BOOL trace) __nonull
 
 
 /*
-    REG = REG2 / REG3
+    REG = REG2 / REG3,
+    registers have operands of current ASSIGN token, so checks are skipped
+    using ranges of operands ( see alias.h )
 
     PARAMS
     @IN res - pointer to register
@@ -277,7 +281,9 @@ int do_mult(Register *res, Register *left, Register *right, BOOL trace) __nonull
 int do_div(Register *res, Register *left, Register *right, BOOL trace) __nonull__(1, 2, 3);
 
 /*
-    REG = REG2 mod REG3
+    REG = REG2 mod REG3,
+    registers have operands of current ASSIGN token, so checks are skipped
+    using ranges of operands ( see alias.h )
 
     PARAMS
     @IN res - pointer to register
@@ -646,20 +652,4 @@ __inline__ BOOL value_can_trace(Value *val)
     return TRUE;
 }
 
-/* get node from arraylist */
-__inline__ Arraylist_node *arraylist_get_node(Arraylist *list, uint64_t pos)
-{
-    Arraylist_node *node;
-    uint64_t i = 0;
-
-    if(list == NULL)
-        return NULL;
-
-    node = list->head;
-    while(node != NULL && i < pos)
-        node = node->next;
-
-    return node;
-}
-
 #endif
@@ -0,0 +1,45 @@
+#ifndef COST_H
+#define COST_H
+
+#include <common.h>
+#include <compiler.h>
+#include <vector.h>
+#include <darray.h>
+
+/*
+    Static cost analysis of generated asm code
+
+    Author: Michal Kukowski
+    email: michalkukowski10@gmail.com
+
+    Program is not executed, cost of each line is taken from op_cost.
+    Report contains:
+        cost of each basic block
+        cost formula of whole program, FOR loops in terms of their bounds,
+        WHILE loops in terms of unknown iterations count W<line>,
+        MULT / DIV / MOD loops in terms of operands bit widths
+        top N most expensive source statements
+
+    To rank statements formulas are estimated, unknown values are replaced by guesses
+*/
+
+#define COST_LOOP_GUESS     100 /* iterations of loop with unknown bounds */
+#define COST_BITS_GUESS     64  /* bits of variable operand */
+#define COST_TOP_N          10
+
+/*
+    Write static cost report to file
+
+    PARAMS
+    @IN file - path to report file
+    @IN code - asm code lines before layout
+    @IN tokens - compiled token list
+    @IN line_map - Line_map of each token which generated code
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+int cost_report(const char *file, Vector *code, Vector *tokens, Darray *line_map) __nonull__(1, 2, 3, 4);
+
+#endif
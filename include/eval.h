@@ -0,0 +1,42 @@
+#ifndef EVAL_H
+#define EVAL_H
+
+#include <common.h>
+#include <vector.h>
+#include <hashmap.h>
+
+/*
+    Reference evaluator of source programs ( --eval )
+
+    Author: Michal Kukowski
+    email: michalkukowski10@gmail.com
+
+    Token list from parse ( before optimizer, -O is not used ) is executed directly,
+    numbers are mpz_t, so there is no overflow and result is the reference
+    output of program for compiled code ( see tests/fuzz.c ).
+
+    Semantic:
+        a - b is 0 iff b > a, a / 0 and a % 0 are 0
+        FOR bounds are taken once before the first iteration
+        READ reads number from input, WRITE writes number and new line
+        element of array which was not written is 0 ( memory of machine )
+
+    Program fails on READ without input, read of not set variable and index out of array.
+*/
+
+/*
+    Execute token list
+
+    PARAMS
+    @IN tokens - token list from parse
+    @IN vars - variables from parse ( Pvar ), arrays have their length there
+    @IN in - input of READ
+    @IN out - output of WRITE
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+int eval_tokens(Vector *tokens, Hashmap *vars, FILE *in, FILE *out) __nonull__(1, 2, 3, 4);
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef LAYOUT_H
+#define LAYOUT_H
+
+#include <common.h>
+#include <vector.h>
+
+/*
+    Profile guided layout of generated asm code
+
+    Author: Michal Kukowski
+    email: michalkukowski10@gmail.com
+
+    Layout works on ready asm code ( all labels are resolved ).
+    Code is splitted into basic blocks, jumps to jumps are threaded and
+    blocks are chained, so the hottest edge is fall-through edge.
+    Never executed blocks ( error paths, rare ELSE arms ) are moved to the end of code.
+
+    Profile file format ( CSV ):
+
+    # comment
+    lines,N                 <- number of asm lines in profiled code
+    line,count,taken        <- line executed count times, jump in line taken taken times
+    op,NAME,count,cost      <- ignored
+    mem,addr,reads,writes   <- ignored
+
+    lines not present in profile were never executed
+*/
+
+/* line removed by layout */
+#define LAYOUT_NO_LINE  UINT64_MAX
+
+typedef struct Profile
+{
+    uint64_t lines; /* number of asm lines in profiled code */
+
+    uint64_t *count; /* count[i] -> how many times line i was executed */
+    uint64_t *taken; /* taken[i] -> how many times jump in line i was taken */
+
+}Profile;
+
+/*
+    Load execution profile from file
+
+    PARAMS
+    @IN file - path to profile file
+
+    RETURN:
+    NULL iff failure
+    Pointer to Profile iff success
+*/
+Profile *profile_load(const char *file) __nonull__(1);
+
+/*
+    Destroy profile
+
+    PARAMS
+    @IN profile - pointer to Profile
+
+    RETURN:
+    This is a void function
+*/
+void profile_destroy(Profile *profile) __nonull__(1);
+
+/*
+    Reorder basic blocks in asm code using execution profile
+
+    Lines moved from @in_code to @out_code are not copied, so after success
+    only list @in_code should be destroyed ( without lines )
+
+    PARAMS
+    @IN in_code - asm code lines
+    @IN profile - execution profile for @in_code
+    @OUT out_code - asm code lines after layout
+    @OUT relocation - ( might be NULL ) array with @in_code->length entries,
+                      new line of each line or LAYOUT_NO_LINE iff line was removed
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+int layout_code(Vector *in_code, Profile *profile, Vector **out_code, uint64_t *relocation) __nonull__(1, 2, 3);
+
+#endif
@@ -16,35 +16,76 @@
 	DEBUG_MODE -> if defined, log
 
 	TRACE_MODE -> if defined trace_call works
+
+	TRACE_EVENTS -> if defined, TRACE writes begin and end of function to ring buffer of thread,
+	                buffers are dumped at exit to file from FLATT_TRACE env ( default flatt.trace ),
+	                ./trace_decode.out makes timeline ( Chrome trace JSON ) from this file
+
+	Without modes macros compile to nothing ( arguments are checked, but never evaluated ),
+	so there is no call into log.c in functions.
 */
 
 #define __TRACE__ "[TRACE]\tFUNC: %s\n",__func__
 
-#define __ERROR__ "[ERROR]\tFILE: %s\n\tFUNC: %s\tLINE: %d\n",__FILE__,__func__,__LINE__
+#define __ERROR__ "[ERROR]\tFILE: %s\n\tFUNC: %s\tLINE: %d\n\t"
+
+#define __LOG__ "[LOG]\tFUNC: %s\tLINE: %d\n\t"
 
-#define __LOG__ "[LOG]\tFUNC: %s\tLINE: %d\n",__func__,__LINE__
+/* default file with events of TRACE_EVENTS */
+#define TRACE_FILE_DEFAULT  "flatt.trace"
+#define TRACE_FILE_ENV      "FLATT_TRACE"
 
-#define TRACE(...) \
-    do{ \
-        __trace_call__(__TRACE__, ##__VA_ARGS__); \
-    }while(0)
+/* events in ring buffer of thread, older events are overwritten */
+#define TRACE_RING_SIZE     (1 << 16)
 
+#define TRACE_EVENT_BEGIN   0
+#define TRACE_EVENT_END     1
+
+/* trace file starts with magic */
+#define TRACE_MAGIC         "FLATTTR1"
+
+#if defined(TRACE_EVENTS)
+    /* end of function is written by cleanup of scope variable, so every return is traced */
+    #define TRACE(...) \
+        const char *__trace_scope__ __attribute__((cleanup(__trace_end__), unused)) = __trace_begin__(__func__)
+#elif defined(TRACE_MODE)
+    #define TRACE(...) \
+        do{ \
+            __trace_call__(__TRACE__, ##__VA_ARGS__); \
+        }while(0)
+#else
+    #define TRACE(...)
+#endif
 
-#define LOG(msg, ...) \
-    do{ \
-        __log__(__LOG__); \
-        __log__("\t"); \
-        __log__(msg, ##__VA_ARGS__); \
-    }while(0)
+#ifdef DEBUG_MODE
+    #define LOG(msg, ...) \
+        do{ \
+            __log__(__LOG__ msg, __func__, __LINE__, ##__VA_ARGS__); \
+        }while(0)
+
+    #define ERROR(msg, errno, ...) \
+        do{ \
+            __log__(__ERROR__ msg, __FILE__, __func__, __LINE__, ##__VA_ARGS__); \
+            \
+            return errno; \
+        }while(0)
+#else
+    /* dead call, so variables used only in logs are still used */
+    #define LOG(msg, ...) \
+        do{ \
+            if(0) \
+                __log__(msg, ##__VA_ARGS__); \
+        }while(0)
+
+    #define ERROR(msg, errno, ...) \
+        do{ \
+            if(0) \
+                __log__(msg, ##__VA_ARGS__); \
+            \
+            return errno; \
+        }while(0)
+#endif
 
-#define ERROR(msg, errno, ...) \
-    do{ \
-        __log__(__ERROR__); \
-        __log__("\t"); \
-        __log__(msg, ##__VA_ARGS__); \
-        \
-        return errno; \
-    }while(0)
 /*
 	Simple log function, put msg to stderr
 	FUNCTION WORKS IFF DEBUG_MODE is defined
@@ -71,4 +112,30 @@ void __log__(const char *msg, ...);
 */
 void __trace_call__(const char *msg, ...);
 
+/*
+	Write begin of function to ring buffer of thread
+
+	FUNCTION WORKS IFF TRACE_EVENTS is defined
+
+	PARAMS
+	@IN func - name of function ( __func__ )
+
+	RETURN:
+	func
+*/
+const char *__trace_begin__(const char *func);
+
+/*
+	Write end of function to ring buffer of thread, cleanup of TRACE scope variable
+
+	FUNCTION WORKS IFF TRACE_EVENTS is defined
+
+	PARAMS
+	@IN scope - pointer to name of function
+
+	RETURN:
+	This is a void function
+*/
+void __trace_end__(const char **scope);
+
 #endif
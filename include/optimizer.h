@@ -1,5 +1,5 @@
 #include <common.h>
-#include <arraylist.h>
+#include <vector.h>
 
 /*
     Static analysis for code flow before compiling it to asm
@@ -19,4 +19,4 @@
     0 iff success
     1 iff failure
 */
-int main_optimizing(Arraylist *in_tokens, Arraylist **out_tokens) __nonull__(1, 2);
+int main_optimizing(Vector *in_tokens, Vector **out_tokens) __nonull__(1, 2);
@@ -0,0 +1,131 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_ROOT_REPO_INCLUDE_PARSER_TAB_H_INCLUDED
+# define YY_YY_ROOT_REPO_INCLUDE_PARSER_TAB_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+/* "%code requires" blocks.  */
+#line 61 "/root/repo/src/parser.y"
+
+    #include <parser_helper.h>
+
+#line 53 "/root/repo/include/parser.tab.h"
+
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    YY_EQ = 258,                   /* YY_EQ  */
+    YY_NE = 259,                   /* YY_NE  */
+    YY_LT = 260,                   /* YY_LT  */
+    YY_GT = 261,                   /* YY_GT  */
+    YY_LE = 262,                   /* YY_LE  */
+    YY_GE = 263,                   /* YY_GE  */
+    YY_ADD = 264,                  /* YY_ADD  */
+    YY_SUB = 265,                  /* YY_SUB  */
+    YY_DIV = 266,                  /* YY_DIV  */
+    YY_MOD = 267,                  /* YY_MOD  */
+    YY_MULT = 268,                 /* YY_MULT  */
+    YY_ASSIGN = 269,               /* YY_ASSIGN  */
+    YY_VAR = 270,                  /* YY_VAR  */
+    YY_BEGIN = 271,                /* YY_BEGIN  */
+    YY_END = 272,                  /* YY_END  */
+    YY_READ = 273,                 /* YY_READ  */
+    YY_WRITE = 274,                /* YY_WRITE  */
+    YY_SKIP = 275,                 /* YY_SKIP  */
+    YY_FOR = 276,                  /* YY_FOR  */
+    YY_FROM = 277,                 /* YY_FROM  */
+    YY_TO = 278,                   /* YY_TO  */
+    YY_DOWNTO = 279,               /* YY_DOWNTO  */
+    YY_ENDFOR = 280,               /* YY_ENDFOR  */
+    YY_WHILE = 281,                /* YY_WHILE  */
+    YY_DO = 282,                   /* YY_DO  */
+    YY_ENDWHILE = 283,             /* YY_ENDWHILE  */
+    YY_IF = 284,                   /* YY_IF  */
+    YY_THEN = 285,                 /* YY_THEN  */
+    YY_ELSE = 286,                 /* YY_ELSE  */
+    YY_ENDIF = 287,                /* YY_ENDIF  */
+    YY_VARIABLE = 288,             /* YY_VARIABLE  */
+    YY_NUM = 289,                  /* YY_NUM  */
+    YY_L_BRACKET = 290,            /* YY_L_BRACKET  */
+    YY_R_BRACKET = 291,            /* YY_R_BRACKET  */
+    YY_ERROR = 292,                /* YY_ERROR  */
+    YY_SEMICOLON = 293             /* YY_SEMICOLON  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+union YYSTYPE
+{
+#line 67 "/root/repo/src/parser.y"
+
+    parser_token    ptoken;
+    Pvalue          val;
+    Pexpr           expr;
+    Pcond           cond;
+    Vector       *list;
+    Token           *token;
+
+#line 117 "/root/repo/include/parser.tab.h"
+
+};
+typedef union YYSTYPE YYSTYPE;
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
+#endif
+
+
+extern YYSTYPE yylval;
+
+
+int yyparse (void);
+
+
+#endif /* !YY_YY_ROOT_REPO_INCLUDE_PARSER_TAB_H_INCLUDED  */
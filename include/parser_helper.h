@@ -12,17 +12,21 @@
 #include <asm.h>
 #include <filebuffer.h>
 #include <compiler.h>
-#include <arraylist.h>
-#include <avl.h>
+#include <vector.h>
+#include <hashmap.h>
 
-/* avl with Pvars */
-extern Avl *variables;
+/* map with Pvars, name is key */
+extern __thread Hashmap *variables;
 
-/* array with code split at lines */
-extern Darray *code_lines;
+/* offsets of lines begins in source_code ( uint64_t ) */
+extern __thread Darray *code_lines;
 
-/* buffer for input code file */
-extern file_buffer *fb_input;
+/* tokens which set hidden variables of big literals, added at the beginning of program */
+extern __thread Vector *big_consts;
+
+/* input code file mapped by source_map, lexer reads it in place */
+extern __thread char *source_code;
+extern __thread uint64_t source_size;
 
 /*
     MAIN PARSER FUNCTION
@@ -35,7 +39,21 @@ extern file_buffer *fb_input;
     0 iff failure
     1 iff success
 */
-int parse(const char *file, Arraylist **out_tokens) __nonull__(1, 2);
+int parse(const char *file, Vector **out_tokens) __nonull__(1, 2);
+
+/*
+    Release parser lock iff current thread holds it
+
+    Lexer and parser are not reentrant, so only one thread can parse at once,
+    compiler_exit calls it when parser was stopped in the middle
+
+    PARAMS
+    NO PARAMS
+
+    RETURN:
+    This is a void function
+*/
+void parse_unlock(void);
 
 /* DEBUG_MODE FOR PARSER */
 #ifdef YY_DEBUG_MODE
@@ -85,8 +103,12 @@ typedef struct parser_token
     char *str;
     uint64_t val;
     uint64_t line;
+    BOOL big; /* YY_NUM has more than 64 bits, value is only in str */
 }parser_token;
 
+/* big literal is kept in hidden variable BIG_CONST_PREFIX<literal>, start with | like compiler variables */
+#define BIG_CONST_PREFIX    "|BIG"
+
 typedef struct Pvar
 {
     /* is variable set ? */
@@ -163,6 +185,31 @@ void pvar_destroy(Pvar *pvar) __nonull__(1);
 */
 int pvar_cmp(void *pvar1, void *pvar2) __nonull__(1, 2);
 
+/*
+    Hash function for pvar ( hash of name )
+
+    PARAMS
+    @IN pvar - addr of Parser var
+
+    RETURN:
+    Hash of pvar name
+*/
+uint64_t pvar_hash(void *pvar) __nonull__(1);
+
+/*
+    Get pvars from map sorted by name
+
+    PARAMS
+    @IN vars - map with pvars
+    @OUT array - malloced array of pvars
+    @OUT size - number of pvars
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+int pvars_sorted(Hashmap *vars, Pvar ***array, int *size) __nonull__(1, 2, 3);
+
 /*
     Get pvar from varibales by name
 
@@ -188,6 +235,33 @@ Pvar *pvar_get_by_name(char *name) __nonull__(1);
 */
 void declare(uint8_t type, parser_token *token, uint64_t array_len) __nonull__(2);
 
+/*
+    Create value of big literal ( more than 64 bits )
+
+    Compiler folds constants of 64 bits only, so big literal is a hidden variable
+    set at the beginning of program, compiler traces its value like value of other variables
+
+    PARAMS
+    @IN token - YY_NUM token with big literal
+
+    RETURN:
+    NULL iff failure
+    Pointer to value iff success
+*/
+Value *big_const_value(parser_token *token) __nonull__(1);
+
+/*
+    Insert tokens from big_consts at the beginning of program and destroy big_consts
+
+    PARAMS
+    @IN tokens - program tokens
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+int big_consts_insert(Vector *tokens) __nonull__(1);
+
 /*
     Undeclare variable or array
 
@@ -367,18 +441,56 @@ void use_cond(Pcond *cond) __nonull__(1);
 void check_use_it(Value *it, Token *token, uint64_t fl, uint64_t ll) __nonull__(1, 2);
 
 /*
-    Split string into array of string and write to arr
+    Write offsets of lines begins in str to arr, lines are not copied
 
     PARAMS
     @IN str - string
+    @IN size - length of string
     @IN delimeter - delimeter
-    @IN arr - dynamic array
+    @IN arr - dynamic array of uint64_t
 
     RETURN
     0 iff success
     Non-zero value if failure
 */
-int strspl(char *str, const char delimeter, Darray *arr) __nonull__(1, 3);
+int line_index(const char *str, uint64_t size, const char delimeter, Darray *arr) __nonull__(1, 4);
+
+/*
+    Get line of source code, line is not ended by '\0'
+
+    PARAMS
+    @IN i - line number ( from 0 )
+    @OUT len - length of line
+
+    RETURN:
+    Pointer to begin of line in source_code ( empty string iff there is no such line )
+*/
+const char *code_line(uint64_t i, int *len) __nonull__(2);
+
+/*
+    Map file to private memory ended by two '\0', so flex can scan it without copy
+
+    PARAMS
+    @IN file - path to file
+    @OUT size - size of file
+
+    RETURN:
+    NULL iff failure
+    Pointer to mapped code iff success
+*/
+char *source_map(const char *file, uint64_t *size) __nonull__(1, 2);
+
+/*
+    Unmap code mapped by source_map
+
+    PARAMS
+    @IN code - mapped code
+    @IN size - size of file
+
+    RETURN:
+    This is a void function
+*/
+void source_unmap(char *code, uint64_t size);
 
 /*
     Print error msg and lines in code
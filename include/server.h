@@ -0,0 +1,54 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <common.h>
+#include <compiler.h>
+
+/*
+    Persistent compile server
+
+    Author: Michal Kukowski
+    email: michalkukowski10@gmail.com
+
+    Server is started once and compiles many programs, so process startup,
+    parser initialization and malloc arenas of worker threads are paid only once.
+    Each connection is served by own thread, parsing is serialized, code generation runs in parallel.
+    Thread has one compile arena for all its requests, arena is reset after each request.
+
+    Protocol ( text framing, the same on unix socket and on stdin / stdout ):
+
+    request:
+    COMPILE <flags> <path>\n    <- flags: '-' or letters a ( Wall ), e ( Werror ), t ( tokens ),
+                                   digit is optimalization level, path is rest of line
+
+    response:
+    OK <len>\n<len bytes>       <- asm code or token list
+    ERROR <len>\n<len bytes>    <- error message, compiler errors are printed to server stderr
+
+    connection ends on EOF
+*/
+
+#define SERVER_STDIO        "-" /* serve requests from stdin, responses to stdout */
+#define SERVER_BACKLOG      64
+#define SERVER_TMP_TEMPLATE "/tmp/flatt_server_XXXXXX"
+
+#define SERVER_REQ_COMPILE  "COMPILE"
+#define SERVER_RES_OK       "OK"
+#define SERVER_RES_ERROR    "ERROR"
+
+/* error message when message can't be allocated */
+#define SERVER_MSG_NO_MEMORY "out of memory"
+
+/*
+    Run compile server, returns only on error or when stdin is closed
+
+    PARAMS
+    @IN path - unix socket path or SERVER_STDIO
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+int server_run(const char *path) __nonull__(1);
+
+#endif
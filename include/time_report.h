@@ -0,0 +1,129 @@
+#ifndef TIME_REPORT_H
+#define TIME_REPORT_H
+
+#include <common.h>
+
+/*
+    Time and memory of compilation phases ( --time-report )
+
+    Author: Michal Kukowski
+    email: michalkukowski10@gmail.com
+
+    Phase is measured between PHASE_BEGIN and PHASE_END, measured are wall time,
+    cpu time of thread, heap allocations of thread and peak RSS of process after phase.
+    Phases of code generation for each token type and label resolution are parts of
+    code generation, so they are not added to total.
+
+    Heap allocations are counted by __wrap_* functions of malloc, calloc, realloc,
+    strdup, asprintf and free, compiler is linked with --wrap of them ( ALLOC_WRAP in Makefile ),
+    so only calls from compiler and my libs are counted, not from gmp or libc.
+    Counters are per thread, so jobs compiled in parallel have own counters.
+    Without report nothing is counted and time is not taken.
+*/
+
+#define PHASE_SOURCE            0
+#define PHASE_PARSE             1
+#define PHASE_SEMANTIC          2
+#define PHASE_OPTIMIZER         3
+#define PHASE_MEM_SECTIONS      4
+#define PHASE_ALLOC_VARIABLES   5
+#define PHASE_CODEGEN           6
+#define PHASE_CODEGEN_ASSIGN    7
+#define PHASE_CODEGEN_IO        8
+#define PHASE_CODEGEN_IF        9
+#define PHASE_CODEGEN_WHILE     10
+#define PHASE_CODEGEN_FOR       11
+#define PHASE_CODEGEN_GUARD     12
+#define PHASE_LABELS            13
+#define PHASE_COST_REPORT       14
+#define PHASE_LAYOUT            15
+#define PHASE_MAPS              16
+#define PHASE_OUTPUT            17
+#define PHASES_NUM              18
+
+/* state at begin of phase */
+typedef struct Phase_mark
+{
+    uint64_t wall_ns;
+    uint64_t cpu_ns;
+    uint64_t allocs;
+    uint64_t alloc_bytes;
+    uint64_t frees;
+
+}Phase_mark;
+
+typedef struct Phase_stat
+{
+    uint64_t calls;
+    uint64_t wall_ns;
+    uint64_t cpu_ns;
+    uint64_t allocs;
+    uint64_t alloc_bytes;
+    uint64_t max_rss_kb; /* 0 iff not measured ( parts of code generation ) */
+
+}Phase_stat;
+
+/* TRUE iff phases of current compilation are measured */
+extern __thread BOOL time_report_on;
+
+#define PHASE_BEGIN(mark) \
+    do { \
+        if(time_report_on) \
+            time_report_begin(&(mark)); \
+    } while(0)
+
+#define PHASE_END(phase, mark) \
+    do { \
+        if(time_report_on) \
+            time_report_end(phase, &(mark)); \
+    } while(0)
+
+/*
+    Clear stats of phases and turn measuring on / off for this thread
+
+    PARAMS
+    @IN on - TRUE iff phases will be measured
+
+    RETURN:
+    This is a void function
+*/
+void time_report_reset(BOOL on);
+
+/*
+    Remember state at begin of phase
+
+    PARAMS
+    @OUT mark - state at begin
+
+    RETURN:
+    This is a void function
+*/
+void time_report_begin(Phase_mark *mark) __nonull__(1);
+
+/*
+    Add time and allocations from mark to now to phase
+
+    PARAMS
+    @IN phase - PHASE_*
+    @IN mark - state at begin of phase
+
+    RETURN:
+    This is a void function
+*/
+void time_report_end(int phase, const Phase_mark *mark) __nonull__(2);
+
+/*
+    Print table of phases
+
+    PARAMS
+    @IN f - output stream
+    @IN file - compiled file
+    @IN total - state at begin of compilation
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+int time_report_print(FILE *f, const char *file, const Phase_mark *total) __nonull__(1, 2, 3);
+
+#endif
@@ -135,10 +135,72 @@ typedef struct Token
 
     }body;
 
+    /* source span, 0 iff unknown */
+    uint64_t first_line;
+    uint64_t last_line;
+
 }Token;
 
 extern token_id tokens_id;
 
+/*
+    Set source span of token
+
+    PARAMS
+    @IN token - pointer to token
+    @IN first - first line in source code
+    @IN last - last line in source code
+
+    RETURN:
+    This is a void function
+*/
+__inline__ void token_set_lines(Token *token, uint64_t first, uint64_t last)
+{
+    token->first_line = first;
+    token->last_line = last;
+}
+
+/*
+    Get short name of token kind ( i.e WHILE, ENDWHILE )
+
+    PARAMS
+    @IN token - pointer to token
+
+    RETURN:
+    const pointer to const string
+*/
+__inline__ const char *token_kind_str(Token *token)
+{
+    switch(token->type)
+    {
+        case TOKEN_IO:
+            return token->body.io->op == tokens_id.read ? "READ" : "WRITE";
+        case TOKEN_ASSIGN:
+            return "ASSIGN";
+        case TOKEN_IF:
+            return "IF";
+        case TOKEN_WHILE:
+            return "WHILE";
+        case TOKEN_FOR:
+            return "FOR";
+        case TOKEN_GUARD:
+        {
+            if(token->body.guard->type == tokens_id.else_cond)
+                return "ELSE";
+            else if(token->body.guard->type == tokens_id.end_for)
+                return "ENDFOR";
+            else if(token->body.guard->type == tokens_id.end_if)
+                return "ENDIF";
+            else if(token->body.guard->type == tokens_id.end_while)
+                return "ENDWHILE";
+            else
+                return "SKIP";
+        }
+        default:
+            return "UNDEFINED";
+    }
+}
+
 /*
     Get str from operation type
 
@@ -0,0 +1,199 @@
+#include <server.h>
+#include <getopt.h>
+#include <limits.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/*
+    CLIENT OF COMPILE SERVER
+
+    Send files to compiler server ( ./compiler.out --server ) and write results
+
+    Author: Michal Kukowski
+    email: michalkukowski10@gmail.com
+*/
+
+/*
+    Send one file to server and write response to output file
+
+    PARAMS
+    @IN in - response stream
+    @IN out - request stream
+    @IN flags - request flags
+    @IN file - input file
+
+    RETURN:
+    0 iff file compiled
+    Non-zero value iff failure
+*/
+static int request(FILE *in, FILE *out, const char *flags, const char *file) __nonull__(1, 2, 3, 4);
+
+void usage()
+{
+    printf( "Compiler server client\n\n"
+            "ARGS:\n"
+            "MANDATORY\n"
+            "--socket[-s]\t\tunix socket of server\n"
+            "files to compile after options, output of file is file.asm ( file.tokens with --tokens )\n\n"
+            "OPTIONAL:\n"
+            "--Wall[-a]\t\tprint all warnings\n"
+            "--Werror[-e]\t\tmake all warnings into errors\n"
+            "--tokens[-t]\t\tget token list instead of asm code\n\n"
+            "Examples:\n"
+            "./compiler.out --server /tmp/flatt.sock &\n"
+            "./client.out --socket /tmp/flatt.sock code1 code2 code3\n\n");
+
+    exit(0);
+}
+
+static int request(FILE *in, FILE *out, const char *flags, const char *file)
+{
+    char path[PATH_MAX];
+    char status[16];
+    char *output;
+    char *data;
+    size_t len;
+    FILE *f;
+    int ret;
+
+    TRACE("");
+
+    /* server can run in other directory */
+    if(realpath(file, path) == NULL)
+    {
+        fprintf(stderr, "%sERROR: %s No such file%s\n", RED, file, RESET);
+        return 1;
+    }
+
+    fprintf(out, "%s %s %s\n", SERVER_REQ_COMPILE, flags, path);
+    if(fflush(out))
+        ERROR("cannot send request\n", 1, "");
+
+    if(fscanf(in, "%15s %zu", status, &len) != 2 || fgetc(in) != '\n')
+        ERROR("bad response\n", 1, "");
+
+    data = (char*)malloc(len + 1);
+    if(data == NULL)
+        ERROR("malloc error\n", 1, "");
+
+    if(fread(data, sizeof(char), len, in) != len)
+    {
+        FREE(data);
+        ERROR("bad response\n", 1, "");
+    }
+
+    data[len] = '\0';
+
+    if(strcmp(status, SERVER_RES_OK))
+    {
+        fprintf(stderr, "%sERROR: %s%s\n", RED, data, RESET);
+        FREE(data);
+
+        return 1;
+    }
+
+    if(asprintf(&output, "%s%s", file, strchr(flags, 't') ? ".tokens" : ".asm") == -1)
+    {
+        FREE(data);
+        ERROR("asprintf error\n", 1, "");
+    }
+
+    ret = 0;
+    f = fopen(output, "w");
+    if(f == NULL || fwrite(data, sizeof(char), len, f) != len)
+    {
+        fprintf(stderr, "%sERROR: cannot write %s%s\n", RED, output, RESET);
+        ret = 1;
+    }
+
+    if(f != NULL)
+        fclose(f);
+
+    FREE(output);
+    FREE(data);
+
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    struct sockaddr_un addr;
+    FILE *in;
+    FILE *out;
+    int sock;
+
+	static struct option long_option[] =
+	{
+		{"Wall",	no_argument,	    0,	'a'},
+		{"Werror",	no_argument,	    0,	'e'},
+        {"tokens",  no_argument,        0,  't'},
+        {"socket",  required_argument,  0,  's'},
+		{NULL,		0,				    0,	'\0'}
+
+    };
+
+    int opt;
+    char flags[4] = "";
+    char *socket_path = NULL;
+
+    int i;
+    int failed = 0;
+
+    if(argc < 4)
+        usage();
+
+    while ((opt = getopt_long_only(argc, argv, "aets:", long_option, NULL )) != -1)
+    {
+        switch(opt)
+        {
+            case 'a':
+            case 'e':
+            case 't':
+            {
+                if(strchr(flags, opt) == NULL)
+                    flags[strlen(flags)] = (char)opt;
+
+                break;
+            }
+            case 's':
+            {
+                socket_path = argv[optind - 1];
+                break;
+            }
+            default:
+            {
+                usage();
+            }
+        }
+    }
+
+    if(socket_path == NULL || optind == argc || strlen(socket_path) >= sizeof(addr.sun_path))
+        usage();
+
+    sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(sock == -1)
+        ERROR("socket error\n", 1, "");
+
+    (void)memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    (void)strcpy(addr.sun_path, socket_path);
+
+    if(connect(sock, (struct sockaddr*)&addr, sizeof(addr)))
+    {
+        fprintf(stderr, "%sERROR: cannot connect to %s%s\n", RED, socket_path, RESET);
+        return 1;
+    }
+
+    in = fdopen(sock, "r");
+    out = fdopen(dup(sock), "w");
+    if(in == NULL || out == NULL)
+        ERROR("fdopen error\n", 1, "");
+
+    for(i = optind; i < argc; ++i)
+        failed += request(in, out, flags[0] ? flags : "-", argv[i]);
+
+    fclose(out);
+    fclose(in);
+
+    return failed ? 1 : 0;
+}
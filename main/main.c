@@ -1,8 +1,11 @@
 #include <compiler.h>
+#include <server.h>
+#include <cache.h>
 #include <common.h>
 #include <getopt.h>
 #include <unistd.h>
 #include <sys/stat.h>
+#include <pthread.h>
 
 /*
     MAIN FILE
@@ -13,6 +16,53 @@
     email: michalkukowski10@gmail.com
 */
 
+/* batch of jobs shared by worker threads */
+typedef struct Batch
+{
+    CompilerContext *jobs;
+    int njobs;
+
+    int next; /* next job to take */
+
+}Batch;
+
+/*
+    Worker thread, compile jobs from batch until all are taken
+
+    PARAMS
+    @IN arg - pointer to Batch
+
+    RETURN:
+    NULL
+*/
+static void *batch_worker(void *arg);
+
+/*
+    Compile many files on @jobs threads, output of file is file.asm ( file.tokens with --tokens )
+
+    PARAMS
+    @IN files - input files
+    @IN n - number of files
+    @IN jobs - number of threads
+
+    RETURN:
+    0 iff all files compiled
+    Non-zero value iff failure
+*/
+static int batch_compile(char **files, int n, int jobs);
+
+/*
+    Print statistics of compiled code cache
+
+    PARAMS
+    @IN dir - cache directory
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int print_cache_stats(const char *dir);
+
 void usage()
 {
     printf( "Compiler\n\n"
@@ -23,15 +73,133 @@ void usage()
             "OPTIONAL:\n"
             "--Wall[-a]\t\tprint all warnings\n"
             "--Werror[-e]\t\tmake all warnings into errors\n"
-            "--tokens[-t]\t\tget token list instead of asm code\n\n"
+            "--tokens[-t]\t\tget token list instead of asm code\n"
+            "--profile-use[-p]\tlayout code using execution profile of the same code\n"
+            "--line-map[-m]\t\twrite asm lines to source lines map to file\n"
+            "--cost-report[-c]\twrite static cost analysis of code to file\n"
+            "--emitter-map[-E]\twrite asm lines to emitters ( do_mult, do_div ... ) map to file\n"
+            "--time-report[-R]\tprint time, allocations and peak memory of compilation phases\n"
+            "--eval[-x]\t\trun program by reference evaluator instead of compiling,\n"
+            "\t\t\tREAD from stdin, WRITE to stdout ( output file is not needed, -O is not used )\n"
+            "--jobs[-j]\t\tcompile all files given after options on N threads,\n"
+            "\t\t\toutput of file is file.asm ( file.tokens with --tokens )\n"
+            "--server[-s]\t\trun compile server on unix socket ( - for stdin / stdout ),\n"
+            "\t\t\tsee ./client.out\n"
+            "--cache[-C]\t\ttake compiled code from cache dir, store new code there\n"
+            "--cache-size[-Z]\tmax size of cache in MiB ( default 64 )\n"
+            "--cache-stats[-T]\tprint hits, misses, evictions and size of cache and exit\n\n"
             "Examples:\n"
             "./compiler.out --input my_code --output my_code.asm\n"
             "./compiler.out --input my_code --output my_code.asm --Wall --Werror\n"
-            "./compiler.out --input my_code --tokens --output mytokens\n\n");
+            "./compiler.out --input my_code --tokens --output mytokens\n"
+            "./compiler.out --input my_code --output my_code.asm --profile-use my_code.prof\n"
+            "./compiler.out --input my_code --output my_code.asm --line-map my_code.map\n"
+            "./compiler.out --input my_code --output my_code.asm --cost-report my_code.cost\n"
+            "./compiler.out --input my_code --output my_code.asm --emitter-map my_code.emit\n"
+            "./compiler.out --input my_code --output my_code.asm --time-report\n"
+            "./compiler.out --input my_code --eval < my_code.in\n"
+            "./compiler.out --jobs 8 code1 code2 code3\n"
+            "./compiler.out --server /tmp/flatt.sock\n"
+            "./compiler.out --input my_code --output my_code.asm --cache ~/.flatt_cache\n"
+            "./compiler.out --cache ~/.flatt_cache --cache-stats\n\n");
 
     exit(0);
 }
 
+static int print_cache_stats(const char *dir)
+{
+    Cache_stats stats;
+    uint64_t all;
+
+    TRACE("");
+
+    if(access(dir, F_OK))
+    {
+        printf("%sERROR: %s No such cache%s\n", RED, dir, RESET);
+        return 1;
+    }
+
+    if(cache_stats(dir, &stats))
+        ERROR("cache_stats error\n", 1, "");
+
+    all = stats.hits + stats.misses;
+
+    printf("hits:\t\t%ju\n", (uintmax_t)stats.hits);
+    printf("misses:\t\t%ju\n", (uintmax_t)stats.misses);
+    printf("hit ratio:\t%.2lf%%\n", all ? 100.0 * (double)stats.hits / (double)all : 0.0);
+    printf("evictions:\t%ju\n", (uintmax_t)stats.evictions);
+    printf("entries:\t%ju\n", (uintmax_t)stats.entries);
+    printf("size:\t\t%ju B\n", (uintmax_t)stats.size);
+
+    return 0;
+}
+
+static void *batch_worker(void *arg)
+{
+    Batch *batch = (Batch*)arg;
+    int i;
+
+    while((i = __sync_fetch_and_add(&batch->next, 1)) < batch->njobs)
+        compile_context(&batch->jobs[i]);
+
+    return NULL;
+}
+
+static int batch_compile(char **files, int n, int jobs)
+{
+    Batch batch;
+    pthread_t *threads;
+
+    int i;
+    int failed = 0;
+
+    TRACE("");
+
+    batch.jobs = (CompilerContext*)malloc(sizeof(CompilerContext) * (size_t)n);
+    threads = (pthread_t*)malloc(sizeof(pthread_t) * (size_t)jobs);
+    if(batch.jobs == NULL || threads == NULL)
+        ERROR("malloc error\n", 1, "");
+
+    batch.njobs = n;
+    batch.next = 0;
+
+    for(i = 0; i < n; ++i)
+    {
+        batch.jobs[i].option = option;
+        batch.jobs[i].option.input_file = files[i];
+        batch.jobs[i].arena = NULL;
+        batch.jobs[i].ret = 0;
+
+        if(asprintf(&batch.jobs[i].option.output_file, "%s%s", files[i],
+                    option.tokens ? ".tokens" : ".asm") == -1)
+            ERROR("asprintf error\n", 1, "");
+    }
+
+    jobs = MIN(jobs, n);
+    for(i = 0; i < jobs; ++i)
+        if(pthread_create(&threads[i], NULL, batch_worker, (void*)&batch))
+            ERROR("pthread_create error\n", 1, "");
+
+    for(i = 0; i < jobs; ++i)
+        pthread_join(threads[i], NULL);
+
+    for(i = 0; i < n; ++i)
+    {
+        if(batch.jobs[i].ret)
+        {
+            fprintf(stderr, "%sERROR: %s not compiled%s\n", RED, files[i], RESET);
+            ++failed;
+        }
+
+        FREE(batch.jobs[i].option.output_file);
+    }
+
+    FREE(batch.jobs);
+    FREE(threads);
+
+    return failed;
+}
+
 int main(int argc, char **argv)
 {
     int ret;
@@ -45,17 +213,31 @@ int main(int argc, char **argv)
         {"tokens",  no_argument,        0,  't'},
         {"output",  required_argument,  0,  'o'},
         {"input",  required_argument,   0,  'i'},
+        {"profile-use", required_argument, 0, 'p'},
+        {"line-map", required_argument, 0, 'm'},
+        {"cost-report", required_argument, 0, 'c'},
+        {"emitter-map", required_argument, 0, 'E'},
+        {"time-report", no_argument, 0, 'R'},
+        {"eval", no_argument, 0, 'x'},
+        {"jobs", required_argument, 0, 'j'},
+        {"server", required_argument, 0, 's'},
+        {"cache", required_argument, 0, 'C'},
+        {"cache-size", required_argument, 0, 'Z'},
+        {"cache-stats", no_argument, 0, 'T'},
 		{NULL,		0,				    0,	'\0'}
 
     };
 
     int opt;
+    int jobs = 0;
+    char *server = NULL;
+    BOOL stats = FALSE;
 
-    /* need at least 2 param: -input and -output */
+    /* need at least 2 param: -input and -output or --server and path */
     if(argc < 3)
         usage();
 
-    while ((opt = getopt_long_only(argc, argv, "aeto:i:O:",
+    while ((opt = getopt_long_only(argc, argv, "aeto:i:O:p:m:c:E:Rxj:s:C:Z:T",
                     long_option, NULL )) != -1)
     {
         switch(opt)
@@ -90,6 +272,61 @@ int main(int argc, char **argv)
                 option.input_file = argv[optind - 1];
                 break;
             }
+            case 'p':
+            {
+                option.profile_file = argv[optind - 1];
+                break;
+            }
+            case 'm':
+            {
+                option.map_file = argv[optind - 1];
+                break;
+            }
+            case 'c':
+            {
+                option.cost_file = argv[optind - 1];
+                break;
+            }
+            case 'E':
+            {
+                option.emitter_file = argv[optind - 1];
+                break;
+            }
+            case 'R':
+            {
+                option.time_report = 1;
+                break;
+            }
+            case 'x':
+            {
+                option.eval = 1;
+                break;
+            }
+            case 'j':
+            {
+                jobs = atoi(argv[optind - 1]);
+                break;
+            }
+            case 's':
+            {
+                server = argv[optind - 1];
+                break;
+            }
+            case 'C':
+            {
+                option.cache_dir = argv[optind - 1];
+                break;
+            }
+            case 'Z':
+            {
+                option.cache_size = strtoull(argv[optind - 1], NULL, 10) << 20;
+                break;
+            }
+            case 'T':
+            {
+                stats = TRUE;
+                break;
+            }
             default:
             {
                 usage();
@@ -97,7 +334,42 @@ int main(int argc, char **argv)
         }
     }
 
-    if(option.input_file == NULL || option.output_file == NULL)
+    if(stats)
+    {
+        if(option.cache_dir == NULL)
+            usage();
+
+        return print_cache_stats(option.cache_dir);
+    }
+
+    /* server mode, options come with requests */
+    if(server != NULL)
+    {
+        if(jobs > 0 || optind != argc || option.input_file != NULL || option.output_file != NULL
+            || option.profile_file != NULL || option.map_file != NULL || option.cost_file != NULL
+            || option.emitter_file != NULL || option.eval)
+            usage();
+
+        if(server_run(server))
+            ERROR("server error\n", 1, "");
+
+        return 0;
+    }
+
+    /* batch mode, files are after options */
+    if(jobs > 0)
+    {
+        /* these files are for single code */
+        if(optind == argc || option.input_file != NULL || option.output_file != NULL
+            || option.profile_file != NULL || option.map_file != NULL || option.cost_file != NULL
+            || option.emitter_file != NULL || option.eval)
+            usage();
+
+        return batch_compile(&argv[optind], argc - optind, jobs) ? 1 : 0;
+    }
+
+    /* evaluator has no output file */
+    if(option.input_file == NULL || (option.output_file == NULL && ! option.eval))
         usage();
 
     /* check existing of inpu file */
@@ -0,0 +1,285 @@
+#include <common.h>
+#include <getopt.h>
+
+/*
+    DECODER OF TRACE EVENTS
+
+    Make timeline ( Chrome trace JSON, chrome://tracing or ui.perfetto.dev ) from file
+    written by programs built with TRACE_EVENTS ( see log.h, make compiler_trace )
+
+    Author: Michal Kukowski
+    email: michalkukowski10@gmail.com
+
+    Ring buffer keeps only the newest events of thread, so END without BEGIN is skipped.
+    Functions which didn't end ( exit in the middle ) end at the last event of thread.
+*/
+
+typedef struct Trace_names
+{
+    char **names;
+    uint64_t num;
+
+}Trace_names;
+
+/*
+    Read names of functions
+
+    PARAMS
+    @IN f - trace file after magic
+    @OUT names - names
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int names_read(FILE *f, Trace_names *names) __nonull__(1, 2);
+
+/*
+    Write one event in JSON
+
+    PARAMS
+    @IN out - JSON stream
+    @IN name - name of function
+    @IN type - TRACE_EVENT_BEGIN or TRACE_EVENT_END
+    @IN ts - time in ns
+    @IN tid - thread id
+    @IN/OUT first - TRUE iff it is first event in JSON
+
+    RETURN:
+    This is a void function
+*/
+static void event_write(FILE *out, const char *name, uint32_t type, uint64_t ts, uint64_t tid, BOOL *first) __nonull__(1, 2, 6);
+
+/*
+    Read events of one thread and write them in JSON
+
+    PARAMS
+    @IN f - trace file
+    @IN out - JSON stream
+    @IN names - names of functions
+    @IN/OUT first - TRUE iff no event was written yet
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int ring_decode(FILE *f, FILE *out, const Trace_names *names, BOOL *first) __nonull__(1, 2, 3, 4);
+
+static int names_read(FILE *f, Trace_names *names)
+{
+    uint64_t i;
+    uint32_t len;
+
+    TRACE("");
+
+    if(fread(&names->num, sizeof(uint64_t), 1, f) != 1)
+        ERROR("fread error\n", 1, "");
+
+    names->names = (char**)calloc(names->num + 1, sizeof(char*));
+    if(names->names == NULL)
+        ERROR("calloc error\n", 1, "");
+
+    for(i = 0; i < names->num; ++i)
+    {
+        if(fread(&len, sizeof(uint32_t), 1, f) != 1)
+            ERROR("fread error\n", 1, "");
+
+        names->names[i] = (char*)malloc((size_t)len + 1);
+        if(names->names[i] == NULL)
+            ERROR("malloc error\n", 1, "");
+
+        if(fread(names->names[i], sizeof(char), len, f) != len)
+            ERROR("fread error\n", 1, "");
+
+        names->names[i][len] = '\0';
+    }
+
+    return 0;
+}
+
+static void event_write(FILE *out, const char *name, uint32_t type, uint64_t ts, uint64_t tid, BOOL *first)
+{
+    fprintf(out, "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%ju.%03ju,\"pid\":1,\"tid\":%ju}",
+            *first ? "" : ",", name, type == TRACE_EVENT_BEGIN ? 'B' : 'E',
+            ts / 1000, ts % 1000, tid);
+
+    *first = FALSE;
+}
+
+static int ring_decode(FILE *f, FILE *out, const Trace_names *names, BOOL *first)
+{
+    uint64_t tid;
+    uint64_t count;
+    uint64_t ts;
+    uint64_t last = 0;
+    uint64_t i;
+    uint32_t id;
+    uint32_t type;
+
+    uint32_t *stack;
+    uint64_t depth = 0;
+
+    TRACE("");
+
+    if(fread(&tid, sizeof(uint64_t), 1, f) != 1 || fread(&count, sizeof(uint64_t), 1, f) != 1)
+        ERROR("fread error\n", 1, "");
+
+    /* stack of begun functions, never deeper than number of events */
+    stack = (uint32_t*)malloc(sizeof(uint32_t) * (size_t)(count + 1));
+    if(stack == NULL)
+        ERROR("malloc error\n", 1, "");
+
+    for(i = 0; i < count; ++i)
+    {
+        if(fread(&ts, sizeof(uint64_t), 1, f) != 1 || fread(&id, sizeof(uint32_t), 1, f) != 1
+            || fread(&type, sizeof(uint32_t), 1, f) != 1 || id >= names->num)
+        {
+            FREE(stack);
+            ERROR("corrupted trace\n", 1, "");
+        }
+
+        last = ts;
+
+        if(type == TRACE_EVENT_BEGIN)
+            stack[depth++] = id;
+        else
+        {
+            /* begin was overwritten in ring */
+            if(depth == 0)
+                continue;
+
+            --depth;
+        }
+
+        event_write(out, names->names[id], type, ts, tid, first);
+    }
+
+    while(depth > 0)
+        event_write(out, names->names[stack[--depth]], TRACE_EVENT_END, last, tid, first);
+
+    FREE(stack);
+
+    return 0;
+}
+
+void usage()
+{
+    printf( "Decoder of trace events\n\n"
+            "ARGS:\n"
+            "OPTIONAL:\n"
+            "--input[-i]\t\ttrace file ( default %s )\n"
+            "--output[-o]\t\tChrome trace JSON ( default stdout )\n\n"
+            "Examples:\n"
+            "make compiler_trace\n"
+            "FLATT_TRACE=my_code.trace ./compiler_trace.out --input my_code --output my_code.asm\n"
+            "./trace_decode.out --input my_code.trace --output my_code.json\n\n",
+            TRACE_FILE_DEFAULT);
+
+    exit(0);
+}
+
+int main(int argc, char **argv)
+{
+	static struct option long_option[] =
+	{
+        {"input",   required_argument,  0,  'i'},
+        {"output",  required_argument,  0,  'o'},
+        {"help",    no_argument,        0,  'h'},
+		{NULL,		0,				    0,	'\0'}
+
+    };
+
+    const char *input = TRACE_FILE_DEFAULT;
+    const char *output = NULL;
+    char magic[sizeof(TRACE_MAGIC)];
+    Trace_names names;
+    uint64_t rings;
+    uint64_t i;
+    BOOL first = TRUE;
+    FILE *f;
+    FILE *out = stdout;
+    int opt;
+    int ret = 0;
+
+    while ((opt = getopt_long_only(argc, argv, "i:o:h", long_option, NULL )) != -1)
+    {
+        switch(opt)
+        {
+            case 'i':
+            {
+                input = argv[optind - 1];
+                break;
+            }
+            case 'o':
+            {
+                output = argv[optind - 1];
+                break;
+            }
+            default:
+            {
+                usage();
+            }
+        }
+    }
+
+    f = fopen(input, "r");
+    if(f == NULL)
+    {
+        fprintf(stderr, "%sERROR: %s No such file%s\n", RED, input, RESET);
+        return 1;
+    }
+
+    if(fread(magic, sizeof(char), strlen(TRACE_MAGIC), f) != strlen(TRACE_MAGIC)
+        || memcmp(magic, TRACE_MAGIC, strlen(TRACE_MAGIC)) != 0)
+    {
+        fprintf(stderr, "%sERROR: %s is not trace file%s\n", RED, input, RESET);
+        fclose(f);
+        return 1;
+    }
+
+    names.names = NULL;
+    names.num = 0;
+
+    if(names_read(f, &names) || fread(&rings, sizeof(uint64_t), 1, f) != 1)
+    {
+        fprintf(stderr, "%sERROR: %s corrupted trace%s\n", RED, input, RESET);
+        ret = 1;
+        goto clean;
+    }
+
+    if(output != NULL)
+    {
+        out = fopen(output, "w");
+        if(out == NULL)
+        {
+            fprintf(stderr, "%sERROR: cannot open %s%s\n", RED, output, RESET);
+            ret = 1;
+            goto clean;
+        }
+    }
+
+    fprintf(out, "{\"traceEvents\":[");
+
+    for(i = 0; i < rings; ++i)
+        if(ring_decode(f, out, &names, &first))
+        {
+            fprintf(stderr, "%sERROR: %s corrupted trace%s\n", RED, input, RESET);
+            ret = 1;
+            break;
+        }
+
+    fprintf(out, "\n],\"displayTimeUnit\":\"ns\"}\n");
+
+    if(out != stdout)
+        fclose(out);
+
+clean:
+    if(names.names != NULL)
+        for(i = 0; i < names.num; ++i)
+            FREE(names.names[i]);
+
+    FREE(names.names);
+    fclose(f);
+
+    return ret;
+}
@@ -0,0 +1,2887 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 0
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+/* First part of user prologue.  */
+#line 1 "/root/repo/src/parser.y"
+
+
+/*
+    Author: Michal Kukowski
+    email: michalkukowski10@gmail.com
+*/
+
+#include <parser_helper.h>
+#include <common.h>
+#include <time_report.h>
+
+#include <pthread.h>
+
+/* definision of lexer function use in bison */
+int yylex(void);
+
+/* set lexer at the begining of new input, buffer is ended by two '\0' */
+int lexer_reset(char *buffer, size_t size);
+
+/* release lexer buffer */
+void lexer_release(void);
+
+/* text of current lexeme */
+extern char *yytext;
+
+/* input code */
+__thread char *source_code = NULL;
+__thread uint64_t source_size = 0;
+
+__thread Darray *code_lines = NULL;
+
+__thread Vector *big_consts = NULL;
+
+/* check use of variables */
+__thread Hashmap *variables;
+
+__thread Vector *tokens;
+
+/*
+    Lexer and parser are not reentrant, one thread parse at once.
+
+    Jobs of --jobs and --server don't get explicit parser context, the rest of compiler
+    state is thread local instead. Scanner of flex keeps lines, yyin and its buffer stack
+    ( YY_CURRENT_BUFFER ) in globals of generated code, bison keeps yylval, yychar and
+    yynerrs in globals too, so they are shared by all threads and can't be made thread
+    local from here. Only this phase is serial, optimizer and code generation of jobs
+    run in parallel.
+    Reentrant scanner ( %option reentrant, lines in yyextra ) with %define api.pure
+    would remove this lock.
+*/
+static pthread_mutex_t parse_mutex = PTHREAD_MUTEX_INITIALIZER;
+static __thread BOOL parse_locked = FALSE;
+
+/* parser built in functions */
+static void yyerror(const char *msg);
+static int yyparse(void);
+
+
+#line 130 "/root/repo/obj/parser.tab.c"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "parser.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_YY_EQ = 3,                      /* YY_EQ  */
+  YYSYMBOL_YY_NE = 4,                      /* YY_NE  */
+  YYSYMBOL_YY_LT = 5,                      /* YY_LT  */
+  YYSYMBOL_YY_GT = 6,                      /* YY_GT  */
+  YYSYMBOL_YY_LE = 7,                      /* YY_LE  */
+  YYSYMBOL_YY_GE = 8,                      /* YY_GE  */
+  YYSYMBOL_YY_ADD = 9,                     /* YY_ADD  */
+  YYSYMBOL_YY_SUB = 10,                    /* YY_SUB  */
+  YYSYMBOL_YY_DIV = 11,                    /* YY_DIV  */
+  YYSYMBOL_YY_MOD = 12,                    /* YY_MOD  */
+  YYSYMBOL_YY_MULT = 13,                   /* YY_MULT  */
+  YYSYMBOL_YY_ASSIGN = 14,                 /* YY_ASSIGN  */
+  YYSYMBOL_YY_VAR = 15,                    /* YY_VAR  */
+  YYSYMBOL_YY_BEGIN = 16,                  /* YY_BEGIN  */
+  YYSYMBOL_YY_END = 17,                    /* YY_END  */
+  YYSYMBOL_YY_READ = 18,                   /* YY_READ  */
+  YYSYMBOL_YY_WRITE = 19,                  /* YY_WRITE  */
+  YYSYMBOL_YY_SKIP = 20,                   /* YY_SKIP  */
+  YYSYMBOL_YY_FOR = 21,                    /* YY_FOR  */
+  YYSYMBOL_YY_FROM = 22,                   /* YY_FROM  */
+  YYSYMBOL_YY_TO = 23,                     /* YY_TO  */
+  YYSYMBOL_YY_DOWNTO = 24,                 /* YY_DOWNTO  */
+  YYSYMBOL_YY_ENDFOR = 25,                 /* YY_ENDFOR  */
+  YYSYMBOL_YY_WHILE = 26,                  /* YY_WHILE  */
+  YYSYMBOL_YY_DO = 27,                     /* YY_DO  */
+  YYSYMBOL_YY_ENDWHILE = 28,               /* YY_ENDWHILE  */
+  YYSYMBOL_YY_IF = 29,                     /* YY_IF  */
+  YYSYMBOL_YY_THEN = 30,                   /* YY_THEN  */
+  YYSYMBOL_YY_ELSE = 31,                   /* YY_ELSE  */
+  YYSYMBOL_YY_ENDIF = 32,                  /* YY_ENDIF  */
+  YYSYMBOL_YY_VARIABLE = 33,               /* YY_VARIABLE  */
+  YYSYMBOL_YY_NUM = 34,                    /* YY_NUM  */
+  YYSYMBOL_YY_L_BRACKET = 35,              /* YY_L_BRACKET  */
+  YYSYMBOL_YY_R_BRACKET = 36,              /* YY_R_BRACKET  */
+  YYSYMBOL_YY_ERROR = 37,                  /* YY_ERROR  */
+  YYSYMBOL_YY_SEMICOLON = 38,              /* YY_SEMICOLON  */
+  YYSYMBOL_YYACCEPT = 39,                  /* $accept  */
+  YYSYMBOL_program = 40,                   /* program  */
+  YYSYMBOL_vdeclar = 41,                   /* vdeclar  */
+  YYSYMBOL_commands = 42,                  /* commands  */
+  YYSYMBOL_command = 43,                   /* command  */
+  YYSYMBOL_fordeclar = 44,                 /* fordeclar  */
+  YYSYMBOL_expr = 45,                      /* expr  */
+  YYSYMBOL_cond = 46,                      /* cond  */
+  YYSYMBOL_value = 47,                     /* value  */
+  YYSYMBOL_identifier = 48                 /* identifier  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_USE_ALLOCA
+#  if YYSTACK_USE_ALLOCA
+#   ifdef __GNUC__
+#    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
+#   else
+#    define YYSTACK_ALLOC alloca
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
+#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
+#    endif
+#   endif
+#  endif
+# endif
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* !defined yyoverflow */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
+      + YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  4
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   167
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  39
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  10
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  34
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  83
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   293
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
+{
+       0,   117,   117,   118,   143,   147,   158,   189,   200,   238,
+     352,   461,   541,   615,   661,   713,   755,   842,   935,   957,
+     985,  1014,  1043,  1072,  1109,  1139,  1170,  1202,  1234,  1265,
+    1305,  1335,  1357,  1384,  1437
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "YY_EQ", "YY_NE",
+  "YY_LT", "YY_GT", "YY_LE", "YY_GE", "YY_ADD", "YY_SUB", "YY_DIV",
+  "YY_MOD", "YY_MULT", "YY_ASSIGN", "YY_VAR", "YY_BEGIN", "YY_END",
+  "YY_READ", "YY_WRITE", "YY_SKIP", "YY_FOR", "YY_FROM", "YY_TO",
+  "YY_DOWNTO", "YY_ENDFOR", "YY_WHILE", "YY_DO", "YY_ENDWHILE", "YY_IF",
+  "YY_THEN", "YY_ELSE", "YY_ENDIF", "YY_VARIABLE", "YY_NUM",
+  "YY_L_BRACKET", "YY_R_BRACKET", "YY_ERROR", "YY_SEMICOLON", "$accept",
+  "program", "vdeclar", "commands", "command", "fordeclar", "expr", "cond",
+  "value", "identifier", YY_NULLPTR
+};
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-30)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-1)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+       4,   -30,    10,   -15,   -30,   134,   -12,    -9,   -29,    -8,
+      -4,   -29,   -29,    -7,    70,   -30,   134,    19,    -3,    -1,
+     -30,     0,   -30,   -30,    13,    23,     9,     6,   -26,   -30,
+     -30,    44,   -29,    15,   -30,   -30,   -29,   134,   -29,   -29,
+     -29,   -29,   -29,   -29,   134,    16,    31,   -30,     2,    33,
+     -30,    -2,    86,   -30,   -30,   -30,   -30,   -30,   -30,   102,
+     -30,   -30,   -30,   -29,   -29,   -29,   -29,   -29,   -29,   -29,
+     -30,   134,   -30,   -30,   -30,   -30,   -30,    45,    48,   118,
+     -30,   -30,   -30
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
+{
+       2,     4,     0,     0,     1,     0,     5,     0,     0,     0,
+       0,     0,     0,    32,     0,     7,     0,     0,     0,     0,
+      30,     0,    31,    15,     0,     0,     0,     0,     0,     3,
+       8,     0,     0,     0,    13,    14,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,    12,     0,    18,
+       6,     0,     0,    24,    25,    26,    27,    28,    29,     0,
+      33,    34,     9,     0,     0,     0,     0,     0,     0,     0,
+      11,     0,    19,    20,    22,    23,    21,     0,     0,     0,
+      16,    17,    10
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int8 yypgoto[] =
+{
+     -30,   -30,   -30,   -10,   -11,   -30,   -30,    59,    17,    -5
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int8 yydefgoto[] =
+{
+       0,     2,     3,    14,    15,    16,    48,    25,    26,    22
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int8 yytable[] =
+{
+      17,     5,    19,    30,    13,    20,    31,    45,    46,    17,
+       4,    17,    38,    39,    40,    41,    42,    43,     6,     1,
+      30,    68,    69,    18,    13,    21,    17,    52,    28,    24,
+      23,    33,    17,    32,    59,    36,    44,    34,    35,    17,
+      62,    30,    63,    64,    65,    66,    67,    17,    30,    49,
+      37,    50,    60,    51,    17,    53,    54,    55,    56,    57,
+      58,    79,     7,     8,     9,    10,    17,    61,    30,    47,
+      11,    27,    80,    12,    17,    81,     0,    13,     0,     0,
+      72,    73,    74,    75,    76,    77,    78,    29,     7,     8,
+       9,    10,     0,     0,     0,     0,    11,     0,     0,    12,
+       0,     0,     0,    13,     7,     8,     9,    10,     0,     0,
+       0,     0,    11,     0,    70,    12,     0,     0,     0,    13,
+       7,     8,     9,    10,     0,     0,     0,     0,    11,     0,
+       0,    12,     0,    71,     0,    13,     7,     8,     9,    10,
+       0,     0,     0,     0,    11,     0,     0,    12,     0,     0,
+      82,    13,     7,     8,     9,    10,     0,     0,     0,     0,
+      11,     0,     0,    12,     0,     0,     0,    13
+};
+
+static const yytype_int8 yycheck[] =
+{
+       5,    16,     7,    14,    33,    34,    16,    33,    34,    14,
+       0,    16,     3,     4,     5,     6,     7,     8,    33,    15,
+      31,    23,    24,    35,    33,     8,    31,    37,    35,    33,
+      38,    34,    37,    14,    44,    22,    30,    38,    38,    44,
+      38,    52,     9,    10,    11,    12,    13,    52,    59,    32,
+      27,    36,    36,    36,    59,    38,    39,    40,    41,    42,
+      43,    71,    18,    19,    20,    21,    71,    36,    79,    25,
+      26,    12,    27,    29,    79,    27,    -1,    33,    -1,    -1,
+      63,    64,    65,    66,    67,    68,    69,    17,    18,    19,
+      20,    21,    -1,    -1,    -1,    -1,    26,    -1,    -1,    29,
+      -1,    -1,    -1,    33,    18,    19,    20,    21,    -1,    -1,
+      -1,    -1,    26,    -1,    28,    29,    -1,    -1,    -1,    33,
+      18,    19,    20,    21,    -1,    -1,    -1,    -1,    26,    -1,
+      -1,    29,    -1,    31,    -1,    33,    18,    19,    20,    21,
+      -1,    -1,    -1,    -1,    26,    -1,    -1,    29,    -1,    -1,
+      32,    33,    18,    19,    20,    21,    -1,    -1,    -1,    -1,
+      26,    -1,    -1,    29,    -1,    -1,    -1,    33
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
+{
+       0,    15,    40,    41,     0,    16,    33,    18,    19,    20,
+      21,    26,    29,    33,    42,    43,    44,    48,    35,    48,
+      34,    47,    48,    38,    33,    46,    47,    46,    35,    17,
+      43,    42,    14,    34,    38,    38,    22,    27,     3,     4,
+       5,     6,     7,     8,    30,    33,    34,    25,    45,    47,
+      36,    47,    42,    47,    47,    47,    47,    47,    47,    42,
+      36,    36,    38,     9,    10,    11,    12,    13,    23,    24,
+      28,    31,    47,    47,    47,    47,    47,    47,    47,    42,
+      27,    27,    32
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    39,    40,    40,    41,    41,    41,    42,    42,    43,
+      43,    43,    43,    43,    43,    43,    44,    44,    45,    45,
+      45,    45,    45,    45,    46,    46,    46,    46,    46,    46,
+      47,    47,    48,    48,    48
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     0,     5,     0,     2,     5,     1,     2,     4,
+       7,     5,     3,     3,     3,     2,     7,     7,     1,     3,
+       3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
+       1,     1,     1,     4,     4
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  yy_symbol_value_print (yyo, yykind, yyvaluep);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)]);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+
+
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
+{
+  YY_USE (yyvaluep);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/* Lookahead token kind.  */
+int yychar;
+
+/* The semantic value of the lookahead symbol.  */
+YYSTYPE yylval;
+/* Number of syntax errors so far.  */
+int yynerrs;
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (void)
+{
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+
+
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex ();
+    }
+
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 3: /* program: YY_VAR vdeclar YY_BEGIN commands YY_END  */
+#line 119 "/root/repo/src/parser.y"
+    {
+        YY_LOG("[YACC]\tYY_VAR vdeclar YY_BEGIN commands YY_END\n","");
+
+        FREE((yyvsp[-4].ptoken).str);
+        FREE((yyvsp[-2].ptoken).str);
+        FREE((yyvsp[0].ptoken).str);
+
+        /* we read program code so assign pointer to token list */
+        tokens = (yyvsp[-1].list);
+
+        /* hidden variables of big literals are set before first command */
+        if(big_consts_insert(tokens))
+            ERROR("big_consts_insert error\n", 1, "");
+    }
+#line 1240 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 5: /* vdeclar: vdeclar YY_VARIABLE  */
+#line 148 "/root/repo/src/parser.y"
+    {
+        YY_LOG("[YACC]\tvdeclar\tYY_VARIABLE:\t%s\n", (yyvsp[0].ptoken).str);
+        declare(PTOKEN_VAR, &(yyvsp[0].ptoken), 0ull);
+
+        FREE((yyvsp[0].ptoken).str);
+    }
+#line 1251 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 6: /* vdeclar: vdeclar YY_VARIABLE YY_L_BRACKET YY_NUM YY_R_BRACKET  */
+#line 159 "/root/repo/src/parser.y"
+    {
+        YY_LOG("[YACC]\tdeclar\tYY_ARRAY:\t%s[ %s ]\n", (yyvsp[-3].ptoken).str, (yyvsp[-1].ptoken).str);
+
+        /* array is indexed by 64 bits offsets */
+        if((yyvsp[-1].ptoken).big)
+        {
+            print_err((yyvsp[-3].ptoken).line - 1, (yyvsp[0].ptoken).line - 1, "array is too big:\t%s[ %s ]\n", (yyvsp[-3].ptoken).str, (yyvsp[-1].ptoken).str);
+            compiler_exit(1);
+        }
+
+        declare(PTOKEN_ARR, &(yyvsp[-3].ptoken), (yyvsp[-1].ptoken).val);
+
+        FREE((yyvsp[-3].ptoken).str);
+        FREE((yyvsp[-2].ptoken).str);
+        FREE((yyvsp[-1].ptoken).str);
+        FREE((yyvsp[0].ptoken).str);
+    }
+#line 1273 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 7: /* commands: command  */
+#line 190 "/root/repo/src/parser.y"
+    {
+        YY_LOG("[YACC]\tcommand\n", "");
+
+        /* last recursive step, no alloc, just copy pointers */
+        (yyval.list) = (yyvsp[0].list);
+    }
+#line 1284 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 8: /* commands: commands command  */
+#line 201 "/root/repo/src/parser.y"
+    {
+        /* cmds here is only needed for recursive calls, add only cmd tokens */
+        YY_LOG("[YACC]\tcommands command\n", "");
+
+        Token *token;
+        Vector_iterator it;
+
+        /* we alloc list in last recursive step, so just add to list */
+
+        for( vector_iterator_init((yyvsp[0].list), &it, ITI_BEGIN);\
+            ! vector_iterator_end(&it); \
+            vector_iterator_next(&it))
+        {
+
+            vector_iterator_get_data(&it, (void*)&token);
+
+            if(vector_insert_last((yyval.list), (void*)&token))
+                ERROR("vector_insert_first error\n", 1, "");
+        }
+
+
+        /* we add here every token so now can destroy not needed list */
+        vector_destroy((yyvsp[0].list));
+    }
+#line 1313 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 9: /* command: identifier YY_ASSIGN expr YY_SEMICOLON  */
+#line 239 "/root/repo/src/parser.y"
+    {
+
+#ifdef YY_DEBUG_MODE
+        char *str1;
+        char *str2;
+        char *str3;
+#endif
+        Pvalue wrapper1;
+        Pvalue wrapper2;
+
+        token_assign *tass;
+        Token *token;
+
+        /* 1st case: ID := VAL */
+        if((yyvsp[-1].expr).expr->op == tokens_id.undefined)
+        {
+
+#ifdef YY_DEBUG_MODE
+            str1 = pval_str(&(yyvsp[-3].val));
+            str2 = value_str((yyvsp[-1].expr).expr->left);
+
+            YY_LOG("[YACC]\t%s := %s\n", str1, str2);
+#endif
+            /* check use correctnes */
+            pval_check_use(&(yyvsp[-3].val), (yyvsp[-3].val).line - 1, (yyvsp[0].ptoken).line - 1);
+
+            wrapper1.val = (yyvsp[-1].expr).expr->left;
+            pval_check_use(&wrapper1, (yyvsp[-3].val).line - 1, (yyvsp[0].ptoken).line - 1);
+
+            if(wrapper1.val->type == VARIABLE)
+            {
+                pval_check_init(&wrapper1, (yyvsp[-3].val).line - 1, (yyvsp[0].ptoken).line - 1);
+                use(variable_get_name(wrapper1.val->body.var));
+            }
+
+            set(variable_get_name((yyvsp[-3].val).val->body.var));
+
+#ifdef YY_DEBUG_MODE
+            FREE(str1);
+            FREE(str2);
+#endif
+        }
+        /* 2nd case: ID := VAL OP VAL */
+        else
+        {
+
+#ifdef YY_DEBUG_MODE
+            str1 = pval_str(&(yyvsp[-3].val));
+            str2 = value_str((yyvsp[-1].expr).expr->left);
+            str3 = value_str((yyvsp[-1].expr).expr->right);
+
+            YY_LOG("[YACC]\t%s := %s %s %s\n", str1, str2,
+                        op_get_str((yyvsp[-1].expr).expr->op), str3);
+#endif
+
+            /* check use correctnes */
+            pval_check_use(&(yyvsp[-3].val), (yyvsp[-3].val).line - 1, (yyvsp[0].ptoken).line - 1);
+
+            wrapper1.val = (yyvsp[-1].expr).expr->left;
+            pval_check_use(&wrapper1, (yyvsp[-3].val).line - 1, (yyvsp[0].ptoken).line - 1);
+
+            if(wrapper1.val->type == VARIABLE)
+            {
+                pval_check_init(&wrapper1, (yyvsp[-3].val).line - 1, (yyvsp[0].ptoken).line - 1);
+                use(variable_get_name(wrapper1.val->body.var));
+            }
+
+            wrapper2.val = (yyvsp[-1].expr).expr->right;
+            pval_check_use(&wrapper2, (yyvsp[-3].val).line - 1, (yyvsp[0].ptoken).line - 1);
+
+            if(wrapper2.val->type == VARIABLE)
+            {
+                pval_check_init(&wrapper2, (yyvsp[-3].val).line - 1, (yyvsp[0].ptoken).line - 1);
+                use(variable_get_name(wrapper2.val->body.var));
+            }
+
+            set(variable_get_name((yyvsp[-3].val).val->body.var));
+
+#ifdef YY_DEBUG_MODE
+            FREE(str1);
+            FREE(str2);
+            FREE(str3);
+#endif
+        }
+
+        tass = token_assign_create((yyvsp[-3].val).val, (yyvsp[-1].expr).expr);
+        if(tass == NULL)
+            ERROR("token_assign_create error\n", 1, "");
+
+        token = token_create(TOKEN_ASSIGN, (void*)tass);
+        if(token == NULL)
+            ERROR("token_create error\n", 1, "");
+
+        token_set_lines(token, (yyvsp[-3].val).line, (yyvsp[0].ptoken).line);
+
+        check_use_it((yyvsp[-3].val).val, token, (yyvsp[-3].val).line - 1, (yyvsp[0].ptoken).line - 1);
+
+        /* create new list */
+        (yyval.list) = vector_create(sizeof(Token*));
+        if((yyval.list) == NULL)
+            ERROR("vector_create error\n", 1, "");
+
+        /* ADD token to list */
+        if( vector_insert_last((yyval.list), (void*)&token))
+            ERROR("vector_insert_last error\n", 1, "");
+
+        FREE((yyvsp[0].ptoken).str);
+        FREE((yyvsp[-2].ptoken).str);
+    }
+#line 1427 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 10: /* command: YY_IF cond YY_THEN commands YY_ELSE commands YY_ENDIF  */
+#line 353 "/root/repo/src/parser.y"
+    {
+
+#ifdef YY_DEBUG_MODE
+            char *str1 = value_str((yyvsp[-5].cond).cond->left);
+            char *str2 = value_str((yyvsp[-5].cond).cond->right);
+#endif
+            token_if *tiff;
+            token_guard *telsee;
+            token_guard *endiff;
+
+            Token *token1;
+            Token *token2;
+            Token *token3;
+
+            Vector_iterator it;
+            Token *token;
+
+#ifdef YY_DEBUG_MODE
+            YY_LOG("[YACC]\tIF %s %s %s\n", str1, rel_get_str((yyvsp[-5].cond).cond->r) ,str2);
+#endif
+            tiff = token_if_create((yyvsp[-5].cond).cond);
+            if(tiff == NULL)
+                ERROR("token_if_create error\n", 1, "");
+
+            token1 = token_create(TOKEN_IF, (void*)tiff);
+            if(token1 == NULL)
+                ERROR("token_create error\n", 1, "");
+
+            token_set_lines(token1, (yyvsp[-6].ptoken).line, (yyvsp[-4].ptoken).line);
+
+            telsee = token_guard_create(tokens_id.else_cond);
+            if(telsee == NULL)
+                ERROR("token_guard_create error\n", 1, "");
+
+            token2 = token_create(TOKEN_GUARD, (void*)telsee);
+            if(token2 == NULL)
+                ERROR("token_create error\n", 1, "");
+
+            token_set_lines(token2, (yyvsp[-2].ptoken).line, (yyvsp[-2].ptoken).line);
+
+            endiff = token_guard_create(tokens_id.end_if);
+            if(endiff == NULL)
+                ERROR("token_guard_create error\n", 1, "");
+
+            token3 = token_create(TOKEN_GUARD, (void*)endiff);
+            if(token3 == NULL)
+                ERROR("token_create error\n", 1, "");
+
+            token_set_lines(token3, (yyvsp[0].ptoken).line, (yyvsp[0].ptoken).line);
+
+            /* create new list */
+            (yyval.list) = vector_create(sizeof(Token*));
+            if((yyval.list) == NULL)
+                ERROR("vector_create error\n", 1, "");
+
+            /* ADD IF token to list */
+            if( vector_insert_last((yyval.list), (void*)&token1))
+                ERROR("vector_insert_last error\n", 1, "");
+
+            /* add if statement */
+            for( vector_iterator_init((yyvsp[-3].list), &it, ITI_BEGIN);\
+                ! vector_iterator_end(&it); \
+                vector_iterator_next(&it))
+            {
+
+                vector_iterator_get_data(&it, (void*)&token);
+
+                if(vector_insert_last((yyval.list), (void*)&token))
+                    ERROR("vector_insert_first error\n", 1, "");
+            }
+
+            /* ADD ELSE token to list */
+            if( vector_insert_last((yyval.list), (void*)&token2))
+                ERROR("vector_insert_last error\n", 1, "");
+
+            /* add ELSE statement */
+            for( vector_iterator_init((yyvsp[-1].list), &it, ITI_BEGIN);\
+                ! vector_iterator_end(&it); \
+                vector_iterator_next(&it))
+            {
+
+                vector_iterator_get_data(&it, (void*)&token);
+
+                if(vector_insert_last((yyval.list), (void*)&token))
+                    ERROR("vector_insert_first error\n", 1, "");
+            }
+
+            /* ADD ENDIF token to list */
+            if( vector_insert_last((yyval.list), (void*)&token3))
+                ERROR("vector_insert_last error\n", 1, "");
+
+#ifdef YY_DEBUG_MODE
+            FREE(str1);
+            FREE(str2);
+#endif
+            FREE((yyvsp[-6].ptoken).str);
+            FREE((yyvsp[-4].ptoken).str);
+            FREE((yyvsp[-2].ptoken).str);
+            FREE((yyvsp[0].ptoken).str);
+
+            /* we copy every tokens from cmd1 and cmd2 so destroy lists*/
+            vector_destroy((yyvsp[-3].list));
+            vector_destroy((yyvsp[-1].list));
+    }
+#line 1536 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 11: /* command: YY_WHILE cond YY_DO commands YY_ENDWHILE  */
+#line 462 "/root/repo/src/parser.y"
+    {
+
+#ifdef YY_DEBUG_MODE
+        char *str1 = value_str((yyvsp[-3].cond).cond->left);
+        char *str2 = value_str((yyvsp[-3].cond).cond->right);
+#endif
+        token_while *twhilee;
+        token_guard *endwhile;
+
+        Token *token1;
+        Token *token2;
+
+        Vector_iterator it;
+        Token *token;
+
+#ifdef YY_DEBUG_MODE
+        YY_LOG("[YACC]\tWHILE %s %s %s\n", str1, rel_get_str((yyvsp[-3].cond).cond->r) ,str2);
+#endif
+        twhilee = token_while_create((yyvsp[-3].cond).cond);
+        if(twhilee == NULL)
+            ERROR("token_while_create error\n", 1, "");
+
+        token1 = token_create(TOKEN_WHILE, (void*)twhilee);
+        if(token1 == NULL)
+            ERROR("token_create error\n", 1, "");
+
+        token_set_lines(token1, (yyvsp[-4].ptoken).line, (yyvsp[-2].ptoken).line);
+
+        endwhile = token_guard_create(tokens_id.end_while);
+        if(endwhile == NULL)
+            ERROR("token_guard_create error\n", 1, "");
+
+        token2 = token_create(TOKEN_GUARD, (void*)endwhile);
+        if(token2 == NULL)
+            ERROR("token_create error\n", 1, "");
+
+        token_set_lines(token2, (yyvsp[0].ptoken).line, (yyvsp[0].ptoken).line);
+
+
+        /* create new list */
+        (yyval.list) = vector_create(sizeof(Token*));
+        if((yyval.list) == NULL)
+            ERROR("vector_create error\n", 1, "");
+
+        /* ADD WHILE token to list */
+        if( vector_insert_last((yyval.list), (void*)&token1))
+            ERROR("vector_insert_last error\n", 1, "");
+
+        /* add while statement */
+        for( vector_iterator_init((yyvsp[-1].list), &it, ITI_BEGIN);\
+            ! vector_iterator_end(&it); \
+            vector_iterator_next(&it))
+        {
+
+            vector_iterator_get_data(&it, (void*)&token);
+
+            if(vector_insert_last((yyval.list), (void*)&token))
+                ERROR("vector_insert_first error\n", 1, "");
+        }
+
+        /* ADD ENDWHILE token to list */
+        if( vector_insert_last((yyval.list), (void*)&token2))
+            ERROR("vector_insert_last error\n", 1, "");
+
+#ifdef YY_DEBUG_MODE
+        FREE(str1);
+        FREE(str2);
+#endif
+        FREE((yyvsp[-4].ptoken).str);
+        FREE((yyvsp[-2].ptoken).str);
+        FREE((yyvsp[0].ptoken).str);
+
+        /* we copy every tokens from cmd so destroy list */
+        vector_destroy((yyvsp[-1].list));
+    }
+#line 1616 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 12: /* command: fordeclar commands YY_ENDFOR  */
+#line 542 "/root/repo/src/parser.y"
+    {
+#ifdef YY_DEBUG_MODE
+        char *str1 = value_str((yyvsp[-2].token)->body.for_loop->iterator);
+        char *str2 = value_str((yyvsp[-2].token)->body.for_loop->begin_value);
+        char *str3 = value_str((yyvsp[-2].token)->body.for_loop->end_value);
+#endif
+
+#ifdef YY_DEBUG_MODE
+        if((yyvsp[-2].token)->body.for_loop->type == tokens_id.for_inc)
+            YY_LOG("[YACC]\tFOR LOOP FOR %s FROM %s TO %s\n", str1, str2, str3);
+        else
+            YY_LOG("[YACC]\tFOR LOOP FOR %s FROM %s DOWNTO %s\n", str1, str2, str3);
+#endif
+
+        token_guard *endforr;
+        Token *token1;
+
+        Vector_iterator it;
+        Token *token;
+
+        endforr = token_guard_create(tokens_id.end_for);
+        if(endforr == NULL)
+            ERROR("token_guard error\n", 1, "");
+
+        token1 = token_create(TOKEN_GUARD, (void*)endforr);
+        if(token1 == NULL)
+            ERROR("token_create error\n", 1, "");
+
+        token_set_lines(token1, (yyvsp[0].ptoken).line, (yyvsp[0].ptoken).line);
+
+        /* create new list */
+        (yyval.list) = vector_create(sizeof(Token*));
+        if((yyval.list) == NULL)
+            ERROR("vector_create error\n", 1, "");
+
+        /* ADD FOR token to list */
+        if( vector_insert_last((yyval.list), (void*)&(yyvsp[-2].token)))
+            ERROR("vector_insert_last error\n", 1, "");
+
+        /* add FOR statement */
+        for( vector_iterator_init((yyvsp[-1].list), &it, ITI_BEGIN);\
+            ! vector_iterator_end(&it); \
+            vector_iterator_next(&it))
+        {
+
+            vector_iterator_get_data(&it, (void*)&token);
+
+            if(vector_insert_last((yyval.list), (void*)&token))
+                ERROR("vector_insert_first error\n", 1, "");
+        }
+
+        /* ADD ENDFOR token to list */
+        if( vector_insert_last((yyval.list), (void*)&token1))
+            ERROR("vector_insert_last error\n", 1, "");
+
+#ifdef YY_DEBUG_MODE
+        FREE(str1);
+        FREE(str2);
+        FREE(str3);
+#endif
+
+        /* end loop, so undeclare iterator */
+        undeclare(variable_get_name((yyvsp[-2].token)->body.for_loop->iterator->body.var));
+
+        FREE((yyvsp[0].ptoken).str);
+
+        /* we copy every tokens from cmd so destroy list */
+        vector_destroy((yyvsp[-1].list));
+    }
+#line 1690 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 13: /* command: YY_READ identifier YY_SEMICOLON  */
+#line 616 "/root/repo/src/parser.y"
+    {
+        Token *token;
+        token_io *io;
+
+#ifdef YY_DEBUG_MODE
+        YY_LOG("[YACC]\tREAD %s ;\n", variable_get_name((yyvsp[-1].val).val->body.var));
+#endif
+
+        /* check use correctnes */
+        pval_check_use(&(yyvsp[-1].val), (yyvsp[-2].ptoken).line - 1, (yyvsp[0].ptoken).line - 1);
+
+        io = token_io_create(tokens_id.read, (yyvsp[-1].val).val);
+        if(io == NULL)
+            ERROR("token_io_create error\n", 1 ,"");
+
+        token = token_create(TOKEN_IO, (void*)io);
+        if(token == NULL)
+            ERROR("token_create error\n", 1 ,"");
+
+        token_set_lines(token, (yyvsp[-2].ptoken).line, (yyvsp[0].ptoken).line);
+
+        check_use_it((yyvsp[-1].val).val, token,  (yyvsp[-2].ptoken).line - 1, (yyvsp[0].ptoken).line - 1);
+
+        /* read from stdin so we init value */
+        set(variable_get_name((yyvsp[-1].val).val->body.var));
+
+        /* user want to use this variable */
+        use(variable_get_name((yyvsp[-1].val).val->body.var));
+
+        /* create new list */
+        (yyval.list) = vector_create(sizeof(Token*));
+        if((yyval.list) == NULL)
+            ERROR("vector_create error\n", 1, "");
+
+        /* ADD token to list */
+        if( vector_insert_last((yyval.list), (void*)&token))
+            ERROR("vector_insert_last error\n", 1, "");
+
+        FREE((yyvsp[-2].ptoken).str);
+        FREE((yyvsp[0].ptoken).str);
+    }
+#line 1736 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 14: /* command: YY_WRITE value YY_SEMICOLON  */
+#line 662 "/root/repo/src/parser.y"
+    {
+        Token *token;
+        token_io *io;
+
+#ifdef YY_DEBUG_MODE
+        char *str = pval_str(&(yyvsp[-1].val));
+
+        YY_LOG("[YACC]\tWRITE %s ;\n", str);
+#endif
+
+        /* check use correctnes */
+        pval_check_use(&(yyvsp[-1].val), (yyvsp[-2].ptoken).line - 1, (yyvsp[0].ptoken).line - 1);
+
+        /* WRITE required init var */
+        pval_check_init(&(yyvsp[-1].val), (yyvsp[-2].ptoken).line - 1, (yyvsp[0].ptoken).line - 1);
+
+        io = token_io_create(tokens_id.write, (yyvsp[-1].val).val);
+        if(io == NULL)
+            ERROR("token_io_create error\n", 1 ,"");
+
+        token = token_create(TOKEN_IO, (void*)io);
+        if(token == NULL)
+            ERROR("token_create error\n", 1 ,"");
+
+        token_set_lines(token, (yyvsp[-2].ptoken).line, (yyvsp[0].ptoken).line);
+
+        /* we use this variable */
+        if((yyvsp[-1].val).val->type == VARIABLE)
+            use(variable_get_name((yyvsp[-1].val).val->body.var));
+
+        /* create new list */
+        (yyval.list) = vector_create(sizeof(Token*));
+        if((yyval.list) == NULL)
+            ERROR("vector_create error\n", 1, "");
+
+        /* ADD token to list */
+        if( vector_insert_last((yyval.list), (void*)&token))
+            ERROR("vector_insert_last error\n", 1, "");
+
+        FREE((yyvsp[-2].ptoken).str);
+        FREE((yyvsp[0].ptoken).str);
+
+#ifdef YY_DEBUG_MODE
+        FREE(str);
+#endif
+
+    }
+#line 1788 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 15: /* command: YY_SKIP YY_SEMICOLON  */
+#line 714 "/root/repo/src/parser.y"
+    {
+        Token *token;
+        token_guard *guard;
+
+        YY_LOG("[YACC]\tSKIP ;\n", "");
+
+        guard = token_guard_create(tokens_id.skip);
+        if(guard == NULL)
+            ERROR("token_guard_create error\n", 1, "");
+
+        token = token_create(TOKEN_GUARD, (void*)guard);
+        if(token == NULL)
+            ERROR("token_create error\n", 1, "");
+
+        token_set_lines(token, (yyvsp[-1].ptoken).line, (yyvsp[0].ptoken).line);
+
+        /* create new list */
+        (yyval.list) = vector_create(sizeof(Token*));
+        if((yyval.list) == NULL)
+            ERROR("vector_create error\n", 1, "");
+
+        /* ADD token to list */
+        if( vector_insert_last((yyval.list), (void*)&token))
+            ERROR("vector_insert_last error\n", 1, "");
+
+        FREE((yyvsp[-1].ptoken).str);
+        FREE((yyvsp[0].ptoken).str);
+    }
+#line 1821 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 16: /* fordeclar: YY_FOR YY_VARIABLE YY_FROM value YY_TO value YY_DO  */
+#line 756 "/root/repo/src/parser.y"
+     {
+
+#ifdef YY_DEBUG_MODE
+        char *str1 = value_str((yyvsp[-3].val).val);
+        char *str2 = value_str((yyvsp[-1].val).val);
+#endif
+        Variable *variable;
+        var_normal *vn;
+        Value *iterator;
+
+        token_for *tforr;
+
+        Token *token;
+
+#ifdef YY_DEBUG_MODE
+        YY_LOG("[YACC]\tFOR %s FROM %s TO %s\n", (yyvsp[-5].ptoken).str, str1, str2);
+#endif
+
+        /* check prev declaration */
+        if(is_declared((yyvsp[-5].ptoken).str))
+        {
+            print_err((yyvsp[-6].ptoken).line - 1, (yyvsp[0].ptoken).line - 1, "iterator is redeclared:\t%s\n",(yyvsp[-5].ptoken).str);
+
+            compiler_exit(1);
+        }
+
+        /* declared and create iterator*/
+        declare(PTOKEN_IT, &(yyvsp[-5].ptoken), 0);
+
+        vn = var_normal_create((yyvsp[-5].ptoken).str);
+        if(vn == NULL)
+            ERROR("var_normal error\n", 1, "");
+
+        variable = variable_create(VAR_NORMAL, (void*)vn);
+        if(variable == NULL)
+            ERROR("variable_create error\n", 1, "");
+
+        iterator = value_create(VARIABLE, (void*)variable);
+        if(iterator == NULL)
+            ERROR("value_create error\n", 1, "");
+
+        set((yyvsp[-5].ptoken).str);
+        use((yyvsp[-5].ptoken).str);
+
+        /* check correctnes  */
+        pval_check_use(&(yyvsp[-3].val), (yyvsp[-6].ptoken).line - 1, (yyvsp[0].ptoken).line - 1);
+        pval_check_init(&(yyvsp[-3].val), (yyvsp[-6].ptoken).line - 1, (yyvsp[0].ptoken).line - 1);
+
+        /* we use this variable */
+        if((yyvsp[-3].val).val->type == VARIABLE)
+            use(variable_get_name((yyvsp[-3].val).val->body.var));
+
+        pval_check_use(&(yyvsp[-1].val), (yyvsp[-6].ptoken).line - 1, (yyvsp[0].ptoken).line - 1);
+        pval_check_init(&(yyvsp[-1].val), (yyvsp[-6].ptoken).line - 1, (yyvsp[0].ptoken).line - 1);
+
+        /* we use this variable */
+        if((yyvsp[-1].val).val->type == VARIABLE)
+            use(variable_get_name((yyvsp[-1].val).val->body.var));
+
+        tforr = token_for_create(tokens_id.for_inc, iterator, (yyvsp[-3].val).val, (yyvsp[-1].val).val);
+        if(tforr == NULL)
+            ERROR("token_for_create error\n", 1, "");
+
+        token = token_create(TOKEN_FOR, (void*)tforr);
+        if(token == NULL)
+            ERROR("token_create error\n", 1, "");
+
+        token_set_lines(token, (yyvsp[-6].ptoken).line, (yyvsp[0].ptoken).line);
+
+        (yyval.token) = token;
+
+#ifdef YY_DEBUG_MODE
+        FREE(str1);
+        FREE(str2);
+#endif
+
+        FREE((yyvsp[-6].ptoken).str);
+        FREE((yyvsp[-5].ptoken).str);
+        FREE((yyvsp[-4].ptoken).str);
+        FREE((yyvsp[-2].ptoken).str);
+        FREE((yyvsp[0].ptoken).str);
+    }
+#line 1908 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 17: /* fordeclar: YY_FOR YY_VARIABLE YY_FROM value YY_DOWNTO value YY_DO  */
+#line 843 "/root/repo/src/parser.y"
+    {
+
+#ifdef YY_DEBUG_MODE
+        char *str1 = value_str((yyvsp[-3].val).val);
+        char *str2 = value_str((yyvsp[-1].val).val);
+#endif
+        Variable *variable;
+        var_normal *vn;
+        Value *iterator;
+
+        token_for *tforr;
+
+        Token *token;
+
+#ifdef YY_DEBUG_MODE
+        YY_LOG("[YACC]\tFOR %s FROM %s DOWNTO %s\n", (yyvsp[-5].ptoken).str, str1, str2);
+#endif
+        /* check prev declaration */
+        if(is_declared((yyvsp[-5].ptoken).str))
+        {
+            print_err((yyvsp[-6].ptoken).line - 1, (yyvsp[0].ptoken).line - 1, "iterator is redeclared:\t%s\n",(yyvsp[-5].ptoken).str);
+
+            compiler_exit(1);
+        }
+
+        /* declared and create iterator*/
+        declare(PTOKEN_IT, &(yyvsp[-5].ptoken), 0);
+
+        vn = var_normal_create((yyvsp[-5].ptoken).str);
+        if(vn == NULL)
+            ERROR("var_normal error\n", 1, "");
+
+        variable = variable_create(VAR_NORMAL, (void*)vn);
+        if(variable == NULL)
+            ERROR("variable_create error\n", 1, "");
+
+        iterator = value_create(VARIABLE, (void*)variable);
+        if(iterator == NULL)
+            ERROR("value_create error\n", 1, "");
+
+        set((yyvsp[-5].ptoken).str);
+        use((yyvsp[-5].ptoken).str);
+
+        /* check correctnes  */
+        pval_check_use(&(yyvsp[-3].val), (yyvsp[-6].ptoken).line - 1, (yyvsp[0].ptoken).line - 1);
+        pval_check_init(&(yyvsp[-3].val), (yyvsp[-6].ptoken).line - 1, (yyvsp[0].ptoken).line - 1);
+
+        /* we use this variable */
+        if((yyvsp[-3].val).val->type == VARIABLE)
+            use(variable_get_name((yyvsp[-3].val).val->body.var));
+
+        pval_check_use(&(yyvsp[-1].val), (yyvsp[-6].ptoken).line - 1, (yyvsp[0].ptoken).line - 1);
+        pval_check_init(&(yyvsp[-1].val), (yyvsp[-6].ptoken).line - 1, (yyvsp[0].ptoken).line - 1);
+
+        /* we use this variable */
+        if((yyvsp[-1].val).val->type == VARIABLE)
+            use(variable_get_name((yyvsp[-1].val).val->body.var));
+
+        tforr = token_for_create(tokens_id.for_dec, iterator, (yyvsp[-3].val).val, (yyvsp[-1].val).val);
+        if(tforr == NULL)
+            ERROR("token_for_create error\n", 1, "");
+
+        token = token_create(TOKEN_FOR, (void*)tforr);
+        if(token == NULL)
+            ERROR("token_create error\n", 1, "");
+
+        token_set_lines(token, (yyvsp[-6].ptoken).line, (yyvsp[0].ptoken).line);
+
+        (yyval.token) = token;
+
+#ifdef YY_DEBUG_MODE
+        FREE(str1);
+        FREE(str2);
+#endif
+        FREE((yyvsp[-6].ptoken).str);
+        FREE((yyvsp[-5].ptoken).str);
+        FREE((yyvsp[-4].ptoken).str);
+        FREE((yyvsp[-2].ptoken).str);
+        FREE((yyvsp[0].ptoken).str);
+     }
+#line 1993 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 18: /* expr: value  */
+#line 936 "/root/repo/src/parser.y"
+    {
+
+#ifdef YY_DEBUG_MODE
+        char *str1 = pval_str(&(yyvsp[0].val));
+        YY_LOG("[YACC]\texpr:\t %s\n", str1);
+#endif
+
+        (yyval.expr).expr = token_expr_create(tokens_id.undefined, (yyvsp[0].val).val, NULL);
+        if((yyval.expr).expr == NULL)
+            ERROR("token_expr_create error\n", 1, "");
+
+        (yyval.expr).line = (yyvsp[0].val).line;
+
+#ifdef YY_DEBUG_MODE
+        FREE(str1);
+#endif
+    }
+#line 2015 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 19: /* expr: value YY_ADD value  */
+#line 958 "/root/repo/src/parser.y"
+    {
+
+#ifdef YY_DEBUG_MODE
+        char *str1 = pval_str(&(yyvsp[-2].val));
+        char *str2 = (yyvsp[-1].ptoken).str;
+        char *str3 = pval_str(&(yyvsp[0].val));
+        YY_LOG("[YACC]\texpr:\t %s %s %s\n", str1, str2, str3);
+#endif
+
+        (yyval.expr).expr = token_expr_create(tokens_id.add, (yyvsp[-2].val).val, (yyvsp[0].val).val);
+        if((yyval.expr).expr == NULL)
+            ERROR("token_expr_create error\n", 1, "");
+
+        (yyval.expr).line = (yyvsp[0].val).line;
+
+#ifdef YY_DEBUG_MODE
+        FREE(str1);
+        FREE(str2);
+        FREE(str3);
+#else
+        FREE((yyvsp[-1].ptoken).str);
+#endif
+    }
+#line 2043 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 20: /* expr: value YY_SUB value  */
+#line 986 "/root/repo/src/parser.y"
+    {
+
+#ifdef YY_DEBUG_MODE
+        char *str1 = pval_str(&(yyvsp[-2].val));
+        char *str2 = (yyvsp[-1].ptoken).str;
+        char *str3 = pval_str(&(yyvsp[0].val));
+        YY_LOG("[YACC]\texpr:\t %s %s %s\n", str1, str2, str3);
+#endif
+
+        (yyval.expr).expr = token_expr_create(tokens_id.sub, (yyvsp[-2].val).val, (yyvsp[0].val).val);
+        if((yyval.expr).expr == NULL)
+            ERROR("token_expr_create error\n", 1, "");
+
+        (yyval.expr).line = (yyvsp[0].val).line;
+
+#ifdef YY_DEBUG_MODE
+        FREE(str1);
+        FREE(str2);
+        FREE(str3);
+#else
+        FREE((yyvsp[-1].ptoken).str);
+#endif
+
+    }
+#line 2072 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 21: /* expr: value YY_MULT value  */
+#line 1015 "/root/repo/src/parser.y"
+    {
+
+#ifdef YY_DEBUG_MODE
+        char *str1 = pval_str(&(yyvsp[-2].val));
+        char *str2 = (yyvsp[-1].ptoken).str;
+        char *str3 = pval_str(&(yyvsp[0].val));
+        YY_LOG("[YACC]\texpr:\t %s %s %s\n", str1, str2, str3);
+#endif
+
+        (yyval.expr).expr = token_expr_create(tokens_id.mult, (yyvsp[-2].val).val, (yyvsp[0].val).val);
+        if((yyval.expr).expr == NULL)
+            ERROR("token_expr_create error\n", 1, "");
+
+        (yyval.expr).line = (yyvsp[0].val).line;
+
+#ifdef YY_DEBUG_MODE
+        FREE(str1);
+        FREE(str2);
+        FREE(str3);
+#else
+        FREE((yyvsp[-1].ptoken).str);
+#endif
+
+    }
+#line 2101 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 22: /* expr: value YY_DIV value  */
+#line 1044 "/root/repo/src/parser.y"
+    {
+
+#ifdef YY_DEBUG_MODE
+        char *str1 = pval_str(&(yyvsp[-2].val));
+        char *str2 = (yyvsp[-1].ptoken).str;
+        char *str3 = pval_str(&(yyvsp[0].val));
+        YY_LOG("[YACC]\texpr:\t %s %s %s\n", str1, str2, str3);
+#endif
+
+        (yyval.expr).expr = token_expr_create(tokens_id.div, (yyvsp[-2].val).val, (yyvsp[0].val).val);
+        if((yyval.expr).expr == NULL)
+            ERROR("token_expr_create error\n", 1, "");
+
+        (yyval.expr).line = (yyvsp[0].val).line;
+
+#ifdef YY_DEBUG_MODE
+        FREE(str1);
+        FREE(str2);
+        FREE(str3);
+#else
+        FREE((yyvsp[-1].ptoken).str);
+#endif
+
+    }
+#line 2130 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 23: /* expr: value YY_MOD value  */
+#line 1073 "/root/repo/src/parser.y"
+    {
+
+#ifdef YY_DEBUG_MODE
+        char *str1 = pval_str(&(yyvsp[-2].val));
+        char *str2 = (yyvsp[-1].ptoken).str;
+        char *str3 = pval_str(&(yyvsp[0].val));
+        YY_LOG("[YACC]\texpr:\t %s %s %s\n", str1, str2, str3);
+#endif
+
+        (yyval.expr).expr = token_expr_create(tokens_id.mod, (yyvsp[-2].val).val, (yyvsp[0].val).val);
+        if((yyval.expr).expr == NULL)
+            ERROR("token_expr_create error\n", 1, "");
+
+        (yyval.expr).line = (yyvsp[0].val).line;
+
+#ifdef YY_DEBUG_MODE
+        FREE(str1);
+        FREE(str2);
+        FREE(str3);
+#else
+        FREE((yyvsp[-1].ptoken).str);
+#endif
+    }
+#line 2158 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 24: /* cond: value YY_EQ value  */
+#line 1110 "/root/repo/src/parser.y"
+    {
+
+#ifdef YY_DEBUG_MODE
+        char *str1 = pval_str(&(yyvsp[-2].val));
+        char *str2 = (yyvsp[-1].ptoken).str;
+        char *str3 = pval_str(&(yyvsp[0].val));
+        YY_LOG("[YACC]\tcond:\t %s %s %s\n", str1, str2, str3);
+#endif
+        (yyval.cond).cond = token_cond_create(tokens_id.eq, (yyvsp[-2].val).val, (yyvsp[0].val).val);
+        if((yyval.cond).cond == NULL)
+            ERROR("token_cond_create error\n", 1, "");
+
+        (yyval.cond).line = (yyvsp[0].val).line;
+
+        check_cond(&(yyval.cond));
+        use_cond(&(yyval.cond));
+
+#ifdef YY_DEBUG_MODE
+        FREE(str1);
+        FREE(str2);
+        FREE(str3);
+#else
+        FREE((yyvsp[-1].ptoken).str);
+#endif
+    }
+#line 2188 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 25: /* cond: value YY_NE value  */
+#line 1140 "/root/repo/src/parser.y"
+    {
+
+#ifdef YY_DEBUG_MODE
+        char *str1 = pval_str(&(yyvsp[-2].val));
+        char *str2 = (yyvsp[-1].ptoken).str;
+        char *str3 = pval_str(&(yyvsp[0].val));
+        YY_LOG("[YACC]\tcond:\t %s %s %s\n", str1, str2, str3);
+#endif
+
+        (yyval.cond).cond = token_cond_create(tokens_id.ne, (yyvsp[-2].val).val, (yyvsp[0].val).val);
+        if((yyval.cond).cond == NULL)
+            ERROR("token_cond_create error\n", 1, "");
+
+        (yyval.cond).line = (yyvsp[0].val).line;
+
+        check_cond(&(yyval.cond));
+        use_cond(&(yyval.cond));
+
+#ifdef YY_DEBUG_MODE
+        FREE(str1);
+        FREE(str2);
+        FREE(str3);
+#else
+        FREE((yyvsp[-1].ptoken).str);
+#endif
+    }
+#line 2219 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 26: /* cond: value YY_LT value  */
+#line 1171 "/root/repo/src/parser.y"
+    {
+
+#ifdef YY_DEBUG_MODE
+        char *str1 = pval_str(&(yyvsp[-2].val));
+        char *str2 = (yyvsp[-1].ptoken).str;
+        char *str3 = pval_str(&(yyvsp[0].val));
+        YY_LOG("[YACC]\tcond:\t %s %s %s\n", str1, str2, str3);
+#endif
+
+        (yyval.cond).cond = token_cond_create(tokens_id.lt, (yyvsp[-2].val).val, (yyvsp[0].val).val);
+        if((yyval.cond).cond == NULL)
+            ERROR("token_cond_create error\n", 1, "");
+
+        (yyval.cond).line = (yyvsp[0].val).line;
+
+        check_cond(&(yyval.cond));
+        use_cond(&(yyval.cond));
+
+#ifdef YY_DEBUG_MODE
+        FREE(str1);
+        FREE(str2);
+        FREE(str3);
+#else
+        FREE((yyvsp[-1].ptoken).str);
+#endif
+
+    }
+#line 2251 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 27: /* cond: value YY_GT value  */
+#line 1203 "/root/repo/src/parser.y"
+    {
+
+#ifdef YY_DEBUG_MODE
+        char *str1 = pval_str(&(yyvsp[-2].val));
+        char *str2 = (yyvsp[-1].ptoken).str;
+        char *str3 = pval_str(&(yyvsp[0].val));
+
+        YY_LOG("[YACC]\tcond:\t %s %s %s\n", str1, str2, str3);
+#endif
+
+        (yyval.cond).cond = token_cond_create(tokens_id.gt, (yyvsp[-2].val).val, (yyvsp[0].val).val);
+        if((yyval.cond).cond == NULL)
+            ERROR("token_cond_create error\n", 1, "");
+
+        (yyval.cond).line = (yyvsp[0].val).line;
+
+        check_cond(&(yyval.cond));
+        use_cond(&(yyval.cond));
+
+#ifdef YY_DEBUG_MODE
+        FREE(str1);
+        FREE(str2);
+        FREE(str3);
+#else
+        FREE((yyvsp[-1].ptoken).str);
+#endif
+    }
+#line 2283 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 28: /* cond: value YY_LE value  */
+#line 1235 "/root/repo/src/parser.y"
+    {
+
+#ifdef YY_DEBUG_MODE
+        char *str1 = pval_str(&(yyvsp[-2].val));
+        char *str2 = (yyvsp[-1].ptoken).str;
+        char *str3 = pval_str(&(yyvsp[0].val));
+        YY_LOG("[YACC]\tcond:\t %s %s %s\n", str1, str2, str3);
+#endif
+
+        (yyval.cond).cond = token_cond_create(tokens_id.le, (yyvsp[-2].val).val, (yyvsp[0].val).val);
+        if((yyval.cond).cond == NULL)
+            ERROR("token_cond_create error\n", 1, "");
+
+        (yyval.cond).line = (yyvsp[0].val).line;
+
+        check_cond(&(yyval.cond));
+        use_cond(&(yyval.cond));
+
+#ifdef YY_DEBUG_MODE
+        FREE(str1);
+        FREE(str2);
+        FREE(str3);
+#else
+        FREE((yyvsp[-1].ptoken).str);
+#endif
+    }
+#line 2314 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 29: /* cond: value YY_GE value  */
+#line 1266 "/root/repo/src/parser.y"
+    {
+
+#ifdef YY_DEBUG_MODE
+        char *str1 = pval_str(&(yyvsp[-2].val));
+        char *str2 = (yyvsp[-1].ptoken).str;
+        char *str3 = pval_str(&(yyvsp[0].val));
+        YY_LOG("[YACC]\tcond:\t %s %s %s\n", str1, str2, str3);
+#endif
+
+        (yyval.cond).cond = token_cond_create(tokens_id.ge, (yyvsp[-2].val).val, (yyvsp[0].val).val);
+        if((yyval.cond).cond == NULL)
+            ERROR("token_cond_create error\n", 1, "");
+
+        (yyval.cond).line = (yyvsp[0].val).line;
+
+        check_cond(&(yyval.cond));
+        use_cond(&(yyval.cond));
+
+#ifdef YY_DEBUG_MODE
+        FREE(str1);
+        FREE(str2);
+        FREE(str3);
+#else
+        FREE((yyvsp[-1].ptoken).str);
+#endif
+    }
+#line 2345 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 30: /* value: YY_NUM  */
+#line 1306 "/root/repo/src/parser.y"
+    {
+        const_value *cv;
+
+        YY_LOG("[YACC]\tYY_NUM:\t%s\n", (yyvsp[0].ptoken).str);
+
+        if((yyvsp[0].ptoken).big)
+        {
+            (yyval.val).val = big_const_value(&(yyvsp[0].ptoken));
+            if((yyval.val).val == NULL)
+                ERROR("big_const_value error\n", 1, "");
+        }
+        else
+        {
+            cv = const_value_create((yyvsp[0].ptoken).val);
+            if(cv == NULL)
+                ERROR("const_value_create error\n", 1, "");
+
+            (yyval.val).val = value_create(CONST_VAL, (void*)cv);
+            if((yyval.val).val == NULL)
+                ERROR("value_create error\n", 1, "");
+        }
+
+        (yyval.val).line = (yyvsp[0].ptoken).line;
+
+        FREE((yyvsp[0].ptoken).str);
+    }
+#line 2376 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 31: /* value: identifier  */
+#line 1336 "/root/repo/src/parser.y"
+    {
+        YY_LOG("[YACC]\tidentifier: %s\n", variable_get_name((yyvsp[0].val).val->body.var));
+
+        if( memcpy(&(yyval.val), &(yyvsp[0].val), sizeof(Pvalue)) == NULL)
+            ERROR("memcpy error\n", 1, "");
+
+        /* we don't clean str because we copy pointer to $val */
+    }
+#line 2389 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 32: /* identifier: YY_VARIABLE  */
+#line 1358 "/root/repo/src/parser.y"
+    {
+        Variable *variable;
+        var_normal *vn;
+
+        YY_LOG("[YACC]\tYY_VARIABLE:\t%s\n", (yyvsp[0].ptoken).str);
+
+        vn = var_normal_create((yyvsp[0].ptoken).str);
+        if(vn == NULL)
+            ERROR("var_normal error\n", 1, "");
+
+        variable = variable_create(VAR_NORMAL, (void*)vn);
+        if(variable == NULL)
+            ERROR("variable_create error\n", 1, "");
+
+        (yyval.val).val = value_create(VARIABLE, (void*)variable);
+        if((yyval.val).val == NULL)
+            ERROR("value_create error\n", 1, "");
+
+        (yyval.val).line = (yyvsp[0].ptoken).line;
+
+        FREE((yyvsp[0].ptoken).str);
+    }
+#line 2416 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 33: /* identifier: YY_VARIABLE YY_L_BRACKET YY_VARIABLE YY_R_BRACKET  */
+#line 1385 "/root/repo/src/parser.y"
+    {
+        Variable *variable;
+        Array *arr = *(&arr);
+        var_normal *vn;
+        var_normal *offset;
+        var_arr *va;
+
+        YY_LOG("[YACC]\tYY_ARRAY:\t%s [ %s ]\n", (yyvsp[-3].ptoken).str, (yyvsp[-1].ptoken).str);
+
+        vn = var_normal_create((yyvsp[-3].ptoken).str);
+        if(vn == NULL)
+            ERROR("var_normal error\n", 1, "");
+
+        offset = var_normal_create((yyvsp[-1].ptoken).str);
+        if(offset == NULL)
+            ERROR("var_normal error\n", 1, "");
+
+        va = var_arr_create(vn, arr, 0);
+        if(va == NULL)
+            ERROR("var_arr_create error\n", 1, "");
+
+        va->var_offset = offset;
+
+        variable = variable_create(VAR_ARR, (void*)va);
+        if(variable == NULL)
+            ERROR("variable_create error\n", 1, "");
+
+        (yyval.val).val = value_create(VARIABLE, (void*)variable);
+        if((yyval.val).val == NULL)
+            ERROR("value_create error\n", 1, "");
+
+        (yyval.val).line = (yyvsp[0].ptoken).line;
+
+        /* we assume that array are always used  */
+        if(is_declared((yyvsp[-3].ptoken).str))
+        {
+            use((yyvsp[-3].ptoken).str);
+
+            /* array var offset always set as used */
+            if(is_declared((yyvsp[-1].ptoken).str))
+                use((yyvsp[-1].ptoken).str);
+        }
+
+        FREE((yyvsp[-3].ptoken).str);
+        FREE((yyvsp[-2].ptoken).str);
+        FREE((yyvsp[-1].ptoken).str);
+        FREE((yyvsp[0].ptoken).str);
+    }
+#line 2469 "/root/repo/obj/parser.tab.c"
+    break;
+
+  case 34: /* identifier: YY_VARIABLE YY_L_BRACKET YY_NUM YY_R_BRACKET  */
+#line 1438 "/root/repo/src/parser.y"
+    {
+        Variable *variable;
+        Array *arr = *(&arr);
+        var_normal *vn;
+        var_arr *va;
+
+        YY_LOG("[YACC]\tYY_ARRAY:\t%s [ %s ]\n", (yyvsp[-3].ptoken).str, (yyvsp[-1].ptoken).str);
+
+        /* no array has so many members */
+        if((yyvsp[-1].ptoken).big && is_declared((yyvsp[-3].ptoken).str))
+        {
+            print_err((yyvsp[-3].ptoken).line - 1, (yyvsp[0].ptoken).line - 1, "array member out of array range:\t%s[ %s ]\n", (yyvsp[-3].ptoken).str, (yyvsp[-1].ptoken).str);
+            compiler_exit(1);
+        }
+
+        vn = var_normal_create((yyvsp[-3].ptoken).str);
+        if(vn == NULL)
+            ERROR("var_normal error\n", 1, "");
+
+        va = var_arr_create(vn, arr, (yyvsp[-1].ptoken).val);
+        if(va == NULL)
+            ERROR("var_arr_create error\n", 1, "");
+
+        variable = variable_create(VAR_ARR, (void*)va);
+        if(variable == NULL)
+            ERROR("variable_create error\n", 1, "");
+
+        (yyval.val).val = value_create(VARIABLE, (void*)variable);
+        if((yyval.val).val == NULL)
+            ERROR("value_create error\n", 1, "");
+
+        (yyval.val).line = (yyvsp[0].ptoken).line;
+
+        /* we assume that array are always used  */
+        use((yyvsp[-3].ptoken).str);
+
+        FREE((yyvsp[-3].ptoken).str);
+        FREE((yyvsp[-2].ptoken).str);
+        FREE((yyvsp[-1].ptoken).str);
+        FREE((yyvsp[0].ptoken).str);
+    }
+#line 2515 "/root/repo/obj/parser.tab.c"
+    break;
+
+
+#line 2519 "/root/repo/obj/parser.tab.c"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      yyerror (YY_("syntax error"));
+    }
+
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+
+  return yyresult;
+}
+
+#line 1481 "/root/repo/src/parser.y"
+
+
+static void yyerror(const char *msg)
+{
+    const char *line;
+    int len;
+
+    line = code_line(yylval.ptoken.line - 1, &len);
+
+    fprintf(stderr,"%sERROR!\t%s\t%s\nLINE: %ju\n%.*s%s\n",
+            RED, msg, yytext,
+            yylval.ptoken.line,
+            len, line,
+            RESET);
+
+    compiler_exit(1);
+}
+
+void parse_unlock(void)
+{
+    if(! parse_locked)
+        return;
+
+    /* lexer buffer points to source_code */
+    lexer_release();
+
+    parse_locked = FALSE;
+    pthread_mutex_unlock(&parse_mutex);
+}
+
+int parse(const char *file, Vector **out_tokens)
+{
+    int ret;
+
+    Pvar **sorted;
+    Pvar *pvar;
+    int size;
+    int pos;
+
+#ifdef DEBUG_MODE
+    int i;
+    int len;
+    const char *line;
+    Vector_iterator ait;
+    Token *token;
+
+    char *str;
+#endif
+
+    Phase_mark mark;
+
+    TRACE("");
+
+    PHASE_BEGIN(mark);
+
+    /* Create variables to check correctnes of using */
+    variables = hashmap_create(sizeof(Pvar*), pvar_hash, pvar_cmp);
+    if(variables == NULL)
+        ERROR("hashmap_create error\n", 1, "");
+
+    /* map file */
+    if(file == NULL)
+        ERROR("file == NULL\n", 1, "");
+
+    /* code of stopped parsing */
+    if(source_code != NULL)
+        source_unmap(source_code, source_size);
+
+    if(code_lines != NULL)
+        darray_destroy(code_lines);
+
+    /* tokens of stopped parsing are in compile_arena */
+    if(big_consts != NULL)
+        vector_destroy(big_consts);
+
+    big_consts = NULL;
+
+    source_code = source_map(file, &source_size);
+    if(source_code == NULL)
+        ERROR("source_map error\n", 1, "");
+
+    /* errors print lines of code, so remember where lines start */
+    code_lines = darray_create(UNSORTED, 0, sizeof(uint64_t), NULL);
+    if(code_lines == NULL)
+        ERROR("darray_create error\n", 1, "");
+
+    if(line_index(source_code, source_size, '\n', code_lines))
+        ERROR("line_index error\n", 1, "");
+
+    PHASE_END(PHASE_SOURCE, mark);
+
+#ifdef DEBUG_MODE
+    for(i = 0; i < code_lines->num_entries; ++i )
+    {
+        line = code_line((uint64_t)i, &len);
+        LOG("LINE %d\t%.*s\n", i, len, line);
+    }
+#endif
+
+    /* waiting for parser of other job is in wall time only */
+    PHASE_BEGIN(mark);
+
+    pthread_mutex_lock(&parse_mutex);
+    parse_locked = TRUE;
+
+    /* lexer reads mapped code in place */
+    if(lexer_reset(source_code, (size_t)source_size))
+    {
+        parse_unlock();
+        ERROR("lexer_reset error\n", 1, "");
+    }
+
+	ret = yyparse();
+
+    parse_unlock();
+
+    PHASE_END(PHASE_PARSE, mark);
+
+#ifdef DEBUG_MODE
+    for(vector_iterator_init(tokens, &ait, ITI_BEGIN); \
+        ! vector_iterator_end(&ait); \
+        vector_iterator_next(&ait) )
+    {
+        vector_iterator_get_data(&ait, (void*)&token);
+        str = token_str(token);
+
+        LOG("TOKEN: %s\n", str);
+
+        FREE(str);
+    }
+#endif
+
+    /* check ununused variables, sorted by name so order of warnings doesn't depend on map */
+    if(option.wall)
+    {
+        PHASE_BEGIN(mark);
+
+        if(pvars_sorted(variables, &sorted, &size))
+            ERROR("pvars_sorted error\n", 1, "");
+
+        for(pos = 0; pos < size; ++pos)
+        {
+            pvar = sorted[pos];
+            if( ! IS_VAR_USE(pvar) )
+            {
+                if(option.werr)
+                {
+                    fprintf(stderr,"%sERROR!\tunused variable:\t%s%s\n",
+                        RED, pvar->name, RESET);
+
+                    FREE(sorted);
+                    compiler_exit(1);
+                }
+                else
+                fprintf(stderr,"%sWARNING!\tunused variable:\t%s%s\n",
+                    YELLOW, pvar->name, RESET);
+            }
+        }
+
+        FREE(sorted);
+
+        PHASE_END(PHASE_SEMANTIC, mark);
+    }
+
+    /* clean up */
+    source_unmap(source_code, source_size);
+    source_code = NULL;
+    source_size = 0;
+
+    darray_destroy(code_lines);
+    code_lines = NULL;
+
+    *out_tokens = tokens;
+
+    return ret;
+}
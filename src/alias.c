@@ -0,0 +1,1390 @@
+#include <alias.h>
+#include <compiler.h>
+#include <compiler_algo.h>
+#include <arch.h>
+#include <asm.h>
+
+#define RANGE_FOR   0 /* iterator, valid in whole loop */
+#define RANGE_COND  1 /* from IF condition, valid until variable is changed */
+#define RANGE_EXPR  2 /* from assignment, valid until variable is changed */
+
+#define RANGE_MAX   UINT64_MAX
+
+/* possible values of variable */
+typedef struct Range
+{
+    const char *name;
+
+    uint64_t lo;
+    uint64_t hi;
+
+    uint8_t kind        :2;
+    uint8_t alive       :1;
+    uint8_t padding     :5;
+
+}Range;
+
+/* loop or IF in compilation */
+typedef struct Alias_block
+{
+    token_cond *cond; /* NULL for loops */
+    uint64_t first; /* first range of block in ranges */
+
+}Alias_block;
+
+/* value in token replaced by const value */
+typedef struct Alias_fold
+{
+    Value **slot;
+    Value *orig;
+
+}Alias_fold;
+
+/* Range, top is the last one */
+static __thread Vector *ranges = NULL;
+
+/* Alias_block, top is the innermost block */
+static __thread Vector *blocks = NULL;
+
+/* Alias_fold of current token */
+static __thread Vector *folds = NULL;
+
+/* depth of loops and IFs */
+static __thread uint64_t depth = 0;
+
+/* ranges of operands of current token */
+static __thread Range operands[2];
+
+/* variable assigned by current token and its new range */
+static __thread const char *assigned = NULL;
+static __thread Range assigned_range;
+
+/*
+    Intersect range with [@lo, @hi]
+
+    PARAMS
+    @IN r - range
+    @IN lo - low bound
+    @IN hi - high bound
+
+    RETURN:
+    This is a void function
+*/
+static __inline__ void range_cut(Range *r, uint64_t lo, uint64_t hi);
+
+/*
+    Get possible values of variable
+
+    PARAMS
+    @IN name - variable name
+    @IN scan - TRUE iff range is needed for whole loop body ( only iterators are used )
+    @OUT r - range
+
+    RETURN:
+    This is a void function
+*/
+static void range_of_name(const char *name, BOOL scan, Range *r) __nonull__(1, 3);
+
+/*
+    Get possible values of value
+
+    PARAMS
+    @IN val - value
+    @IN scan - TRUE iff range is needed for whole loop body
+    @OUT r - range
+
+    RETURN:
+    This is a void function
+*/
+static void range_of_value(Value *val, BOOL scan, Range *r) __nonull__(1, 3);
+
+/*
+    Push range
+
+    PARAMS
+    @IN name - variable name
+    @IN kind - RANGE_FOR or RANGE_COND
+    @IN r - range
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int range_push(const char *name, uint8_t kind, Range *r) __nonull__(1, 3);
+
+/*
+    Pop ranges above @first
+
+    PARAMS
+    @IN first - number of ranges to leave
+
+    RETURN:
+    This is a void function
+*/
+static void range_pop(uint64_t first);
+
+/*
+    Variable is changed, so forget ranges from conditions and assignments
+
+    PARAMS
+    @IN name - variable name
+
+    RETURN:
+    This is a void function
+*/
+static void range_kill(const char *name) __nonull__(1);
+
+/*
+    Get possible values of expression ( the same semantic as in machine )
+
+    PARAMS
+    @IN expr - expression
+    @IN left - range of left operand
+    @IN right - range of right operand
+    @OUT r - range
+
+    RETURN:
+    This is a void function
+*/
+static void range_of_expr(token_expr *expr, Range *left, Range *right, Range *r) __nonull__(1, 2, 3, 4);
+
+/*
+    Open block of loop or IF
+
+    PARAMS
+    @IN cond - condition of IF ( NULL for loops )
+    @IN first - first range of block
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int block_push(token_cond *cond, uint64_t first);
+
+/*
+    Close block, forget ranges created in block
+
+    PARAMS
+    NO PARAMS
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int block_pop(void);
+
+/*
+    Push range of FOR iterator
+
+    PARAMS
+    @IN token - FOR token
+    @IN scan - TRUE iff range is needed for whole body of outer loop
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int range_push_for(token_for *token, BOOL scan) __nonull__(1);
+
+/*
+    Push ranges of variables in condition
+
+    PARAMS
+    @IN cond - condition
+    @IN r - relation ( can be negated relation of condition )
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int range_push_cond(token_cond *cond, uint8_t r) __nonull__(1);
+
+/*
+    Get small array of array member
+
+    PARAMS
+    @IN val - value
+
+    RETURN:
+    NULL iff value is not member of small array
+    Pointer to Array iff success
+*/
+static Array *elem_array(Value *val) __nonull__(1);
+
+/*
+    Get range of offset of array member
+
+    PARAMS
+    @IN val - array member
+    @IN scan - TRUE iff range is needed for whole loop body
+    @OUT r - range
+
+    RETURN:
+    This is a void function
+*/
+static void elem_offset(Value *val, BOOL scan, Range *r) __nonull__(1, 3);
+
+/*
+    Get element with known value
+
+    PARAMS
+    @IN val - value
+
+    RETURN:
+    NULL iff value is not element with known value
+    Pointer to var_arr iff success
+*/
+static var_arr *elem_known(Value *val) __nonull__(1);
+
+/*
+    Store to array member, forget all elements which may be aliased
+
+    PARAMS
+    @IN val - array member
+    @IN known - TRUE iff stored value is known
+    @IN value - stored value
+    @IN scan - TRUE iff store is in loop body ( element is forgotten before loop )
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int elem_store(Value *val, BOOL known, mpz_t value, BOOL scan) __nonull__(1);
+
+/*
+    Get known value of value
+
+    PARAMS
+    @IN val - value
+    @OUT res - value ( initialized by function iff success )
+
+    RETURN:
+    TRUE iff value is known
+    FALSE iff not
+*/
+static BOOL value_known(Value *val, mpz_t res) __nonull__(1);
+
+/*
+    Get known value of expression
+
+    PARAMS
+    @IN expr - expression
+    @OUT res - value ( initialized by function iff success )
+
+    RETURN:
+    TRUE iff value is known
+    FALSE iff not
+*/
+static BOOL expr_known(token_expr *expr, mpz_t res) __nonull__(1);
+
+/*
+    Replace value in token by const value until alias_token_end
+
+    PARAMS
+    @IN slot - addr of value in token
+    @IN value - const value
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int slot_replace(Value **slot, uint64_t value) __nonull__(1);
+
+/*
+    Replace value by const value iff value is element with known value
+    and const value is better than load
+
+    PARAMS
+    @IN slot - addr of value in token
+    @IN op - operation with value ( MULT, DIV or MOD by value, undefined otherwise )
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int fold(Value **slot, uint8_t op) __nonull__(1);
+
+/*
+    Check condition using ranges of its values
+
+    PARAMS
+    @IN cond - condition
+
+    RETURN:
+    -1 iff condition is not decided by ranges
+    0 iff condition is always false
+    1 iff condition is always true
+*/
+static int cond_decide(token_cond *cond) __nonull__(1);
+
+/*
+    Replace values of condition by const values with the same result
+
+    PARAMS
+    @IN cond - condition
+    @IN res - result of condition
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int cond_fold(token_cond *cond, BOOL res) __nonull__(1);
+
+/*
+    Forget elements written in loop body, forget ranges of variables changed in body
+
+    PARAMS
+    @IN tokens - token list
+    @IN pos - position of loop token
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int loop_scan(Vector *tokens, uint64_t pos) __nonull__(1);
+
+static __inline__ void range_cut(Range *r, uint64_t lo, uint64_t hi)
+{
+    if(lo > r->lo)
+        r->lo = lo;
+
+    if(hi < r->hi)
+        r->hi = hi;
+}
+
+static void range_of_name(const char *name, BOOL scan, Range *r)
+{
+    Cvar *cvar;
+    Range *range;
+    uint64_t i;
+
+    TRACE("");
+
+    r->lo = 0;
+    r->hi = RANGE_MAX;
+
+    /* in straight code value is known */
+    if( ! scan && cvar_is_declared_by_name(name))
+    {
+        cvar = cvar_get_by_name(name);
+        if(cvar->type != ARRAY && cvar->type != BIG_ARRAY
+            && value_can_trace(cvar->body.val) && ! value_is_symbolic(cvar->body.val)
+            && mpz_sizeinbase(cvar->body.val->body.var->body.var->value, 2) <= 64)
+        {
+            r->lo = mpz2ull(cvar->body.val->body.var->body.var->value);
+            r->hi = r->lo;
+
+            return;
+        }
+    }
+
+    for(i = ranges->length; i > 0; --i)
+    {
+        range = (Range*)vector_get_ptr(ranges, i - 1);
+
+        if( ! range->alive || strcmp(range->name, name))
+            continue;
+
+        if(scan && range->kind != RANGE_FOR)
+            continue;
+
+        range_cut(r, range->lo, range->hi);
+    }
+}
+
+static void range_of_value(Value *val, BOOL scan, Range *r)
+{
+    var_arr *va;
+
+    TRACE("");
+
+    r->lo = 0;
+    r->hi = RANGE_MAX;
+
+    if(val->type == CONST_VAL)
+    {
+        if(val->body.cv->type == CONST_VAL)
+        {
+            r->lo = val->body.cv->value;
+            r->hi = r->lo;
+        }
+
+        return;
+    }
+
+    if(val->body.var->type == VAR_NORMAL)
+    {
+        range_of_name(val->body.var->body.var->name, scan, r);
+
+        return;
+    }
+
+    if(scan)
+        return;
+
+    va = elem_known(val);
+    if(va != NULL && mpz_sizeinbase(va->var->value, 2) <= 64)
+    {
+        r->lo = mpz2ull(va->var->value);
+        r->hi = r->lo;
+    }
+}
+
+static int range_push(const char *name, uint8_t kind, Range *r)
+{
+    Range range;
+    Range *old;
+    Alias_block block;
+    uint64_t first = 0;
+    uint64_t i;
+
+    TRACE("");
+
+    /* the newest assignment in block replaces previous one */
+    if(kind == RANGE_EXPR)
+    {
+        if(blocks->length)
+        {
+            if(vector_get_pos(blocks, blocks->length - 1, (void*)&block))
+                ERROR("vector_get_pos error\n", 1, "");
+
+            first = block.first;
+        }
+
+        for(i = ranges->length; i > first; --i)
+        {
+            old = (Range*)vector_get_ptr(ranges, i - 1);
+            if(old->kind == RANGE_EXPR && ! strcmp(old->name, name))
+            {
+                old->lo = r->lo;
+                old->hi = r->hi;
+                old->alive = 1;
+
+                return 0;
+            }
+        }
+    }
+
+    range.name = name;
+    range.lo = r->lo;
+    range.hi = r->hi;
+    range.kind = kind;
+    range.alive = 1;
+
+    if(vector_insert_last(ranges, (void*)&range))
+        ERROR("vector_insert_last error\n", 1, "");
+
+    return 0;
+}
+
+static void range_pop(uint64_t first)
+{
+    TRACE("");
+
+    while(ranges->length > first)
+        vector_delete_last(ranges);
+}
+
+static void range_kill(const char *name)
+{
+    Range *range;
+    uint64_t i;
+
+    TRACE("");
+
+    for(i = 0; i < ranges->length; ++i)
+    {
+        range = (Range*)vector_get_ptr(ranges, i);
+        if(range->kind != RANGE_FOR && ! strcmp(range->name, name))
+            range->alive = 0;
+    }
+}
+
+static void range_of_expr(token_expr *expr, Range *left, Range *right, Range *r)
+{
+    TRACE("");
+
+    r->lo = left->lo;
+    r->hi = left->hi;
+
+    /* RANGE_MAX as high bound means unbounded value */
+    if(expr->op == tokens_id.undefined)
+        return;
+
+    /* empty range, code is never executed ( contradictory conditions ) */
+    if(left->lo > left->hi || right->lo > right->hi)
+    {
+        r->lo = 0;
+        r->hi = RANGE_MAX;
+
+        return;
+    }
+
+    if(expr->op == tokens_id.add)
+    {
+        r->lo = left->lo > RANGE_MAX - right->lo ? RANGE_MAX : left->lo + right->lo;
+        r->hi = left->hi > RANGE_MAX - right->hi ? RANGE_MAX : left->hi + right->hi;
+    }
+    else if(expr->op == tokens_id.sub)
+    {
+        r->lo = left->lo > right->hi ? left->lo - right->hi : 0;
+
+        if(left->hi != RANGE_MAX)
+            r->hi = left->hi > right->lo ? left->hi - right->lo : 0;
+    }
+    else if(expr->op == tokens_id.mult)
+    {
+        if(left->lo == 0 || right->lo == 0)
+            r->lo = 0;
+        else
+            r->lo = left->lo > RANGE_MAX / right->lo ? RANGE_MAX : left->lo * right->lo;
+
+        if(left->hi == 0 || right->hi == 0)
+            r->hi = 0;
+        else
+            r->hi = left->hi > RANGE_MAX / right->hi ? RANGE_MAX : left->hi * right->hi;
+    }
+    else if(expr->op == tokens_id.div)
+    {
+        /* DIV by 0 is 0 */
+        if(right->lo == 0)
+            r->lo = 0;
+        else
+        {
+            r->lo = right->hi == RANGE_MAX ? 0 : left->lo / right->hi;
+
+            if(left->hi != RANGE_MAX)
+                r->hi = left->hi / right->lo;
+        }
+    }
+    else
+    {
+        /* left < right, so left MOD right is left */
+        if(left->hi < right->lo)
+            return;
+
+        /* MOD by 0 is 0, otherwise less than right */
+        r->lo = 0;
+        if(right->hi != RANGE_MAX && (right->hi == 0 || right->hi - 1 < r->hi))
+            r->hi = right->hi == 0 ? 0 : right->hi - 1;
+    }
+}
+
+static int block_push(token_cond *cond, uint64_t first)
+{
+    Alias_block block;
+
+    TRACE("");
+
+    block.cond = cond;
+    block.first = first;
+
+    if(vector_insert_last(blocks, (void*)&block))
+        ERROR("vector_insert_last error\n", 1, "");
+
+    return 0;
+}
+
+static int block_pop(void)
+{
+    Alias_block block;
+
+    TRACE("");
+
+    if(vector_get_pos(blocks, blocks->length - 1, (void*)&block))
+        ERROR("vector_get_pos error\n", 1, "");
+
+    range_pop(block.first);
+    vector_delete_last(blocks);
+
+    return 0;
+}
+
+static int range_push_for(token_for *token, BOOL scan)
+{
+    Range begin;
+    Range end;
+    Range r;
+
+    TRACE("");
+
+    range_of_value(token->begin_value, scan, &begin);
+    range_of_value(token->end_value, scan, &end);
+
+    if(token->type == tokens_id.for_inc)
+    {
+        r.lo = begin.lo;
+        r.hi = end.hi;
+    }
+    else
+    {
+        r.lo = end.lo;
+        r.hi = begin.hi;
+    }
+
+    LOG("%s in [%ju, %ju]\n", token->iterator->body.var->body.var->name, r.lo, r.hi);
+
+    return range_push(token->iterator->body.var->body.var->name, RANGE_FOR, &r);
+}
+
+static int range_push_cond(token_cond *cond, uint8_t r)
+{
+    Value *var[2];
+    Value *other[2];
+    uint8_t rel[2];
+
+    Range range;
+    Range bound;
+
+    int i;
+
+    TRACE("");
+
+    var[0] = cond->left;
+    other[0] = cond->right;
+    rel[0] = r;
+
+    /* y R x  <=>  x R' y */
+    var[1] = cond->right;
+    other[1] = cond->left;
+    if(r == tokens_id.lt)
+        rel[1] = tokens_id.gt;
+    else if(r == tokens_id.gt)
+        rel[1] = tokens_id.lt;
+    else if(r == tokens_id.le)
+        rel[1] = tokens_id.ge;
+    else if(r == tokens_id.ge)
+        rel[1] = tokens_id.le;
+    else
+        rel[1] = r;
+
+    for(i = 0; i < 2; ++i)
+    {
+        if(var[i]->type == CONST_VAL || var[i]->body.var->type != VAR_NORMAL)
+            continue;
+
+        range_of_value(other[i], FALSE, &bound);
+
+        range.lo = 0;
+        range.hi = RANGE_MAX;
+
+        if(rel[i] == tokens_id.lt)
+        {
+            /* body is dead, nothing to say */
+            if(bound.hi == 0)
+                continue;
+
+            if(bound.hi != RANGE_MAX)
+                range.hi = bound.hi - 1;
+        }
+        else if(rel[i] == tokens_id.le)
+            range.hi = bound.hi;
+        else if(rel[i] == tokens_id.gt)
+        {
+            if(bound.lo == RANGE_MAX)
+                continue;
+
+            range.lo = bound.lo + 1;
+        }
+        else if(rel[i] == tokens_id.ge)
+            range.lo = bound.lo;
+        else if(rel[i] == tokens_id.eq)
+        {
+            range.lo = bound.lo;
+            range.hi = bound.hi;
+        }
+        else
+            continue;
+
+        LOG("%s in [%ju, %ju]\n", var[i]->body.var->body.var->name, range.lo, range.hi);
+
+        if(range_push(var[i]->body.var->body.var->name, RANGE_COND, &range))
+            ERROR("range_push error\n", 1, "");
+    }
+
+    return 0;
+}
+
+static Array *elem_array(Value *val)
+{
+    Cvar *cvar;
+
+    TRACE("");
+
+    if(val->type == CONST_VAL || val->body.var->type != VAR_ARR)
+        return NULL;
+
+    cvar = cvar_get_by_value(val);
+    if(cvar == NULL || cvar->type != ARRAY || cvar->body.arr->type != ARRAY)
+        return NULL;
+
+    return cvar->body.arr;
+}
+
+static void elem_offset(Value *val, BOOL scan, Range *r)
+{
+    var_arr *va = val->body.var->body.arr;
+
+    TRACE("");
+
+    if(va->var_offset == NULL)
+    {
+        r->lo = va->offset;
+        r->hi = va->offset;
+    }
+    else
+        range_of_name(va->var_offset->name, scan, r);
+}
+
+static var_arr *elem_known(Value *val)
+{
+    Array *arr;
+    var_arr *va;
+    Range r;
+
+    TRACE("");
+
+    arr = elem_array(val);
+    if(arr == NULL)
+        return NULL;
+
+    elem_offset(val, FALSE, &r);
+    if(r.lo != r.hi)
+        return NULL;
+
+    va = array_elem_get(arr, r.lo);
+    if(va == NULL || va->var->is_symbolic)
+        return NULL;
+
+    return va;
+}
+
+static int elem_store(Value *val, BOOL known, mpz_t value, BOOL scan)
+{
+    Hashmap_iterator it;
+    mem_chunk *chunk;
+    Array *arr;
+    var_arr *va;
+    Range r;
+
+    TRACE("");
+
+    arr = elem_array(val);
+    if(arr == NULL)
+        return 0;
+
+    elem_offset(val, scan, &r);
+    if(r.lo >= arr->len)
+        return 0;
+
+    /* must alias, the only one element is changed */
+    if(r.lo == r.hi)
+    {
+        if(known)
+        {
+            /* element is owned by memory, so take it from memory */
+            chunk = memory_get_chunk(mpz2ull(arr->addr) + r.lo);
+            if(chunk == NULL)
+                ERROR("memory_get_chunk error\n", 1, "");
+
+            va = chunk->val->body.var->body.arr;
+
+            mpz_set(va->var->value, value);
+            va->var->is_symbolic = 0;
+
+            LOG("%s[%ju] is known\n", arr->name, r.lo);
+        }
+        else
+        {
+            va = array_elem_get(arr, r.lo);
+            if(va != NULL)
+                va->var->is_symbolic = 1;
+        }
+
+        return 0;
+    }
+
+    if(arr->elems == NULL)
+        return 0;
+
+    LOG("%s[%ju - %ju] are forgotten\n", arr->name, r.lo, r.hi);
+
+    /* may alias, forget touched elements in range */
+    for(  hashmap_iterator_init(arr->elems, &it, ITI_BEGIN);
+        ! hashmap_iterator_end(&it);
+          hashmap_iterator_next(&it))
+        {
+            hashmap_iterator_get_data(&it, (void*)&va);
+
+            if(va->offset >= r.lo && va->offset <= r.hi)
+                va->var->is_symbolic = 1;
+        }
+
+    return 0;
+}
+
+static BOOL value_known(Value *val, mpz_t res)
+{
+    Cvar *cvar;
+    var_arr *va;
+
+    TRACE("");
+
+    if(val->type == CONST_VAL)
+    {
+        value_get_val(val, res);
+
+        return TRUE;
+    }
+
+    if(val->body.var->type == VAR_NORMAL)
+    {
+        cvar = cvar_get_by_value(val);
+        if(cvar == NULL || ! value_can_trace(cvar->body.val) || value_is_symbolic(cvar->body.val))
+            return FALSE;
+
+        value_get_val(cvar->body.val, res);
+
+        return TRUE;
+    }
+
+    va = elem_known(val);
+    if(va == NULL)
+        return FALSE;
+
+    mpz_init_set(res, va->var->value);
+
+    return TRUE;
+}
+
+static BOOL expr_known(token_expr *expr, mpz_t res)
+{
+    mpz_t right;
+
+    TRACE("");
+
+    if( ! value_known(expr->left, res))
+        return FALSE;
+
+    if(expr->op == tokens_id.undefined)
+        return TRUE;
+
+    if( ! value_known(expr->right, right))
+    {
+        mpz_clear(res);
+
+        return FALSE;
+    }
+
+    /* the same semantic as in machine */
+    if(expr->op == tokens_id.add)
+        mpz_add(res, res, right);
+    else if(expr->op == tokens_id.sub)
+    {
+        mpz_sub(res, res, right);
+        if(mpz_cmp_ui(res, 0) < 0)
+            mpz_set_ui(res, 0);
+    }
+    else if(expr->op == tokens_id.mult)
+        mpz_mul(res, res, right);
+    else if(mpz_cmp_ui(right, 0) == 0)
+        mpz_set_ui(res, 0);
+    else if(expr->op == tokens_id.div)
+        mpz_fdiv_q(res, res, right);
+    else
+        mpz_mod(res, res, right);
+
+    mpz_clear(right);
+
+    return TRUE;
+}
+
+static int slot_replace(Value **slot, uint64_t value)
+{
+    Alias_fold f;
+    const_value *cv;
+
+    TRACE("");
+
+    cv = const_value_create(value);
+    if(cv == NULL)
+        ERROR("const_value_create error\n", 1, "");
+
+    f.slot = slot;
+    f.orig = *slot;
+
+    *slot = value_create(CONST_VAL, (void*)cv);
+    if(*slot == NULL)
+        ERROR("value_create error\n", 1, "");
+
+    if(vector_insert_last(folds, (void*)&f))
+        ERROR("vector_insert_last error\n", 1, "");
+
+    return 0;
+}
+
+static int fold(Value **slot, uint8_t op)
+{
+    var_arr *va;
+    BOOL always;
+
+    TRACE("");
+
+    if(*slot == NULL)
+        return 0;
+
+    va = elem_known(*slot);
+    if(va == NULL || mpz_sizeinbase(va->var->value, 2) > 64)
+        return 0;
+
+    /* MULT by const and DIV, MOD by 0, 1 or power of 2 don't need loop */
+    if(op == tokens_id.mult)
+        always = TRUE;
+    else if(op == tokens_id.div || op == tokens_id.mod)
+        always = mpz_popcount(va->var->value) <= 1;
+    else
+        always = FALSE;
+
+    if( ! always && BPUMP_COST(va->var->value) > op_cost.load)
+        return 0;
+
+    LOG("%s[%ju] folded\n", va->arr->name, va->offset);
+
+    if(slot_replace(slot, mpz2ull(va->var->value)))
+        ERROR("slot_replace error\n", 1, "");
+
+    return 0;
+}
+
+static int cond_decide(token_cond *cond)
+{
+    Range a;
+    Range b;
+    Range t;
+    uint8_t r = cond->r;
+    int res = -1;
+
+    TRACE("");
+
+    range_of_value(cond->left, FALSE, &a);
+    range_of_value(cond->right, FALSE, &b);
+
+    /* a > b  <=>  b < a,  a >= b  <=>  b <= a */
+    if(r == tokens_id.gt || r == tokens_id.ge)
+    {
+        t = a;
+        a = b;
+        b = t;
+
+        r = r == tokens_id.gt ? tokens_id.lt : tokens_id.le;
+    }
+
+    /* RANGE_MAX as high bound means unbounded value */
+    if(r == tokens_id.lt)
+    {
+        if(a.hi < b.lo)
+            res = 1;
+        else if(b.hi != RANGE_MAX && b.hi <= a.lo)
+            res = 0;
+    }
+    else if(r == tokens_id.le)
+    {
+        if(a.hi != RANGE_MAX && a.hi <= b.lo)
+            res = 1;
+        else if(b.hi < a.lo)
+            res = 0;
+    }
+    else
+    {
+        if(a.hi < b.lo || b.hi < a.lo)
+            res = 0;
+        else if(a.lo == a.hi && b.lo == b.hi && a.lo == b.lo && a.lo != RANGE_MAX)
+            res = 1;
+
+        if(res != -1 && r == tokens_id.ne)
+            res = ! res;
+    }
+
+    return res;
+}
+
+static int cond_fold(token_cond *cond, BOOL res)
+{
+    uint64_t left = 0;
+    uint64_t right = 0;
+
+    /* 0 R 0 is TRUE only for <=, >=, = */
+    BOOL zero = cond->r == tokens_id.le || cond->r == tokens_id.ge || cond->r == tokens_id.eq;
+
+    TRACE("");
+
+    /* 1 R 0 is TRUE for >, FALSE for <=, 0 R 1 for others */
+    if(zero != res)
+    {
+        if(cond->r == tokens_id.le || cond->r == tokens_id.gt)
+            left = 1;
+        else
+            right = 1;
+    }
+
+    LOG("condition is always %s\n", res ? "TRUE" : "FALSE");
+
+    if(slot_replace(&cond->left, left))
+        ERROR("slot_replace error\n", 1, "");
+
+    if(slot_replace(&cond->right, right))
+        ERROR("slot_replace error\n", 1, "");
+
+    return 0;
+}
+
+static int loop_scan(Vector *tokens, uint64_t pos)
+{
+    Token *token;
+    Value *res;
+
+    uint64_t first = ranges->length;
+    uint64_t loops = 1;
+    uint64_t i;
+
+    TRACE("");
+
+    for(i = pos + 1; i < tokens->length && loops; ++i)
+    {
+        if(vector_get_pos(tokens, i, (void*)&token))
+            ERROR("vector_get_pos error\n", 1, "");
+
+        res = NULL;
+
+        switch(token->type)
+        {
+            case TOKEN_FOR:
+            {
+                if(range_push_for(token->body.for_loop, TRUE))
+                    ERROR("range_push_for error\n", 1, "");
+
+                ++loops;
+                break;
+            }
+            case TOKEN_WHILE:
+            {
+                ++loops;
+                break;
+            }
+            case TOKEN_GUARD:
+            {
+                /* range of scanned loop is not pushed by scan */
+                if(token->body.guard->type == tokens_id.end_for)
+                {
+                    if(--loops)
+                        vector_delete_last(ranges);
+                }
+                else if(token->body.guard->type == tokens_id.end_while)
+                    --loops;
+
+                break;
+            }
+            case TOKEN_ASSIGN:
+            {
+                res = token->body.assign->res;
+                break;
+            }
+            case TOKEN_IO:
+            {
+                if(token->body.io->op == tokens_id.read)
+                    res = token->body.io->res;
+
+                break;
+            }
+            default:
+                break;
+        }
+
+        if(res == NULL)
+            continue;
+
+        if(res->body.var->type == VAR_NORMAL)
+            range_kill(res->body.var->body.var->name);
+        else if(elem_store(res, FALSE, NULL, TRUE))
+            ERROR("elem_store error\n", 1, "");
+    }
+
+    range_pop(first);
+
+    return 0;
+}
+
+int alias_init(void)
+{
+    TRACE("");
+
+    /* previous job was stopped by error */
+    alias_destroy();
+
+    ranges = vector_create(sizeof(Range));
+    if(ranges == NULL)
+        ERROR("vector_create error\n", 1, "");
+
+    blocks = vector_create(sizeof(Alias_block));
+    if(blocks == NULL)
+        ERROR("vector_create error\n", 1, "");
+
+    folds = vector_create(sizeof(Alias_fold));
+    if(folds == NULL)
+        ERROR("vector_create error\n", 1, "");
+
+    depth = 0;
+    assigned = NULL;
+
+    operands[0].lo = 0;
+    operands[0].hi = RANGE_MAX;
+    operands[1] = operands[0];
+
+    return 0;
+}
+
+void alias_destroy(void)
+{
+    TRACE("");
+
+    if(ranges != NULL)
+        vector_destroy(ranges);
+
+    if(blocks != NULL)
+        vector_destroy(blocks);
+
+    if(folds != NULL)
+        vector_destroy(folds);
+
+    ranges = NULL;
+    blocks = NULL;
+    folds = NULL;
+}
+
+int alias_token_begin(Vector *tokens, uint64_t pos)
+{
+    Token *token;
+    Alias_block block;
+    Value *res;
+
+    BOOL known;
+    uint8_t op;
+    uint8_t r;
+    int decided;
+    uint64_t first;
+    mpz_t val;
+
+    TRACE("");
+
+    if(vector_get_pos(tokens, pos, (void*)&token))
+        ERROR("vector_get_pos error\n", 1, "");
+
+    operands[0].lo = 0;
+    operands[0].hi = RANGE_MAX;
+    operands[1] = operands[0];
+
+    switch(token->type)
+    {
+        case TOKEN_ASSIGN:
+        {
+            op = token->body.assign->expr->op;
+
+            if(fold(&token->body.assign->expr->left, op == tokens_id.mult ? op : tokens_id.undefined))
+                ERROR("fold error\n", 1, "");
+
+            if(op != tokens_id.undefined)
+                if(fold(&token->body.assign->expr->right, op))
+                    ERROR("fold error\n", 1, "");
+
+            range_of_value(token->body.assign->expr->left, FALSE, &operands[0]);
+            if(op != tokens_id.undefined)
+                range_of_value(token->body.assign->expr->right, FALSE, &operands[1]);
+
+            res = token->body.assign->res;
+            if(res->body.var->type == VAR_NORMAL)
+            {
+                /* operand can be result, so range is changed after compilation */
+                assigned = res->body.var->body.var->name;
+                range_of_expr(token->body.assign->expr, &operands[0], &operands[1], &assigned_range);
+
+                LOG("%s in [%ju, %ju]\n", assigned, assigned_range.lo, assigned_range.hi);
+
+                break;
+            }
+
+            /* only in straight code value is known after store */
+            known = depth == 0 && expr_known(token->body.assign->expr, val);
+
+            if(elem_store(res, known, val, FALSE))
+                ERROR("elem_store error\n", 1, "");
+
+            if(known)
+                mpz_clear(val);
+
+            break;
+        }
+        case TOKEN_IO:
+        {
+            res = token->body.io->res;
+            if(token->body.io->op == tokens_id.write)
+            {
+                if(fold(&token->body.io->res, tokens_id.undefined))
+                    ERROR("fold error\n", 1, "");
+            }
+            else if(res->body.var->type == VAR_NORMAL)
+            {
+                assigned = res->body.var->body.var->name;
+                assigned_range.lo = 0;
+                assigned_range.hi = RANGE_MAX;
+            }
+            else if(elem_store(res, FALSE, NULL, FALSE))
+                ERROR("elem_store error\n", 1, "");
+
+            break;
+        }
+        case TOKEN_FOR:
+        {
+            /* bounds are computed once before loop */
+            if(fold(&token->body.for_loop->begin_value, tokens_id.undefined))
+                ERROR("fold error\n", 1, "");
+
+            if(fold(&token->body.for_loop->end_value, tokens_id.undefined))
+                ERROR("fold error\n", 1, "");
+
+            first = ranges->length;
+            if(range_push_for(token->body.for_loop, FALSE))
+                ERROR("range_push_for error\n", 1, "");
+
+            if(loop_scan(tokens, pos))
+                ERROR("loop_scan error\n", 1, "");
+
+            if(block_push(NULL, first))
+                ERROR("block_push error\n", 1, "");
+
+            ++depth;
+            break;
+        }
+        case TOKEN_WHILE:
+        {
+            /* condition is checked after each iteration */
+            if(loop_scan(tokens, pos))
+                ERROR("loop_scan error\n", 1, "");
+
+            if(fold(&token->body.while_loop->cond->left, tokens_id.undefined))
+                ERROR("fold error\n", 1, "");
+
+            if(fold(&token->body.while_loop->cond->right, tokens_id.undefined))
+                ERROR("fold error\n", 1, "");
+
+            if(block_push(NULL, ranges->length))
+                ERROR("block_push error\n", 1, "");
+
+            ++depth;
+            break;
+        }
+        case TOKEN_IF:
+        {
+            if(fold(&token->body.if_cond->cond->left, tokens_id.undefined))
+                ERROR("fold error\n", 1, "");
+
+            if(fold(&token->body.if_cond->cond->right, tokens_id.undefined))
+                ERROR("fold error\n", 1, "");
+
+            decided = cond_decide(token->body.if_cond->cond);
+
+            if(block_push(token->body.if_cond->cond, ranges->length))
+                ERROR("block_push error\n", 1, "");
+
+            if(range_push_cond(token->body.if_cond->cond, token->body.if_cond->cond->r))
+                ERROR("range_push_cond error\n", 1, "");
+
+            /* compiler skips check of condition with const values */
+            if(decided != -1)
+                if(cond_fold(token->body.if_cond->cond, (BOOL)decided))
+                    ERROR("cond_fold error\n", 1, "");
+
+            ++depth;
+            break;
+        }
+        case TOKEN_GUARD:
+        {
+            if(token->body.guard->type == tokens_id.else_cond)
+            {
+                if(vector_get_pos(blocks, blocks->length - 1, (void*)&block))
+                    ERROR("vector_get_pos error\n", 1, "");
+
+                range_pop(block.first);
+
+                /* ELSE body has negated condition */
+                if(block.cond->r == tokens_id.lt)
+                    r = tokens_id.ge;
+                else if(block.cond->r == tokens_id.le)
+                    r = tokens_id.gt;
+                else if(block.cond->r == tokens_id.gt)
+                    r = tokens_id.le;
+                else if(block.cond->r == tokens_id.ge)
+                    r = tokens_id.lt;
+                else if(block.cond->r == tokens_id.eq)
+                    r = tokens_id.ne;
+                else
+                    r = tokens_id.eq;
+
+                if(range_push_cond(block.cond, r))
+                    ERROR("range_push_cond error\n", 1, "");
+            }
+            else if(token->body.guard->type != tokens_id.skip)
+            {
+                /* ENDIF, ENDFOR, ENDWHILE */
+                if(block_pop())
+                    ERROR("block_pop error\n", 1, "");
+
+                --depth;
+            }
+
+            break;
+        }
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+int alias_token_end(void)
+{
+    Alias_fold f;
+
+    TRACE("");
+
+    while(folds->length)
+    {
+        if(vector_get_pos(folds, folds->length - 1, (void*)&f))
+            ERROR("vector_get_pos error\n", 1, "");
+
+        value_destroy(*f.slot);
+        *f.slot = f.orig;
+
+        vector_delete_last(folds);
+    }
+
+    if(assigned != NULL)
+    {
+        range_kill(assigned);
+
+        if(assigned_range.lo > 0 || assigned_range.hi != RANGE_MAX)
+            if(range_push(assigned, RANGE_EXPR, &assigned_range))
+                ERROR("range_push error\n", 1, "");
+
+        assigned = NULL;
+    }
+
+    return 0;
+}
+
+void alias_operand_range(BOOL left, uint64_t *lo, uint64_t *hi)
+{
+    TRACE("");
+
+    *lo = operands[left ? 0 : 1].lo;
+    *hi = operands[left ? 0 : 1].hi;
+}
@@ -1,6 +1,12 @@
 #include <arch.h>
 #include <asm.h>
 
+/* compare chunk in memory tree with addr, the same order as mem_chunk_cmp */
+#define MEM_CHUNK_ADDR_CMP(chunk, key) \
+    ((*(chunk))->addr < (key) ? -1 : (*(chunk))->addr > (key) ? 1 : 0)
+
+AVL_SEARCH_DEFINE(mem_chunk_search, mem_chunk*, uint64_t, MEM_CHUNK_ADDR_CMP)
+
 /*
     Init cpu and registers
 
@@ -91,8 +97,8 @@ const operation_cost op_cost =
     .halt   =   0
 };
 
-Memory *memory = NULL;
-CPU *cpu = NULL;
+__thread Memory *memory = NULL;
+__thread CPU *cpu = NULL;
 
 static CPU *cpu_init(void)
 {
@@ -161,6 +167,12 @@ static Memory *memory_init(void)
     memory->arrays_first_addr = 0;
     memory->arrays_last_addr = 0;
 
+    memory->arrays = vector_create(sizeof(Array*));
+    if(memory->arrays == NULL)
+        ERROR("vector_create error\n", NULL, "");
+
+    memory->array_max_len = ARRAY_MAX_LEN;
+
     memory->var_allocated = 0;
     memory->var_first_addr = 0;
     memory->var_last_addr = 0;
@@ -201,6 +213,7 @@ static void memory_destroy(Memory *memory)
     mpz_clear(memory->big_arrays_allocated);
     mpz_clear(memory->big_arrays_first_addr);
 
+    vector_destroy(memory->arrays);
     avl_destroy(memory->memory);
     FREE(memory);
 }
@@ -217,6 +230,22 @@ static void __inline__ dealloc(mem_chunk *chunk)
     FREE(chunk);
 }
 
+uint32_t opcode_get_cost(uint8_t opcode)
+{
+    const uint32_t costs[] =
+    {
+        0, op_cost.get, op_cost.put, op_cost.load, op_cost.store,
+        op_cost.add, op_cost.sub, op_cost.copy, op_cost.shr,
+        op_cost.shl, op_cost.inc, op_cost.dec, op_cost.zero,
+        op_cost.jump, op_cost.jzero, op_cost.jodd, op_cost.halt
+    };
+
+    if(opcode >= ARRAY_SIZE(costs))
+        return 0;
+
+    return costs[opcode];
+}
+
 int mem_chunk_cmp(void *a, void *b)
 {
     mem_chunk *_a = *(mem_chunk**)a;
@@ -250,24 +279,23 @@ void board_destroy(void)
 {
     TRACE("");
 
-    memory_destroy(memory);
-    cpu_destroy(cpu);
+    /* board could be partly created */
+    if(memory != NULL)
+        memory_destroy(memory);
+
+    if(cpu != NULL)
+        cpu_destroy(cpu);
+
+    memory = NULL;
+    cpu = NULL;
 }
 
 int my_malloc(Memory *memory, VAR_TYPE type, void *stct)
 {
     mem_chunk *chunk;
-    mem_chunk *fake_chunk;
 
-    Darray_iterator it;
-
-    var_arr *va;
-    Variable *var;
-    Value *val;
     Array *arr;
 
-    BOOL first_time = TRUE;
-
     mpz_t len;
     mpz_t addr;
 
@@ -305,60 +333,20 @@ int my_malloc(Memory *memory, VAR_TYPE type, void *stct)
         {
             arr = (Array*)stct;
 
-            for(  darray_iterator_init(arr->arr, &it, ITI_BEGIN);
-                ! darray_iterator_end(&it);
-                  darray_iterator_next(&it))
-                {
-                    darray_iterator_get_data(&it, (void*)&va);
-
-                    var = variable_create(VAR_ARR, (void*)va);
-                    if(var == NULL)
-                        ERROR("variable create error\n", 1 ,"");
-
-                    val = value_create(VARIABLE, (void*)var);
-                    if(val == NULL)
-                        ERROR("value create error\n", 1, "");
-
-                    chunk = (mem_chunk*)malloc(sizeof(mem_chunk));
-                    if(chunk == NULL)
-                        ERROR("malloc error\n", 1, "");
-
-                    if(memory->arrays_allocated + memory->arrays_first_addr > memory->arrays_last_addr)
-                        ERROR("not enough memory for arrays\n", 1, "");
-
-                    chunk->val = val;
-                    chunk->addr = memory->arrays_first_addr + memory->arrays_allocated;
-
-                    if(first_time)
-                    {
-                        first_time = FALSE;
-                        arr->chunk = chunk;
-
-                        mpz_init(addr);
+            if(memory->arrays_allocated + arr->len + memory->arrays_first_addr > memory->arrays_last_addr + 1)
+                ERROR("not enough memory for arrays\n", 1, "");
 
-                        ull2mpz(addr, chunk->addr);
+            /* only addr is reserved, elements are allocated on first touch */
+            ull2mpz(arr->addr, memory->arrays_first_addr + memory->arrays_allocated);
+            memory->arrays_allocated += arr->len;
 
-                        mpz_set(arr->addr, addr);
-
-                        mpz_clear(addr);
-                    }
-
-                    ++memory->arrays_allocated;
-
-                    if(alloc(memory, chunk) )
-                        ERROR("alloc error\n", 1, "");
-
-                    val->chunk = chunk;
-                }
+            if(vector_insert_last(memory->arrays, (void*)&arr))
+                ERROR("vector_insert_last error\n", 1, "");
 
             break;
         }
         case LOOP_VAR:
         {
-            fake_chunk = (mem_chunk*)malloc(sizeof(mem_chunk));
-            if(fake_chunk == NULL)
-                ERROR("malloc error\n", 1, "");
-
             chunk = (mem_chunk*)malloc(sizeof(mem_chunk));
             if(chunk == NULL)
                 ERROR("malloc error\n", 1, "");
@@ -372,11 +360,8 @@ int my_malloc(Memory *memory, VAR_TYPE type, void *stct)
 
             /* find place for new chunk */
             for(i = memory->loop_var_first_addr; i <= memory->loop_var_last_addr; ++i)
-            {
-                fake_chunk->addr = i;
-                if( ! avl_key_exist(memory->memory, (void*)&fake_chunk))
+                if(mem_chunk_search(memory->memory, i) == NULL)
                     break;
-            }
 
             chunk->addr = i;
 
@@ -387,8 +372,6 @@ int my_malloc(Memory *memory, VAR_TYPE type, void *stct)
 
             ((Value*)stct)->chunk = chunk;
 
-            FREE(fake_chunk);
-
             break;
         }
         case BIG_ARRAY:
@@ -422,6 +405,71 @@ int my_malloc(Memory *memory, VAR_TYPE type, void *stct)
     return 0;
 }
 
+mem_chunk *memory_array_chunk(uint64_t addr)
+{
+    mem_chunk *chunk;
+
+    var_arr *va;
+    Variable *var;
+    Value *val;
+    Array *arr;
+    Array **arrays;
+
+    uint64_t first;
+    uint64_t left;
+    uint64_t right;
+    uint64_t middle;
+
+    TRACE("");
+
+    if(memory->arrays->length == 0 || addr < memory->arrays_first_addr)
+        ERROR("%ju is not in arrays section\n", NULL, addr);
+
+    /* last array with first addr <= addr */
+    arrays = (Array**)memory->arrays->array;
+    left = 0;
+    right = memory->arrays->length;
+    while(right - left > 1)
+    {
+        middle = (left + right) >> 1;
+        if(mpz2ull(arrays[middle]->addr) <= addr)
+            left = middle;
+        else
+            right = middle;
+    }
+
+    arr = arrays[left];
+    first = mpz2ull(arr->addr);
+    if(addr < first || addr - first >= arr->len)
+        ERROR("%ju is not in arrays section\n", NULL, addr);
+
+    va = array_elem_touch(arr, addr - first);
+    if(va == NULL)
+        ERROR("array_elem_touch error\n", NULL, "");
+
+    var = variable_create(VAR_ARR, (void*)va);
+    if(var == NULL)
+        ERROR("variable create error\n", NULL ,"");
+
+    val = value_create(VARIABLE, (void*)var);
+    if(val == NULL)
+        ERROR("value create error\n", NULL, "");
+
+    chunk = (mem_chunk*)malloc(sizeof(mem_chunk));
+    if(chunk == NULL)
+        ERROR("malloc error\n", NULL, "");
+
+    chunk->val = val;
+    chunk->addr = addr;
+
+    if(alloc(memory, chunk))
+        ERROR("alloc error\n", NULL, "");
+
+    val->chunk = chunk;
+
+    return chunk;
+}
+
 int free_loop_section(Memory *memory)
 {
     uint64_t i;
@@ -435,22 +483,20 @@ int free_loop_section(Memory *memory)
 
 int my_free(Memory *memory, uint64_t addr)
 {
-    mem_chunk *key;
+    mem_chunk **node;
     mem_chunk *chunk;
 
-    key = (mem_chunk*)malloc(sizeof(mem_chunk));
-    key->addr = addr;
-
-    if(avl_key_exist(memory->memory, (void*)&key))
+    node = mem_chunk_search(memory->memory, addr);
+    if(node != NULL)
     {
-        if( avl_search(memory->memory, (void*)&key, (void*)&chunk) )
-            ERROR("avl_search error\n", 1, "");
+        chunk = *node;
 
-            dealloc(chunk);
-
-        if( avl_delete(memory->memory, (void*)&key) )
+        /* avl compares chunks while deleting, so free chunk after that */
+        if( avl_delete(memory->memory, (void*)&chunk) )
             ERROR("avl_delete error\n", 1, "");
 
+        dealloc(chunk);
+
         if(addr >= memory->var_first_addr && addr <= memory->var_last_addr)
             --memory->var_allocated;
         else if (addr >= memory->loop_var_first_addr && addr <= memory->loop_var_last_addr)
@@ -459,7 +505,5 @@ int my_free(Memory *memory, uint64_t addr)
             --memory->arrays_allocated;
     }
 
-    FREE(key);
-
     return 0;
 }
@@ -0,0 +1,198 @@
+#include <arena.h>
+
+__thread Arena *compile_arena = NULL;
+
+/*
+    Add new chunk to arena
+
+    PARAMS
+    @IN arena - pointer to arena
+    @IN size - min free bytes in chunk
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int arena_chunk_add(Arena *arena, size_t size) __nonull__(1);
+
+static int arena_chunk_add(Arena *arena, size_t size)
+{
+    Arena_chunk *chunk;
+
+    TRACE("");
+
+    /* place for alignment of first object */
+    size = MAX(size + ARENA_ALIGN, (size_t)ARENA_CHUNK_SIZE);
+
+    chunk = (Arena_chunk*)malloc(sizeof(Arena_chunk) + size);
+    if(chunk == NULL)
+        ERROR("malloc error\n", 1, "");
+
+    chunk->size = size;
+    chunk->used = 0;
+    chunk->next = arena->chunk;
+
+    arena->chunk = chunk;
+    ++arena->chunks;
+
+    return 0;
+}
+
+Arena *arena_create(void)
+{
+    Arena *arena;
+
+    TRACE("");
+
+    arena = (Arena*)calloc(1, sizeof(Arena));
+    if(arena == NULL)
+        ERROR("calloc error\n", NULL, "");
+
+    return arena;
+}
+
+void arena_destroy(Arena *arena)
+{
+    Arena_chunk *chunk;
+    Arena_defer *defer;
+
+    TRACE("");
+
+    if(arena == NULL)
+    {
+        LOG("arena == NULL\n", "");
+        return;
+    }
+
+    LOG("arena: %ju allocs, %ju reused, %ju bytes, %ju chunks\n",
+        arena->allocs, arena->reused, arena->bytes, arena->chunks);
+
+    /* defers live in arena, so call them before chunks are freed */
+    for(defer = arena->defer; defer != NULL; defer = defer->next)
+        defer->release(defer->ptr);
+
+    while(arena->chunk != NULL)
+    {
+        chunk = arena->chunk;
+        arena->chunk = chunk->next;
+
+        FREE(chunk);
+    }
+
+    FREE(arena);
+}
+
+void arena_reset(Arena *arena)
+{
+    Arena_chunk *chunk;
+    Arena_defer *defer;
+
+    TRACE("");
+
+    LOG("arena: %ju allocs, %ju reused, %ju bytes, %ju chunks\n",
+        arena->allocs, arena->reused, arena->bytes, arena->chunks);
+
+    for(defer = arena->defer; defer != NULL; defer = defer->next)
+        defer->release(defer->ptr);
+
+    /* older chunks are freed, so there is one chunk after many compilations */
+    if(arena->chunk != NULL)
+    {
+        while(arena->chunk->next != NULL)
+        {
+            chunk = arena->chunk->next;
+            arena->chunk->next = chunk->next;
+
+            FREE(chunk);
+        }
+
+        arena->chunk->used = 0;
+    }
+
+    arena->defer = NULL;
+    (void)memset(arena->pool, 0, sizeof(arena->pool));
+
+    arena->allocs = 0;
+    arena->reused = 0;
+    arena->bytes = 0;
+    arena->chunks = arena->chunk != NULL ? 1 : 0;
+}
+
+void *arena_get(Arena *arena, int pool, size_t size, BOOL *reused)
+{
+    Arena_chunk *chunk = arena->chunk;
+    uintptr_t addr = 0;
+    size_t pad = 0;
+    void *ptr;
+
+    ++arena->allocs;
+
+    if(pool != ARENA_NO_POOL && arena->pool[pool] != NULL)
+    {
+        ptr = arena->pool[pool];
+        arena->pool[pool] = *(void**)ptr;
+
+        ++arena->reused;
+        if(reused != NULL)
+            *reused = TRUE;
+
+        return ptr;
+    }
+
+    if(reused != NULL)
+        *reused = FALSE;
+
+    /* object from free list of class is reused by object of any size from class */
+    if(pool != ARENA_NO_POOL && pool < ARENA_CLASSES)
+        size = (size_t)(pool + 1) * ARENA_ALIGN;
+
+    if(chunk != NULL)
+    {
+        addr = (uintptr_t)(chunk->data + chunk->used);
+        pad = (ARENA_ALIGN - (addr & (ARENA_ALIGN - 1))) & (ARENA_ALIGN - 1);
+    }
+
+    if(chunk == NULL || chunk->used + pad + size > chunk->size)
+    {
+        if(arena_chunk_add(arena, size))
+            ERROR("arena_chunk_add error\n", NULL, "");
+
+        chunk = arena->chunk;
+        addr = (uintptr_t)chunk->data;
+        pad = (ARENA_ALIGN - (addr & (ARENA_ALIGN - 1))) & (ARENA_ALIGN - 1);
+    }
+
+    chunk->used += pad;
+    ptr = (void*)(chunk->data + chunk->used);
+    chunk->used += size;
+
+    arena->bytes += size;
+
+    return ptr;
+}
+
+void arena_put(Arena *arena, int pool, void *ptr)
+{
+    if(pool == ARENA_NO_POOL)
+        return;
+
+    *(void**)ptr = arena->pool[pool];
+    arena->pool[pool] = ptr;
+}
+
+int arena_defer(Arena *arena, void (*release)(void *ptr), void *ptr)
+{
+    Arena_defer *defer;
+
+    defer = (Arena_defer*)arena_get(arena, ARENA_NO_POOL, sizeof(Arena_defer), NULL);
+    if(defer == NULL)
+        ERROR("arena_get error\n", 1, "");
+
+    defer->release = release;
+    defer->ptr = ptr;
+    defer->next = arena->defer;
+
+    arena->defer = defer;
+
+    return 0;
+}
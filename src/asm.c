@@ -1,5 +1,6 @@
 #include <asm.h>
 #include <arch.h>
+#include <arena.h>
 #include <common.h>
 
 const Mnemonics mnemonics =
@@ -44,15 +45,148 @@ const Opcodes opcodes =
 
 };
 
+int asm_line_parse(const char *str, Asm_line *line)
+{
+    char name[16];
+    unsigned long long arg1 = 0;
+    unsigned long long arg2 = 0;
+
+    uint8_t i;
+
+    const char *names[] =
+    {
+        mnemonics.get, mnemonics.put, mnemonics.load, mnemonics.store,
+        mnemonics.add, mnemonics.sub, mnemonics.copy, mnemonics.shr,
+        mnemonics.shl, mnemonics.inc, mnemonics.dec, mnemonics.zero,
+        mnemonics.jump, mnemonics.jzero, mnemonics.jodd, mnemonics.halt
+    };
+
+    const uint8_t codes[] =
+    {
+        opcodes.get, opcodes.put, opcodes.load, opcodes.store,
+        opcodes.add, opcodes.sub, opcodes.copy, opcodes.shr,
+        opcodes.shl, opcodes.inc, opcodes.dec, opcodes.zero,
+        opcodes.jump, opcodes.jzero, opcodes.jodd, opcodes.halt
+    };
+
+    TRACE("");
+
+    if(sscanf(str, "%15s %llu %llu", name, &arg1, &arg2) < 1)
+        ERROR("bad asm line %s\n", 1, str);
+
+    for(i = 0; i < ARRAY_SIZE(codes); ++i)
+        if(! strcmp(name, names[i]))
+            break;
+
+    if(i == ARRAY_SIZE(codes))
+        ERROR("unknown mnemonic %s\n", 1, name);
+
+    line->opcode = codes[i];
+    line->reg = 0;
+    line->target = 0;
+
+    if(line->opcode == opcodes.jump)
+        line->target = arg1;
+    else if(line->opcode == opcodes.jzero || line->opcode == opcodes.jodd)
+    {
+        line->reg = arg1;
+        line->target = arg2;
+    }
+    else if(line->opcode != opcodes.halt)
+        line->reg = arg1;
+
+    return 0;
+}
+
+/*
+    Release memory owned by object from compile_arena, called by arena_destroy
+
+    PARAMS
+    @IN ptr - pointer to const_value or var_normal
+
+    RETURN:
+    This is a void function
+*/
+static void const_value_release(void *ptr);
+static void var_normal_release(void *ptr);
+
+/*
+    Hash of element in Array->elems ( by offset )
+
+    PARAMS
+    @IN va - addr of var_arr*
+
+    RETURN:
+    Hash of offset
+*/
+static uint64_t array_elem_hash(void *va);
+
+/*
+    Compare elements in Array->elems by offset
+
+    PARAMS
+    @IN va1 - addr of 1st var_arr*
+    @IN va2 - addr of 2nd var_arr*
+
+    RETURN:
+    0 iff elements have the same offset
+    1 iff not
+*/
+static int array_elem_cmp(void *va1, void *va2);
+
+/*
+    Compare element in Array->elems with offset
+
+    PARAMS
+    @IN va - addr of var_arr*
+    @IN offset - addr of offset
+
+    RETURN:
+    0 iff element has this offset
+    1 iff not
+*/
+static int array_elem_offset_cmp(void *va, const void *offset);
+
+/* hash of offset ( fibonacci hashing ) */
+#define OFFSET_HASH(offset) ((uint64_t)(offset) * 0x9E3779B97F4A7C15ull)
+
+static void const_value_release(void *ptr)
+{
+    mpz_clear(((const_value*)ptr)->big_value);
+}
+
+static void var_normal_release(void *ptr)
+{
+    var_normal *var = (var_normal*)ptr;
+
+    mpz_clear(var->value);
+    FREE(var->symbolic_value);
+}
+
+static uint64_t array_elem_hash(void *va)
+{
+    return OFFSET_HASH((*(var_arr**)va)->offset);
+}
+
+static int array_elem_cmp(void *va1, void *va2)
+{
+    return (*(var_arr**)va1)->offset != (*(var_arr**)va2)->offset;
+}
+
+static int array_elem_offset_cmp(void *va, const void *offset)
+{
+    return (*(var_arr**)va)->offset != *(const uint64_t*)offset;
+}
+
 const_value *const_value_create(uint64_t val)
 {
     const_value *cv;
 
     TRACE("");
 
-    cv = (const_value*)malloc(sizeof(const_value));
+    cv = (const_value*)node_alloc(sizeof(const_value));
     if(cv == NULL)
-        ERROR("malloc errro\n", NULL, "");
+        ERROR("node_alloc error\n", NULL, "");
 
     cv->value = val;
     cv->type = CONST_VAL;
@@ -66,9 +200,9 @@ const_value *const_bigvalue_create(mpz_t val)
 
     TRACE("");
 
-    cv = (const_value*)malloc(sizeof(const_value));
+    cv = (const_value*)node_alloc(sizeof(const_value));
     if(cv == NULL)
-        ERROR("malloc errro\n", NULL, "");
+        ERROR("node_alloc error\n", NULL, "");
 
     cv->value = 0;
     cv->type = BIG_CONST;
@@ -76,6 +210,9 @@ const_value *const_bigvalue_create(mpz_t val)
     mpz_init(cv->big_value);
     mpz_set(cv->big_value, val);
 
+    if(compile_arena != NULL && arena_defer(compile_arena, const_value_release, (void*)cv))
+        ERROR("arena_defer error\n", NULL, "");
+
     return cv;
 }
 
@@ -90,9 +227,15 @@ void const_value_destroy(const_value *cv)
     }
 
     if(cv->type == BIG_CONST)
+    {
+        /* mpz_t is cleared by arena_destroy, so object can not be reused */
+        if(compile_arena != NULL)
+            return;
+
         mpz_clear(cv->big_value);
+    }
 
-    FREE(cv);
+    NODE_FREE(cv);
 }
 
 void const_value_print(const_value *cv)
@@ -106,28 +249,55 @@ void const_value_print(const_value *cv)
         return;
     }
 
-    printf(" %ju ", cv->value);
+    if(cv->type == BIG_CONST)
+        gmp_printf(" %Zd ", cv->big_value);
+    else
+        printf(" %ju ", cv->value);
 }
 
 var_normal *var_normal_create(const char *name)
 {
     var_normal *var;
+    BOOL reused;
 
     TRACE("");
 
     if(name == NULL)
         ERROR("name == NULL\n", NULL, "");
 
-    var = (var_normal*)malloc(sizeof(var_normal));
+    if(compile_arena == NULL)
+    {
+        var = (var_normal*)malloc(sizeof(var_normal));
+        if(var == NULL)
+            ERROR("malloc error\n", NULL, "");
 
-    if(asprintf(&var->name, "%s", name) == -1)
-        ERROR("asprintf error\n", NULL, "");
+        mpz_init(var->value);
+    }
+    else
+    {
+        /* var_normal from pool has initialized mpz_t, so mpz_init is called once per object */
+        var = (var_normal*)arena_get(compile_arena, ARENA_POOL_VAR, sizeof(var_normal), &reused);
+        if(var == NULL)
+            ERROR("arena_get error\n", NULL, "");
 
-    mpz_init(var->value);
+        if(reused)
+            mpz_set_ui(var->value, 0);
+        else
+        {
+            mpz_init(var->value);
+
+            if(arena_defer(compile_arena, var_normal_release, (void*)var))
+                ERROR("arena_defer error\n", NULL, "");
+        }
+    }
 
     var->symbolic_value = NULL;
     var->is_symbolic = 0;
 
+    var->name = node_strdup(name);
+    if(var->name == NULL)
+        ERROR("node_strdup error\n", NULL, "");
+
     return var;
 }
 
@@ -142,10 +312,16 @@ void var_normal_destroy(var_normal *var)
         return;
     }
 
-    mpz_clear(var->value);
-
-    FREE(var->name);
+    NODE_FREE_STR(var->name);
     FREE(var->symbolic_value);
+
+    if(compile_arena != NULL)
+    {
+        arena_put(compile_arena, ARENA_POOL_VAR, (void*)var);
+        return;
+    }
+
+    mpz_clear(var->value);
     FREE(var);
 }
 
@@ -191,9 +367,9 @@ var_arr *var_arr_create(var_normal *var, Array *arr, uint64_t offset)
     if(var == NULL)
         ERROR("var == NULL\n", NULL, "");
 
-    va = (var_arr*)malloc(sizeof(var_arr));
+    va = (var_arr*)node_alloc(sizeof(var_arr));
     if(va == NULL)
-        ERROR("malloc error\n", NULL, "");
+        ERROR("node_alloc error\n", NULL, "");
 
     va->var = var;
     va->arr = arr;
@@ -219,7 +395,7 @@ void var_arr_destroy(var_arr *va)
     if(va->var_offset != NULL)
         var_normal_destroy(va->var_offset);
 
-    FREE(va);
+    NODE_FREE(va);
 }
 
 int var_arr_cmp(void *va1, void *va2)
@@ -293,9 +469,9 @@ Variable *variable_create(VAR_TYPE type, void *str)
     if( (type != VAR_NORMAL && type != VAR_ARR ) || str == NULL)
         ERROR("(type != VAR_NORMAL && type != VAR_ARR ) || str == NULL\n", NULL, "");
 
-    var = (Variable*)malloc(sizeof(Variable));
+    var = (Variable*)node_alloc(sizeof(Variable));
     if(var == NULL)
-        ERROR("malloc error\n", NULL, "");
+        ERROR("node_alloc error\n", NULL, "");
 
     var->type = type;
 
@@ -313,8 +489,6 @@ Variable *variable_create(VAR_TYPE type, void *str)
         }
         default:
         {
-            FREE(var);
-
             /* This is obsolete but to avoid warn with no default i declare it */
             ERROR("unrecognized type\n", NULL, "");
         }
@@ -353,7 +527,7 @@ void variable_destroy(Variable *var)
         }
     }
 
-    FREE(var);
+    NODE_FREE(var);
 }
 
 int variable_cmp(void *var1, void *var2)
@@ -460,9 +634,9 @@ Value *value_create(VAR_TYPE type, void *str)
     if( (type != CONST_VAL && type != VARIABLE) || str == NULL )
         ERROR("(type != CONST_VAL && type != VARIABLE) || str == NULL\n", NULL, "");
 
-    val = (Value*)malloc(sizeof(Value));
+    val = (Value*)node_alloc(sizeof(Value));
     if(val == NULL)
-        ERROR("malloc error\n", NULL, "");
+        ERROR("node_alloc error\n", NULL, "");
 
     val->type = type;
 
@@ -480,8 +654,6 @@ Value *value_create(VAR_TYPE type, void *str)
         }
         default:
         {
-            FREE(val);
-
             /* This is obsolete but to avoid warn with no default i declare it */
             ERROR("unrecognized type\n", NULL, "");
         }
@@ -523,7 +695,7 @@ void value_destroy(Value *val)
         }
     }
 
-    FREE(val);
+    NODE_FREE(val);
 }
 
 void value_print(Value *value)
@@ -573,7 +745,12 @@ char *value_str(Value *val)
     {
         case CONST_VAL:
         {
-            if(asprintf(&str, " %ju ", val->body.cv->value) == -1)
+            if(val->body.cv->type == BIG_CONST)
+            {
+                if(gmp_asprintf(&str, " %Zd ", val->body.cv->big_value) == -1)
+                    ERROR("gmp_asprintf error\n", NULL, "");
+            }
+            else if(asprintf(&str, " %ju ", val->body.cv->value) == -1)
                 ERROR("asprintf error\n", NULL, "");
 
             break;
@@ -757,16 +934,14 @@ int value_copy(Value **dst, Value *src)
 
     if(src->type == CONST_VAL)
     {
-        cv = const_value_create(0ull);
+        if(src->body.cv->type == BIG_CONST)
+            cv = const_bigvalue_create(src->body.cv->big_value);
+        else
+            cv = const_value_create(src->body.cv->value);
+
         if(cv == NULL)
             ERROR("const_value_create error\n", 1, "");
 
-        cv->type = src->body.cv->type;
-        cv->value = src->body.cv->value;
-
-        if(cv->type == BIG_CONST)
-            mpz_set(cv->big_value, src->body.cv->big_value);
-
         val = value_create(CONST_VAL, (void*)cv);
         if(val == NULL)
             ERROR("value_create error\n", 1, "");
@@ -845,29 +1020,9 @@ int value_copy(Value **dst, Value *src)
     return 0;
 }
 
-Array *array_create(const char *name, uint64_t len)
+Array *array_create(const char *name, uint64_t len, uint64_t max_len)
 {
-/*
-    Private define
-*/
-#define CLEANUP(DA, IT, VA) \
-    do{ \
-        for(  darray_iterator_init(DA, &IT, ITI_BEGIN); \
-            ! darray_iterator_end(&IT); \
-              darray_iterator_next(&IT)) \
-        { \
-            darray_iterator_get_data(&IT, (void*)&VA); \
-            var_arr_destroy(VA); \
-        } \
-    }while(0)
-
-    uint64_t i;
-
     Array *array;
-    var_arr *va;
-    var_normal *var;
-
-    Darray_iterator it;
 
     TRACE("");
 
@@ -882,58 +1037,78 @@ Array *array_create(const char *name, uint64_t len)
         ERROR("asprintf error\n", NULL, "");
 
     mpz_init(array->addr);
-    array->chunk = NULL;
 
     array->len = len;
-    if(len <= ARRAY_MAX_LEN)
-    {
-        array->type = ARRAY;
+    array->type = len <= max_len ? ARRAY : BIG_ARRAY;
+    array->elems = NULL;
 
-        array->arr = darray_create(UNSORTED, 1 << 10, sizeof(var_arr*), var_arr_cmp);
-        if(array->arr == NULL)
-            ERROR("darray_create error\n", NULL, "");
+    return array;
+}
 
-        for(i = 0; i < len; ++i)
-        {
-            var = var_normal_create(name);
-            if(var == NULL)
-            {
-                CLEANUP(array->arr, it, va);
+var_arr *array_elem_get(Array *array, uint64_t offset)
+{
+    var_arr **va;
 
-                ERROR("var_normal_create error\n", NULL, "");
-            }
+    TRACE("");
 
-            va = var_arr_create(var, array, i);
-            if(va == NULL)
-            {
-                var_normal_destroy(var);
-                CLEANUP(array->arr, it, va);
+    if(array->elems == NULL)
+        return NULL;
 
-                ERROR("var_arr_create error\n", NULL, "");
-            }
+    va = (var_arr**)hashmap_search_hash(array->elems, OFFSET_HASH(offset),
+                                        (const void*)&offset, array_elem_offset_cmp);
+    if(va == NULL)
+        return NULL;
 
-            if( darray_insert(array->arr, (void*)&va) )
-            {
-                var_arr_destroy(va);
-                CLEANUP(array->arr, it, va);
-                ERROR("darray_insert_last error\n", NULL, "");
-            }
-        }
+    return *va;
+}
+
+var_arr *array_elem_touch(Array *array, uint64_t offset)
+{
+    var_arr *va;
+    var_normal *var;
+
+    TRACE("");
+
+    if(array->type != ARRAY || offset >= array->len)
+        ERROR("%s[%ju] is not element of small array\n", NULL, array->name, offset);
+
+    va = array_elem_get(array, offset);
+    if(va != NULL)
+        return va;
+
+    if(array->elems == NULL)
+    {
+        array->elems = hashmap_create(sizeof(var_arr*), array_elem_hash, array_elem_cmp);
+        if(array->elems == NULL)
+            ERROR("hashmap_create error\n", NULL, "");
     }
-    else
+
+    var = var_normal_create(array->name);
+    if(var == NULL)
+        ERROR("var_normal_create error\n", NULL, "");
+
+    /* value is not known until compiler stores known value */
+    var->is_symbolic = 1;
+
+    va = var_arr_create(var, array, offset);
+    if(va == NULL)
     {
-        array->type = BIG_ARRAY;
-        array->arr = NULL;
+        var_normal_destroy(var);
+        ERROR("var_arr_create error\n", NULL, "");
     }
 
-    return array;
+    if(hashmap_insert(array->elems, (void*)&va))
+    {
+        var_arr_destroy(va);
+        ERROR("hashmap_insert error\n", NULL, "");
+    }
 
-#undef CLEANUP
+    return va;
 }
 
 void array_destroy(Array *array)
 {
-    Darray_iterator it;
+    Hashmap_iterator it;
     var_arr *va;
 
     TRACE("");
@@ -944,18 +1119,18 @@ void array_destroy(Array *array)
         return;
     }
 
-    if(array->type == ARRAY)
+    if(array->elems != NULL)
     {
-        for( darray_iterator_init(array->arr, &it, ITI_BEGIN); \
-             ! darray_iterator_end(&it); \
-             darray_iterator_next(&it))
-             {
-                darray_iterator_get_data(&it,(void*)&va);
+        for(  hashmap_iterator_init(array->elems, &it, ITI_BEGIN);
+            ! hashmap_iterator_end(&it);
+              hashmap_iterator_next(&it))
+            {
+                hashmap_iterator_get_data(&it, (void*)&va);
 
                 var_arr_destroy(va);
-             }
+            }
 
-        darray_destroy(array->arr);
+        hashmap_destroy(array->elems);
     }
 
     mpz_clear(array->addr);
@@ -0,0 +1,524 @@
+#include <cache.h>
+#include <filebuffer.h>
+#include <dirent.h>
+#include <errno.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+/* FNV-1a 128 */
+__extension__ typedef unsigned __int128 uint128_t;
+
+#define FNV128_OFFSET   (((uint128_t)0x6c62272e07bb0142ull << 64) | 0x62b821756295c58dull)
+#define FNV128_PRIME    (((uint128_t)0x0000000001000000ull << 64) | 0x000000000000013bull)
+
+#define CACHE_COPY_BUF  (1 << 16)
+
+typedef struct Entry
+{
+    char name[(CACHE_KEY_LEN << 1) + 1];
+    struct timespec used; /* mtime, touched on hit */
+    uint64_t size;
+
+}Entry;
+
+/*
+    Hash bytes with FNV-1a 128
+
+    PARAMS
+    @IN hash - current hash
+    @IN data - bytes
+    @IN len - number of bytes
+
+    RETURN:
+    New hash
+*/
+static uint128_t fnv_update(uint128_t hash, const void *data, size_t len);
+
+/*
+    Lock cache directory ( between threads and processes )
+
+    PARAMS
+    @IN dir - cache directory
+
+    RETURN:
+    -1 iff failure
+    descriptor of lock iff success ( close it to unlock )
+*/
+static int cache_lock(const char *dir) __nonull__(1);
+
+/*
+    Read and write stats file, caller holds lock
+
+    PARAMS
+    @IN dir - cache directory
+    @IN stats - stats to write or read
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int stats_read(const char *dir, Cache_stats *stats) __nonull__(1, 2);
+static int stats_write(const char *dir, const Cache_stats *stats) __nonull__(1, 2);
+
+/*
+    Copy file
+
+    PARAMS
+    @IN src - source path
+    @IN dst - destination path
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int copy_file(const char *src, const char *dst) __nonull__(1, 2);
+
+/*
+    Get all entries of cache, caller holds lock
+
+    PARAMS
+    @IN dir - cache directory
+    @OUT entries - array of entries ( don't forget to free )
+    @OUT n - number of entries
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int entries_get(const char *dir, Entry **entries, size_t *n) __nonull__(1, 2, 3);
+
+/*
+    Compare entries by last use, the oldest first
+
+    PARAMS
+    @IN a - pointer to Entry
+    @IN b - pointer to Entry
+
+    RETURN:
+    -1 iff a was used before b
+    0 iff a and b were used at the same time
+    1 iff a was used after b
+*/
+static int entry_cmp(const void *a, const void *b) __nonull__(1, 2);
+
+static uint128_t fnv_update(uint128_t hash, const void *data, size_t len)
+{
+    const uint8_t *bytes = (const uint8_t*)data;
+    size_t i;
+
+    for(i = 0; i < len; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= FNV128_PRIME;
+    }
+
+    return hash;
+}
+
+static int cache_lock(const char *dir)
+{
+    char *path;
+    int fd;
+
+    TRACE("");
+
+    if(asprintf(&path, "%s/%s", dir, CACHE_LOCK_FILE) == -1)
+        ERROR("asprintf error\n", -1, "");
+
+    fd = open(path, O_RDWR | O_CREAT, 0644);
+    FREE(path);
+
+    if(fd == -1)
+        ERROR("cannot open lock file\n", -1, "");
+
+    /* lock belongs to open file, so each thread with own descriptor waits too */
+    if(flock(fd, LOCK_EX))
+    {
+        close(fd);
+        ERROR("flock error\n", -1, "");
+    }
+
+    return fd;
+}
+
+static int stats_read(const char *dir, Cache_stats *stats)
+{
+    char *path;
+    FILE *f;
+    uintmax_t hits;
+    uintmax_t misses;
+    uintmax_t evictions;
+
+    TRACE("");
+
+    (void)memset(stats, 0, sizeof(*stats));
+
+    if(asprintf(&path, "%s/%s", dir, CACHE_STATS_FILE) == -1)
+        ERROR("asprintf error\n", 1, "");
+
+    f = fopen(path, "r");
+    FREE(path);
+
+    /* new cache */
+    if(f == NULL)
+        return 0;
+
+    if(fscanf(f, "hits %ju\nmisses %ju\nevictions %ju\n", &hits, &misses, &evictions) == 3)
+    {
+        stats->hits = (uint64_t)hits;
+        stats->misses = (uint64_t)misses;
+        stats->evictions = (uint64_t)evictions;
+    }
+
+    fclose(f);
+
+    return 0;
+}
+
+static int stats_write(const char *dir, const Cache_stats *stats)
+{
+    char *path;
+    FILE *f;
+
+    TRACE("");
+
+    if(asprintf(&path, "%s/%s", dir, CACHE_STATS_FILE) == -1)
+        ERROR("asprintf error\n", 1, "");
+
+    f = fopen(path, "w");
+    FREE(path);
+
+    if(f == NULL)
+        ERROR("cannot write stats\n", 1, "");
+
+    fprintf(f, "hits %ju\nmisses %ju\nevictions %ju\n", (uintmax_t)stats->hits,
+            (uintmax_t)stats->misses, (uintmax_t)stats->evictions);
+
+    fclose(f);
+
+    return 0;
+}
+
+static int copy_file(const char *src, const char *dst)
+{
+    char buf[CACHE_COPY_BUF];
+    ssize_t r;
+    ssize_t w;
+    ssize_t done;
+    int in;
+    int out;
+    int ret = 0;
+
+    TRACE("");
+
+    in = open(src, O_RDONLY);
+    if(in == -1)
+        return 1;
+
+    out = open(dst, O_WRONLY | O_TRUNC | O_CREAT, 0644);
+    if(out == -1)
+    {
+        close(in);
+        ERROR("cannot open %s file\n", 1, dst);
+    }
+
+    while((r = read(in, buf, sizeof(buf))) > 0)
+        for(done = 0; done < r; done += w)
+        {
+            w = write(out, buf + done, (size_t)(r - done));
+            if(w <= 0)
+            {
+                r = -1;
+                break;
+            }
+        }
+
+    if(r < 0)
+        ret = 1;
+
+    close(in);
+    if(close(out))
+        ret = 1;
+
+    return ret;
+}
+
+static int entries_get(const char *dir, Entry **entries, size_t *n)
+{
+    DIR *d;
+    struct dirent *de;
+    struct stat st;
+    size_t size = 0;
+    char *path;
+    Entry *temp;
+
+    TRACE("");
+
+    *entries = NULL;
+    *n = 0;
+
+    d = opendir(dir);
+    if(d == NULL)
+        ERROR("cannot open %s dir\n", 1, dir);
+
+    while((de = readdir(d)) != NULL)
+    {
+        /* only entries, skip stats, lock and temp files */
+        if(strlen(de->d_name) != (CACHE_KEY_LEN << 1)
+            || strspn(de->d_name, "0123456789abcdef") != (CACHE_KEY_LEN << 1))
+            continue;
+
+        if(asprintf(&path, "%s/%s", dir, de->d_name) == -1)
+            break;
+
+        if(stat(path, &st))
+        {
+            FREE(path);
+            continue;
+        }
+
+        FREE(path);
+
+        if(*n == size)
+        {
+            size = size ? size << 1 : 64;
+            temp = (Entry*)realloc(*entries, sizeof(Entry) * size);
+            if(temp == NULL)
+            {
+                closedir(d);
+                FREE(*entries);
+                ERROR("realloc error\n", 1, "");
+            }
+
+            *entries = temp;
+        }
+
+        (void)strcpy((*entries)[*n].name, de->d_name);
+        (*entries)[*n].used = st.st_mtim;
+        (*entries)[*n].size = (uint64_t)st.st_size;
+        ++*n;
+    }
+
+    closedir(d);
+
+    return 0;
+}
+
+static int entry_cmp(const void *a, const void *b)
+{
+    const Entry *e1 = (const Entry*)a;
+    const Entry *e2 = (const Entry*)b;
+
+    if(e1->used.tv_sec != e2->used.tv_sec)
+        return e1->used.tv_sec < e2->used.tv_sec ? -1 : 1;
+
+    if(e1->used.tv_nsec != e2->used.tv_nsec)
+        return e1->used.tv_nsec < e2->used.tv_nsec ? -1 : 1;
+
+    return 0;
+}
+
+int cache_key(const Option *opt, Cache_key *key)
+{
+    uint128_t hash = FNV128_OFFSET;
+    file_buffer *fb;
+    struct stat st;
+    uint8_t flags;
+    int fd;
+    int i;
+
+    TRACE("");
+
+    if(opt->input_file == NULL)
+        ERROR("input file == NULL\n", 1, "");
+
+    /* new compiler binary can generate other code */
+    hash = fnv_update(hash, COMPILER_VERSION, sizeof(COMPILER_VERSION));
+    if(stat("/proc/self/exe", &st) == 0)
+    {
+        hash = fnv_update(hash, &st.st_size, sizeof(st.st_size));
+        hash = fnv_update(hash, &st.st_mtim, sizeof(st.st_mtim));
+    }
+
+    flags = (uint8_t)(opt->wall | (opt->werr << 1) | (opt->optimal << 2) | (opt->tokens << 4));
+    hash = fnv_update(hash, &flags, sizeof(flags));
+
+    fd = open(opt->input_file, O_RDONLY);
+    if(fd == -1)
+        ERROR("cannot open %s file\n", 1, opt->input_file);
+
+    fb = file_buffer_create(fd, PROT_READ);
+    if(fb == NULL)
+    {
+        close(fd);
+        ERROR("file_buffer_create error\n", 1, "");
+    }
+
+    hash = fnv_update(hash, fb->buffer, fb->size);
+
+    file_buffer_destroy(fb);
+    close(fd);
+
+    for(i = 0; i < CACHE_KEY_LEN; ++i)
+    {
+        key->hash[i] = (uint8_t)(hash >> ((CACHE_KEY_LEN - 1 - i) << 3));
+        (void)sprintf(&key->hex[i << 1], "%02x", key->hash[i]);
+    }
+
+    return 0;
+}
+
+int cache_get(const char *dir, const Cache_key *key, const char *output)
+{
+    Cache_stats stats;
+    char *path;
+    int lock;
+    int ret;
+
+    TRACE("");
+
+    if(mkdir(dir, 0755) && errno != EEXIST)
+        ERROR("cannot create %s dir\n", 1, dir);
+
+    lock = cache_lock(dir);
+    if(lock == -1)
+        ERROR("cache_lock error\n", 1, "");
+
+    if(asprintf(&path, "%s/%s", dir, key->hex) == -1)
+    {
+        close(lock);
+        ERROR("asprintf error\n", 1, "");
+    }
+
+    ret = copy_file(path, output);
+
+    (void)stats_read(dir, &stats);
+    if(ret == 0)
+    {
+        ++stats.hits;
+
+        /* entry was used, so evict it later */
+        (void)utimes(path, NULL);
+    }
+    else
+        ++stats.misses;
+
+    (void)stats_write(dir, &stats);
+
+    FREE(path);
+    close(lock);
+
+    return ret;
+}
+
+int cache_put(const char *dir, uint64_t max_size, const Cache_key *key, const char *output)
+{
+    Cache_stats stats;
+    Entry *entries;
+    size_t n;
+    size_t i;
+    uint64_t size;
+    char *path;
+    char *tmp;
+    int lock;
+    int ret;
+
+    TRACE("");
+
+    if(mkdir(dir, 0755) && errno != EEXIST)
+        ERROR("cannot create %s dir\n", 1, dir);
+
+    lock = cache_lock(dir);
+    if(lock == -1)
+        ERROR("cache_lock error\n", 1, "");
+
+    if(asprintf(&path, "%s/%s", dir, key->hex) == -1)
+    {
+        close(lock);
+        ERROR("asprintf error\n", 1, "");
+    }
+
+    if(asprintf(&tmp, "%s.tmp", path) == -1)
+    {
+        FREE(path);
+        close(lock);
+        ERROR("asprintf error\n", 1, "");
+    }
+
+    /* reader never sees half written entry */
+    ret = copy_file(output, tmp) || rename(tmp, path);
+    if(ret)
+        (void)unlink(tmp);
+
+    FREE(tmp);
+    FREE(path);
+
+    /* evict the least recently used entries */
+    if(ret == 0 && entries_get(dir, &entries, &n) == 0)
+    {
+        size = 0;
+        for(i = 0; i < n; ++i)
+            size += entries[i].size;
+
+        if(size > max_size)
+        {
+            (void)stats_read(dir, &stats);
+
+            qsort(entries, n, sizeof(Entry), entry_cmp);
+            for(i = 0; i < n && size > max_size; ++i)
+            {
+                if(asprintf(&path, "%s/%s", dir, entries[i].name) == -1)
+                    break;
+
+                if(unlink(path) == 0)
+                {
+                    size -= entries[i].size;
+                    ++stats.evictions;
+                }
+
+                FREE(path);
+            }
+
+            (void)stats_write(dir, &stats);
+        }
+
+        FREE(entries);
+    }
+
+    close(lock);
+
+    return ret;
+}
+
+int cache_stats(const char *dir, Cache_stats *stats)
+{
+    Entry *entries;
+    size_t n;
+    size_t i;
+    int lock;
+
+    TRACE("");
+
+    lock = cache_lock(dir);
+    if(lock == -1)
+        ERROR("cache_lock error\n", 1, "");
+
+    (void)stats_read(dir, stats);
+
+    if(entries_get(dir, &entries, &n))
+    {
+        close(lock);
+        ERROR("entries_get error\n", 1, "");
+    }
+
+    stats->entries = (uint64_t)n;
+    for(i = 0; i < n; ++i)
+        stats->size += entries[i].size;
+
+    FREE(entries);
+    close(lock);
+
+    return 0;
+}
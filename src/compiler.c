@@ -1,36 +1,71 @@
 #include <compiler.h>
 #include <parser_helper.h>
 #include <optimizer.h>
+#include <eval.h>
 #include <filebuffer.h>
 #include <asm.h>
 #include <arch.h>
+#include <layout.h>
+#include <cost.h>
+#include <cache.h>
+#include <arena.h>
+#include <alias.h>
+#include <time_report.h>
+
+#include <setjmp.h>
+
+/*
+    Whole compiler state is thread local, so each thread can compile its own program.
+    State is not passed in explicit context, functions of compiler use these globals,
+    only parser is shared and serialized ( see parse_mutex in parser.y )
+*/
 
 /* Buffer for file */
-static file_buffer *fb;
+static __thread file_buffer *fb;
 
 /* extern from compierl.h */
 /* compiled asm code */
-Arraylist *asmcode;
+__thread Vector *asmcode;
 /* avl of cvars */
-Avl* compiler_variables;
+__thread Hashmap* compiler_variables;
 /* stack with labels */
-Stack *labels;
+__thread Stack *labels;
 
 /* stack with loop begining lines */
-static Stack *looplines;
+static __thread Stack *looplines;
 
 /* stack with Cfor structures */
-static Stack *forloops;
+static __thread Stack *forloops;
+
+/* Line_map for each token, NULL iff map is not needed */
+static __thread Darray *line_map = NULL;
+
+/* Emitter_map for each call of emitter, NULL iff map is not needed */
+__thread Darray *emitter_map = NULL;
 
 /* loop counters */
-static uint64_t while_c = 0;
-static uint64_t for_c = 0;
+static __thread uint64_t while_c = 0;
+static __thread uint64_t for_c = 0;
 
 /* if counter */
-static uint64_t if_c = 0;
+static __thread uint64_t if_c = 0;
+
+/* where to go on compiler_exit, NULL iff exit process */
+static __thread jmp_buf *job_exit = NULL;
+
+/* token list and output file of current job, released by job_clean also after compiler_exit */
+static __thread Vector *job_tokens = NULL;
+static __thread int job_fd = -1;
+
+/* arena given by caller of compile_context, reset instead of destroy, NULL iff not given */
+static __thread Arena *job_arena = NULL;
+
+/* profile and relocation of code layout, released by compile_clean also after compiler_exit */
+static __thread Profile *job_profile = NULL;
+static __thread uint64_t *job_relocation = NULL;
 
 /* compiler option */
-Option option =
+__thread Option option =
 {
     .wall           =   0,
     .werr           =   0,
@@ -38,7 +73,13 @@ Option option =
     .tokens         =   0,
     .padding        =   0,
     .input_file     =   NULL,
-    .output_file    =   NULL
+    .output_file    =   NULL,
+    .profile_file   =   NULL,
+    .map_file       =   NULL,
+    .cost_file      =   NULL,
+    .emitter_file   =   NULL,
+    .cache_dir      =   NULL,
+    .cache_size     =   CACHE_DEFAULT_SIZE
 };
 
 /*
@@ -51,7 +92,7 @@ Option option =
     0 iff success
     Non-zero value iff failure
 */
-static int write_tokens(Arraylist *tokens) __nonull__(1);
+static int write_tokens(Vector *tokens) __nonull__(1);
 
 /*
     Compile token list to asm code
@@ -63,19 +104,62 @@ static int write_tokens(Arraylist *tokens) __nonull__(1);
     0 iff success
     Non-zero value iff failure
 */
-static int compile(Arraylist *tokens) __nonull__(1);
+static int compile(Vector *tokens) __nonull__(1);
 
 /*
     Alloc all variables and arrays in memory
 
     PARAMS
-    @IN vars - avl with pvars
+    @IN vars - map with pvars
 
     RETURN
     0 iff success
     Non-zero value iff failure
 */
-static int alloc_variables(Avl *vars) __nonull__(1);
+static int alloc_variables(Hashmap *vars) __nonull__(1);
+
+/*
+    Add @weight to weight of array iff value is element of array
+
+    PARAMS
+    @IN arrays - arrays sorted by name
+    @IN weights - weights of arrays
+    @IN n - number of arrays
+    @IN val - value from token ( can be NULL )
+    @IN weight - weight of access
+
+    RETURN
+    This is a void function
+*/
+static void array_weight_add(Pvar **arrays, uint64_t *weights, int n, Value *val, uint64_t weight) __nonull__(1, 2);
+
+/*
+    Choose max len of array in ARRAYS section ( shorter arrays have smaller addresses than BIG ARRAYS ),
+    so cost of array addresses weighted by number of accesses ( more inside loops ) is minimal
+
+    PARAMS
+    @IN arrays - arrays sorted by name ( order of allocation )
+    @IN n - number of arrays
+    @IN tokens - tokens list
+    @IN first_addr - first addr of ARRAYS section
+
+    RETURN
+    Max len of array in ARRAYS section
+*/
+static uint64_t array_max_len_choose(Pvar **arrays, int n, Vector *tokens, uint64_t first_addr) __nonull__(1, 3);
+
+/*
+    Compare cvar in compiler_variables with name
+
+    PARAMS
+    @IN cvar - addr of cvar
+    @IN name - name of variable
+
+    RETURN:
+    0 iff cvar has this name
+    Non-zero value iff cvar has other name
+*/
+static int cvar_name_cmp(void *cvar, const void *name) __nonull__(1, 2);
 
 /*
     compile all tokens to asm code
@@ -87,7 +171,51 @@ static int alloc_variables(Avl *vars) __nonull__(1);
     0 iff success
     Non-zero value iff failure
 */
-static int compiler_helper(Arraylist *tokens) __nonull__(1);
+static int compiler_helper(Vector *tokens) __nonull__(1);
+
+/*
+    Write map: asm lines -> source lines to file
+
+    PARAMS
+    @IN file - path to map file
+    @IN relocation - ( might be NULL ) new asm lines after layout
+
+    RETURN
+    0 iff success
+    Non-zero value iff failure
+*/
+static int write_line_map(const char *file, uint64_t *relocation) __nonull__(1);
+
+/*
+    Write map: asm lines -> emitter which generated them to file,
+    line from nested emitters belongs to the outer one
+
+    PARAMS
+    @IN file - path to map file
+    @IN relocation - ( might be NULL ) new asm lines after layout
+
+    RETURN
+    0 iff success
+    Non-zero value iff failure
+*/
+static int write_emitter_map(const char *file, uint64_t *relocation) __nonull__(1);
+
+/*
+    Write range of asm lines with rest of map line,
+    after layout lines can be moved, so each continuous range is written
+
+    PARAMS
+    @IN f - map file
+    @IN asm_first - first asm line of range
+    @IN asm_last - last asm line of range
+    @IN relocation - ( might be NULL ) new asm lines after layout
+    @IN rest - rest of map line
+
+    RETURN
+    This is a void function
+*/
+static void write_map_range(FILE *f, uint64_t asm_first, uint64_t asm_last,
+                            uint64_t *relocation, const char *rest) __nonull__(1, 5);
 
 /*
     If we have loop we don't know how to trace value
@@ -97,7 +225,7 @@ static int compiler_helper(Arraylist *tokens) __nonull__(1);
         a := 0
         READ a;
     in loop we overwrite symbolic flag,
-    so do it on every token
+    so do it on every token before and after compilation
 
     PARAMS
     @IN token - pointer to token
@@ -279,6 +407,31 @@ static int __assign(token_assign *token) __nonull__(1);
 */
 static int __cond(token_cond *token) __nonull__(1);
 
+/*
+    Release state of compile, output file, token list, variables and arena of current job
+    ( reset iff arena is given by caller ), every end of main_compile and job stopped by compiler_exit go here
+
+    PARAMS
+    NO PARAMS
+
+    RETURN:
+    This is a void function
+*/
+static void job_clean(void);
+
+/*
+    Release state of compile: compiler variables, asm code with lines, labels, loop stacks,
+    line / emitter maps, profile and board, pointers are set to NULL, so it is safe after
+    compile stopped at any point
+
+    PARAMS
+    NO PARAMS
+
+    RETURN:
+    This is a void function
+*/
+static void compile_clean(void);
+
 static __inline__ int cond_fake(void)
 {
     LOG("COND FAKE\n", "");
@@ -300,27 +453,27 @@ static __inline__ BOOL cvar_need_malloc(const char *name)
     return TRUE;
 }
 
-static __inline__ BOOL need_jump(Arraylist *tokens, uint64_t pos)
+static __inline__ BOOL need_jump(Vector *tokens, uint64_t pos)
 {
-    Arraylist_iterator it;
+    Vector_iterator it;
     Token *token;
 
     uint64_t counter = 0;
 
     /* skip obsolete tokens */
-    for(  arraylist_iterator_init(tokens, &it, ITI_BEGIN);
-        ! arraylist_iterator_end(&it) && counter < pos;
-          arraylist_iterator_next(&it))
+    for(  vector_iterator_init(tokens, &it, ITI_BEGIN);
+        ! vector_iterator_end(&it) && counter < pos;
+          vector_iterator_next(&it))
         {
             ++counter;
         }
 
     /* for each token on list DO: */
     for( ;
-        ! arraylist_iterator_end(&it);
-          arraylist_iterator_next(&it))
+        ! vector_iterator_end(&it);
+          vector_iterator_next(&it))
         {
-            arraylist_iterator_get_data(&it, (void*)&token);
+            vector_iterator_get_data(&it, (void*)&token);
 
             if(token->type == TOKEN_GUARD &&
                 token->body.guard->type == tokens_id.end_if)
@@ -334,10 +487,10 @@ static __inline__ BOOL need_jump(Arraylist *tokens, uint64_t pos)
     return TRUE;
 }
 
-static int write_tokens(Arraylist *tokens)
+static int write_tokens(Vector *tokens)
 {
     char *str;
-    Arraylist_iterator it;
+    Vector_iterator it;
     Token *token;
 
     TRACE("");
@@ -345,11 +498,11 @@ static int write_tokens(Arraylist *tokens)
     if(tokens == NULL)
         ERROR("tokens == NULL\n", 1, "");
 
-    for(  arraylist_iterator_init(tokens, &it, ITI_BEGIN);
-        ! arraylist_iterator_end(&it);
-          arraylist_iterator_next(&it))
+    for(  vector_iterator_init(tokens, &it, ITI_BEGIN);
+        ! vector_iterator_end(&it);
+          vector_iterator_next(&it))
         {
-            arraylist_iterator_get_data(&it, (void*)&token);
+            vector_iterator_get_data(&it, (void*)&token);
 
             str = token_str(token);
 
@@ -362,9 +515,13 @@ static int write_tokens(Arraylist *tokens)
     return 0;
 }
 
-static int alloc_variables(Avl *vars)
+static int alloc_variables(Hashmap *vars)
 {
     Pvar *var;
+    Pvar **sorted;
+
+    int size;
+    int i;
 
     var_normal *vn;
     Variable *variable;
@@ -372,8 +529,6 @@ static int alloc_variables(Avl *vars)
 
     Array *arr;
 
-    Avl_iterator it;
-
     Cvar *cvar;
 
     TRACE("");
@@ -381,11 +536,13 @@ static int alloc_variables(Avl *vars)
     if(vars == NULL)
         ERROR("vars == NULL\n", 1, "");
 
-    for(  avl_iterator_init(vars, &it, ITI_BEGIN);
-        ! avl_iterator_end(&it);
-          avl_iterator_next(&it))
+    /* addresses depend on order, so variables are allocated sorted by name */
+    if(pvars_sorted(vars, &sorted, &size))
+        ERROR("pvars_sorted error\n", 1, "");
+
+    for(i = 0; i < size; ++i)
         {
-            avl_iterator_get_data(&it, (void*)&var);
+            var = sorted[i];
 
             /* normal variable */
             if(var->type == PTOKEN_VAR)
@@ -413,18 +570,18 @@ static int alloc_variables(Avl *vars)
                 if(cvar == NULL)
                     ERROR("cvar_create error\n", 1, "");
 
-                if(avl_insert(compiler_variables, (void*)&cvar))
-                    ERROR("avl_insert error\n", 1, "");
+                if(hashmap_insert(compiler_variables, (void*)&cvar))
+                    ERROR("hashmap_insert error\n", 1, "");
             }
             else
             {
                 LOG("Alloc array %s with len %ju\n", var->name, var->array_len);
 
-                arr = array_create(var->name, var->array_len);
+                arr = array_create(var->name, var->array_len, memory->array_max_len);
                 if(arr == NULL)
                     ERROR("array_create error\n", 1, "");
 
-                if(var->array_len <= ARRAY_MAX_LEN)
+                if(arr->type == ARRAY)
                     my_malloc(memory, ARRAY, (void*)arr);
                 else
                     my_malloc(memory, BIG_ARRAY, (void*)arr);
@@ -434,11 +591,13 @@ static int alloc_variables(Avl *vars)
                 if(cvar == NULL)
                     ERROR("cvar_create error\n", 1, "");
 
-                if(avl_insert(compiler_variables, (void*)&cvar))
-                    ERROR("avl_insert error\n", 1, "");
+                if(hashmap_insert(compiler_variables, (void*)&cvar))
+                    ERROR("hashmap_insert error\n", 1, "");
             }
         }
 
+    FREE(sorted);
+
     return 0;
 }
 
@@ -701,10 +860,152 @@ static int sync_all(void)
     return 0;
 }
 
-static int compiler_helper(Arraylist *tokens)
+static void write_map_range(FILE *f, uint64_t asm_first, uint64_t asm_last,
+                            uint64_t *relocation, const char *rest)
+{
+    uint64_t i;
+    uint64_t first;
+    uint64_t last;
+
+    if(relocation == NULL)
+    {
+        fprintf(f, "%ju,%ju,%s\n", asm_first, asm_last, rest);
+        return;
+    }
+
+    first = LAYOUT_NO_LINE;
+    last = LAYOUT_NO_LINE;
+    for(i = asm_first; i <= asm_last + 1; ++i)
+    {
+        if(i <= asm_last && relocation[i] != LAYOUT_NO_LINE
+            && first != LAYOUT_NO_LINE && relocation[i] == last + 1)
+        {
+            last = relocation[i];
+            continue;
+        }
+
+        if(first != LAYOUT_NO_LINE)
+            fprintf(f, "%ju,%ju,%s\n", first, last, rest);
+
+        first = LAYOUT_NO_LINE;
+        if(i <= asm_last && relocation[i] != LAYOUT_NO_LINE)
+        {
+            first = relocation[i];
+            last = first;
+        }
+    }
+}
+
+static int write_line_map(const char *file, uint64_t *relocation)
+{
+    FILE *f;
+    Darray_iterator it;
+    Line_map map;
+
+    char *rest;
+
+    TRACE("");
+
+    f = fopen(file, "w");
+    if(f == NULL)
+        ERROR("cannot open %s file\n", 1, file);
+
+    fprintf(f, "# asm_first,asm_last,src_first,src_last,token\n");
+
+    for(  darray_iterator_init(line_map, &it, ITI_BEGIN);
+        ! darray_iterator_end(&it);
+          darray_iterator_next(&it))
+        {
+            darray_iterator_get_data(&it, (void*)&map);
+
+            if(asprintf(&rest, "%ju,%ju,%s", map.token->first_line, map.token->last_line,
+                        token_kind_str(map.token)) == -1)
+            {
+                fclose(f);
+                ERROR("asprintf error\n", 1, "");
+            }
+
+            write_map_range(f, map.asm_first, map.asm_last, relocation, rest);
+
+            FREE(rest);
+        }
+
+    fclose(f);
+
+    return 0;
+}
+
+static int write_emitter_map(const char *file, uint64_t *relocation)
 {
-    Arraylist_iterator it;
+    FILE *f;
+    Darray_iterator it;
+    Emitter_map map;
+
+    const char **owner;
+    uint64_t len = 0;
+    uint64_t first;
+    uint64_t i;
+
+    TRACE("");
+
+    for(  darray_iterator_init(emitter_map, &it, ITI_BEGIN);
+        ! darray_iterator_end(&it);
+          darray_iterator_next(&it))
+        {
+            darray_iterator_get_data(&it, (void*)&map);
+            len = MAX(len, map.asm_last + 1);
+        }
+
+    /* owner[i] is emitter of asm line i, NULL iff line is not from emitter */
+    owner = (const char**)calloc(len + 1, sizeof(const char*));
+    if(owner == NULL)
+        ERROR("calloc error\n", 1, "");
+
+    /* outer emitter ends after inner, so it is later in map and overwrites inner */
+    for(  darray_iterator_init(emitter_map, &it, ITI_BEGIN);
+        ! darray_iterator_end(&it);
+          darray_iterator_next(&it))
+        {
+            darray_iterator_get_data(&it, (void*)&map);
+
+            for(i = map.asm_first; i <= map.asm_last; ++i)
+                owner[i] = map.emitter;
+        }
+
+    f = fopen(file, "w");
+    if(f == NULL)
+    {
+        FREE(owner);
+        ERROR("cannot open %s file\n", 1, file);
+    }
+
+    fprintf(f, "# asm_first,asm_last,emitter\n");
+
+    /* owner[len] is NULL, so last range is written too */
+    first = 0;
+    for(i = 1; i <= len; ++i)
+        if(owner[i] != owner[first])
+        {
+            if(owner[first] != NULL)
+                write_map_range(f, first, i - 1, relocation, owner[first]);
+
+            first = i;
+        }
+
+    fclose(f);
+    FREE(owner);
+
+    return 0;
+}
+
+static int compiler_helper(Vector *tokens)
+{
+    Vector_iterator it;
     Token *token;
+    Line_map map;
+
+    Phase_mark mark;
+    int phase;
 
     int i;
 
@@ -713,18 +1014,33 @@ static int compiler_helper(Arraylist *tokens)
     token_list = tokens;
     token_list_pos = 1;
 
+    if(alias_init())
+        ERROR("alias_init error\n", 1, "");
+
     /* for each token do compile */
-    for(   arraylist_iterator_init(tokens, &it, ITI_BEGIN);
-         ! arraylist_iterator_end(&it);
-           arraylist_iterator_next(&it) )
+    for(   vector_iterator_init(tokens, &it, ITI_BEGIN);
+         ! vector_iterator_end(&it);
+           vector_iterator_next(&it) )
         {
-            arraylist_iterator_get_data(&it, (void*)&token);
+            vector_iterator_get_data(&it, (void*)&token);
+
+            map.asm_first = asmcode->length;
+            map.token = token;
+
+            PHASE_BEGIN(mark);
 
             set_symbolic_in_loop(token);
+
+            /* array elements with known value are replaced by const values */
+            if(alias_token_begin(tokens, token_list_pos - 1))
+                ERROR("alias_token_begin error\n", 1, "");
+
             switch(token->type)
             {
                 case TOKEN_ASSIGN:
                 {
+                    phase = PHASE_CODEGEN_ASSIGN;
+
                     if ( compile_token_assign(token->body.assign) )
                         ERROR("compile_token_assign error\n", 1, "");
 
@@ -732,6 +1048,8 @@ static int compiler_helper(Arraylist *tokens)
                 }
                 case TOKEN_FOR:
                 {
+                    phase = PHASE_CODEGEN_FOR;
+
                     if( compile_token_for(token->body.for_loop) )
                         ERROR("compile_token_for error\n", 1, "");
 
@@ -739,6 +1057,8 @@ static int compiler_helper(Arraylist *tokens)
                 }
                 case TOKEN_GUARD:
                 {
+                    phase = PHASE_CODEGEN_GUARD;
+
                     if ( compile_token_guard(token->body.guard) )
                         ERROR("compile_token_guard error\n", 1, "");
 
@@ -746,6 +1066,8 @@ static int compiler_helper(Arraylist *tokens)
                 }
                 case TOKEN_IF:
                 {
+                    phase = PHASE_CODEGEN_IF;
+
                     if( compile_token_if(token->body.if_cond) )
                         ERROR("compile_token_if error\n", 1, "");
 
@@ -753,6 +1075,8 @@ static int compiler_helper(Arraylist *tokens)
                 }
                 case TOKEN_IO:
                 {
+                    phase = PHASE_CODEGEN_IO;
+
                     if( compile_token_io(token->body.io) )
                         ERROR("compile_token_io error\n", 1, "");
 
@@ -760,6 +1084,8 @@ static int compiler_helper(Arraylist *tokens)
                 }
                 case TOKEN_WHILE:
                 {
+                    phase = PHASE_CODEGEN_WHILE;
+
                     if( compile_token_while(token->body.while_loop) )
                         ERROR("compile_token_while error\n", 1, "");
 
@@ -771,14 +1097,33 @@ static int compiler_helper(Arraylist *tokens)
                 }
             }
 
+            if(alias_token_end())
+                ERROR("alias_token_end error\n", 1, "");
+
+            /* const stored in loop or IF is not known after it */
+            if(token->type == TOKEN_ASSIGN || token->type == TOKEN_IO)
+                set_symbolic_in_loop(token);
+
+            PHASE_END(phase, mark);
+
             ++token_list_pos;
 
+            /* token generated code, remember it in map */
+            if(line_map != NULL && asmcode->length > map.asm_first)
+            {
+                map.asm_last = asmcode->length - 1;
+                if(darray_insert(line_map, (void*)&map))
+                    ERROR("darray_insert error\n", 1, "");
+            }
+
             /* assert NO REG IS IN USE */
             for(i = 0; i < REGS_NUMBER; ++i)
                 if(IS_REG_IN_USE(cpu->registers[i]))
                     ERROR("REGISTER IN USE AFTER TOKEN\n", 1, "");
         }
 
+        alias_destroy();
+
         /* at the end we need halt */
         if(do_halt())
             ERROR("do_halt error\n", 1, "");
@@ -1634,8 +1979,13 @@ static int __assign(token_assign *token)
         else
             reg_set_val(cpu->registers[reg], cvar_res->body.val);
 
-        /* pump value to reg */
-        if( do_pump(cpu->registers[reg], token->expr->left->body.cv->value, TRUE) )
+        /* pump value to reg, big literal is set only by its hidden variable */
+        if(token->expr->left->body.cv->type == BIG_CONST)
+        {
+            if( do_pump_bigvalue(cpu->registers[reg], token->expr->left->body.cv->big_value, TRUE) )
+                ERROR("do_pump_bigvalue error\n", 1, "");
+        }
+        else if( do_pump(cpu->registers[reg], token->expr->left->body.cv->value, TRUE) )
             ERROR("do_pump error\n", 1, "");
 
         /* we can't trace value so imediatly store it */
@@ -4297,6 +4647,9 @@ static int __div(token_assign *token)
     int i;
     uint64_t value;
 
+    uint64_t lo;
+    uint64_t hi;
+
     mpz_t val;
 
     mpz_t temp1;
@@ -5090,8 +5443,12 @@ static int __div(token_assign *token)
                     else
                         reg_set_val(cpu->registers[reg], cvar_res->body.val);
 
-                    if(do_jzero(cpu->registers[reg], asmcode->length + 4))
-                        ERROR("do_jzero error\n", 1, "");
+                    /* check a == 0 iff range of a contains 0 */
+                    alias_operand_range(TRUE, &lo, &hi);
+
+                    if(lo == 0)
+                        if(do_jzero(cpu->registers[reg], asmcode->length + 4))
+                            ERROR("do_jzero error\n", 1, "");
 
                     if(do_zero(cpu->registers[reg], FALSE))
                         ERROR("do_zero error\n", 1, "");
@@ -5099,11 +5456,14 @@ static int __div(token_assign *token)
                     if(do_inc(cpu->registers[reg], FALSE))
                         ERROR("do_inc error\n", 1, "");
 
-                    if(do_jump(asmcode->length + 2))
-                        ERROR("do_jump error\n", 1, "");
+                    if(lo == 0)
+                    {
+                        if(do_jump(asmcode->length + 2))
+                            ERROR("do_jump error\n", 1, "");
 
-                    if(do_zero(cpu->registers[reg], FALSE))
-                        ERROR("do_zero error\n", 1, "");
+                        if(do_zero(cpu->registers[reg], FALSE))
+                            ERROR("do_zero error\n", 1, "");
+                    }
 
                     /* we have branch here so set to symbolic */
                     if(value_can_trace(token->res))
@@ -6219,8 +6579,8 @@ static int compile_token_for(token_for *token)
 
         value_set_symbolic_flag(hit->body.val);
 
-        if(avl_insert(compiler_variables, (void*)&hit))
-            ERROR("avl_insert error\n", 1, "");
+        if(hashmap_insert(compiler_variables, (void*)&hit))
+            ERROR("hashmap_insert error\n", 1, "");
     }
 
     /* we need iterator */
@@ -6245,8 +6605,8 @@ static int compile_token_for(token_for *token)
 
             value_set_symbolic_flag(it->body.val);
 
-            if(avl_insert(compiler_variables, (void*)&it))
-                ERROR("avl_insert error\n", 1, "");
+            if(hashmap_insert(compiler_variables, (void*)&it))
+                ERROR("hashmap_insert error\n", 1, "");
         }
         else
         {
@@ -6611,12 +6971,12 @@ static int compile_token_guard(token_guard *token)
         ptr = cvar_get_by_name(PTR_NAME);
         value_set_symbolic_flag(ptr->body.val);
 
-        if(avl_delete(compiler_variables, (void*)&cfor->hit))
-            ERROR("avl_delete error\n", 1 ,"");
+        if(hashmap_delete(compiler_variables, (void*)&cfor->hit))
+            ERROR("hashmap_delete error\n", 1 ,"");
 
         if(cfor->it_needed == 1)
-            if(avl_delete(compiler_variables, (void*)&cfor->it))
-                ERROR("avl_delete error\n", 1, "");
+            if(hashmap_delete(compiler_variables, (void*)&cfor->it))
+                ERROR("hashmap_delete error\n", 1, "");
 
         cfor_destroy(cfor);
     }
@@ -6913,15 +7273,18 @@ static int compile_token_while(token_while *token)
     return 0;
 }
 
-static int compile(Arraylist *tokens)
+static int compile(Vector *tokens)
 {
-    Avl_iterator it;
     Cvar *cvar;
     Pvar *pvar;
 
-    Arraylist_iterator ait;
+    Vector_iterator ait;
     char *line;
 
+    Vector *code;
+
+    Phase_mark mark;
+
 #ifdef DEBUG_MODE
     char *str = NULL;
 #endif
@@ -6936,57 +7299,65 @@ static int compile(Arraylist *tokens)
         ERROR("board_init error\n", 1, "");
 
     /* PREPARE COMPILER VARIABLES AND MEMORY MANAGMENT */
-    compiler_variables = avl_create(sizeof(Cvar*), cvar_cmp);
+    compiler_variables = hashmap_create(sizeof(Cvar*), cvar_hash, cvar_cmp);
     if(compiler_variables == NULL)
-        ERROR("avl_create error\n", 1, "");
+        ERROR("hashmap_create error\n", 1, "");
 
     /* ADD special Variable PTR for pointer from PTR */
     pvar = pvar_create(PTR_NAME, PTOKEN_VAR, 0);
     if(pvar == NULL)
         ERROR("pvar_create error\n", 1, "");
 
-    if(avl_insert(variables, (void*)&pvar))
-        ERROR("avl_insert error\n", 1, "");
+    if(hashmap_insert(variables, (void*)&pvar))
+        ERROR("hashmap_insert error\n", 1, "");
 
     /* ADD temp VARIABLE */
     pvar = pvar_create(TEMP1_NAME, PTOKEN_VAR, 0);
     if(pvar == NULL)
         ERROR("pvar_create error\n", 1, "");
 
-    if(avl_insert(variables, (void*)&pvar))
-        ERROR("avl_insert error\n", 1, "");
+    if(hashmap_insert(variables, (void*)&pvar))
+        ERROR("hashmap_insert error\n", 1, "");
 
     /* ADD temp VARIABLE */
     pvar = pvar_create(TEMP2_NAME, PTOKEN_VAR, 0);
     if(pvar == NULL)
         ERROR("pvar_create error\n", 1, "");
 
-    if(avl_insert(variables, (void*)&pvar))
-        ERROR("avl_insert error\n", 1, "");
+    if(hashmap_insert(variables, (void*)&pvar))
+        ERROR("hashmap_insert error\n", 1, "");
+
+    PHASE_BEGIN(mark);
 
     if( prepare_mem_sections(variables, tokens) )
         ERROR("prepare_mem_sections error\n", 1, "");
 
+    PHASE_END(PHASE_MEM_SECTIONS, mark);
+
     /* VARS NO NEED MEMORY */
     /* ADD temp VARIABLE */
     pvar = pvar_create(TEMP_ADDR_NAME, PTOKEN_VAR, 0);
     if(pvar == NULL)
         ERROR("pvar_create error\n", 1, "");
 
-    if(avl_insert(variables, (void*)&pvar))
-        ERROR("avl_insert error\n", 1, "");
+    if(hashmap_insert(variables, (void*)&pvar))
+        ERROR("hashmap_insert error\n", 1, "");
 
     /* ADD temp VARIABLE */
     pvar = pvar_create(TEMP_DIV_HELPER, PTOKEN_VAR, 0);
     if(pvar == NULL)
         ERROR("pvar_create error\n", 1, "");
 
-    if(avl_insert(variables, (void*)&pvar))
-        ERROR("avl_insert error\n", 1, "");
+    if(hashmap_insert(variables, (void*)&pvar))
+        ERROR("hashmap_insert error\n", 1, "");
+
+    PHASE_BEGIN(mark);
 
     if(alloc_variables(variables))
         ERROR("alloc variables error\n", 1, "");
 
+    PHASE_END(PHASE_ALLOC_VARIABLES, mark);
+
 
 #ifdef DEBUG_MODE
     str = mpz_get_str(str, 10, memory->big_arrays_allocated);
@@ -7000,10 +7371,10 @@ static int compile(Arraylist *tokens)
     FREE(str);
 #endif
 
-    /* Prepare arraylist with asm code lines */
-    asmcode = arraylist_create(sizeof(char*));
+    /* Prepare vector with asm code lines */
+    asmcode = vector_create(sizeof(char*));
     if(asmcode == NULL)
-        ERROR("arraylist_create error\n", 1, "");
+        ERROR("vector_create error\n", 1, "");
 
     cvar = cvar_get_by_name(PTR_NAME);
     reg_set_val(cpu->registers[REG_PTR], cvar->body.val);
@@ -7024,53 +7395,137 @@ static int compile(Arraylist *tokens)
     if(forloops == NULL)
         ERROR("stack_create error\n", 1, "");
 
+    /* Prepare line map, cost report needs it too */
+    if(option.map_file != NULL || option.cost_file != NULL)
+    {
+        line_map = darray_create(UNSORTED, 0, sizeof(Line_map), NULL);
+        if(line_map == NULL)
+            ERROR("darray_create error\n", 1, "");
+    }
+
+    if(option.emitter_file != NULL)
+    {
+        emitter_map = darray_create(UNSORTED, 0, sizeof(Emitter_map), NULL);
+        if(emitter_map == NULL)
+            ERROR("darray_create error\n", 1, "");
+    }
+
+    PHASE_BEGIN(mark);
+
     if(compiler_helper(tokens))
         ERROR("compile error\n", 1, "");
 
-    /* write lines to file */
-    for(  arraylist_iterator_init(asmcode, &ait, ITI_BEGIN);
-        ! arraylist_iterator_end(&ait);
-          arraylist_iterator_next(&ait))
+    PHASE_END(PHASE_CODEGEN, mark);
+
+    /* static analysis is done on code before layout, so it is the same as in source */
+    if(option.cost_file != NULL)
+    {
+        PHASE_BEGIN(mark);
+
+        if(cost_report(option.cost_file, asmcode, tokens, line_map))
+            ERROR("cost_report error\n", 1, "");
+
+        PHASE_END(PHASE_COST_REPORT, mark);
+    }
+
+    /* reorder code using execution profile */
+    if(option.profile_file != NULL)
+    {
+        PHASE_BEGIN(mark);
+
+        job_profile = profile_load(option.profile_file);
+        if(job_profile == NULL)
+            ERROR("profile_load error\n", 1, "");
+
+        /* profile from other code, we can't use it */
+        if(job_profile->lines != asmcode->length)
         {
-            arraylist_iterator_get_data(&ait, (void*)&line);
-            file_buffer_append(fb, line);
-            FREE(line);
+            if(option.werr)
+            {
+                fprintf(stderr,"%sERROR!\tprofile doesn't match code:\t%s%s\n",
+                    RED, option.profile_file, RESET);
+
+                compiler_exit(1);
+            }
+            else
+            fprintf(stderr,"%sWARNING!\tprofile doesn't match code:\t%s%s\n",
+                YELLOW, option.profile_file, RESET);
+        }
+        else
+        {
+            if(option.map_file != NULL || option.emitter_file != NULL)
+            {
+                job_relocation = (uint64_t*)malloc(sizeof(uint64_t) * asmcode->length);
+                if(job_relocation == NULL)
+                    ERROR("malloc error\n", 1, "");
+            }
+
+            if(layout_code(asmcode, job_profile, &code, job_relocation))
+                ERROR("layout_code error\n", 1, "");
+
+            vector_destroy(asmcode);
+            asmcode = code;
         }
 
-    file_buffer_synch(fb);
+        profile_destroy(job_profile);
+        job_profile = NULL;
 
-    /* CLEANUP */
-    cvar = cvar_get_by_name(TEMP_ADDR_NAME);
-    value_destroy(cvar->body.val);
+        PHASE_END(PHASE_LAYOUT, mark);
+    }
 
-    cvar = cvar_get_by_name(TEMP_DIV_HELPER);
-    value_destroy(cvar->body.val);
+    PHASE_BEGIN(mark);
 
-    for(  avl_iterator_init(compiler_variables, &it, ITI_BEGIN);
-        ! avl_iterator_end(&it);
-        avl_iterator_next(&it))
-        {
-            avl_iterator_get_data(&it, (void*)&cvar);
+    if(line_map != NULL)
+    {
+        if(option.map_file != NULL)
+            if(write_line_map(option.map_file, job_relocation))
+                ERROR("write_line_map error\n", 1, "");
+
+        darray_destroy(line_map);
+        line_map = NULL;
+    }
+
+    if(emitter_map != NULL)
+    {
+        if(write_emitter_map(option.emitter_file, job_relocation))
+            ERROR("write_emitter_map error\n", 1, "");
+
+        darray_destroy(emitter_map);
+        emitter_map = NULL;
+    }
+
+    FREE(job_relocation);
 
-            cvar_destroy(cvar);
+    if(option.map_file != NULL || option.emitter_file != NULL)
+        PHASE_END(PHASE_MAPS, mark);
+
+    PHASE_BEGIN(mark);
+
+    /* write lines to file */
+    for(  vector_iterator_init(asmcode, &ait, ITI_BEGIN);
+        ! vector_iterator_end(&ait);
+          vector_iterator_next(&ait))
+        {
+            vector_iterator_get_data(&ait, (void*)&line);
+            file_buffer_append(fb, line);
         }
 
-    avl_destroy(compiler_variables);
-    arraylist_destroy(asmcode);
-    stack_destroy(labels);
-    stack_destroy(looplines);
-    stack_destroy(forloops);
-    board_destroy();
+    file_buffer_synch(fb);
+
+    PHASE_END(PHASE_OUTPUT, mark);
+
+    /* the same cleanup as after error */
+    compile_clean();
 
     return 0;
 }
 
-uint64_t calc_loop_mem_section(Arraylist *tokens)
+uint64_t calc_loop_mem_section(Vector *tokens)
 {
     uint64_t max = 0;
     uint64_t cur = 0;
 
-    Arraylist_iterator it;
+    Vector_iterator it;
     Token *token;
 
     TRACE("");
@@ -7078,11 +7533,11 @@ uint64_t calc_loop_mem_section(Arraylist *tokens)
     if(tokens == NULL)
         ERROR("tokens == NULL\n", 0, "");
 
-    for(  arraylist_iterator_init(tokens, &it, ITI_BEGIN);
-        ! arraylist_iterator_end(&it);
-          arraylist_iterator_next(&it))
+    for(  vector_iterator_init(tokens, &it, ITI_BEGIN);
+        ! vector_iterator_end(&it);
+          vector_iterator_next(&it))
         {
-            arraylist_iterator_get_data(&it, (void*)&token);
+            vector_iterator_get_data(&it, (void*)&token);
             if(token->type == TOKEN_FOR)
                 cur += 2; /* iterator and end value */
 
@@ -7095,16 +7550,202 @@ uint64_t calc_loop_mem_section(Arraylist *tokens)
     return max;
 }
 
-int prepare_mem_sections(Avl *vars, Arraylist *tokens)
+static void array_weight_add(Pvar **arrays, uint64_t *weights, int n, Value *val, uint64_t weight)
 {
-    Pvar *var;
+    const char *name;
+
+    int left;
+    int right;
+    int middle;
+    int res;
+
+    if(val == NULL || val->type != VARIABLE || val->body.var->type != VAR_ARR)
+        return;
+
+    name = val->body.var->body.arr->var->name;
+
+    left = 0;
+    right = n - 1;
+    while(left <= right)
+    {
+        middle = (left + right) >> 1;
+
+        res = strcmp(arrays[middle]->name, name);
+        if(res == 0)
+        {
+            weights[middle] += weight;
+            return;
+        }
+
+        if(res < 0)
+            left = middle + 1;
+        else
+            right = middle - 1;
+    }
+}
+
+static uint64_t array_max_len_choose(Pvar **arrays, int n, Vector *tokens, uint64_t first_addr)
+{
+    Vector_iterator it;
+    Token *token;
+
+    uint64_t *weights;
+    uint64_t weight;
+    uint64_t depth = 0;
+    uint64_t used = 0;
+
+    uint64_t max_len;
+    uint64_t best_len = ARRAY_MAX_LEN;
+    uint64_t best_cost = UINT64_MAX;
+    uint64_t cost;
+    uint64_t low;
+
+    mpz_t addr;
+    mpz_t high;
+
+    int i;
+    int j;
+
+    TRACE("");
+
+    /* +1, so calloc(0) is not a problem */
+    weights = (uint64_t*)calloc((size_t)n + 1, sizeof(uint64_t));
+    if(weights == NULL)
+        ERROR("calloc error\n", ARRAY_MAX_LEN, "");
+
+    for(  vector_iterator_init(tokens, &it, ITI_BEGIN);
+        ! vector_iterator_end(&it);
+          vector_iterator_next(&it))
+        {
+            vector_iterator_get_data(&it, (void*)&token);
+
+            /* condition of while is checked in each iteration */
+            if(token->type == TOKEN_WHILE)
+                ++depth;
+
+            weight = 1;
+            for(i = 0; i < (int)MIN(depth, ARRAY_LOOP_DEPTH); ++i)
+                weight *= ARRAY_LOOP_WEIGHT;
+
+            switch(token->type)
+            {
+                case TOKEN_IO:
+                {
+                    array_weight_add(arrays, weights, n, token->body.io->res, weight);
+                    break;
+                }
+                case TOKEN_ASSIGN:
+                {
+                    array_weight_add(arrays, weights, n, token->body.assign->res, weight);
+                    array_weight_add(arrays, weights, n, token->body.assign->expr->left, weight);
+                    array_weight_add(arrays, weights, n, token->body.assign->expr->right, weight);
+                    break;
+                }
+                case TOKEN_IF:
+                {
+                    array_weight_add(arrays, weights, n, token->body.if_cond->cond->left, weight);
+                    array_weight_add(arrays, weights, n, token->body.if_cond->cond->right, weight);
+                    break;
+                }
+                case TOKEN_WHILE:
+                {
+                    array_weight_add(arrays, weights, n, token->body.while_loop->cond->left, weight);
+                    array_weight_add(arrays, weights, n, token->body.while_loop->cond->right, weight);
+                    break;
+                }
+                case TOKEN_FOR:
+                {
+                    array_weight_add(arrays, weights, n, token->body.for_loop->begin_value, weight);
+                    array_weight_add(arrays, weights, n, token->body.for_loop->end_value, weight);
+                    ++depth;
+                    break;
+                }
+                case TOKEN_GUARD:
+                {
+                    if(token->body.guard->type == tokens_id.end_for
+                       || token->body.guard->type == tokens_id.end_while)
+                        --depth;
+
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+
+    for(i = 0; i < n; ++i)
+        used += weights[i];
+
+    /* without accesses order doesn't matter */
+    if(used == 0)
+    {
+        FREE(weights);
+        return ARRAY_MAX_LEN;
+    }
+
+    mpz_init(addr);
+    mpz_init(high);
+
+    /* each len of array ( and 0 ) is a candidate, equal cost -> longer max len */
+    for(i = -1; i < n; ++i)
+    {
+        max_len = i < 0 ? 0 : arrays[i]->array_len;
+        if(max_len > ARRAY_MAX_LEN)
+            continue;
+
+        low = first_addr;
+        for(j = 0; j < n; ++j)
+            if(arrays[j]->array_len <= max_len)
+                low += arrays[j]->array_len;
+
+        ull2mpz(high, low);
+        low = first_addr;
+        cost = 0;
+
+        for(j = 0; j < n; ++j)
+        {
+            if(arrays[j]->array_len <= max_len)
+            {
+                ull2mpz(addr, low);
+                low += arrays[j]->array_len;
+            }
+            else
+            {
+                mpz_set(addr, high);
+                mpz_add_ui(high, high, arrays[j]->array_len);
+            }
+
+            if(weights[j])
+                cost += weights[j] * (uint64_t)BPUMP_COST(addr);
+        }
+
+        if(cost < best_cost || (cost == best_cost && max_len > best_len))
+        {
+            best_cost = cost;
+            best_len = max_len;
+        }
+    }
+
+    mpz_clear(addr);
+    mpz_clear(high);
+    FREE(weights);
+
+    return best_len;
+}
+
+int prepare_mem_sections(Hashmap *vars, Vector *tokens)
+{
+    Pvar **sorted;
+    Pvar **arrays;
+
+    int size;
+    int narrays;
+    int i;
 
     uint64_t mem_vars;
     uint64_t mem_arrays;
     uint64_t mem_loop_vars;
 
-    Avl_iterator it;
-
 #ifdef DEBUG_MODE
     char *str = NULL;
 #endif
@@ -7114,23 +7755,25 @@ int prepare_mem_sections(Avl *vars, Arraylist *tokens)
     if(vars == NULL)
         ERROR("vars == NULL\n", 1, "");
 
+    /* the same order as in alloc_variables */
+    if(pvars_sorted(vars, &sorted, &size))
+        ERROR("pvars_sorted error\n", 1, "");
+
+    arrays = (Pvar**)malloc(sizeof(Pvar*) * ((size_t)size + 1));
+    if(arrays == NULL)
+        ERROR("malloc error\n", 1, "");
+
     mem_vars = 0;
     mem_arrays = 0;
+    narrays = 0;
 
-    for(  avl_iterator_init(vars, &it, ITI_BEGIN);
-        ! avl_iterator_end(&it);
-          avl_iterator_next(&it))
-        {
-                avl_iterator_get_data(&it, (void*)&var);
-
-                if(var->type == PTOKEN_VAR)
-                    ++mem_vars;
-                else
-                {
-                    if(var->array_len <= ARRAY_MAX_LEN)
-                        mem_arrays += var->array_len;
-                }
-        }
+    for(i = 0; i < size; ++i)
+    {
+        if(sorted[i]->type == PTOKEN_VAR)
+            ++mem_vars;
+        else
+            arrays[narrays++] = sorted[i];
+    }
 
     mem_loop_vars = calc_loop_mem_section(tokens);
 
@@ -7140,6 +7783,15 @@ int prepare_mem_sections(Avl *vars, Arraylist *tokens)
     memory->var_first_addr = memory->loop_var_last_addr + 1;
     memory->var_last_addr = memory->var_first_addr + mem_vars - 1;
 
+    memory->array_max_len = array_max_len_choose(arrays, narrays, tokens, memory->var_last_addr + 1);
+
+    for(i = 0; i < narrays; ++i)
+        if(arrays[i]->array_len <= memory->array_max_len)
+            mem_arrays += arrays[i]->array_len;
+
+    FREE(arrays);
+    FREE(sorted);
+
     memory->arrays_first_addr = memory->var_last_addr + 1;
     memory->arrays_last_addr = memory->arrays_first_addr + mem_arrays - 1;
 
@@ -7233,8 +7885,9 @@ void cvar_destroy(Cvar *cvar)
 
     if(cvar->type == ARRAY || cvar->type == BIG_ARRAY)
     {
-        if(cvar->type == ARRAY)
-            darray_destroy(cvar->body.arr->arr);
+        /* elements are owned by memory */
+        if(cvar->body.arr->elems != NULL)
+            hashmap_destroy(cvar->body.arr->elems);
 
         mpz_clear(cvar->body.arr->addr);
 
@@ -7261,6 +7914,16 @@ int cvar_cmp(void *a, void *b)
     return 0;
 }
 
+uint64_t cvar_hash(void *cvar)
+{
+    return hashmap_hash_str((*(Cvar**)cvar)->name);
+}
+
+static int cvar_name_cmp(void *cvar, const void *name)
+{
+    return strcmp((*(Cvar**)cvar)->name, (const char*)name);
+}
+
 Cvar *cvar_get_by_value(Value *val)
 {
     char *name;
@@ -7280,74 +7943,22 @@ Cvar *cvar_get_by_value(Value *val)
 
 Cvar *cvar_get_by_name(const char *name)
 {
-    Cvar *in;
-    Cvar *out;
-
-    var_normal *vn;
-    Variable *var;
-    Value *val;
+    Cvar **cvar;
 
     TRACE("");
 
-    vn = var_normal_create(name);
-    if(vn == NULL)
-        ERROR("var_normal_create error\n", NULL, "");
-
-    var = variable_create(VAR_NORMAL, (void*)vn);
-    if(var == NULL)
-        ERROR("variable_create error\n", NULL, "");
-
-    val = value_create(VARIABLE, (void*)var);
-    if(val == NULL)
-        ERROR("value_create error\n", NULL, "");
-
-    in = cvar_create(VALUE, (void*)val);
-    if(in == NULL)
-        ERROR("cvar_create error\n", NULL, "");
-
-    if( avl_search(compiler_variables, (void*)&in, (void*)&out) )
+    cvar = (Cvar**)hashmap_search_hash(compiler_variables, hashmap_hash_str(name), (const void*)name, cvar_name_cmp);
+    if(cvar == NULL)
         ERROR("cvar %s doesn't exists\n", NULL, name);
 
-    cvar_destroy(in);
-    value_destroy(val);
-
-    return out;
+    return *cvar;
 }
 
 BOOL cvar_is_declared_by_name(const char *name)
 {
-    Cvar *in;
-
-    var_normal *vn;
-    Variable *var;
-    Value *val;
-
-    BOOL res;
-
     TRACE("");
 
-    vn = var_normal_create(name);
-    if(vn == NULL)
-        ERROR("var_normal_create error\n", FALSE, "");
-
-    var = variable_create(VAR_NORMAL, (void*)vn);
-    if(var == NULL)
-        ERROR("variable_create error\n", FALSE, "");
-
-    val = value_create(VARIABLE, (void*)var);
-    if(val == NULL)
-        ERROR("value_create error\n", FALSE, "");
-
-    in = cvar_create(VALUE, (void*)val);
-    if(in == NULL)
-        ERROR("cvar_create error\n", FALSE, "");
-
-    res =  avl_key_exist(compiler_variables, (void*)&in);
-
-    cvar_destroy(in);
-    value_destroy(val);
-
-    return res;
+    return hashmap_search_hash(compiler_variables, hashmap_hash_str(name), (const void*)name, cvar_name_cmp) != NULL;
 }
 
 BOOL cvar_is_declared_by_value(Value *val)
@@ -7367,20 +7978,17 @@ BOOL cvar_is_declared_by_value(Value *val)
     return cvar_is_declared_by_name(name);
 }
 
-Label *label_create(Arraylist_node *ptr, int8_t type)
+Label *label_create(uint64_t line, int8_t type)
 {
     Label *label;
 
     TRACE("");
 
-    if(ptr == NULL && type != LABEL_FAKE)
-        ERROR("ptr == NULL\n", NULL, "");
-
     label = (Label*)malloc(sizeof(Label));
     if(label == NULL)
         ERROR("malloc error\n", NULL , "");
 
-    label->ptr = ptr;
+    label->line = line;
     label->type = type;
 
     return label;
@@ -7444,88 +8052,311 @@ void cfor_destroy(Cfor *cfor)
     FREE(cfor);
 }
 
+static void compile_clean(void)
+{
+    Hashmap_iterator it;
+    Vector_iterator ait;
+
+    Cvar *cvar;
+    Label *label;
+    Cfor *cfor;
+    char *line;
+
+    TRACE("");
+
+    if(compiler_variables != NULL)
+    {
+        /* values of temp variables are not in memory, compile could stop before they were added */
+        if(cvar_is_declared_by_name(TEMP_ADDR_NAME))
+            value_destroy(cvar_get_by_name(TEMP_ADDR_NAME)->body.val);
+
+        if(cvar_is_declared_by_name(TEMP_DIV_HELPER))
+            value_destroy(cvar_get_by_name(TEMP_DIV_HELPER)->body.val);
+
+        for(  hashmap_iterator_init(compiler_variables, &it, ITI_BEGIN);
+            ! hashmap_iterator_end(&it);
+            hashmap_iterator_next(&it))
+            {
+                hashmap_iterator_get_data(&it, (void*)&cvar);
+
+                cvar_destroy(cvar);
+            }
+
+        hashmap_destroy(compiler_variables);
+        compiler_variables = NULL;
+    }
+
+    if(asmcode != NULL)
+    {
+        for(  vector_iterator_init(asmcode, &ait, ITI_BEGIN);
+            ! vector_iterator_end(&ait);
+              vector_iterator_next(&ait))
+            {
+                vector_iterator_get_data(&ait, (void*)&line);
+                FREE(line);
+            }
+
+        vector_destroy(asmcode);
+        asmcode = NULL;
+    }
+
+    if(labels != NULL)
+    {
+        while( ! stack_is_empty(labels) && stack_pop(labels, (void*)&label) == 0)
+            label_destroy(label);
+
+        stack_destroy(labels);
+        labels = NULL;
+    }
+
+    if(looplines != NULL)
+    {
+        stack_destroy(looplines);
+        looplines = NULL;
+    }
+
+    /* iterators of open loops are still in compiler variables, so they are destroyed above */
+    if(forloops != NULL)
+    {
+        while( ! stack_is_empty(forloops) && stack_pop(forloops, (void*)&cfor) == 0)
+            FREE(cfor);
+
+        stack_destroy(forloops);
+        forloops = NULL;
+    }
+
+    if(line_map != NULL)
+    {
+        darray_destroy(line_map);
+        line_map = NULL;
+    }
+
+    if(emitter_map != NULL)
+    {
+        darray_destroy(emitter_map);
+        emitter_map = NULL;
+    }
+
+    if(job_profile != NULL)
+    {
+        profile_destroy(job_profile);
+        job_profile = NULL;
+    }
+
+    FREE(job_relocation);
+
+    board_destroy();
+}
+
+static void job_clean(void)
+{
+    TRACE("");
+
+    compile_clean();
+
+    if(fb != NULL)
+    {
+        if(file_buffer_destroy(fb))
+            LOG("file_buffer_destroy error\n", "");
+
+        fb = NULL;
+    }
+
+    if(job_fd != -1)
+    {
+        close(job_fd);
+        job_fd = -1;
+    }
+
+    /* tokens and variables are in arena, destroy only containers */
+    if(job_tokens != NULL)
+    {
+        vector_destroy(job_tokens);
+        job_tokens = NULL;
+    }
+
+    if(variables != NULL)
+    {
+        hashmap_destroy(variables);
+        variables = NULL;
+    }
+
+    if(compile_arena != NULL)
+    {
+        if(compile_arena == job_arena)
+            arena_reset(compile_arena);
+        else
+            arena_destroy(compile_arena);
+
+        compile_arena = NULL;
+    }
+}
+
 int main_compile(void)
 {
     int ret;
-    Arraylist *tokens = NULL;
-    Arraylist_iterator it;
-    Token *token;
 
-    Avl_iterator avlit;
-    Pvar *pvar;
+    Cache_key key;
+    BOOL cached;
 
-    int fd;
+    Phase_mark total;
+    Phase_mark mark;
 
     TRACE("");
 
-    if(option.input_file == NULL || option.output_file == NULL)
+    /* evaluator writes to stdout */
+    if(option.input_file == NULL || (option.output_file == NULL && ! option.eval))
         ERROR("input file == NULL || output file == NULL\n", 1, "");
 
+    time_report_reset(option.time_report);
+    PHASE_BEGIN(total);
+
+    /* code with side files can't be taken from cache, report needs real compilation */
+    cached = option.cache_dir != NULL && ! option.eval && option.profile_file == NULL && option.map_file == NULL
+                && option.cost_file == NULL && option.emitter_file == NULL && ! option.time_report
+                && cache_key(&option, &key) == 0;
+
+    /* the same code was compiled before */
+    if(cached && cache_get(option.cache_dir, &key, option.output_file) == 0)
+        return 0;
+
+    /* thread could compile other program before */
+    while_c = 0;
+    for_c = 0;
+    if_c = 0;
+
+    /* objects of stopped compilation */
+    job_clean();
+
+    /* tokens, values and variables live as long as this compilation */
+    compile_arena = job_arena != NULL ? job_arena : arena_create();
+    if(compile_arena == NULL)
+        ERROR("arena_create error\n", 1, "");
+
+    ret = 1;
+
     /* parsing source code to token list */
-    ret = parse(option.input_file, &tokens);
-    if(ret)
-        ERROR("parsing error\n", 1, "");
+    if(parse(option.input_file, &job_tokens))
+    {
+        LOG("parsing error\n", "");
+        goto clean;
+    }
+
+    /* run program by reference evaluator, READ from stdin, WRITE to stdout,
+       tokens are taken before optimizer, so output of optimizer can be checked by them */
+    if(option.eval)
+    {
+        ret = eval_tokens(job_tokens, variables, stdin, stdout);
+        goto clean;
+    }
 
     /* if we want optimalization do it to the same list */
     if(option.optimal)
     {
-        ret = main_optimizing(tokens, &tokens);
-        if(ret)
-            ERROR("optimalization error\n", 1, "");
+        PHASE_BEGIN(mark);
+
+        if(main_optimizing(job_tokens, &job_tokens))
+        {
+            LOG("optimalization error\n", "");
+            goto clean;
+        }
+
+        PHASE_END(PHASE_OPTIMIZER, mark);
     }
 
     /* buffer output file */
-    fd = open(option.output_file, O_RDWR | O_LARGEFILE | O_TRUNC | O_CREAT, 0644);
-    if(fd == -1)
-        ERROR("cannot open %s file\n", 1, option.output_file);
+    job_fd = open(option.output_file, O_RDWR | O_LARGEFILE | O_TRUNC | O_CREAT, 0644);
+    if(job_fd == -1)
+    {
+        LOG("cannot open %s file\n", option.output_file);
+        goto clean;
+    }
 
     /* create File buffer for this file */
-    fb = file_buffer_create(fd, PROT_READ | PROT_WRITE | MAP_SHARED);
+    fb = file_buffer_create(job_fd, PROT_READ | PROT_WRITE | MAP_SHARED);
     if(fb == NULL)
-        ERROR("file_buffer_create error\n", 1, "");
+    {
+        LOG("file_buffer_create error\n", "");
+        goto clean;
+    }
 
     if(option.tokens)
     {
+        PHASE_BEGIN(mark);
+
         /* write token list to file */
-        ret = write_tokens(tokens);
-        if(ret)
-            ERROR("write tokens error\n", 1, "");
+        if(write_tokens(job_tokens))
+        {
+            LOG("write tokens error\n", "");
+            goto clean;
+        }
+
+        PHASE_END(PHASE_OUTPUT, mark);
     }
     else
     {
         /* compile tokens to asm code */
-        ret = compile(tokens);
-        if(ret)
-            ERROR("compiling error\n", 1, "");
+        if(compile(job_tokens))
+        {
+            LOG("compiling error\n", "");
+            goto clean;
+        }
     }
 
-    /* destroy tokens */
-    for(  arraylist_iterator_init(tokens, &it, ITI_BEGIN);
-        ! arraylist_iterator_end(&it);
-          arraylist_iterator_next(&it))
-        {
-            arraylist_iterator_get_data(&it, (void*)&token);
+    ret = 0;
 
-            token_destroy(token);
-        }
+clean:
+    /* destroy buffer */
+    PHASE_BEGIN(mark);
 
-    arraylist_destroy(tokens);
+    job_clean();
 
-    /* destroy variables */
-    for(  avl_iterator_init(variables, &avlit, ITI_BEGIN);
-        ! avl_iterator_end(&avlit);
-          avl_iterator_next(&avlit))
-        {
-            avl_iterator_get_data(&avlit, (void*)&pvar);
+    PHASE_END(PHASE_OUTPUT, mark);
 
-            pvar_destroy(pvar);
-        }
+    if(ret || option.eval)
+        return ret;
 
-    avl_destroy(variables);
+    if(cached && cache_put(option.cache_dir, option.cache_size, &key, option.output_file))
+        LOG("cache_put error\n", "");
 
-    /* destroy buffer */
-    file_buffer_destroy(fb);
-    close(fd);
+    if(option.time_report)
+        if(time_report_print(stderr, option.input_file, &total))
+            ERROR("time_report_print error\n", 1, "");
 
     return 0;
 }
+
+int compile_context(CompilerContext *ctx)
+{
+    jmp_buf env;
+
+    TRACE("");
+
+    option = ctx->option;
+    job_arena = ctx->arena;
+
+    job_exit = &env;
+    if(setjmp(env) == 0)
+        ctx->ret = main_compile();
+    else
+    {
+        job_clean();
+        ctx->ret = 1;
+    }
+
+    job_exit = NULL;
+    job_arena = NULL;
+
+    return ctx->ret;
+}
+
+void compiler_exit(int status)
+{
+    /* parser might be stopped in the middle */
+    parse_unlock();
+
+    if(job_exit != NULL)
+        longjmp(*job_exit, status == 0 ? 1 : status);
+
+    exit(status);
+}
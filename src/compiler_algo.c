@@ -1,9 +1,9 @@
 #include <compiler_algo.h>
+#include <alias.h>
 
-/* extern from compiler.h */
-Arraylist *token_list;
-Stack *labels;
-uint64_t token_list_pos;
+/* extern from compiler.h, labels are defined in compiler.c */
+__thread Vector *token_list;
+__thread uint64_t token_list_pos;
 
 /*
     strcmp
@@ -31,7 +31,21 @@ static int my_strcmp(void *a , void *b) __nonull__(1, 2);
     -1 iff failure
     Reg number iff success
 */
-static int get_register_num(Arraylist *tokens, uint64_t from) __nonull__(1);
+static int get_register_num(Vector *tokens, uint64_t from) __nonull__(1);
+
+/*
+    Add asm lines from @asm_first to end of code to emitter map
+    ( call it at the end of emitter, so inner ranges are before outer )
+
+    PARAMS
+    @IN emitter - name of emitter
+    @IN asm_first - first asm line generated by emitter
+
+    RETURN
+    0 iff success
+    Non-zero value iff failure
+*/
+static int emitter_range(const char *emitter, uint64_t asm_first) __nonull__(1);
 
 int my_strcmp(void *a , void *b)
 {
@@ -49,7 +63,25 @@ int my_strcmp(void *a , void *b)
     return 0;
 }
 
-static int get_register_num(Arraylist *tokens, uint64_t from)
+static int emitter_range(const char *emitter, uint64_t asm_first)
+{
+    Emitter_map map;
+
+    /* map is not needed or emitter didn't generate code */
+    if(emitter_map == NULL || asmcode->length == asm_first)
+        return 0;
+
+    map.asm_first = asm_first;
+    map.asm_last = asmcode->length - 1;
+    map.emitter = emitter;
+
+    if(darray_insert(emitter_map, (void*)&map))
+        ERROR("darray_insert error\n", 1, "");
+
+    return 0;
+}
+
+static int get_register_num(Vector *tokens, uint64_t from)
 {
 #define GET_REG_BY_NAME_PTR(REG, NAME) \
     do{ \
@@ -118,14 +150,14 @@ static int get_register_num(Arraylist *tokens, uint64_t from)
     int while_counter = 0;
     int for_counter = 0;
     int if_counter = 0;
+    int nested_ifs;
 
     Token *token;
-    Arraylist_iterator it;
+    Vector_iterator it;
 
     Token *back_token;
-    Arraylist_iterator back;
+    Vector_iterator back;
 
-    uint64_t counter = 0;
     int reg_to_trace = 0;
 
     Darray *regs;
@@ -151,48 +183,47 @@ static int get_register_num(Arraylist *tokens, uint64_t from)
     if(regs == NULL)
         ERROR("regs == NULL\n", -1, "");
 
-    /* create sorted array with value name in regs */
+    /*
+        create sorted array with value name in regs,
+        names[i] is name of value in register i + 1 ( NULL iff register has no value )
+    */
     for(i = REG_PTR + 1; i < REGS_NUMBER; ++i)
     {
         if(cpu->registers[i]->val != NULL)
         {
-            names[reg_to_trace] = value_str(cpu->registers[i]->val);
-            if(names[reg_to_trace] == NULL)
+            names[i - 1] = value_str(cpu->registers[i]->val);
+            if(names[i - 1] == NULL)
                 ERROR("val_name == NULL\n", -1, "");
 
             /* can't use regster in use */
             if( ! IS_REG_IN_USE(cpu->registers[i]))
             {
-                if(darray_insert(regs, (void*)&names[reg_to_trace]))
+                if(darray_insert(regs, (void*)&names[i - 1]))
                     ERROR("darray_insert error\n", -1, "");
             }
-
-            ++reg_to_trace;
         }
     }
 
+    reg_to_trace = ARRAY_SIZE(names);
+
     CHECK_WINNER(reg);
 
     /**** analyze tokens and choose the best reg *****/
 
     /* skip obsolete tokens */
-    for(  arraylist_iterator_init(tokens, &it, ITI_BEGIN);
-        ! arraylist_iterator_end(&it) && counter < from;
-          arraylist_iterator_next(&it))
-        {
-            ++counter;
-        }
+    if(vector_iterator_init_pos(tokens, &it, MIN(from, tokens->length)))
+        ERROR("vector_iterator_init_pos error\n", -1, "");
 
     /* save checkpoint for going back */
-    if( memcpy((void*)&back, (void*)&it, sizeof(Arraylist_iterator)) == NULL )
+    if( memcpy((void*)&back, (void*)&it, sizeof(Vector_iterator)) == NULL )
         ERROR("mempcy error\n", -1, "");
 
     /* for each token on list DO: */
     for( ;
-        ! arraylist_iterator_end(&it);
-          arraylist_iterator_next(&it))
+        ! vector_iterator_end(&it);
+          vector_iterator_next(&it))
         {
-            arraylist_iterator_get_data(&it, (void*)&token);
+            vector_iterator_get_data(&it, (void*)&token);
 
             /* analyze used values in this token */
             if(token->type == TOKEN_IO)
@@ -265,11 +296,11 @@ static int get_register_num(Arraylist *tokens, uint64_t from)
                     if(while_counter == 0)
                     {
                         /* GO BACK to first while */
-                        for(  arraylist_iterator_prev(&back);
-                            ! arraylist_iterator_end(&back);
-                              arraylist_iterator_prev(&back))
+                        for(  vector_iterator_prev(&back);
+                            ! vector_iterator_end(&back);
+                              vector_iterator_prev(&back))
                         {
-                            arraylist_iterator_get_data(&back, (void*)&back_token);
+                            vector_iterator_get_data(&back, (void*)&back_token);
 
                             if(back_token->type == TOKEN_WHILE)
                                 break;
@@ -289,11 +320,11 @@ static int get_register_num(Arraylist *tokens, uint64_t from)
                     if(for_counter == 0)
                     {
                         /* GO BACK to first FOR */
-                        for(  arraylist_iterator_prev(&back);
-                            ! arraylist_iterator_end(&back);
-                              arraylist_iterator_prev(&back))
+                        for(  vector_iterator_prev(&back);
+                            ! vector_iterator_end(&back);
+                              vector_iterator_prev(&back))
                         {
-                            arraylist_iterator_get_data(&back, (void*)&back_token);
+                            vector_iterator_get_data(&back, (void*)&back_token);
 
                             if(back_token->type == TOKEN_FOR)
                                 break;
@@ -314,15 +345,26 @@ static int get_register_num(Arraylist *tokens, uint64_t from)
                 {
                     if(if_counter == 0)
                     {
-                        /* we are in if else statment but we start from if statement, so else code is death code */
+                        /*
+                            we are in if else statment but we start from if statement, so else code is death code,
+                            skip it to our ENDIF ( not to ENDIF of IF nested in else code )
+                        */
+                        nested_ifs = 0;
                         for(;
-                            ! arraylist_iterator_end(&it);
-                              arraylist_iterator_next(&it))
+                            ! vector_iterator_end(&it);
+                              vector_iterator_next(&it))
                             {
-                                arraylist_iterator_get_data(&it, (void*)&token);
+                                vector_iterator_get_data(&it, (void*)&token);
 
-                                if(token->type == TOKEN_GUARD && token->body.guard->type == tokens_id.end_if)
-                                    break;
+                                if(token->type == TOKEN_IF)
+                                    ++nested_ifs;
+                                else if(token->type == TOKEN_GUARD && token->body.guard->type == tokens_id.end_if)
+                                {
+                                    if(nested_ifs == 0)
+                                        break;
+
+                                    --nested_ifs;
+                                }
                             }
                     }
                 }
@@ -376,30 +418,25 @@ static BOOL __inline__ is_needed (Value *val, Value *it)
     return FALSE;
 }
 
-BOOL is_iterator_needed(Arraylist *tokens, uint64_t pos, Value *it)
+BOOL is_iterator_needed(Vector *tokens, uint64_t pos, Value *it)
 {
     Token *token;
-    Arraylist_iterator ait;
+    Vector_iterator ait;
 
-    uint64_t counter = 0;
     uint64_t for_c = 1;
 
     TRACE("");
 
     /* skip obsolete tokens */
-    for(  arraylist_iterator_init(tokens, &ait, ITI_BEGIN);
-        ! arraylist_iterator_end(&ait) && counter < pos;
-          arraylist_iterator_next(&ait))
-        {
-            ++counter;
-        }
+    if(vector_iterator_init_pos(tokens, &ait, MIN(pos, tokens->length)))
+        ERROR("vector_iterator_init_pos error\n", FALSE, "");
 
     /* for each token on list DO: */
     for( ;
-        ! arraylist_iterator_end(&ait) && for_c;
-          arraylist_iterator_next(&ait))
+        ! vector_iterator_end(&ait) && for_c;
+          vector_iterator_next(&ait))
         {
-            arraylist_iterator_get_data(&ait, (void*)&token);
+            vector_iterator_get_data(&ait, (void*)&token);
 
             /* analyze used values in this token */
             if(token->type == TOKEN_IO)
@@ -489,7 +526,7 @@ int do_synchronize(Register *reg)
     return 0;
 }
 
-int get_register(Arraylist *tokens, uint64_t pos, Value *val)
+int get_register(Vector *tokens, uint64_t pos, Value *val)
 {
     /* here val is NULL or val is common value from cvars */
     int reg;
@@ -522,7 +559,7 @@ int get_register(Arraylist *tokens, uint64_t pos, Value *val)
     return reg;
 }
 
-int do_get_register(Arraylist *tokens, uint64_t pos, Value *val, BOOL force_sync)
+int do_get_register(Vector *tokens, uint64_t pos, Value *val, BOOL force_sync)
 {
     Cvar *cvar;
     Value *common_val;
@@ -571,7 +608,7 @@ int do_get_register(Arraylist *tokens, uint64_t pos, Value *val, BOOL force_sync
     return reg;
 }
 
-int better_reg(Arraylist *tokens, uint64_t pos, Value *val1, Value *val2)
+int better_reg(Vector *tokens, uint64_t pos, Value *val1, Value *val2)
 {
     Cvar *cvar1;
     Cvar *cvar2;
@@ -710,8 +747,8 @@ int do_zero(Register *reg, BOOL trace)
     if(asprintf(&codeline, "%s %ju\n", mnemonics.zero, reg->num) == -1)
         ERROR("asprintf error\n", 1, "");
 
-    if(arraylist_insert_last(asmcode, (void*)&codeline))
-        ERROR("arraylist_insert_last error\n", 1, "");
+    if(vector_insert_last(asmcode, (void*)&codeline))
+        ERROR("vector_insert_last error\n", 1, "");
 
 
 
@@ -778,8 +815,8 @@ int do_inc(Register *reg, BOOL trace)
     if(asprintf(&codeline, "%s %ju\n", mnemonics.inc, reg->num) == -1)
         ERROR("asprintf error\n", 1, "");
 
-    if(arraylist_insert_last(asmcode, (void*)&codeline))
-        ERROR("arraylist_insert_last error\n", 1, "");
+    if(vector_insert_last(asmcode, (void*)&codeline))
+        ERROR("vector_insert_last error\n", 1, "");
 
 
 
@@ -842,8 +879,8 @@ int do_dec(Register *reg, BOOL trace)
     if(asprintf(&codeline, "%s %ju\n", mnemonics.dec, reg->num) == -1)
         ERROR("asprintf error\n", 1, "");
 
-    if(arraylist_insert_last(asmcode, (void*)&codeline))
-        ERROR("arraylist_insert_last error\n", 1, "");
+    if(vector_insert_last(asmcode, (void*)&codeline))
+        ERROR("vector_insert_last error\n", 1, "");
 
 
 
@@ -906,8 +943,8 @@ int do_shl(Register *reg, BOOL trace)
     if(asprintf(&codeline, "%s %ju\n", mnemonics.shl, reg->num) == -1)
         ERROR("asprintf error\n", 1, "");
 
-    if(arraylist_insert_last(asmcode, (void*)&codeline))
-        ERROR("arraylist_insert_last error\n", 1, "");
+    if(vector_insert_last(asmcode, (void*)&codeline))
+        ERROR("vector_insert_last error\n", 1, "");
 
 
 
@@ -970,8 +1007,8 @@ int do_shr(Register *reg, BOOL trace)
     if(asprintf(&codeline, "%s %ju\n", mnemonics.shr, reg->num) == -1)
         ERROR("asprintf error\n", 1, "");
 
-    if(arraylist_insert_last(asmcode, (void*)&codeline))
-        ERROR("arraylist_insert_last error\n", 1, "");
+    if(vector_insert_last(asmcode, (void*)&codeline))
+        ERROR("vector_insert_last error\n", 1, "");
 
 
 
@@ -1040,8 +1077,8 @@ int do_load(Register *reg, Value *val)
     if(asprintf(&codeline, "%s %ju\n", mnemonics.load, reg->num) == -1)
         ERROR("asprintf error\n", 1, "");
 
-    if(arraylist_insert_last(asmcode, (void*)&codeline))
-        ERROR("arraylist_insert_last error\n", 1, "");
+    if(vector_insert_last(asmcode, (void*)&codeline))
+        ERROR("vector_insert_last error\n", 1, "");
 
     return 0;
 }
@@ -1067,8 +1104,8 @@ int do_store(Register *reg)
     if(asprintf(&codeline, "%s %ju\n", mnemonics.store, reg->num) == -1)
         ERROR("asprintf error\n", 1, "");
 
-    if(arraylist_insert_last(asmcode, (void*)&codeline))
-        ERROR("arraylist_insert_last error\n", 1, "");
+    if(vector_insert_last(asmcode, (void*)&codeline))
+        ERROR("vector_insert_last error\n", 1, "");
 
 
 
@@ -1093,8 +1130,8 @@ int do_halt()
     if(asprintf(&codeline, "%s\n", mnemonics.halt) == -1)
         ERROR("asprintf error\n", 1, "");
 
-    if(arraylist_insert_last(asmcode, (void*)&codeline))
-        ERROR("arraylist_insert_last error\n", 1, "");
+    if(vector_insert_last(asmcode, (void*)&codeline))
+        ERROR("vector_insert_last error\n", 1, "");
 
 
 
@@ -1104,9 +1141,12 @@ int do_halt()
 int do_pump(Register *reg, uint64_t val, BOOL trace)
 {
     int i;
+    uint64_t asm_first;
 
     TRACE("");
 
+    asm_first = asmcode->length;
+
     if(reg == NULL)
         ERROR("reg == NULL\n", 1, "");
 
@@ -1139,15 +1179,21 @@ int do_pump(Register *reg, uint64_t val, BOOL trace)
             ERROR("do_inc error\n", 1, "");
     }
 
+    if( emitter_range("do_pump", asm_first) )
+        ERROR("emitter_range error\n", 1, "");
+
     return 0;
 }
 
 int do_pump_bigvalue(Register *reg, mpz_t val, BOOL trace)
 {
     uint64_t i;
+    uint64_t asm_first;
 
     TRACE("");
 
+    asm_first = asmcode->length;
+
     if(reg == NULL)
         ERROR("reg == NULL\n", 1, "");
 
@@ -1177,6 +1223,9 @@ int do_pump_bigvalue(Register *reg, mpz_t val, BOOL trace)
             ERROR("do_inc error\n", 1, "");
     }
 
+    if( emitter_range("do_pump_bigvalue", asm_first) )
+        ERROR("emitter_range error\n", 1, "");
+
     return 0;
 }
 
@@ -1191,8 +1240,8 @@ int do_get(Register *reg, BOOL trace)
     if(asprintf(&codeline, "%s %ju\n", mnemonics.get, reg->num) == -1)
         ERROR("asprintf error\n", 1, "");
 
-    if(arraylist_insert_last(asmcode, (void*)&codeline))
-        ERROR("arraylist_insert_last error\n", 1, "");
+    if(vector_insert_last(asmcode, (void*)&codeline))
+        ERROR("vector_insert_last error\n", 1, "");
 
 
 
@@ -1224,8 +1273,8 @@ int do_put(Register *reg)
     if(asprintf(&codeline, "%s %ju\n", mnemonics.put, reg->num) == -1)
         ERROR("asprintf error\n", 1, "");
 
-    if(arraylist_insert_last(asmcode, (void*)&codeline))
-        ERROR("arraylist_insert_last error\n", 1, "");
+    if(vector_insert_last(asmcode, (void*)&codeline))
+        ERROR("vector_insert_last error\n", 1, "");
 
 
 
@@ -1253,8 +1302,8 @@ int do_add(Register *reg, BOOL trace)
     if(asprintf(&codeline, "%s %ju\n", mnemonics.add, reg->num) == -1)
         ERROR("asprintf error\n", 1, "");
 
-    if(arraylist_insert_last(asmcode, (void*)&codeline))
-        ERROR("arraylist_insert_last error\n", 1, "");
+    if(vector_insert_last(asmcode, (void*)&codeline))
+        ERROR("vector_insert_last error\n", 1, "");
 
 
 
@@ -1328,8 +1377,8 @@ int do_sub(Register *reg, BOOL trace)
     if(asprintf(&codeline, "%s %ju\n", mnemonics.sub, reg->num) == -1)
         ERROR("asprintf error\n", 1, "");
 
-    if(arraylist_insert_last(asmcode, (void*)&codeline))
-        ERROR("arraylist_insert_last error\n", 1, "");
+    if(vector_insert_last(asmcode, (void*)&codeline))
+        ERROR("vector_insert_last error\n", 1, "");
 
 
 
@@ -1401,6 +1450,16 @@ int do_mult(Register *res,Register *left, Register *right, BOOL trace)
     mpz_t old_ptrval;
     Cvar *cvar_ptr;
 
+    uint64_t left_lo;
+    uint64_t left_hi;
+    uint64_t right_lo;
+    uint64_t right_hi;
+
+    BOOL only_mult1;
+    BOOL only_mult2;
+
+    uint64_t asm_first;
+
 #ifdef DEBUG_MODE
     char *str = NULL;
 #endif
@@ -1411,129 +1470,169 @@ int do_mult(Register *res,Register *left, Register *right, BOOL trace)
 
     TRACE("");
 
+    asm_first = asmcode->length;
+
     cvar_ptr = cvar_get_by_name(PTR_NAME);
 
+    /* smaller value drives loop, so check it in runtime iff ranges of operands don't say it */
+    alias_operand_range(TRUE, &left_lo, &left_hi);
+    alias_operand_range(FALSE, &right_lo, &right_hi);
+
+    only_mult1 = left_hi <= right_lo;
+    only_mult2 = ! only_mult1 && right_hi <= left_lo;
+
+    mult2 = 0;
+
     /***** compile mult *****/
 
-    /* R0 = left.addr */
-    if(do_set_val_addr(cpu->registers[REG_PTR], left->val, TRUE))
+    /* R0 = left.addr ( right.addr iff we have only mult1 ) */
+    if(do_set_val_addr(cpu->registers[REG_PTR], only_mult1 ? right->val : left->val, TRUE))
         ERROR("do_set_val_addr error\n", 1, "");
 
     /* RES = 0 */
     if(do_zero(res, FALSE))
         ERROR("do_zero error\n", 1, "");
 
-    /* IF left == 0 END */
-    if(do_jzero_label(left, LABEL_END))
-        ERROR("do_jzero error\n", 1, "");
+    /* IF left == 0 END, skip iff left can't be 0 */
+    if(left_lo == 0)
+    {
+        if(do_jzero_label(left, LABEL_END))
+            ERROR("do_jzero error\n", 1, "");
+    }
+    else
+        label_fake();
 
-    /* IF right == 0 END */
-    if(do_jzero_label(right, LABEL_END))
-        ERROR("do_jzero error\n", 1, "");
+    /* IF right == 0 END, skip iff right can't be 0 */
+    if(right_lo == 0)
+    {
+        if(do_jzero_label(right, LABEL_END))
+            ERROR("do_jzero error\n", 1, "");
+    }
+    else
+        label_fake();
 
-    /* RIGHT = RIGHT - LEFT */
-    if(do_sub(right, FALSE))
-        ERROR("do_sub error\n", 1, "");
+    if(only_mult1 || only_mult2)
+        label_fake();
+    else
+    {
+        /* RIGHT = RIGHT - LEFT */
+        if(do_sub(right, FALSE))
+            ERROR("do_sub error\n", 1, "");
 
-    /* RIGHT <= LEFT GO TO RES = LEFT * RIGHT */
-    if(do_jzero_label(right, LABEL_MULT2_LABEL))
-        ERROR("do_jzero error\n", 1, "");
+        /* RIGHT <= LEFT GO TO RES = LEFT * RIGHT */
+        if(do_jzero_label(right, LABEL_MULT2_LABEL))
+            ERROR("do_jzero error\n", 1, "");
 
-    /* save ptr value */
-    value_get_val(cvar_ptr->body.val, old_ptrval);
+        /* save ptr value */
+        value_get_val(cvar_ptr->body.val, old_ptrval);
 
-    /* LOAD Right, so R0 = right.addr */
-    if(do_load(right, right->val))
-        ERROR("do_load error\n", 1, "");
+        /* LOAD Right, so R0 = right.addr */
+        if(do_load(right, right->val))
+            ERROR("do_load error\n", 1, "");
+    }
 
     /*** mult1 res = right * left ***/
+    if(only_mult2)
+        label_fake();
+    else
+    {
 /* COND1: */
-    k = asmcode->length;
-    if(do_jzero_label(left, LABEL_END))
-        ERROR("do_jzero error\n", 1, "");
+        k = asmcode->length;
+        if(do_jzero_label(left, LABEL_END))
+            ERROR("do_jzero error\n", 1, "");
 
-    if(do_jodd(left, k + 6))
-        ERROR("do_jodd error\n", 1, "");
+        if(do_jodd(left, k + 6))
+            ERROR("do_jodd error\n", 1, "");
 
-    if(do_shl(right, FALSE))
-        ERROR("do_shl error\n", 1, "");
+        if(do_shl(right, FALSE))
+            ERROR("do_shl error\n", 1, "");
 
-    if(do_store(right))
-        ERROR("do_store error\n", 1, "");
+        if(do_store(right))
+            ERROR("do_store error\n", 1, "");
 
-    if(do_shr(left, FALSE))
-        ERROR("do_shr error\n", 1, "");
+        if(do_shr(left, FALSE))
+            ERROR("do_shr error\n", 1, "");
 
-    if(do_jump(k))
-        ERROR("do_jump error\n", 1, "");
+        if(do_jump(k))
+            ERROR("do_jump error\n", 1, "");
 
 /* ODD1: */
-    if(do_add(res, FALSE))
-        ERROR("do_add error\n", 1, "");
+        if(do_add(res, FALSE))
+            ERROR("do_add error\n", 1, "");
 
-    if(do_shl(right, FALSE))
-        ERROR("do_shl error\n", 1, "");
+        if(do_shl(right, FALSE))
+            ERROR("do_shl error\n", 1, "");
 
-    if(do_store(right))
-        ERROR("do_store error\n", 1, "");
+        if(do_store(right))
+            ERROR("do_store error\n", 1, "");
 
-    if(do_shr(left, FALSE))
-        ERROR("do_shr error\n", 1, "");
+        if(do_shr(left, FALSE))
+            ERROR("do_shr error\n", 1, "");
 
-    if(do_jump(k))
-        ERROR("do_jump error\n", 1, "");
+        if(do_jump(k))
+            ERROR("do_jump error\n", 1, "");
+    }
 
     /*** mult2 res = left * right ***/
+    if(only_mult1)
+        label_fake();
+    else
+    {
 /*  LABEL_MULT2: */
 
-    /* Another branch so restore ptr value */
-    value_set_val(cvar_ptr->body.val, old_ptrval);
+        /* right was changed by choice of loop, R0 = left.addr otherwise */
+        if( ! only_mult2)
+        {
+            /* Another branch so restore ptr value */
+            value_set_val(cvar_ptr->body.val, old_ptrval);
 
-    mpz_clear(old_ptrval);
+            mpz_clear(old_ptrval);
 
-    mult2 = asmcode->length;
-    /* R0 = right.addr */
-    if(do_load(right, right->val))
-        ERROR("do_load error\n", 1, "");
+            mult2 = asmcode->length;
+            /* R0 = right.addr */
+            if(do_load(right, right->val))
+                ERROR("do_load error\n", 1, "");
 
-    if(do_set_val_addr(cpu->registers[REG_PTR], left->val, FALSE))
-        ERROR("do_set_val_addr error\n", 1, "");
+            if(do_set_val_addr(cpu->registers[REG_PTR], left->val, FALSE))
+                ERROR("do_set_val_addr error\n", 1, "");
+        }
 
 /* COND2: */
-    k = asmcode->length;
-    if(do_jzero_label(right, LABEL_END))
-        ERROR("do_jzero error\n", 1, "");
+        k = asmcode->length;
+        if(do_jzero_label(right, LABEL_END))
+            ERROR("do_jzero error\n", 1, "");
 
-    if(do_jodd(right, k + 6))
-        ERROR("do_jodd error\n", 1, "");
+        if(do_jodd(right, k + 6))
+            ERROR("do_jodd error\n", 1, "");
 
-    if(do_shl(left, FALSE))
-        ERROR("do_shl error\n", 1, "");
+        if(do_shl(left, FALSE))
+            ERROR("do_shl error\n", 1, "");
 
-    if(do_store(left))
-        ERROR("do_store error\n", 1, "");
+        if(do_store(left))
+            ERROR("do_store error\n", 1, "");
 
-    if(do_shr(right, FALSE))
-        ERROR("do_shr error\n", 1, "");
+        if(do_shr(right, FALSE))
+            ERROR("do_shr error\n", 1, "");
 
-    if(do_jump(k))
-        ERROR("do_jump error\n", 1, "");
+        if(do_jump(k))
+            ERROR("do_jump error\n", 1, "");
 
 /* ODD2: */
-    if(do_add(res, FALSE))
-        ERROR("do_add error\n", 1, "");
+        if(do_add(res, FALSE))
+            ERROR("do_add error\n", 1, "");
 
-    if(do_shl(left, FALSE))
-        ERROR("do_shl error\n", 1, "");
+        if(do_shl(left, FALSE))
+            ERROR("do_shl error\n", 1, "");
 
-    if(do_store(left))
-        ERROR("do_store error\n", 1, "");
+        if(do_store(left))
+            ERROR("do_store error\n", 1, "");
 
-    if(do_shr(right, FALSE))
-        ERROR("do_shr error\n", 1, "");
+        if(do_shr(right, FALSE))
+            ERROR("do_shr error\n", 1, "");
 
-    if(do_jump(k))
-        ERROR("do_jump error\n", 1, "");
+        if(do_jump(k))
+            ERROR("do_jump error\n", 1, "");
+    }
 /* END: */
     if( label_to_line(asmcode->length) )
         ERROR("label_to_line 1 error\n", 1 ,"");
@@ -1552,6 +1651,9 @@ int do_mult(Register *res,Register *left, Register *right, BOOL trace)
 
     value_set_symbolic_flag(cvar_ptr->body.val);
 
+    if( emitter_range("do_mult", asm_first) )
+        ERROR("emitter_range error\n", 1, "");
+
     /* we don't want to trace this value */
     if(! trace)
         return 0;
@@ -1612,8 +1714,19 @@ int do_div(Register *res,Register *left, Register *right, BOOL trace)
     int l;
     int m;
 
+    uint64_t left_lo;
+    uint64_t left_hi;
+    uint64_t right_lo;
+    uint64_t right_hi;
+    uint64_t asm_first;
+
     TRACE("");
 
+    asm_first = asmcode->length;
+
+    alias_operand_range(TRUE, &left_lo, &left_hi);
+    alias_operand_range(FALSE, &right_lo, &right_hi);
+
     div_helper = cvar_get_by_name(TEMP_DIV_HELPER);
 
     ptr = cvar_get_by_name(PTR_NAME);
@@ -1630,11 +1743,23 @@ int do_div(Register *res,Register *left, Register *right, BOOL trace)
     if(do_zero(res, FALSE))
         ERROR("do_zero error\n", 1, "");
 
-    if(do_jzero_label(left, LABEL_END))
-        ERROR("do_jzero_label error\n", 1, "");
+    /* 0 / N = 0, skip check iff left can't be 0 */
+    if(left_lo == 0)
+    {
+        if(do_jzero_label(left, LABEL_END))
+            ERROR("do_jzero_label error\n", 1, "");
+    }
+    else
+        label_fake();
 
-    if(do_jzero_label(right, LABEL_END))
-        ERROR("do_jzero_label error\n", 1, "");
+    /* N / 0 = 0, skip check iff right can't be 0 */
+    if(right_lo == 0)
+    {
+        if(do_jzero_label(right, LABEL_END))
+            ERROR("do_jzero_label error\n", 1, "");
+    }
+    else
+        label_fake();
 
     if(do_set_val_addr(cpu->registers[REG_PTR], right->val, TRUE))
         ERROR("do_set_val_addr error\n", 1, "");
@@ -1763,6 +1888,9 @@ int do_div(Register *res,Register *left, Register *right, BOOL trace)
 
     value_set_symbolic_flag(ptr->body.val);
 
+    if( emitter_range("do_div", asm_first) )
+        ERROR("emitter_range error\n", 1, "");
+
     REG_SET_FREE(helper);
 
     return 0;
@@ -1783,8 +1911,19 @@ int do_mod(Register *res, Register *left, Register *right, BOOL trace)
     int l;
     int m;
 
+    uint64_t left_lo;
+    uint64_t left_hi;
+    uint64_t right_lo;
+    uint64_t right_hi;
+    uint64_t asm_first;
+
     TRACE("");
 
+    asm_first = asmcode->length;
+
+    alias_operand_range(TRUE, &left_lo, &left_hi);
+    alias_operand_range(FALSE, &right_lo, &right_hi);
+
     div_helper = cvar_get_by_name(TEMP_DIV_HELPER);
 
     ptr = cvar_get_by_name(PTR_NAME);
@@ -1801,29 +1940,41 @@ int do_mod(Register *res, Register *left, Register *right, BOOL trace)
     if(do_zero(res, FALSE))
         ERROR("do_zero error\n", 1, "");
 
-    if(do_jzero(left, asmcode->length + 2))
-        ERROR("do_jzero error\n", 1, "");
+    /* 0 % N = 0, skip check iff left can't be 0 */
+    if(left_lo == 0)
+    {
+        if(do_jzero(left, asmcode->length + 2))
+            ERROR("do_jzero error\n", 1, "");
 
-    if(do_jump(asmcode->length + 3))
-        ERROR("do_jump error\n", 1, "");
+        if(do_jump(asmcode->length + 3))
+            ERROR("do_jump error\n", 1, "");
 
-    if(do_zero(left, FALSE))
-        ERROR("do_zero error\n", 1, "");
+        if(do_zero(left, FALSE))
+            ERROR("do_zero error\n", 1, "");
 
-    if(do_jump_label(LABEL_END))
-        ERROR("do_jump_label error\n", 1, "");
+        if(do_jump_label(LABEL_END))
+            ERROR("do_jump_label error\n", 1, "");
+    }
+    else
+        label_fake();
 
-    if(do_jzero(right, asmcode->length + 2))
-        ERROR("do_jzero error\n", 1, "");
+    /* N % 0 = 0, skip check iff right can't be 0 */
+    if(right_lo == 0)
+    {
+        if(do_jzero(right, asmcode->length + 2))
+            ERROR("do_jzero error\n", 1, "");
 
-    if(do_jump(asmcode->length + 3))
-        ERROR("do_jump error\n", 1, "");
+        if(do_jump(asmcode->length + 3))
+            ERROR("do_jump error\n", 1, "");
 
-    if(do_zero(left, FALSE))
-        ERROR("do_zero error\n", 1, "");
+        if(do_zero(left, FALSE))
+            ERROR("do_zero error\n", 1, "");
 
-    if(do_jump_label(LABEL_END))
-        ERROR("do_jump_label error\n", 1, "");
+        if(do_jump_label(LABEL_END))
+            ERROR("do_jump_label error\n", 1, "");
+    }
+    else
+        label_fake();
 
     if(do_set_val_addr(cpu->registers[REG_PTR], right->val, TRUE))
         ERROR("do_set_val_addr error\n", 1, "");
@@ -1952,6 +2103,9 @@ int do_mod(Register *res, Register *left, Register *right, BOOL trace)
 
     value_set_symbolic_flag(ptr->body.val);
 
+    if( emitter_range("do_mod", asm_first) )
+        ERROR("emitter_range error\n", 1, "");
+
     REG_SET_FREE(helper);
 
     return 0;
@@ -1968,8 +2122,8 @@ int do_jump(uint64_t line)
     if(asprintf(&codeline, "%s %ju\n", mnemonics.jump, line) == -1)
         ERROR("asprintf error\n", 1, "");
 
-    if(arraylist_insert_last(asmcode, (void*)&codeline))
-        ERROR("arraylist_insert_last error\n", 1, "");
+    if(vector_insert_last(asmcode, (void*)&codeline))
+        ERROR("vector_insert_last error\n", 1, "");
 
 
 
@@ -1986,8 +2140,8 @@ int do_jzero(Register *reg, uint64_t line)
     if(asprintf(&codeline, "%s %ju %ju\n", mnemonics.jzero, reg->num, line) == -1)
         ERROR("asprintf error\n", 1, "");
 
-    if(arraylist_insert_last(asmcode, (void*)&codeline))
-        ERROR("arraylist_insert_last error\n", 1, "");
+    if(vector_insert_last(asmcode, (void*)&codeline))
+        ERROR("vector_insert_last error\n", 1, "");
 
 
 
@@ -2004,8 +2158,8 @@ int do_jodd(Register *reg, uint64_t line)
     if(asprintf(&codeline, "%s %ju %ju\n", mnemonics.jodd, reg->num, line) == -1)
         ERROR("asprintf error\n", 1, "");
 
-    if(arraylist_insert_last(asmcode, (void*)&codeline))
-        ERROR("arraylist_insert_last error\n", 1, "");
+    if(vector_insert_last(asmcode, (void*)&codeline))
+        ERROR("vector_insert_last error\n", 1, "");
 
 
 
@@ -2023,12 +2177,12 @@ int do_jump_label(int8_t type)
     if(asprintf(&codeline, "%s ", mnemonics.jump) == -1)
         ERROR("asprintf error\n", 1, "");
 
-    if(arraylist_insert_last(asmcode, (void*)&codeline))
-        ERROR("arraylist_insert_last error\n", 1, "");
+    if(vector_insert_last(asmcode, (void*)&codeline))
+        ERROR("vector_insert_last error\n", 1, "");
 
 
 
-    label = label_create(asmcode->tail, type);
+    label = label_create(asmcode->length - 1, type);
     if(label == NULL)
         ERROR("label_create error\n", 1, "");
 
@@ -2049,12 +2203,12 @@ int do_jodd_label(Register *reg, int8_t type)
     if(asprintf(&codeline, "%s %ju ", mnemonics.jodd, reg->num) == -1)
         ERROR("asprintf error\n", 1, "");
 
-    if(arraylist_insert_last(asmcode, (void*)&codeline))
-        ERROR("arraylist_insert_last error\n", 1, "");
+    if(vector_insert_last(asmcode, (void*)&codeline))
+        ERROR("vector_insert_last error\n", 1, "");
 
 
 
-    label = label_create(asmcode->tail, type);
+    label = label_create(asmcode->length - 1, type);
     if(label == NULL)
         ERROR("label_create error\n", 1, "");
 
@@ -2075,10 +2229,10 @@ int do_jzero_label(Register *reg, int8_t type)
     if(asprintf(&codeline, "%s %ju ", mnemonics.jzero, reg->num) == -1)
         ERROR("asprintf error\n", 1, "");
 
-    if(arraylist_insert_last(asmcode, (void*)&codeline))
-        ERROR("arraylist_insert_last error\n", 1, "");
+    if(vector_insert_last(asmcode, (void*)&codeline))
+        ERROR("vector_insert_last error\n", 1, "");
 
-    label = label_create(asmcode->tail, type);
+    label = label_create(asmcode->length - 1, type);
     if(label == NULL)
         ERROR("label_create error\n", 1, "");
 
@@ -2107,8 +2261,8 @@ int do_copy(Register *reg, BOOL trace)
     if(asprintf(&codeline, "%s %ju\n", mnemonics.copy, reg->num) == -1)
         ERROR("asprintf error\n", 1, "");
 
-    if(arraylist_insert_last(asmcode, (void*)&codeline))
-        ERROR("arraylist_insert_last error\n", 1, "");
+    if(vector_insert_last(asmcode, (void*)&codeline))
+        ERROR("vector_insert_last error\n", 1, "");
 
     /* we don't want to trace this value */
     if(! trace)
@@ -2162,9 +2316,12 @@ int do_set_val_addr(Register *reg, Value *val, BOOL trace)
     mpz_t bdst_addr;
 
     int regnum = 0;
+    uint64_t asm_first;
 
     TRACE("");
 
+    asm_first = asmcode->length;
+
     if(reg == NULL || val == NULL)
         ERROR("reg == NULL || val == NULL\n", 1 ,"");
 
@@ -2474,6 +2631,9 @@ int do_set_val_addr(Register *reg, Value *val, BOOL trace)
         mpz_clear(addr);
     }
 
+    if( emitter_range("do_set_val_addr", asm_first) )
+        ERROR("emitter_range error\n", 1, "");
+
     return 0;
 }
 
@@ -0,0 +1,1141 @@
+#include <cost.h>
+#include <asm.h>
+#include <arch.h>
+#include <tokens.h>
+
+#define NO_LINE     UINT64_MAX
+
+/* formula with estimated value */
+typedef struct Cost
+{
+    uint64_t est; /* value of formula, unknowns are replaced by guesses */
+    char *expr; /* formula */
+
+    uint8_t num     :1; /* formula is only a number ( est ) */
+    uint8_t padding :7;
+
+}Cost;
+
+/* source statement */
+typedef struct Stmt
+{
+    uint64_t token; /* token position */
+
+    Cost cost; /* cost of one execution */
+    Cost exec; /* how many times statement is executed */
+
+    uint64_t total; /* estimated cost of all executions */
+
+}Stmt;
+
+typedef struct Cost_ctx
+{
+    Asm_line *code;
+    uint64_t *line_cost;
+    uint64_t lines;
+
+    Token **tokens;
+    uint64_t ntokens;
+
+    /* asm lines of token, NO_LINE iff token has no code */
+    uint64_t *first;
+    uint64_t *last;
+
+    Stmt *stmts;
+    uint64_t nstmts;
+
+}Cost_ctx;
+
+/*
+    Saturating add and mult, estimate is only for ranking so overflow means "very big"
+*/
+static __inline__ uint64_t sat_add(uint64_t a, uint64_t b)
+{
+    return a > UINT64_MAX - b ? UINT64_MAX : a + b;
+}
+
+static __inline__ uint64_t sat_mult(uint64_t a, uint64_t b)
+{
+    return a != 0 && b > UINT64_MAX / a ? UINT64_MAX : a * b;
+}
+
+/*
+    Create cost which is a number
+
+    PARAMS
+    @OUT cost - pointer to cost
+    @IN val - value
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int cost_num(Cost *cost, uint64_t val) __nonull__(1);
+
+/*
+    Create cost with unknown value
+
+    PARAMS
+    @OUT cost - pointer to cost
+    @IN est - guess of value
+    @IN expr - formula ( cost takes it )
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int cost_sym(Cost *cost, uint64_t est, char *expr) __nonull__(1);
+
+/*
+    Copy cost
+
+    PARAMS
+    @OUT dst - pointer to new cost
+    @IN src - pointer to cost
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int cost_copy(Cost *dst, Cost *src) __nonull__(1, 2);
+
+/*
+    Destroy cost formula
+
+    PARAMS
+    @IN cost - pointer to cost
+
+    RETURN:
+    This is a void function
+*/
+static void cost_destroy(Cost *cost) __nonull__(1);
+
+/*
+    @a = @a + @b, @b is destroyed
+
+    PARAMS
+    @IN / @OUT a - pointer to cost
+    @IN b - pointer to cost
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int cost_add(Cost *a, Cost *b) __nonull__(1, 2);
+
+/*
+    @a = @a * @b, @b is destroyed
+
+    PARAMS
+    @IN / @OUT a - pointer to cost
+    @IN b - pointer to cost
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int cost_mult(Cost *a, Cost *b) __nonull__(1, 2);
+
+/*
+    @a = max(@a, @b), @b is destroyed
+
+    PARAMS
+    @IN / @OUT a - pointer to cost
+    @IN b - pointer to cost
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int cost_max(Cost *a, Cost *b) __nonull__(1, 2);
+
+/*
+    Get name of value without spaces around
+
+    PARAMS
+    @IN val - pointer to value
+
+    RETURN:
+    NULL iff failure
+    Allocated name iff success
+*/
+static char *value_name(Value *val) __nonull__(1);
+
+/*
+    Get number of bits of value
+
+    PARAMS
+    @IN val - pointer to value
+    @OUT cost - bits, for variable bits(name)
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int value_bits(Value *val, Cost *cost) __nonull__(1, 2);
+
+/*
+    Get number of loop iterations inside ASSIGN ( MULT, DIV, MOD loops )
+
+    PARAMS
+    @IN ctx - pointer to context
+    @IN pos - token position
+    @OUT cost - iterations
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int token_loop_iters(Cost_ctx *ctx, uint64_t pos, Cost *cost) __nonull__(1, 3);
+
+/*
+    Get number of FOR loop iterations
+
+    PARAMS
+    @IN token - FOR token
+    @OUT cost - iterations
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int for_iters(token_for *token, Cost *cost) __nonull__(1, 2);
+
+/*
+    Get cost of asm lines
+
+    PARAMS
+    @IN ctx - pointer to context
+    @IN first - first line
+    @IN last - last line
+
+    RETURN:
+    Sum of lines cost ( 0 iff first == NO_LINE )
+*/
+static uint64_t range_cost(Cost_ctx *ctx, uint64_t first, uint64_t last) __nonull__(1);
+
+/*
+    Get cost of one execution of token code ( with loops inside token )
+
+    PARAMS
+    @IN ctx - pointer to context
+    @IN pos - token position
+    @OUT cost - cost of token
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int token_cost(Cost_ctx *ctx, uint64_t pos, Cost *cost) __nonull__(1, 3);
+
+/*
+    Remember statement
+
+    PARAMS
+    @IN ctx - pointer to context
+    @IN pos - token position
+    @IN cost - cost of one execution ( copied )
+    @IN exec - executions ( copied )
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int stmt_add(Cost_ctx *ctx, uint64_t pos, Cost *cost, Cost *exec) __nonull__(1, 3, 4);
+
+/*
+    Compare statements, more expensive first
+
+    PARAMS
+    @IN a - pointer to Stmt
+    @IN b - pointer to Stmt
+
+    RETURN:
+    -1 iff a is before b
+    0 iff a == b
+    1 iff a is after b
+*/
+static int stmt_cmp(const void *a, const void *b) __nonull__(1, 2);
+
+/*
+    Compare statements by position in source
+
+    PARAMS
+    @IN a - pointer to Stmt
+    @IN b - pointer to Stmt
+
+    RETURN:
+    -1 iff a is before b
+    0 iff a == b
+    1 iff a is after b
+*/
+static int stmt_pos_cmp(const void *a, const void *b) __nonull__(1, 2);
+
+/*
+    Get cost of tokens block ( till ELSE, ENDIF, ENDFOR, ENDWHILE or end of program )
+
+    PARAMS
+    @IN ctx - pointer to context
+    @IN / @OUT pos - position of 1st token, after call position of closing token
+    @IN exec - how many times block is executed
+    @OUT cost - cost of one execution of block
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int cost_block(Cost_ctx *ctx, uint64_t *pos, Cost *exec, Cost *cost) __nonull__(1, 2, 3, 4);
+
+static int cost_num(Cost *cost, uint64_t val)
+{
+    cost->est = val;
+    cost->num = 1;
+
+    if(asprintf(&cost->expr, "%ju", val) == -1)
+        ERROR("asprintf error\n", 1, "");
+
+    return 0;
+}
+
+static int cost_sym(Cost *cost, uint64_t est, char *expr)
+{
+    if(expr == NULL)
+        ERROR("expr == NULL\n", 1, "");
+
+    cost->est = est;
+    cost->num = 0;
+    cost->expr = expr;
+
+    return 0;
+}
+
+static int cost_copy(Cost *dst, Cost *src)
+{
+    *dst = *src;
+
+    dst->expr = strdup(src->expr);
+    if(dst->expr == NULL)
+        ERROR("strdup error\n", 1, "");
+
+    return 0;
+}
+
+static void cost_destroy(Cost *cost)
+{
+    FREE(cost->expr);
+}
+
+/* is formula a sum on top level ? */
+static BOOL expr_is_sum(const char *expr)
+{
+    int depth = 0;
+
+    for(; *expr; ++expr)
+        if(*expr == '(')
+            ++depth;
+        else if(*expr == ')')
+            --depth;
+        else if(depth == 0 && (*expr == '+' || *expr == '-'))
+            return TRUE;
+
+    return FALSE;
+}
+
+static int cost_add(Cost *a, Cost *b)
+{
+    char *str;
+
+    if(b->num && b->est == 0)
+    {
+        cost_destroy(b);
+        return 0;
+    }
+
+    if(a->num && a->est == 0)
+    {
+        cost_destroy(a);
+        *a = *b;
+        return 0;
+    }
+
+    if(a->num && b->num)
+    {
+        cost_destroy(a);
+        cost_destroy(b);
+        return cost_num(a, sat_add(a->est, b->est));
+    }
+
+    if(asprintf(&str, "%s + %s", a->expr, b->expr) == -1)
+        ERROR("asprintf error\n", 1, "");
+
+    a->est = sat_add(a->est, b->est);
+    a->num = 0;
+
+    cost_destroy(a);
+    cost_destroy(b);
+    a->expr = str;
+
+    return 0;
+}
+
+static int cost_mult(Cost *a, Cost *b)
+{
+    char *str;
+    Cost t;
+
+    /* number first */
+    if(b->num && ! a->num)
+    {
+        t = *a;
+        *a = *b;
+        *b = t;
+    }
+
+    if(a->num && (a->est == 0 || b->num))
+    {
+        cost_destroy(a);
+        cost_destroy(b);
+        return cost_num(a, b->num ? sat_mult(a->est, b->est) : 0);
+    }
+
+    if(a->num && a->est == 1)
+    {
+        cost_destroy(a);
+        *a = *b;
+        return 0;
+    }
+
+    if(asprintf(&str, expr_is_sum(a->expr) ? "(%s)*" : "%s*", a->expr) == -1)
+        ERROR("asprintf error\n", 1, "");
+
+    cost_destroy(a);
+    a->expr = str;
+
+    if(asprintf(&str, expr_is_sum(b->expr) ? "%s(%s)" : "%s%s", a->expr, b->expr) == -1)
+        ERROR("asprintf error\n", 1, "");
+
+    a->est = sat_mult(a->est, b->est);
+    a->num = 0;
+
+    cost_destroy(a);
+    cost_destroy(b);
+    a->expr = str;
+
+    return 0;
+}
+
+static int cost_max(Cost *a, Cost *b)
+{
+    char *str;
+
+    if(a->num && b->num)
+    {
+        cost_destroy(a);
+        cost_destroy(b);
+        return cost_num(a, MAX(a->est, b->est));
+    }
+
+    if(asprintf(&str, "max(%s, %s)", a->expr, b->expr) == -1)
+        ERROR("asprintf error\n", 1, "");
+
+    a->est = MAX(a->est, b->est);
+    a->num = 0;
+
+    cost_destroy(a);
+    cost_destroy(b);
+    a->expr = str;
+
+    return 0;
+}
+
+static char *value_name(Value *val)
+{
+    char *str;
+    char *name;
+    size_t len;
+
+    str = value_str(val);
+    if(str == NULL)
+        ERROR("value_str error\n", NULL, "");
+
+    name = str;
+    while(*name == ' ')
+        ++name;
+
+    len = strlen(name);
+    while(len > 0 && name[len - 1] == ' ')
+        --len;
+
+    name = strndup(name, len);
+    FREE(str);
+
+    if(name == NULL)
+        ERROR("strndup error\n", NULL, "");
+
+    return name;
+}
+
+static int value_bits(Value *val, Cost *cost)
+{
+    char *name;
+    char *str;
+
+    if(val->type == CONST_VAL)
+    {
+        if(val->body.cv->type == BIG_CONST)
+            return cost_num(cost, (uint64_t)mpz_sizeinbase(val->body.cv->big_value, 2));
+
+        return cost_num(cost, val->body.cv->value == 0 ? 0
+                                : (uint64_t)(64 - __builtin_clzll(val->body.cv->value)));
+    }
+
+    name = value_name(val);
+    if(name == NULL)
+        ERROR("value_name error\n", 1, "");
+
+    if(asprintf(&str, "bits(%s)", name) == -1)
+    {
+        FREE(name);
+        ERROR("asprintf error\n", 1, "");
+    }
+
+    FREE(name);
+
+    return cost_sym(cost, COST_BITS_GUESS, str);
+}
+
+static int token_loop_iters(Cost_ctx *ctx, uint64_t pos, Cost *cost)
+{
+    Token *token;
+    token_expr *expr;
+
+    Cost left;
+    Cost right;
+    char *str;
+
+    token = ctx->tokens[pos];
+
+    if(token->type == TOKEN_ASSIGN && token->body.assign->expr->right != NULL)
+    {
+        expr = token->body.assign->expr;
+
+        /* DIV and MOD loops are shifting divisor up to dividend */
+        if(expr->op == tokens_id.div || expr->op == tokens_id.mod)
+            return value_bits(expr->left, cost);
+
+        /* MULT loop is shifting smaller operand */
+        if(expr->op == tokens_id.mult)
+        {
+            if(value_bits(expr->left, &left))
+                ERROR("value_bits error\n", 1, "");
+
+            if(value_bits(expr->right, &right))
+            {
+                cost_destroy(&left);
+                ERROR("value_bits error\n", 1, "");
+            }
+
+            if(left.num && right.num)
+            {
+                cost_destroy(&right);
+                cost_destroy(&left);
+                return cost_num(cost, MIN(left.est, right.est));
+            }
+
+            /* number as 2nd argument */
+            if(asprintf(&str, "min(%s, %s)", left.num ? right.expr : left.expr,
+                        left.num ? left.expr : right.expr) == -1)
+                str = NULL;
+
+            cost->est = MIN(left.est, right.est);
+
+            cost_destroy(&left);
+            cost_destroy(&right);
+
+            return cost_sym(cost, cost->est, str);
+        }
+    }
+
+    /* other loop, we know nothing */
+    if(asprintf(&str, "L%ju", token->first_line) == -1)
+        ERROR("asprintf error\n", 1, "");
+
+    return cost_sym(cost, COST_LOOP_GUESS, str);
+}
+
+static int for_iters(token_for *token, Cost *cost)
+{
+    Value *from;
+    Value *to;
+
+    char *from_name;
+    char *to_name;
+    char *str;
+
+    if(token->type == tokens_id.for_inc)
+    {
+        from = token->begin_value;
+        to = token->end_value;
+    }
+    else
+    {
+        from = token->end_value;
+        to = token->begin_value;
+    }
+
+    /* both bounds known, exact number */
+    if(from->type == CONST_VAL && from->body.cv->type == CONST_VAL
+        && to->type == CONST_VAL && to->body.cv->type == CONST_VAL)
+        return cost_num(cost, to->body.cv->value < from->body.cv->value ? 0
+                                : sat_add(to->body.cv->value - from->body.cv->value, 1));
+
+    from_name = value_name(from);
+    if(from_name == NULL)
+        ERROR("value_name error\n", 1, "");
+
+    to_name = value_name(to);
+    if(to_name == NULL)
+    {
+        FREE(from_name);
+        ERROR("value_name error\n", 1, "");
+    }
+
+    str = NULL;
+    if(from->type == CONST_VAL && from->body.cv->type == CONST_VAL && from->body.cv->value == 1)
+    {
+        /* FOR i FROM 1 TO n -> n iterations */
+        if(asprintf(&str, "%s", to_name) == -1)
+            str = NULL;
+    }
+    else if(asprintf(&str, "(%s - %s + 1)", to_name, from_name) == -1)
+        str = NULL;
+
+    FREE(from_name);
+    FREE(to_name);
+
+    return cost_sym(cost, COST_LOOP_GUESS, str);
+}
+
+static uint64_t range_cost(Cost_ctx *ctx, uint64_t first, uint64_t last)
+{
+    uint64_t sum = 0;
+    uint64_t i;
+
+    if(first == NO_LINE)
+        return 0;
+
+    for(i = first; i <= last; ++i)
+        sum = sat_add(sum, ctx->line_cost[i]);
+
+    return sum;
+}
+
+static int token_cost(Cost_ctx *ctx, uint64_t pos, Cost *cost)
+{
+    uint64_t first;
+    uint64_t last;
+    uint64_t straight = 0;
+    uint64_t loop = 0;
+
+    uint64_t i;
+    uint64_t j;
+    BOOL in_loop;
+
+    Cost iters;
+    Cost body;
+
+    first = ctx->first[pos];
+    last = ctx->last[pos];
+
+    if(first == NO_LINE)
+        return cost_num(cost, 0);
+
+    /* line is in loop iff some backward jump inside token jumps over it */
+    for(i = first; i <= last; ++i)
+    {
+        in_loop = FALSE;
+        for(j = i; j <= last && ! in_loop; ++j)
+            if(opcode_is_jump(ctx->code[j].opcode)
+                && ctx->code[j].target >= first && ctx->code[j].target <= i)
+                in_loop = TRUE;
+
+        if(in_loop)
+            loop = sat_add(loop, ctx->line_cost[i]);
+        else
+            straight = sat_add(straight, ctx->line_cost[i]);
+    }
+
+    if(cost_num(cost, straight))
+        ERROR("cost_num error\n", 1, "");
+
+    if(loop == 0)
+        return 0;
+
+    if(token_loop_iters(ctx, pos, &iters))
+        ERROR("token_loop_iters error\n", 1, "");
+
+    if(cost_num(&body, loop))
+        ERROR("cost_num error\n", 1, "");
+
+    if(cost_mult(&body, &iters))
+        ERROR("cost_mult error\n", 1, "");
+
+    return cost_add(cost, &body);
+}
+
+static int stmt_add(Cost_ctx *ctx, uint64_t pos, Cost *cost, Cost *exec)
+{
+    Stmt *stmt;
+
+    if(ctx->first[pos] == NO_LINE)
+        return 0;
+
+    stmt = &ctx->stmts[ctx->nstmts];
+
+    stmt->token = pos;
+    if(cost_copy(&stmt->cost, cost))
+        ERROR("cost_copy error\n", 1, "");
+
+    if(cost_copy(&stmt->exec, exec))
+    {
+        cost_destroy(&stmt->cost);
+        ERROR("cost_copy error\n", 1, "");
+    }
+
+    stmt->total = sat_mult(cost->est, exec->est);
+
+    ++ctx->nstmts;
+
+    return 0;
+}
+
+static int stmt_cmp(const void *a, const void *b)
+{
+    const Stmt *s1 = (const Stmt*)a;
+    const Stmt *s2 = (const Stmt*)b;
+
+    if(s1->total != s2->total)
+        return s1->total > s2->total ? -1 : 1;
+
+    if(s1->token != s2->token)
+        return s1->token < s2->token ? -1 : 1;
+
+    return 0;
+}
+
+static int stmt_pos_cmp(const void *a, const void *b)
+{
+    const Stmt *s1 = (const Stmt*)a;
+    const Stmt *s2 = (const Stmt*)b;
+
+    if(s1->token != s2->token)
+        return s1->token < s2->token ? -1 : 1;
+
+    return 0;
+}
+
+/* is token closing block ? */
+static BOOL token_is_block_end(Token *token)
+{
+    if(token->type != TOKEN_GUARD)
+        return FALSE;
+
+    return token->body.guard->type == tokens_id.else_cond
+            || token->body.guard->type == tokens_id.end_if
+            || token->body.guard->type == tokens_id.end_for
+            || token->body.guard->type == tokens_id.end_while;
+}
+
+/* is token a guard with type @type ? */
+static BOOL token_is_guard(Cost_ctx *ctx, uint64_t pos, uint8_t type)
+{
+    return pos < ctx->ntokens && ctx->tokens[pos]->type == TOKEN_GUARD
+            && ctx->tokens[pos]->body.guard->type == type;
+}
+
+/*
+    Get cost of FOR or WHILE loop
+
+    Loop token code is splitted by loop head ( target of jump from end token ) into
+    init part ( executed once ) and check part ( executed iterations + 1 times )
+*/
+static int cost_loop(Cost_ctx *ctx, uint64_t *pos, Cost *exec, Cost *cost)
+{
+    uint64_t head_pos;
+    uint64_t end_pos;
+    uint64_t head;
+    uint64_t first;
+    uint64_t last;
+    uint8_t end_type;
+
+    Cost iters;
+    Cost body_exec;
+    Cost body;
+    Cost check;
+    Cost t;
+    char *str;
+
+    head_pos = *pos;
+
+    if(ctx->tokens[head_pos]->type == TOKEN_FOR)
+    {
+        end_type = tokens_id.end_for;
+        if(for_iters(ctx->tokens[head_pos]->body.for_loop, &iters))
+            ERROR("for_iters error\n", 1, "");
+    }
+    else
+    {
+        end_type = tokens_id.end_while;
+        if(asprintf(&str, "W%ju", ctx->tokens[head_pos]->first_line) == -1)
+            ERROR("asprintf error\n", 1, "");
+
+        if(cost_sym(&iters, COST_LOOP_GUESS, str))
+            ERROR("cost_sym error\n", 1, "");
+    }
+
+    /* body is executed exec * iters times */
+    if(cost_copy(&body_exec, exec) || cost_copy(&t, &iters) || cost_mult(&body_exec, &t))
+        ERROR("cost error\n", 1, "");
+
+    ++*pos;
+    if(cost_block(ctx, pos, &body_exec, &body))
+        ERROR("cost_block error\n", 1, "");
+
+    if(! token_is_guard(ctx, *pos, end_type))
+        ERROR("loop without end\n", 1, "");
+
+    end_pos = *pos;
+    ++*pos;
+
+    /* loop head is target of last jump in end token */
+    first = ctx->first[head_pos];
+    last = ctx->last[head_pos];
+    head = first;
+    if(ctx->first[end_pos] != NO_LINE && ctx->code[ctx->last[end_pos]].opcode == opcodes.jump)
+        head = ctx->code[ctx->last[end_pos]].target;
+
+    if(first == NO_LINE || head < first || head > last)
+        head = first;
+
+    /* loop token = init + check + check * iters */
+    if(cost_num(cost, head == first ? 0 : range_cost(ctx, first, head - 1)))
+        ERROR("cost_num error\n", 1, "");
+
+    if(cost_num(&check, range_cost(ctx, head, last)) || cost_add(cost, &check))
+        ERROR("cost error\n", 1, "");
+
+    if(cost_num(&check, range_cost(ctx, head, last)) || cost_copy(&t, &iters)
+        || cost_mult(&check, &t) || cost_add(cost, &check))
+        ERROR("cost error\n", 1, "");
+
+    if(stmt_add(ctx, head_pos, cost, exec))
+        ERROR("stmt_add error\n", 1, "");
+
+    /* end token is executed in each iteration */
+    if(cost_num(&t, range_cost(ctx, ctx->first[end_pos], ctx->last[end_pos])))
+        ERROR("cost_num error\n", 1, "");
+
+    if(stmt_add(ctx, end_pos, &t, &body_exec))
+        ERROR("stmt_add error\n", 1, "");
+
+    /* loop = loop token + iters * (body + end token) */
+    if(cost_add(&body, &t) || cost_mult(&iters, &body) || cost_add(cost, &iters))
+        ERROR("cost error\n", 1, "");
+
+    cost_destroy(&body_exec);
+
+    return 0;
+}
+
+/*
+    Get cost of IF, worst case is the more expensive arm
+*/
+static int cost_if(Cost_ctx *ctx, uint64_t *pos, Cost *exec, Cost *cost)
+{
+    Cost then_arm;
+    Cost else_arm;
+    Cost t;
+
+    if(token_cost(ctx, *pos, cost))
+        ERROR("token_cost error\n", 1, "");
+
+    if(stmt_add(ctx, *pos, cost, exec))
+        ERROR("stmt_add error\n", 1, "");
+
+    ++*pos;
+    if(cost_block(ctx, pos, exec, &then_arm))
+        ERROR("cost_block error\n", 1, "");
+
+    if(token_is_guard(ctx, *pos, tokens_id.else_cond))
+    {
+        /* ELSE is a jump over else arm at the end of then arm */
+        if(token_cost(ctx, *pos, &t) || stmt_add(ctx, *pos, &t, exec) || cost_add(&then_arm, &t))
+            ERROR("cost error\n", 1, "");
+
+        ++*pos;
+        if(cost_block(ctx, pos, exec, &else_arm))
+            ERROR("cost_block error\n", 1, "");
+    }
+    else if(cost_num(&else_arm, 0))
+        ERROR("cost_num error\n", 1, "");
+
+    if(! token_is_guard(ctx, *pos, tokens_id.end_if))
+        ERROR("IF without ENDIF\n", 1, "");
+
+    if(cost_max(&then_arm, &else_arm) || cost_add(cost, &then_arm))
+        ERROR("cost error\n", 1, "");
+
+    if(token_cost(ctx, *pos, &t) || stmt_add(ctx, *pos, &t, exec) || cost_add(cost, &t))
+        ERROR("cost error\n", 1, "");
+
+    ++*pos;
+
+    return 0;
+}
+
+static int cost_block(Cost_ctx *ctx, uint64_t *pos, Cost *exec, Cost *cost)
+{
+    Token *token;
+    Cost t;
+
+    if(cost_num(cost, 0))
+        ERROR("cost_num error\n", 1, "");
+
+    while(*pos < ctx->ntokens)
+    {
+        token = ctx->tokens[*pos];
+
+        if(token_is_block_end(token))
+            break;
+
+        if(token->type == TOKEN_FOR || token->type == TOKEN_WHILE)
+        {
+            if(cost_loop(ctx, pos, exec, &t))
+                ERROR("cost_loop error\n", 1, "");
+        }
+        else if(token->type == TOKEN_IF)
+        {
+            if(cost_if(ctx, pos, exec, &t))
+                ERROR("cost_if error\n", 1, "");
+        }
+        else
+        {
+            if(token_cost(ctx, *pos, &t) || stmt_add(ctx, *pos, &t, exec))
+                ERROR("cost error\n", 1, "");
+
+            ++*pos;
+        }
+
+        if(cost_add(cost, &t))
+            ERROR("cost_add error\n", 1, "");
+    }
+
+    return 0;
+}
+
+int cost_report(const char *file, Vector *code, Vector *tokens, Darray *line_map)
+{
+    FILE *f = NULL;
+    char **lines = NULL;
+    int size = 0;
+    int ntokens = 0;
+
+    Cost_ctx ctx;
+    Darray_iterator it;
+    Line_map map;
+
+    Cost total;
+    Cost exec;
+    Stmt *stmt;
+    BOOL *leader = NULL;
+
+    uint64_t i;
+    uint64_t j;
+    uint64_t pos;
+    uint64_t rest;
+
+    int ret = 1;
+
+    TRACE("");
+
+    (void)memset(&ctx, 0, sizeof(Cost_ctx));
+    total.expr = NULL;
+
+    if(vector_to_array(code, (void*)&lines, &size))
+        ERROR("vector_to_array error\n", 1, "");
+
+    if(vector_to_array(tokens, (void*)&ctx.tokens, &ntokens))
+    {
+        FREE(lines);
+        ERROR("vector_to_array error\n", 1, "");
+    }
+
+    ctx.lines = (uint64_t)size;
+    if(ctx.lines == 0)
+    {
+        FREE(lines);
+        FREE(ctx.tokens);
+        ERROR("empty code\n", 1, "");
+    }
+
+    ctx.ntokens = (uint64_t)ntokens;
+
+    ctx.code = (Asm_line*)malloc(sizeof(Asm_line) * (size_t)(size + 1));
+    ctx.line_cost = (uint64_t*)calloc((size_t)(size + 1), sizeof(uint64_t));
+    ctx.first = (uint64_t*)malloc(sizeof(uint64_t) * (size_t)(ntokens + 1));
+    ctx.last = (uint64_t*)malloc(sizeof(uint64_t) * (size_t)(ntokens + 1));
+    ctx.stmts = (Stmt*)malloc(sizeof(Stmt) * (size_t)(ntokens + 1));
+    leader = (BOOL*)calloc((size_t)(size + 1), sizeof(BOOL));
+    if(ctx.code == NULL || ctx.line_cost == NULL || ctx.first == NULL || ctx.last == NULL
+        || ctx.stmts == NULL || leader == NULL)
+    {
+        LOG("malloc error\n", "");
+        goto cleanup;
+    }
+
+    for(i = 0; i < ctx.lines; ++i)
+    {
+        if(asm_line_parse(lines[i], &ctx.code[i]))
+            goto cleanup;
+
+        ctx.line_cost[i] = opcode_get_cost(ctx.code[i].opcode);
+    }
+
+    /* asm lines of each token, map is in tokens order */
+    for(i = 0; i < ctx.ntokens; ++i)
+    {
+        ctx.first[i] = NO_LINE;
+        ctx.last[i] = NO_LINE;
+    }
+
+    pos = 0;
+    for(  darray_iterator_init(line_map, &it, ITI_BEGIN);
+        ! darray_iterator_end(&it);
+          darray_iterator_next(&it))
+        {
+            darray_iterator_get_data(&it, (void*)&map);
+
+            while(pos < ctx.ntokens && ctx.tokens[pos] != map.token)
+                ++pos;
+
+            if(pos == ctx.ntokens || map.asm_last >= ctx.lines)
+            {
+                LOG("line map doesn't match tokens\n", "");
+                goto cleanup;
+            }
+
+            ctx.first[pos] = map.asm_first;
+            ctx.last[pos] = map.asm_last;
+        }
+
+    /* cost of code outside tokens ( i.e HALT ) */
+    rest = range_cost(&ctx, 0, ctx.lines - 1);
+    for(i = 0; i < ctx.ntokens; ++i)
+        rest -= range_cost(&ctx, ctx.first[i], ctx.last[i]);
+
+    if(cost_num(&exec, 1))
+        goto cleanup;
+
+    pos = 0;
+    if(cost_block(&ctx, &pos, &exec, &total))
+    {
+        cost_destroy(&exec);
+        goto cleanup;
+    }
+
+    cost_destroy(&exec);
+
+    if(pos != ctx.ntokens)
+    {
+        LOG("unexpected token %ju\n", pos);
+        goto cleanup;
+    }
+
+    if(cost_num(&exec, rest) || cost_add(&total, &exec))
+        goto cleanup;
+
+    f = fopen(file, "w");
+    if(f == NULL)
+    {
+        LOG("cannot open %s file\n", file);
+        goto cleanup;
+    }
+
+    fprintf(f, "TOTAL COST: %s\n", total.expr);
+    fprintf(f, "ESTIMATE: %ju\n", total.est);
+    fprintf(f, "( unknown loop = %d iterations, unknown variable = %d bits )\n\n",
+            COST_LOOP_GUESS, COST_BITS_GUESS);
+
+    /* basic blocks */
+    leader[0] = TRUE;
+    for(i = 0; i < ctx.lines; ++i)
+        if(opcode_is_jump(ctx.code[i].opcode) || ctx.code[i].opcode == opcodes.halt)
+        {
+            leader[i + 1] = TRUE;
+            if(opcode_is_jump(ctx.code[i].opcode) && ctx.code[i].target < ctx.lines)
+                leader[ctx.code[i].target] = TRUE;
+        }
+
+    fprintf(f, "BASIC BLOCKS\n");
+    fprintf(f, "first\tlast\tcost\n");
+    for(i = 0; i < ctx.lines; i = j + 1)
+    {
+        for(j = i; j + 1 < ctx.lines && ! leader[j + 1]; ++j)
+            ;
+
+        fprintf(f, "%ju\t%ju\t%ju\n", i, j, range_cost(&ctx, i, j));
+    }
+    fprintf(f, "\n");
+
+    /* loop statements are added after their body */
+    qsort(ctx.stmts, (size_t)ctx.nstmts, sizeof(Stmt), stmt_pos_cmp);
+
+    fprintf(f, "STATEMENTS\n");
+    fprintf(f, "line\ttoken\tcost\texecutions\testimate\n");
+    for(i = 0; i < ctx.nstmts; ++i)
+    {
+        stmt = &ctx.stmts[i];
+        fprintf(f, "%ju\t%s\t%s\t%s\t%ju\n", ctx.tokens[stmt->token]->first_line,
+                token_kind_str(ctx.tokens[stmt->token]), stmt->cost.expr, stmt->exec.expr, stmt->total);
+    }
+    fprintf(f, "\n");
+
+    qsort(ctx.stmts, (size_t)ctx.nstmts, sizeof(Stmt), stmt_cmp);
+
+    fprintf(f, "TOP %d STATEMENTS\n", COST_TOP_N);
+    fprintf(f, "line\ttoken\testimate\t%%\n");
+    for(i = 0; i < ctx.nstmts && i < COST_TOP_N; ++i)
+    {
+        stmt = &ctx.stmts[i];
+        fprintf(f, "%ju\t%s\t%ju\t%.2f\n", ctx.tokens[stmt->token]->first_line,
+                token_kind_str(ctx.tokens[stmt->token]), stmt->total,
+                total.est ? 100.0 * (double)stmt->total / (double)total.est : 0.0);
+    }
+
+    ret = 0;
+
+cleanup:
+    if(f != NULL)
+        fclose(f);
+
+    if(ctx.stmts != NULL)
+        for(i = 0; i < ctx.nstmts; ++i)
+        {
+            cost_destroy(&ctx.stmts[i].cost);
+            cost_destroy(&ctx.stmts[i].exec);
+        }
+
+    if(total.expr != NULL)
+        cost_destroy(&total);
+
+    FREE(lines);
+    FREE(ctx.tokens);
+    FREE(ctx.code);
+    FREE(ctx.line_cost);
+    FREE(ctx.first);
+    FREE(ctx.last);
+    FREE(ctx.stmts);
+    FREE(leader);
+
+    return ret;
+}
@@ -0,0 +1,829 @@
+#include <eval.h>
+#include <tokens.h>
+#include <asm.h>
+#include <parser_helper.h>
+
+#define NO_TOKEN    UINT64_MAX
+
+/* hash of offset ( fibonacci hashing ) */
+#define OFFSET_HASH(offset) ((uint64_t)(offset) * 0x9E3779B97F4A7C15ull)
+
+/* element of array, created on first write, so big arrays cost nothing ( not written is 0 ) */
+typedef struct Eval_elem
+{
+    uint64_t offset;
+    mpz_t val;
+
+}Eval_elem;
+
+typedef struct Eval_var
+{
+    const char *name;
+
+    mpz_t val; /* only for variable */
+
+    uint64_t len; /* only for array */
+    Hashmap *elems; /* Eval_elem* by offset, NULL iff no element was written */
+
+    uint8_t set     :1; /* variable was written */
+    uint8_t array   :1;
+    uint8_t padding :6;
+
+}Eval_var;
+
+typedef struct Eval_ctx
+{
+    Token **tokens;
+    uint64_t ntokens;
+
+    /* IF -> ELSE / ENDIF, ELSE -> ENDIF, WHILE <-> ENDWHILE, FOR <-> ENDFOR */
+    uint64_t *match;
+
+    /* iterations left of FOR, only for FOR tokens */
+    mpz_t *left;
+
+    /* sorted by name */
+    Eval_var *vars;
+    uint64_t nvars;
+
+    FILE *in;
+    FILE *out;
+
+}Eval_ctx;
+
+/*
+    Compare variables by name, for qsort and bsearch
+
+    PARAMS
+    @IN a - pointer to Eval_var
+    @IN b - pointer to Eval_var
+
+    RETURN:
+    < 0 iff a < b
+    0 iff a == b
+    > 0 iff a > b
+*/
+static int eval_var_cmp(const void *a, const void *b);
+
+/*
+    Hash of element in Eval_var->elems ( by offset )
+
+    PARAMS
+    @IN elem - addr of Eval_elem*
+
+    RETURN:
+    Hash of offset
+*/
+static uint64_t eval_elem_hash(void *elem);
+
+/*
+    Compare elements in Eval_var->elems by offset
+
+    PARAMS
+    @IN elem1 - addr of 1st Eval_elem*
+    @IN elem2 - addr of 2nd Eval_elem*
+
+    RETURN:
+    0 iff elements have the same offset
+    1 iff not
+*/
+static int eval_elem_cmp(void *elem1, void *elem2);
+
+/*
+    Compare element in Eval_var->elems with offset
+
+    PARAMS
+    @IN elem - addr of Eval_elem*
+    @IN offset - addr of offset
+
+    RETURN:
+    0 iff element has this offset
+    1 iff not
+*/
+static int eval_elem_offset_cmp(void *elem, const void *offset);
+
+/*
+    Create variables from parser variables and iterators of FOR
+
+    PARAMS
+    @IN ctx - evaluator context with tokens
+    @IN vars - parser variables
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int eval_vars_create(Eval_ctx *ctx, Hashmap *vars) __nonull__(1, 2);
+
+/*
+    Match begins of blocks with ELSE and ends
+
+    PARAMS
+    @IN ctx - evaluator context with tokens
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int eval_match(Eval_ctx *ctx) __nonull__(1);
+
+/*
+    Get cell of variable or array element
+
+    PARAMS
+    @IN ctx - evaluator context
+    @IN val - variable value
+    @IN token - token with value ( for errors )
+    @IN write - TRUE iff cell will be written ( element of array is created then )
+    @OUT cell - pointer to cell, NULL iff element of array was not written
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int eval_cell(Eval_ctx *ctx, Value *val, Token *token, BOOL write, mpz_t **cell) __nonull__(1, 2, 3, 5);
+
+/*
+    Get value of const, variable or array element
+
+    PARAMS
+    @IN ctx - evaluator context
+    @IN val - value
+    @IN token - token with value ( for errors )
+    @OUT res - value
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int eval_get(Eval_ctx *ctx, Value *val, Token *token, mpz_t res) __nonull__(1, 2, 3);
+
+/*
+    Set variable or array element
+
+    PARAMS
+    @IN ctx - evaluator context
+    @IN val - variable value
+    @IN token - token with value ( for errors )
+    @IN res - new value
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int eval_set(Eval_ctx *ctx, Value *val, Token *token, mpz_t res) __nonull__(1, 2, 3);
+
+/*
+    Check condition
+
+    PARAMS
+    @IN ctx - evaluator context
+    @IN cond - condition
+    @IN token - token with condition ( for errors )
+    @OUT res - TRUE iff condition is true
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int eval_cond(Eval_ctx *ctx, token_cond *cond, Token *token, BOOL *res) __nonull__(1, 2, 3, 4);
+
+/*
+    Execute ASSIGN
+
+    PARAMS
+    @IN ctx - evaluator context
+    @IN token - ASSIGN token
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int eval_assign(Eval_ctx *ctx, Token *token) __nonull__(1, 2);
+
+/*
+    Execute tokens from the first to the last
+
+    PARAMS
+    @IN ctx - evaluator context
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int eval_run(Eval_ctx *ctx) __nonull__(1);
+
+/*
+    Print runtime error of program
+
+    PARAMS
+    @IN token - token with error
+    @IN msg - message
+    @IN name - name of variable
+
+    RETURN:
+    This is a void function
+*/
+static void eval_error(Token *token, const char *msg, const char *name) __nonull__(1, 2, 3);
+
+static int eval_var_cmp(const void *a, const void *b)
+{
+    return strcmp(((const Eval_var*)a)->name, ((const Eval_var*)b)->name);
+}
+
+static uint64_t eval_elem_hash(void *elem)
+{
+    return OFFSET_HASH((*(Eval_elem**)elem)->offset);
+}
+
+static int eval_elem_cmp(void *elem1, void *elem2)
+{
+    return (*(Eval_elem**)elem1)->offset != (*(Eval_elem**)elem2)->offset;
+}
+
+static int eval_elem_offset_cmp(void *elem, const void *offset)
+{
+    return (*(Eval_elem**)elem)->offset != *(const uint64_t*)offset;
+}
+
+static void eval_error(Token *token, const char *msg, const char *name)
+{
+    fprintf(stderr, "%sERROR!\tline %ju:\t%s:\t%s%s\n", RED, token->first_line, msg, name, RESET);
+}
+
+static int eval_vars_create(Eval_ctx *ctx, Hashmap *vars)
+{
+    Pvar **pvars;
+    int size;
+    int i;
+    uint64_t j;
+    uint64_t n;
+
+    TRACE("");
+
+    if(hashmap_to_array(vars, (void*)&pvars, &size))
+        ERROR("hashmap_to_array error\n", 1, "");
+
+    /* iterators are undeclared after ENDFOR, so they are taken from FOR tokens */
+    ctx->vars = (Eval_var*)calloc((size_t)size + ctx->ntokens + 1, sizeof(Eval_var));
+    if(ctx->vars == NULL)
+    {
+        FREE(pvars);
+        ERROR("calloc error\n", 1, "");
+    }
+
+    n = 0;
+    for(i = 0; i < size; ++i)
+    {
+        ctx->vars[n].name = pvars[i]->name;
+        ctx->vars[n].array = pvars[i]->type == PTOKEN_ARR;
+        ctx->vars[n].len = pvars[i]->array_len;
+        ++n;
+    }
+
+    FREE(pvars);
+
+    for(j = 0; j < ctx->ntokens; ++j)
+        if(ctx->tokens[j]->type == TOKEN_FOR)
+        {
+            ctx->vars[n].name = variable_get_name(ctx->tokens[j]->body.for_loop->iterator->body.var);
+            ctx->vars[n].array = 0;
+            ++n;
+        }
+
+    qsort(ctx->vars, (size_t)n, sizeof(Eval_var), eval_var_cmp);
+
+    /* the same iterator is used by many loops */
+    ctx->nvars = 0;
+    for(j = 0; j < n; ++j)
+        if(ctx->nvars == 0 || strcmp(ctx->vars[ctx->nvars - 1].name, ctx->vars[j].name))
+            ctx->vars[ctx->nvars++] = ctx->vars[j];
+
+    for(j = 0; j < ctx->nvars; ++j)
+        mpz_init(ctx->vars[j].val);
+
+    return 0;
+}
+
+static int eval_match(Eval_ctx *ctx)
+{
+    uint64_t *stack;
+    uint64_t depth = 0;
+    uint64_t i;
+    uint64_t top;
+    Token *token;
+
+    TRACE("");
+
+    stack = (uint64_t*)malloc(sizeof(uint64_t) * (size_t)(ctx->ntokens + 1));
+    if(stack == NULL)
+        ERROR("malloc error\n", 1, "");
+
+    for(i = 0; i < ctx->ntokens; ++i)
+    {
+        token = ctx->tokens[i];
+        ctx->match[i] = NO_TOKEN;
+
+        if(token->type == TOKEN_IF || token->type == TOKEN_WHILE || token->type == TOKEN_FOR)
+            stack[depth++] = i;
+        else if(token->type == TOKEN_GUARD && token->body.guard->type != tokens_id.skip)
+        {
+            if(depth == 0)
+            {
+                FREE(stack);
+                ERROR("guard without begin of block\n", 1, "");
+            }
+
+            top = stack[--depth];
+            ctx->match[top] = i;
+
+            /* ELSE is begin of block to ENDIF, loops jump back to begin */
+            if(token->body.guard->type == tokens_id.else_cond)
+                stack[depth++] = i;
+            else if(token->body.guard->type != tokens_id.end_if)
+                ctx->match[i] = top;
+        }
+    }
+
+    FREE(stack);
+
+    if(depth != 0)
+        ERROR("block without end\n", 1, "");
+
+    return 0;
+}
+
+static int eval_cell(Eval_ctx *ctx, Value *val, Token *token, BOOL write, mpz_t **cell)
+{
+    Eval_var key;
+    Eval_var *var;
+    Eval_var *index;
+    Eval_elem **found;
+    Eval_elem *elem;
+    var_arr *va;
+    uint64_t offset;
+
+    if(val->type != VARIABLE)
+    {
+        eval_error(token, "not a variable", "");
+        return 1;
+    }
+
+    if(val->body.var->type == VAR_NORMAL)
+    {
+        key.name = val->body.var->body.var->name;
+        var = (Eval_var*)bsearch(&key, ctx->vars, (size_t)ctx->nvars, sizeof(Eval_var), eval_var_cmp);
+        if(var == NULL || var->array)
+        {
+            eval_error(token, "not a variable", key.name);
+            return 1;
+        }
+
+        if(! write && ! var->set)
+        {
+            eval_error(token, "variable not set", key.name);
+            return 1;
+        }
+
+        var->set = 1;
+        *cell = &var->val;
+
+        return 0;
+    }
+
+    va = val->body.var->body.arr;
+
+    key.name = va->var->name;
+    var = (Eval_var*)bsearch(&key, ctx->vars, (size_t)ctx->nvars, sizeof(Eval_var), eval_var_cmp);
+    if(var == NULL || ! var->array)
+    {
+        eval_error(token, "not an array", key.name);
+        return 1;
+    }
+
+    offset = va->offset;
+
+    /* t[i] */
+    if(va->var_offset != NULL)
+    {
+        key.name = va->var_offset->name;
+        index = (Eval_var*)bsearch(&key, ctx->vars, (size_t)ctx->nvars, sizeof(Eval_var), eval_var_cmp);
+        if(index == NULL || index->array || ! index->set)
+        {
+            eval_error(token, "index not set", key.name);
+            return 1;
+        }
+
+        if(mpz_cmp_ui(index->val, (unsigned long)var->len) >= 0)
+        {
+            eval_error(token, "index out of array", var->name);
+            return 1;
+        }
+
+        offset = (uint64_t)mpz_get_ui(index->val);
+    }
+
+    if(offset >= var->len)
+    {
+        eval_error(token, "index out of array", var->name);
+        return 1;
+    }
+
+    if(var->elems != NULL)
+    {
+        found = (Eval_elem**)hashmap_search_hash(var->elems, OFFSET_HASH(offset),
+                                                 (const void*)&offset, eval_elem_offset_cmp);
+        if(found != NULL)
+        {
+            *cell = &(*found)->val;
+            return 0;
+        }
+    }
+
+    if(! write)
+    {
+        *cell = NULL;
+        return 0;
+    }
+
+    if(var->elems == NULL)
+    {
+        var->elems = hashmap_create(sizeof(Eval_elem*), eval_elem_hash, eval_elem_cmp);
+        if(var->elems == NULL)
+            ERROR("hashmap_create error\n", 1, "");
+    }
+
+    elem = (Eval_elem*)malloc(sizeof(Eval_elem));
+    if(elem == NULL)
+        ERROR("malloc error\n", 1, "");
+
+    elem->offset = offset;
+    mpz_init(elem->val);
+
+    if(hashmap_insert(var->elems, (void*)&elem))
+    {
+        mpz_clear(elem->val);
+        FREE(elem);
+        ERROR("hashmap_insert error\n", 1, "");
+    }
+
+    *cell = &elem->val;
+
+    return 0;
+}
+
+static int eval_get(Eval_ctx *ctx, Value *val, Token *token, mpz_t res)
+{
+    mpz_t *cell;
+
+    if(val->type == CONST_VAL)
+    {
+        if(val->body.cv->type == BIG_CONST)
+            mpz_set(res, val->body.cv->big_value);
+        else
+            mpz_set_ui(res, (unsigned long)val->body.cv->value);
+
+        return 0;
+    }
+
+    if(eval_cell(ctx, val, token, FALSE, &cell))
+        return 1;
+
+    /* memory of machine is 0 at start, so array element which was not written is 0 */
+    if(cell == NULL)
+        mpz_set_ui(res, 0);
+    else
+        mpz_set(res, *cell);
+
+    return 0;
+
+    return 0;
+}
+
+static int eval_set(Eval_ctx *ctx, Value *val, Token *token, mpz_t res)
+{
+    mpz_t *cell;
+
+    if(eval_cell(ctx, val, token, TRUE, &cell))
+        return 1;
+
+    mpz_set(*cell, res);
+
+    return 0;
+}
+
+static int eval_cond(Eval_ctx *ctx, token_cond *cond, Token *token, BOOL *res)
+{
+    mpz_t left;
+    mpz_t right;
+    int cmp;
+    int ret = 1;
+
+    mpz_init(left);
+    mpz_init(right);
+
+    if(eval_get(ctx, cond->left, token, left) || eval_get(ctx, cond->right, token, right))
+        goto clean;
+
+    cmp = mpz_cmp(left, right);
+    ret = 0;
+
+    if(cond->r == tokens_id.eq)
+        *res = cmp == 0;
+    else if(cond->r == tokens_id.ne)
+        *res = cmp != 0;
+    else if(cond->r == tokens_id.lt)
+        *res = cmp < 0;
+    else if(cond->r == tokens_id.gt)
+        *res = cmp > 0;
+    else if(cond->r == tokens_id.le)
+        *res = cmp <= 0;
+    else if(cond->r == tokens_id.ge)
+        *res = cmp >= 0;
+    else
+        ret = 1;
+
+clean:
+    mpz_clear(left);
+    mpz_clear(right);
+
+    return ret;
+}
+
+static int eval_assign(Eval_ctx *ctx, Token *token)
+{
+    token_expr *expr = token->body.assign->expr;
+    mpz_t left;
+    mpz_t right;
+    int ret = 1;
+
+    mpz_init(left);
+    mpz_init(right);
+
+    if(eval_get(ctx, expr->left, token, left))
+        goto clean;
+
+    /* a := b */
+    if(expr->op == tokens_id.undefined || expr->right == NULL)
+    {
+        ret = eval_set(ctx, token->body.assign->res, token, left);
+        goto clean;
+    }
+
+    if(eval_get(ctx, expr->right, token, right))
+        goto clean;
+
+    if(expr->op == tokens_id.add)
+        mpz_add(left, left, right);
+    else if(expr->op == tokens_id.sub)
+    {
+        if(mpz_cmp(left, right) <= 0)
+            mpz_set_ui(left, 0);
+        else
+            mpz_sub(left, left, right);
+    }
+    else if(expr->op == tokens_id.mult)
+        mpz_mul(left, left, right);
+    else if(expr->op == tokens_id.div)
+    {
+        if(mpz_sgn(right) == 0)
+            mpz_set_ui(left, 0);
+        else
+            mpz_fdiv_q(left, left, right);
+    }
+    else if(expr->op == tokens_id.mod)
+    {
+        if(mpz_sgn(right) == 0)
+            mpz_set_ui(left, 0);
+        else
+            mpz_fdiv_r(left, left, right);
+    }
+    else
+        goto clean;
+
+    ret = eval_set(ctx, token->body.assign->res, token, left);
+
+clean:
+    mpz_clear(left);
+    mpz_clear(right);
+
+    return ret;
+}
+
+static int eval_run(Eval_ctx *ctx)
+{
+    Token *token;
+    token_for *tfor;
+    uint64_t pc = 0;
+    uint8_t type;
+    BOOL cond;
+    mpz_t begin;
+    mpz_t end;
+    int ret = 1;
+
+    TRACE("");
+
+    mpz_init(begin);
+    mpz_init(end);
+
+    while(pc < ctx->ntokens)
+    {
+        token = ctx->tokens[pc];
+
+        switch(token->type)
+        {
+            case TOKEN_ASSIGN:
+            {
+                if(eval_assign(ctx, token))
+                    goto clean;
+
+                ++pc;
+                break;
+            }
+            case TOKEN_IO:
+            {
+                if(token->body.io->op == tokens_id.read)
+                {
+                    if(mpz_inp_str(begin, ctx->in, 10) == 0)
+                    {
+                        eval_error(token, "no input for READ", "");
+                        goto clean;
+                    }
+
+                    if(eval_set(ctx, token->body.io->res, token, begin))
+                        goto clean;
+                }
+                else
+                {
+                    if(eval_get(ctx, token->body.io->res, token, begin))
+                        goto clean;
+
+                    mpz_out_str(ctx->out, 10, begin);
+                    fputc('\n', ctx->out);
+                }
+
+                ++pc;
+                break;
+            }
+            case TOKEN_IF:
+            case TOKEN_WHILE:
+            {
+                if(eval_cond(ctx, token->type == TOKEN_IF ? token->body.if_cond->cond :
+                            token->body.while_loop->cond, token, &cond))
+                    goto clean;
+
+                /* false IF goes after ELSE ( or ENDIF ), false WHILE after ENDWHILE */
+                pc = cond ? pc + 1 : ctx->match[pc] + 1;
+                break;
+            }
+            case TOKEN_FOR:
+            {
+                tfor = token->body.for_loop;
+
+                if(eval_get(ctx, tfor->begin_value, token, begin) || eval_get(ctx, tfor->end_value, token, end))
+                    goto clean;
+
+                /* TO: end - begin + 1, DOWNTO: begin - end + 1 */
+                if(tfor->type == tokens_id.for_inc)
+                    mpz_sub(ctx->left[pc], end, begin);
+                else
+                    mpz_sub(ctx->left[pc], begin, end);
+
+                mpz_add_ui(ctx->left[pc], ctx->left[pc], 1);
+                if(mpz_sgn(ctx->left[pc]) <= 0)
+                {
+                    pc = ctx->match[pc] + 1;
+                    break;
+                }
+
+                if(eval_set(ctx, tfor->iterator, token, begin))
+                    goto clean;
+
+                ++pc;
+                break;
+            }
+            case TOKEN_GUARD:
+            {
+                type = token->body.guard->type;
+
+                /* end of IF branch, skip ELSE branch */
+                if(type == tokens_id.else_cond)
+                    pc = ctx->match[pc] + 1;
+                else if(type == tokens_id.end_while)
+                    pc = ctx->match[pc];
+                else if(type == tokens_id.end_for)
+                {
+                    tfor = ctx->tokens[ctx->match[pc]]->body.for_loop;
+
+                    mpz_sub_ui(ctx->left[ctx->match[pc]], ctx->left[ctx->match[pc]], 1);
+                    if(mpz_sgn(ctx->left[ctx->match[pc]]) == 0)
+                    {
+                        ++pc;
+                        break;
+                    }
+
+                    if(eval_get(ctx, tfor->iterator, token, begin))
+                        goto clean;
+
+                    if(tfor->type == tokens_id.for_inc)
+                        mpz_add_ui(begin, begin, 1);
+                    else
+                        mpz_sub_ui(begin, begin, 1);
+
+                    if(eval_set(ctx, tfor->iterator, token, begin))
+                        goto clean;
+
+                    pc = ctx->match[pc] + 1;
+                }
+                else
+                    ++pc;
+
+                break;
+            }
+            default:
+            {
+                eval_error(token, "unknown token", token_kind_str(token));
+                goto clean;
+            }
+        }
+    }
+
+    ret = 0;
+
+clean:
+    mpz_clear(begin);
+    mpz_clear(end);
+
+    return ret;
+}
+
+int eval_tokens(Vector *tokens, Hashmap *vars, FILE *in, FILE *out)
+{
+    Eval_ctx ctx;
+    Hashmap_iterator it;
+    Eval_elem *elem;
+    int size;
+    int ret = 1;
+    uint64_t i;
+
+    TRACE("");
+
+    memset(&ctx, 0, sizeof(Eval_ctx));
+    ctx.in = in;
+    ctx.out = out;
+
+    if(vector_to_array(tokens, (void*)&ctx.tokens, &size))
+        ERROR("vector_to_array error\n", 1, "");
+
+    ctx.ntokens = (uint64_t)size;
+
+    ctx.match = (uint64_t*)malloc(sizeof(uint64_t) * (size_t)(ctx.ntokens + 1));
+    ctx.left = (mpz_t*)malloc(sizeof(mpz_t) * (size_t)(ctx.ntokens + 1));
+    if(ctx.match == NULL || ctx.left == NULL)
+        goto clean;
+
+    if(eval_match(&ctx))
+        goto clean;
+
+    for(i = 0; i < ctx.ntokens; ++i)
+        if(ctx.tokens[i]->type == TOKEN_FOR)
+            mpz_init(ctx.left[i]);
+
+    if(eval_vars_create(&ctx, vars) == 0)
+        ret = eval_run(&ctx);
+
+    for(i = 0; i < ctx.ntokens; ++i)
+        if(ctx.tokens[i]->type == TOKEN_FOR)
+            mpz_clear(ctx.left[i]);
+
+    fflush(out);
+
+clean:
+    if(ctx.vars != NULL)
+        for(i = 0; i < ctx.nvars; ++i)
+        {
+            mpz_clear(ctx.vars[i].val);
+
+            if(ctx.vars[i].elems == NULL)
+                continue;
+
+            for(  hashmap_iterator_init(ctx.vars[i].elems, &it, ITI_BEGIN);
+                ! hashmap_iterator_end(&it);
+                  hashmap_iterator_next(&it))
+            {
+                hashmap_iterator_get_data(&it, (void*)&elem);
+
+                mpz_clear(elem->val);
+                FREE(elem);
+            }
+
+            hashmap_destroy(ctx.vars[i].elems);
+        }
+
+    FREE(ctx.vars);
+    FREE(ctx.tokens);
+    FREE(ctx.match);
+    FREE(ctx.left);
+
+    return ret;
+}
@@ -0,0 +1,609 @@
+#include <layout.h>
+#include <asm.h>
+#include <sort.h>
+
+/* how block ends */
+#define TERM_FALL   0 /* falls into next line */
+#define TERM_JUMP   1 /* JUMP */
+#define TERM_COND   2 /* JZERO or JODD, fall into next line iff not taken */
+#define TERM_HALT   3 /* HALT */
+
+#define NO_BLOCK    UINT64_MAX
+
+typedef struct Block
+{
+    uint64_t first; /* first line */
+    uint64_t last; /* last line */
+    uint64_t count; /* how many times block was executed */
+
+    uint64_t taken; /* jump target block */
+    uint64_t fall; /* fall through block */
+
+    uint64_t taken_w; /* how many times jump was taken */
+    uint64_t fall_w; /* how many times block falls into next */
+
+    uint64_t chain; /* chain id ( id of chain head ) */
+    uint64_t next; /* next block in chain */
+    uint64_t tail; /* iff block is chain head -> last block in chain */
+
+    uint64_t addr; /* first line after layout */
+
+    uint8_t term;
+    uint8_t reachable   :1;
+    uint8_t padding     :7;
+
+}Block;
+
+typedef struct Edge
+{
+    uint64_t src;
+    uint64_t dst;
+    uint64_t weight;
+
+}Edge;
+
+/* heavier edge first, then by src and dst, so order doesn't depend on sort */
+#define EDGE_LESS(a, b) ( (a)->weight != (b)->weight ? (a)->weight > (b)->weight : \
+                          (a)->src != (b)->src ? (a)->src < (b)->src : (a)->dst < (b)->dst )
+
+SORT_DEFINE(edge_sort, Edge, EDGE_LESS)
+
+/*
+    Create asm line for jump instruction
+
+    PARAMS
+    @IN opcode - jump, jzero or jodd
+    @IN reg - register
+    @IN target - jump target
+
+    RETURN:
+    NULL iff failure
+    asm line iff success
+*/
+static char *jump_line_create(uint8_t opcode, uint64_t reg, uint64_t target);
+
+/*
+    Follow chain of blocks which contain only JUMP
+
+    PARAMS
+    @IN blocks - array of blocks
+    @IN nblocks - number of blocks
+    @IN b - block id
+
+    RETURN:
+    Final block id
+*/
+static uint64_t block_thread(Block *blocks, uint64_t nblocks, uint64_t b) __nonull__(1);
+
+/*
+    Merge chain with head @b to the end of chain with tail @a
+
+    PARAMS
+    @IN blocks - array of blocks
+    @IN a - tail of 1st chain
+    @IN b - head of 2nd chain
+
+    RETURN:
+    This is a void function
+*/
+static void chain_merge(Block *blocks, uint64_t a, uint64_t b) __nonull__(1);
+
+/*
+    Try to merge chains using edge @src -> @dst
+
+    PARAMS
+    @IN blocks - array of blocks
+    @IN src - edge source
+    @IN dst - edge destination
+
+    RETURN:
+    TRUE iff chains merged
+    FALSE iff not
+*/
+static BOOL chain_try_merge(Block *blocks, uint64_t src, uint64_t dst) __nonull__(1);
+
+static char *jump_line_create(uint8_t opcode, uint64_t reg, uint64_t target)
+{
+    char *str;
+
+    if(opcode == opcodes.jump)
+    {
+        if(asprintf(&str, "%s %ju\n", mnemonics.jump, target) == -1)
+            ERROR("asprintf error\n", NULL, "");
+    }
+    else
+    {
+        if(asprintf(&str, "%s %ju %ju\n", opcode == opcodes.jzero ? mnemonics.jzero : mnemonics.jodd,
+                    reg, target) == -1)
+            ERROR("asprintf error\n", NULL, "");
+    }
+
+    return str;
+}
+
+static uint64_t block_thread(Block *blocks, uint64_t nblocks, uint64_t b)
+{
+    uint64_t steps = 0;
+
+    /* block with only JUMP, jump to jump target, stop on infinite loop */
+    while(b != NO_BLOCK && steps < nblocks
+            && blocks[b].first == blocks[b].last && blocks[b].term == TERM_JUMP)
+    {
+        b = blocks[b].taken;
+        ++steps;
+    }
+
+    return b;
+}
+
+static void chain_merge(Block *blocks, uint64_t a, uint64_t b)
+{
+    uint64_t head;
+    uint64_t i;
+
+    head = blocks[a].chain;
+
+    blocks[a].next = b;
+    blocks[head].tail = blocks[b].tail;
+
+    for(i = b; i != NO_BLOCK; i = blocks[i].next)
+        blocks[i].chain = head;
+}
+
+static BOOL chain_try_merge(Block *blocks, uint64_t src, uint64_t dst)
+{
+    /* entry block has to be 1st */
+    if(dst == NO_BLOCK || dst == 0)
+        return FALSE;
+
+    /* src is not a tail or dst is not a head */
+    if(blocks[src].next != NO_BLOCK || blocks[dst].chain != dst)
+        return FALSE;
+
+    /* the same chain */
+    if(blocks[src].chain == blocks[dst].chain)
+        return FALSE;
+
+    chain_merge(blocks, src, dst);
+
+    return TRUE;
+}
+
+Profile *profile_load(const char *file)
+{
+    Profile *profile;
+    FILE *f;
+
+    char *buf = NULL;
+    size_t len = 0;
+
+    unsigned long long line;
+    unsigned long long count;
+    unsigned long long taken;
+
+    TRACE("");
+
+    f = fopen(file, "r");
+    if(f == NULL)
+        ERROR("cannot open %s file\n", NULL, file);
+
+    profile = (Profile*)malloc(sizeof(Profile));
+    if(profile == NULL)
+        ERROR("malloc error\n", NULL, "");
+
+    profile->lines = 0;
+    profile->count = NULL;
+    profile->taken = NULL;
+
+    while(getline(&buf, &len, f) != -1)
+    {
+        /* skip comments */
+        if(buf[0] == '#' || buf[0] == '\n')
+            continue;
+
+        if(sscanf(buf, "lines,%llu", &line) == 1)
+        {
+            if(profile->count != NULL)
+                goto bad_profile;
+
+            profile->lines = line;
+            profile->count = (uint64_t*)calloc(line + 1, sizeof(uint64_t));
+            profile->taken = (uint64_t*)calloc(line + 1, sizeof(uint64_t));
+            if(profile->count == NULL || profile->taken == NULL)
+                goto bad_profile;
+
+            continue;
+        }
+
+        /* other records ( op, mem ) are not needed for layout */
+        if(isalpha(buf[0]))
+            continue;
+
+        taken = 0;
+        if(sscanf(buf, "%llu,%llu,%llu", &line, &count, &taken) < 2)
+            goto bad_profile;
+
+        if(profile->count == NULL || line >= profile->lines || taken > count)
+            goto bad_profile;
+
+        profile->count[line] = count;
+        profile->taken[line] = taken;
+    }
+
+    if(profile->count == NULL)
+        goto bad_profile;
+
+    FREE(buf);
+    fclose(f);
+
+    return profile;
+
+bad_profile:
+    FREE(buf);
+    fclose(f);
+    profile_destroy(profile);
+
+    ERROR("bad profile file %s\n", NULL, file);
+}
+
+void profile_destroy(Profile *profile)
+{
+    TRACE("");
+
+    if(profile == NULL)
+        return;
+
+    FREE(profile->count);
+    FREE(profile->taken);
+    FREE(profile);
+}
+
+int layout_code(Vector *in_code, Profile *profile, Vector **out_code, uint64_t *relocation)
+{
+    char **lines = NULL;
+    int size;
+
+    Asm_line *code = NULL;
+    Block *blocks = NULL;
+    uint64_t *block_of = NULL;
+    uint64_t nblocks;
+
+    Edge *edges = NULL;
+    uint64_t nedges;
+
+    uint64_t *order = NULL;
+    uint64_t norder;
+
+    char **jumps = NULL;
+    Vector *out;
+
+    uint64_t i;
+    uint64_t j;
+    uint64_t b;
+    uint64_t next;
+    uint64_t addr;
+    uint64_t last;
+    BOOL hot;
+    int pass;
+
+    int ret = 1;
+
+    TRACE("");
+
+    if(in_code->length == 0 || profile->lines != in_code->length)
+        ERROR("profile doesn't match code\n", 1, "");
+
+    if(vector_to_array(in_code, (void*)&lines, &size))
+        ERROR("vector_to_array error\n", 1, "");
+
+    code = (Asm_line*)malloc(sizeof(Asm_line) * (size_t)size);
+    block_of = (uint64_t*)malloc(sizeof(uint64_t) * (size_t)size);
+    blocks = (Block*)malloc(sizeof(Block) * (size_t)size);
+    edges = (Edge*)malloc(sizeof(Edge) * (size_t)size * 2);
+    order = (uint64_t*)malloc(sizeof(uint64_t) * (size_t)size);
+    jumps = (char**)calloc((size_t)size * 2, sizeof(char*));
+    if(code == NULL || block_of == NULL || blocks == NULL || edges == NULL || order == NULL
+        || jumps == NULL)
+    {
+        LOG("malloc error\n", "");
+        goto cleanup;
+    }
+
+    /* parse code, find leaders */
+    for(i = 0; i < size; ++i)
+        block_of[i] = 0;
+
+    block_of[0] = 1;
+    for(i = 0; i < size; ++i)
+    {
+        if(asm_line_parse(lines[i], &code[i]))
+            goto cleanup;
+
+        if(opcode_is_jump(code[i].opcode))
+        {
+            if(code[i].target >= size)
+            {
+                LOG("jump outside code in line %ju\n", i);
+                goto cleanup;
+            }
+
+            block_of[code[i].target] = 1;
+        }
+
+        if((opcode_is_jump(code[i].opcode) || code[i].opcode == opcodes.halt) && i + 1 < size)
+            block_of[i + 1] = 1;
+    }
+
+    /* split code into basic blocks */
+    nblocks = 0;
+    for(i = 0; i < size; ++i)
+    {
+        if(block_of[i])
+        {
+            blocks[nblocks].first = i;
+            blocks[nblocks].count = profile->count[i];
+            ++nblocks;
+        }
+
+        block_of[i] = nblocks - 1;
+        blocks[nblocks - 1].last = i;
+    }
+
+    /* set successors and edge weights */
+    for(b = 0; b < nblocks; ++b)
+    {
+        i = blocks[b].last;
+
+        blocks[b].taken = NO_BLOCK;
+        blocks[b].fall = b + 1 < nblocks ? b + 1 : NO_BLOCK;
+        blocks[b].taken_w = 0;
+        blocks[b].fall_w = profile->count[i];
+        blocks[b].next = NO_BLOCK;
+        blocks[b].chain = b;
+        blocks[b].tail = b;
+        blocks[b].reachable = 0;
+        blocks[b].term = TERM_FALL;
+
+        if(code[i].opcode == opcodes.jump)
+        {
+            blocks[b].term = TERM_JUMP;
+            blocks[b].taken = block_of[code[i].target];
+            blocks[b].taken_w = profile->count[i];
+            blocks[b].fall = NO_BLOCK;
+            blocks[b].fall_w = 0;
+        }
+        else if(code[i].opcode == opcodes.jzero || code[i].opcode == opcodes.jodd)
+        {
+            blocks[b].term = TERM_COND;
+            blocks[b].taken = block_of[code[i].target];
+            blocks[b].taken_w = profile->taken[i];
+            blocks[b].fall_w = profile->count[i] - profile->taken[i];
+        }
+        else if(code[i].opcode == opcodes.halt)
+        {
+            blocks[b].term = TERM_HALT;
+            blocks[b].fall = NO_BLOCK;
+            blocks[b].fall_w = 0;
+        }
+    }
+
+    /* jump to jump -> jump to final target */
+    for(b = 0; b < nblocks; ++b)
+    {
+        blocks[b].taken = block_thread(blocks, nblocks, blocks[b].taken);
+        blocks[b].fall = block_thread(blocks, nblocks, blocks[b].fall);
+    }
+
+    /* mark reachable blocks, threaded blocks can be dropped */
+    norder = 0;
+    order[norder++] = 0;
+    blocks[0].reachable = 1;
+    for(i = 0; i < norder; ++i)
+    {
+        b = order[i];
+
+        if(blocks[b].taken != NO_BLOCK && ! blocks[blocks[b].taken].reachable)
+        {
+            blocks[blocks[b].taken].reachable = 1;
+            order[norder++] = blocks[b].taken;
+        }
+
+        if(blocks[b].fall != NO_BLOCK && ! blocks[blocks[b].fall].reachable)
+        {
+            blocks[blocks[b].fall].reachable = 1;
+            order[norder++] = blocks[b].fall;
+        }
+    }
+
+    /* collect executed edges */
+    nedges = 0;
+    for(b = 0; b < nblocks; ++b)
+    {
+        if(! blocks[b].reachable)
+            continue;
+
+        /* taken cond jump costs the same wherever the target is, so only JUMP edge can be removed */
+        if(blocks[b].term == TERM_JUMP && blocks[b].taken_w)
+        {
+            edges[nedges].src = b;
+            edges[nedges].dst = blocks[b].taken;
+            edges[nedges].weight = blocks[b].taken_w;
+            ++nedges;
+        }
+
+        if(blocks[b].fall != NO_BLOCK && blocks[b].fall_w)
+        {
+            edges[nedges].src = b;
+            edges[nedges].dst = blocks[b].fall;
+            edges[nedges].weight = blocks[b].fall_w;
+            ++nedges;
+        }
+    }
+
+    /* the hottest edges become fall through edges */
+    (void)edge_sort(edges, (int)nedges);
+    for(i = 0; i < nedges; ++i)
+        chain_try_merge(blocks, edges[i].src, edges[i].dst);
+
+    /* keep original fall through in cold code */
+    for(b = 0; b < nblocks; ++b)
+        if(blocks[b].reachable && blocks[b].term != TERM_JUMP && blocks[b].fall == b + 1)
+            chain_try_merge(blocks, b, b + 1);
+
+    /* entry chain, executed chains, never executed chains */
+    norder = 0;
+    for(pass = 0; pass < 3; ++pass)
+        for(b = 0; b < nblocks; ++b)
+        {
+            if(! blocks[b].reachable || blocks[b].chain != b)
+                continue;
+
+            if((pass == 0) != (b == 0))
+                continue;
+
+            hot = FALSE;
+            for(j = b; j != NO_BLOCK; j = blocks[j].next)
+                if(blocks[j].count)
+                    hot = TRUE;
+
+            if(pass == 1 && ! hot)
+                continue;
+
+            if(pass == 2 && hot)
+                continue;
+
+            for(j = b; j != NO_BLOCK; j = blocks[j].next)
+                order[norder++] = j;
+        }
+
+    /* calc new addr of blocks */
+    addr = 0;
+    for(i = 0; i < norder; ++i)
+    {
+        b = order[i];
+        next = i + 1 < norder ? order[i + 1] : NO_BLOCK;
+
+        blocks[b].addr = addr;
+        addr += blocks[b].last - blocks[b].first;
+
+        switch(blocks[b].term)
+        {
+            case TERM_FALL:
+            {
+                addr += 1 + (blocks[b].fall != NO_BLOCK && blocks[b].fall != next);
+                break;
+            }
+            case TERM_JUMP:
+            {
+                addr += blocks[b].taken != next;
+                break;
+            }
+            case TERM_COND:
+            {
+                addr += 1 + (blocks[b].fall != NO_BLOCK && blocks[b].fall != next);
+                break;
+            }
+            default:
+            {
+                ++addr;
+                break;
+            }
+        }
+    }
+
+    LOG("LAYOUT: %d lines -> %ju lines\n", size, addr);
+
+    /* create jumps before moving any line, so failure leaves @in_code untouched */
+    for(i = 0; i < norder; ++i)
+    {
+        b = order[i];
+        next = i + 1 < norder ? order[i + 1] : NO_BLOCK;
+        j = blocks[b].last;
+
+        /* cond is always taken to taken block, iff fall block is not next we need JUMP */
+        if(blocks[b].term == TERM_COND)
+        {
+            jumps[2 * i] = jump_line_create(code[j].opcode, code[j].reg, blocks[blocks[b].taken].addr);
+            if(jumps[2 * i] == NULL)
+                goto cleanup_jumps;
+        }
+
+        if(blocks[b].term == TERM_JUMP && blocks[b].taken != next)
+        {
+            jumps[2 * i + 1] = jump_line_create(opcodes.jump, 0, blocks[blocks[b].taken].addr);
+            if(jumps[2 * i + 1] == NULL)
+                goto cleanup_jumps;
+        }
+
+        if((blocks[b].term == TERM_FALL || blocks[b].term == TERM_COND)
+            && blocks[b].fall != NO_BLOCK && blocks[b].fall != next)
+        {
+            jumps[2 * i + 1] = jump_line_create(opcodes.jump, 0, blocks[blocks[b].fall].addr);
+            if(jumps[2 * i + 1] == NULL)
+                goto cleanup_jumps;
+        }
+    }
+
+    out = vector_create(sizeof(char*));
+    if(out == NULL)
+    {
+        LOG("vector_create error\n", "");
+        goto cleanup_jumps;
+    }
+
+    if(relocation != NULL)
+        for(i = 0; i < size; ++i)
+            relocation[i] = LAYOUT_NO_LINE;
+
+    /* emit code */
+    for(i = 0; i < norder; ++i)
+    {
+        b = order[i];
+
+        /* body, terminator of FALL and HALT block is a normal line */
+        last = blocks[b].term == TERM_FALL || blocks[b].term == TERM_HALT ? blocks[b].last + 1 : blocks[b].last;
+        for(j = blocks[b].first; j < last; ++j)
+        {
+            if(relocation != NULL)
+                relocation[j] = out->length;
+
+            vector_insert_last(out, (void*)&lines[j]);
+            lines[j] = NULL;
+        }
+
+        /* jump terminator is replaced by new jumps */
+        if(relocation != NULL && last == blocks[b].last
+            && (jumps[2 * i] != NULL || jumps[2 * i + 1] != NULL))
+            relocation[last] = out->length;
+
+        if(jumps[2 * i] != NULL)
+            vector_insert_last(out, (void*)&jumps[2 * i]);
+
+        if(jumps[2 * i + 1] != NULL)
+            vector_insert_last(out, (void*)&jumps[2 * i + 1]);
+    }
+
+    *out_code = out;
+    ret = 0;
+    goto cleanup;
+
+cleanup_jumps:
+    for(j = 0; j < 2 * (uint64_t)size; ++j)
+        FREE(jumps[j]);
+
+cleanup:
+    /* free lines which are not used in new code */
+    if(ret == 0)
+        for(i = 0; i < size; ++i)
+            FREE(lines[i]);
+
+    FREE(lines);
+    FREE(code);
+    FREE(block_of);
+    FREE(blocks);
+    FREE(edges);
+    FREE(order);
+    FREE(jumps);
+
+    return ret;
+}
@@ -1,6 +1,6 @@
 #include <optimizer.h>
 
-int main_optimizing(Arraylist *in_tokens, Arraylist **out_tokens)
+int main_optimizing(Vector *in_tokens, Vector **out_tokens)
 {
     int ret;
 
@@ -7,22 +7,49 @@
 
 #include <parser_helper.h>
 #include <common.h>
+#include <time_report.h>
+
+#include <pthread.h>
 
 /* definision of lexer function use in bison */
 int yylex(void);
 
-/* input file buffer */
-file_buffer *fb_input = NULL;
+/* set lexer at the begining of new input, buffer is ended by two '\0' */
+int lexer_reset(char *buffer, size_t size);
+
+/* release lexer buffer */
+void lexer_release(void);
+
+/* text of current lexeme */
+extern char *yytext;
+
+/* input code */
+__thread char *source_code = NULL;
+__thread uint64_t source_size = 0;
 
-/* input stream */
-FILE *yyin;
+__thread Darray *code_lines = NULL;
 
-Darray *code_lines;
+__thread Vector *big_consts = NULL;
 
 /* check use of variables */
-Avl *variables;
+__thread Hashmap *variables;
 
-Arraylist *tokens;
+__thread Vector *tokens;
+
+/*
+    Lexer and parser are not reentrant, one thread parse at once.
+
+    Jobs of --jobs and --server don't get explicit parser context, the rest of compiler
+    state is thread local instead. Scanner of flex keeps lines, yyin and its buffer stack
+    ( YY_CURRENT_BUFFER ) in globals of generated code, bison keeps yylval, yychar and
+    yynerrs in globals too, so they are shared by all threads and can't be made thread
+    local from here. Only this phase is serial, optimizer and code generation of jobs
+    run in parallel.
+    Reentrant scanner ( %option reentrant, lines in yyextra ) with %define api.pure
+    would remove this lock.
+*/
+static pthread_mutex_t parse_mutex = PTHREAD_MUTEX_INITIALIZER;
+static __thread BOOL parse_locked = FALSE;
 
 /* parser built in functions */
 static void yyerror(const char *msg);
@@ -42,7 +69,7 @@ static int yyparse(void);
     Pvalue          val;
     Pexpr           expr;
     Pcond           cond;
-    Arraylist       *list;
+    Vector       *list;
     Token           *token;
 }
 
@@ -98,6 +125,10 @@ program[pro]:
 
         /* we read program code so assign pointer to token list */
         tokens = $cmd;
+
+        /* hidden variables of big literals are set before first command */
+        if(big_consts_insert(tokens))
+            ERROR("big_consts_insert error\n", 1, "");
     }
 ;
 
@@ -127,6 +158,14 @@ vdeclar[res]:
 	| vdeclar[dec] YY_VARIABLE[var] YY_L_BRACKET[lb] YY_NUM[num] YY_R_BRACKET[rb]
     {
         YY_LOG("[YACC]\tdeclar\tYY_ARRAY:\t%s[ %s ]\n", $var.str, $num.str);
+
+        /* array is indexed by 64 bits offsets */
+        if($num.big)
+        {
+            print_err($var.line - 1, $rb.line - 1, "array is too big:\t%s[ %s ]\n", $var.str, $num.str);
+            compiler_exit(1);
+        }
+
         declare(PTOKEN_ARR, &$var, $num.val);
 
         FREE($var.str);
@@ -164,24 +203,24 @@ commands[list]:
         YY_LOG("[YACC]\tcommands command\n", "");
 
         Token *token;
-        Arraylist_iterator it;
+        Vector_iterator it;
 
         /* we alloc list in last recursive step, so just add to list */
 
-        for( arraylist_iterator_init($cmd, &it, ITI_BEGIN);\
-            ! arraylist_iterator_end(&it); \
-            arraylist_iterator_next(&it))
+        for( vector_iterator_init($cmd, &it, ITI_BEGIN);\
+            ! vector_iterator_end(&it); \
+            vector_iterator_next(&it))
         {
 
-            arraylist_iterator_get_data(&it, (void*)&token);
+            vector_iterator_get_data(&it, (void*)&token);
 
-            if(arraylist_insert_last($list, (void*)&token))
-                ERROR("arraylist_insert_first error\n", 1, "");
+            if(vector_insert_last($list, (void*)&token))
+                ERROR("vector_insert_first error\n", 1, "");
         }
 
 
         /* we add here every token so now can destroy not needed list */
-        arraylist_destroy($cmd);
+        vector_destroy($cmd);
     }
 ;
 
@@ -290,16 +329,18 @@ command[cmd]:
         if(token == NULL)
             ERROR("token_create error\n", 1, "");
 
+        token_set_lines(token, $id.line, $semi.line);
+
         check_use_it($id.val, token, $id.line - 1, $semi.line - 1);
 
         /* create new list */
-        $cmd = arraylist_create(sizeof(Token*));
+        $cmd = vector_create(sizeof(Token*));
         if($cmd == NULL)
-            ERROR("arraylist_create error\n", 1, "");
+            ERROR("vector_create error\n", 1, "");
 
         /* ADD token to list */
-        if( arraylist_insert_last($cmd, (void*)&token))
-            ERROR("arraylist_insert_last error\n", 1, "");
+        if( vector_insert_last($cmd, (void*)&token))
+            ERROR("vector_insert_last error\n", 1, "");
 
         FREE($semi.str);
         FREE($ass.str);
@@ -323,7 +364,7 @@ command[cmd]:
             Token *token2;
             Token *token3;
 
-            Arraylist_iterator it;
+            Vector_iterator it;
             Token *token;
 
 #ifdef YY_DEBUG_MODE
@@ -337,6 +378,8 @@ command[cmd]:
             if(token1 == NULL)
                 ERROR("token_create error\n", 1, "");
 
+            token_set_lines(token1, $tif.line, $then.line);
+
             telsee = token_guard_create(tokens_id.else_cond);
             if(telsee == NULL)
                 ERROR("token_guard_create error\n", 1, "");
@@ -345,6 +388,8 @@ command[cmd]:
             if(token2 == NULL)
                 ERROR("token_create error\n", 1, "");
 
+            token_set_lines(token2, $telse.line, $telse.line);
+
             endiff = token_guard_create(tokens_id.end_if);
             if(endiff == NULL)
                 ERROR("token_guard_create error\n", 1, "");
@@ -353,46 +398,48 @@ command[cmd]:
             if(token3 == NULL)
                 ERROR("token_create error\n", 1, "");
 
+            token_set_lines(token3, $endif.line, $endif.line);
+
             /* create new list */
-            $cmd = arraylist_create(sizeof(Token*));
+            $cmd = vector_create(sizeof(Token*));
             if($cmd == NULL)
-                ERROR("arraylist_create error\n", 1, "");
+                ERROR("vector_create error\n", 1, "");
 
             /* ADD IF token to list */
-            if( arraylist_insert_last($cmd, (void*)&token1))
-                ERROR("arraylist_insert_last error\n", 1, "");
+            if( vector_insert_last($cmd, (void*)&token1))
+                ERROR("vector_insert_last error\n", 1, "");
 
             /* add if statement */
-            for( arraylist_iterator_init($cmd1, &it, ITI_BEGIN);\
-                ! arraylist_iterator_end(&it); \
-                arraylist_iterator_next(&it))
+            for( vector_iterator_init($cmd1, &it, ITI_BEGIN);\
+                ! vector_iterator_end(&it); \
+                vector_iterator_next(&it))
             {
 
-                arraylist_iterator_get_data(&it, (void*)&token);
+                vector_iterator_get_data(&it, (void*)&token);
 
-                if(arraylist_insert_last($cmd, (void*)&token))
-                    ERROR("arraylist_insert_first error\n", 1, "");
+                if(vector_insert_last($cmd, (void*)&token))
+                    ERROR("vector_insert_first error\n", 1, "");
             }
 
             /* ADD ELSE token to list */
-            if( arraylist_insert_last($cmd, (void*)&token2))
-                ERROR("arraylist_insert_last error\n", 1, "");
+            if( vector_insert_last($cmd, (void*)&token2))
+                ERROR("vector_insert_last error\n", 1, "");
 
             /* add ELSE statement */
-            for( arraylist_iterator_init($cmd2, &it, ITI_BEGIN);\
-                ! arraylist_iterator_end(&it); \
-                arraylist_iterator_next(&it))
+            for( vector_iterator_init($cmd2, &it, ITI_BEGIN);\
+                ! vector_iterator_end(&it); \
+                vector_iterator_next(&it))
             {
 
-                arraylist_iterator_get_data(&it, (void*)&token);
+                vector_iterator_get_data(&it, (void*)&token);
 
-                if(arraylist_insert_last($cmd, (void*)&token))
-                    ERROR("arraylist_insert_first error\n", 1, "");
+                if(vector_insert_last($cmd, (void*)&token))
+                    ERROR("vector_insert_first error\n", 1, "");
             }
 
             /* ADD ENDIF token to list */
-            if( arraylist_insert_last($cmd, (void*)&token3))
-                ERROR("arraylist_insert_last error\n", 1, "");
+            if( vector_insert_last($cmd, (void*)&token3))
+                ERROR("vector_insert_last error\n", 1, "");
 
 #ifdef YY_DEBUG_MODE
             FREE(str1);
@@ -404,8 +451,8 @@ command[cmd]:
             FREE($endif.str);
 
             /* we copy every tokens from cmd1 and cmd2 so destroy lists*/
-            arraylist_destroy($cmd1);
-            arraylist_destroy($cmd2);
+            vector_destroy($cmd1);
+            vector_destroy($cmd2);
     }
 
 /*******************************************************************************
@@ -424,7 +471,7 @@ command[cmd]:
         Token *token1;
         Token *token2;
 
-        Arraylist_iterator it;
+        Vector_iterator it;
         Token *token;
 
 #ifdef YY_DEBUG_MODE
@@ -438,6 +485,8 @@ command[cmd]:
         if(token1 == NULL)
             ERROR("token_create error\n", 1, "");
 
+        token_set_lines(token1, $twhile.line, $tdo.line);
+
         endwhile = token_guard_create(tokens_id.end_while);
         if(endwhile == NULL)
             ERROR("token_guard_create error\n", 1, "");
@@ -446,31 +495,33 @@ command[cmd]:
         if(token2 == NULL)
             ERROR("token_create error\n", 1, "");
 
+        token_set_lines(token2, $tend.line, $tend.line);
+
 
         /* create new list */
-        $cmd = arraylist_create(sizeof(Token*));
+        $cmd = vector_create(sizeof(Token*));
         if($cmd == NULL)
-            ERROR("arraylist_create error\n", 1, "");
+            ERROR("vector_create error\n", 1, "");
 
         /* ADD WHILE token to list */
-        if( arraylist_insert_last($cmd, (void*)&token1))
-            ERROR("arraylist_insert_last error\n", 1, "");
+        if( vector_insert_last($cmd, (void*)&token1))
+            ERROR("vector_insert_last error\n", 1, "");
 
         /* add while statement */
-        for( arraylist_iterator_init($cmd1, &it, ITI_BEGIN);\
-            ! arraylist_iterator_end(&it); \
-            arraylist_iterator_next(&it))
+        for( vector_iterator_init($cmd1, &it, ITI_BEGIN);\
+            ! vector_iterator_end(&it); \
+            vector_iterator_next(&it))
         {
 
-            arraylist_iterator_get_data(&it, (void*)&token);
+            vector_iterator_get_data(&it, (void*)&token);
 
-            if(arraylist_insert_last($cmd, (void*)&token))
-                ERROR("arraylist_insert_first error\n", 1, "");
+            if(vector_insert_last($cmd, (void*)&token))
+                ERROR("vector_insert_first error\n", 1, "");
         }
 
         /* ADD ENDWHILE token to list */
-        if( arraylist_insert_last($cmd, (void*)&token2))
-            ERROR("arraylist_insert_last error\n", 1, "");
+        if( vector_insert_last($cmd, (void*)&token2))
+            ERROR("vector_insert_last error\n", 1, "");
 
 #ifdef YY_DEBUG_MODE
         FREE(str1);
@@ -481,7 +532,7 @@ command[cmd]:
         FREE($tend.str);
 
         /* we copy every tokens from cmd so destroy list */
-        arraylist_destroy($cmd1);
+        vector_destroy($cmd1);
     }
 
 /*******************************************************************************
@@ -505,7 +556,7 @@ command[cmd]:
         token_guard *endforr;
         Token *token1;
 
-        Arraylist_iterator it;
+        Vector_iterator it;
         Token *token;
 
         endforr = token_guard_create(tokens_id.end_for);
@@ -516,30 +567,32 @@ command[cmd]:
         if(token1 == NULL)
             ERROR("token_create error\n", 1, "");
 
+        token_set_lines(token1, $endfor.line, $endfor.line);
+
         /* create new list */
-        $cmd = arraylist_create(sizeof(Token*));
+        $cmd = vector_create(sizeof(Token*));
         if($cmd == NULL)
-            ERROR("arraylist_create error\n", 1, "");
+            ERROR("vector_create error\n", 1, "");
 
         /* ADD FOR token to list */
-        if( arraylist_insert_last($cmd, (void*)&$tfor))
-            ERROR("arraylist_insert_last error\n", 1, "");
+        if( vector_insert_last($cmd, (void*)&$tfor))
+            ERROR("vector_insert_last error\n", 1, "");
 
         /* add FOR statement */
-        for( arraylist_iterator_init($cmd1, &it, ITI_BEGIN);\
-            ! arraylist_iterator_end(&it); \
-            arraylist_iterator_next(&it))
+        for( vector_iterator_init($cmd1, &it, ITI_BEGIN);\
+            ! vector_iterator_end(&it); \
+            vector_iterator_next(&it))
         {
 
-            arraylist_iterator_get_data(&it, (void*)&token);
+            vector_iterator_get_data(&it, (void*)&token);
 
-            if(arraylist_insert_last($cmd, (void*)&token))
-                ERROR("arraylist_insert_first error\n", 1, "");
+            if(vector_insert_last($cmd, (void*)&token))
+                ERROR("vector_insert_first error\n", 1, "");
         }
 
         /* ADD ENDFOR token to list */
-        if( arraylist_insert_last($cmd, (void*)&token1))
-            ERROR("arraylist_insert_last error\n", 1, "");
+        if( vector_insert_last($cmd, (void*)&token1))
+            ERROR("vector_insert_last error\n", 1, "");
 
 #ifdef YY_DEBUG_MODE
         FREE(str1);
@@ -553,7 +606,7 @@ command[cmd]:
         FREE($endfor.str);
 
         /* we copy every tokens from cmd so destroy list */
-        arraylist_destroy($cmd1);
+        vector_destroy($cmd1);
     }
 
 /*******************************************************************************
@@ -579,6 +632,8 @@ command[cmd]:
         if(token == NULL)
             ERROR("token_create error\n", 1 ,"");
 
+        token_set_lines(token, $read.line, $semi.line);
+
         check_use_it($id.val, token,  $read.line - 1, $semi.line - 1);
 
         /* read from stdin so we init value */
@@ -588,13 +643,13 @@ command[cmd]:
         use(variable_get_name($id.val->body.var));
 
         /* create new list */
-        $cmd = arraylist_create(sizeof(Token*));
+        $cmd = vector_create(sizeof(Token*));
         if($cmd == NULL)
-            ERROR("arraylist_create error\n", 1, "");
+            ERROR("vector_create error\n", 1, "");
 
         /* ADD token to list */
-        if( arraylist_insert_last($cmd, (void*)&token))
-            ERROR("arraylist_insert_last error\n", 1, "");
+        if( vector_insert_last($cmd, (void*)&token))
+            ERROR("vector_insert_last error\n", 1, "");
 
         FREE($read.str);
         FREE($semi.str);
@@ -628,18 +683,20 @@ command[cmd]:
         if(token == NULL)
             ERROR("token_create error\n", 1 ,"");
 
+        token_set_lines(token, $write.line, $semi.line);
+
         /* we use this variable */
         if($val.val->type == VARIABLE)
             use(variable_get_name($val.val->body.var));
 
         /* create new list */
-        $cmd = arraylist_create(sizeof(Token*));
+        $cmd = vector_create(sizeof(Token*));
         if($cmd == NULL)
-            ERROR("arraylist_create error\n", 1, "");
+            ERROR("vector_create error\n", 1, "");
 
         /* ADD token to list */
-        if( arraylist_insert_last($cmd, (void*)&token))
-            ERROR("arraylist_insert_last error\n", 1, "");
+        if( vector_insert_last($cmd, (void*)&token))
+            ERROR("vector_insert_last error\n", 1, "");
 
         FREE($write.str);
         FREE($semi.str);
@@ -668,14 +725,16 @@ command[cmd]:
         if(token == NULL)
             ERROR("token_create error\n", 1, "");
 
+        token_set_lines(token, $skip.line, $semi.line);
+
         /* create new list */
-        $cmd = arraylist_create(sizeof(Token*));
+        $cmd = vector_create(sizeof(Token*));
         if($cmd == NULL)
-            ERROR("arraylist_create error\n", 1, "");
+            ERROR("vector_create error\n", 1, "");
 
         /* ADD token to list */
-        if( arraylist_insert_last($cmd, (void*)&token))
-            ERROR("arraylist_insert_last error\n", 1, "");
+        if( vector_insert_last($cmd, (void*)&token))
+            ERROR("vector_insert_last error\n", 1, "");
 
         FREE($skip.str);
         FREE($semi.str);
@@ -717,7 +776,7 @@ fordeclar[declar]:
         {
             print_err($tfor.line - 1, $tdo.line - 1, "iterator is redeclared:\t%s\n",$var.str);
 
-            exit(1);
+            compiler_exit(1);
         }
 
         /* declared and create iterator*/
@@ -761,6 +820,8 @@ fordeclar[declar]:
         if(token == NULL)
             ERROR("token_create error\n", 1, "");
 
+        token_set_lines(token, $tfor.line, $tdo.line);
+
         $declar = token;
 
 #ifdef YY_DEBUG_MODE
@@ -801,7 +862,7 @@ fordeclar[declar]:
         {
             print_err($tfor.line - 1, $tdo.line - 1, "iterator is redeclared:\t%s\n",$var.str);
 
-            exit(1);
+            compiler_exit(1);
         }
 
         /* declared and create iterator*/
@@ -845,6 +906,8 @@ fordeclar[declar]:
         if(token == NULL)
             ERROR("token_create error\n", 1, "");
 
+        token_set_lines(token, $tfor.line, $tdo.line);
+
         $declar = token;
 
 #ifdef YY_DEBUG_MODE
@@ -1245,13 +1308,22 @@ value[val]:
 
         YY_LOG("[YACC]\tYY_NUM:\t%s\n", $num.str);
 
-        cv = const_value_create($num.val);
-        if(cv == NULL)
-            ERROR("const_value_create error\n", 1, "");
+        if($num.big)
+        {
+            $val.val = big_const_value(&$num);
+            if($val.val == NULL)
+                ERROR("big_const_value error\n", 1, "");
+        }
+        else
+        {
+            cv = const_value_create($num.val);
+            if(cv == NULL)
+                ERROR("const_value_create error\n", 1, "");
 
-        $val.val = value_create(CONST_VAL, (void*)cv);
-        if($val.val == NULL)
-            ERROR("value_create error\n", 1, "");
+            $val.val = value_create(CONST_VAL, (void*)cv);
+            if($val.val == NULL)
+                ERROR("value_create error\n", 1, "");
+        }
 
         $val.line = $num.line;
 
@@ -1371,6 +1443,13 @@ identifier[id]:
 
         YY_LOG("[YACC]\tYY_ARRAY:\t%s [ %s ]\n", $var.str, $num.str);
 
+        /* no array has so many members */
+        if($num.big && is_declared($var.str))
+        {
+            print_err($var.line - 1, $rb.line - 1, "array member out of array range:\t%s[ %s ]\n", $var.str, $num.str);
+            compiler_exit(1);
+        }
+
         vn = var_normal_create($var.str);
         if(vn == NULL)
             ERROR("var_normal error\n", 1, "");
@@ -1403,82 +1482,126 @@ identifier[id]:
 
 static void yyerror(const char *msg)
 {
-    fprintf(stderr,"%sERROR!\t%s\t%s\nLINE: %ju\n%s%s\n",
-            RED, msg, yylval.ptoken.str,
+    const char *line;
+    int len;
+
+    line = code_line(yylval.ptoken.line - 1, &len);
+
+    fprintf(stderr,"%sERROR!\t%s\t%s\nLINE: %ju\n%.*s%s\n",
+            RED, msg, yytext,
             yylval.ptoken.line,
-            ((char**)code_lines->array)[yylval.ptoken.line - 1],
+            len, line,
             RESET);
 
-    exit(1);
+    compiler_exit(1);
 }
 
-int parse(const char *file, Arraylist **out_tokens)
+void parse_unlock(void)
 {
-    FILE *f;
+    if(! parse_locked)
+        return;
 
-    int fd;
-    int ret;
+    /* lexer buffer points to source_code */
+    lexer_release();
 
-    Darray_iterator it;
-    char *temp;
+    parse_locked = FALSE;
+    pthread_mutex_unlock(&parse_mutex);
+}
 
-    Avl_iterator avl_it;
+int parse(const char *file, Vector **out_tokens)
+{
+    int ret;
+
+    Pvar **sorted;
     Pvar *pvar;
+    int size;
+    int pos;
 
 #ifdef DEBUG_MODE
     int i;
-    Arraylist_iterator ait;
+    int len;
+    const char *line;
+    Vector_iterator ait;
     Token *token;
 
     char *str;
 #endif
 
+    Phase_mark mark;
+
     TRACE("");
 
+    PHASE_BEGIN(mark);
+
     /* Create variables to check correctnes of using */
-    variables = avl_create(sizeof(Pvar*), pvar_cmp);
+    variables = hashmap_create(sizeof(Pvar*), pvar_hash, pvar_cmp);
     if(variables == NULL)
-        ERROR("avl_create error\n", 1, "");
+        ERROR("hashmap_create error\n", 1, "");
 
     /* map file */
     if(file == NULL)
         ERROR("file == NULL\n", 1, "");
 
-    fd = open(file, O_RDWR | O_LARGEFILE);
-    if( fd == -1)
-        ERROR("cannot open %s file\n", 1, file);
+    /* code of stopped parsing */
+    if(source_code != NULL)
+        source_unmap(source_code, source_size);
 
-    /* create File buffer for this file */
-    fb_input = file_buffer_create(fd, PROT_READ | PROT_WRITE | MAP_SHARED);
-    if(fb_input == NULL)
-        ERROR("file_buffer_create error\n", 1, "");
+    if(code_lines != NULL)
+        darray_destroy(code_lines);
 
-    close(fd);
+    /* tokens of stopped parsing are in compile_arena */
+    if(big_consts != NULL)
+        vector_destroy(big_consts);
 
-    code_lines = darray_create(UNSORTED, 0, sizeof(char*), NULL);
+    big_consts = NULL;
+
+    source_code = source_map(file, &source_size);
+    if(source_code == NULL)
+        ERROR("source_map error\n", 1, "");
+
+    /* errors print lines of code, so remember where lines start */
+    code_lines = darray_create(UNSORTED, 0, sizeof(uint64_t), NULL);
     if(code_lines == NULL)
         ERROR("darray_create error\n", 1, "");
 
-    if(strspl(fb_input->buffer, '\n', code_lines))
-        ERROR("strspl error\n", 1, "");
+    if(line_index(source_code, source_size, '\n', code_lines))
+        ERROR("line_index error\n", 1, "");
+
+    PHASE_END(PHASE_SOURCE, mark);
 
 #ifdef DEBUG_MODE
     for(i = 0; i < code_lines->num_entries; ++i )
-        LOG("LINE %d\t%s\n",i,((char**)code_lines->array)[i]);
+    {
+        line = code_line((uint64_t)i, &len);
+        LOG("LINE %d\t%.*s\n", i, len, line);
+    }
 #endif
 
-    /* set file as lex input */
-    f = fopen(file, "r");
-    yyin = f;
+    /* waiting for parser of other job is in wall time only */
+    PHASE_BEGIN(mark);
+
+    pthread_mutex_lock(&parse_mutex);
+    parse_locked = TRUE;
+
+    /* lexer reads mapped code in place */
+    if(lexer_reset(source_code, (size_t)source_size))
+    {
+        parse_unlock();
+        ERROR("lexer_reset error\n", 1, "");
+    }
 
 	ret = yyparse();
 
+    parse_unlock();
+
+    PHASE_END(PHASE_PARSE, mark);
+
 #ifdef DEBUG_MODE
-    for(arraylist_iterator_init(tokens, &ait, ITI_BEGIN); \
-        ! arraylist_iterator_end(&ait); \
-        arraylist_iterator_next(&ait) )
+    for(vector_iterator_init(tokens, &ait, ITI_BEGIN); \
+        ! vector_iterator_end(&ait); \
+        vector_iterator_next(&ait) )
     {
-        arraylist_iterator_get_data(&ait, (void*)&token);
+        vector_iterator_get_data(&ait, (void*)&token);
         str = token_str(token);
 
         LOG("TOKEN: %s\n", str);
@@ -1487,41 +1610,45 @@ int parse(const char *file, Arraylist **out_tokens)
     }
 #endif
 
-    /* check ununused variables */
-    for( avl_iterator_init(variables, &avl_it, ITI_BEGIN);
-        ! avl_iterator_end(&avl_it);
-        avl_iterator_next(&avl_it))
+    /* check ununused variables, sorted by name so order of warnings doesn't depend on map */
+    if(option.wall)
     {
-        avl_iterator_get_data(&avl_it, (void*)&pvar);
-        if( ! IS_VAR_USE(pvar) )
+        PHASE_BEGIN(mark);
+
+        if(pvars_sorted(variables, &sorted, &size))
+            ERROR("pvars_sorted error\n", 1, "");
+
+        for(pos = 0; pos < size; ++pos)
         {
-            if(option.wall)
+            pvar = sorted[pos];
+            if( ! IS_VAR_USE(pvar) )
             {
                 if(option.werr)
                 {
                     fprintf(stderr,"%sERROR!\tunused variable:\t%s%s\n",
                         RED, pvar->name, RESET);
 
-                    exit(1);
+                    FREE(sorted);
+                    compiler_exit(1);
                 }
                 else
                 fprintf(stderr,"%sWARNING!\tunused variable:\t%s%s\n",
                     YELLOW, pvar->name, RESET);
             }
         }
-    }
 
-    /* clean up */
-    file_buffer_destroy(fb_input);
+        FREE(sorted);
 
-    for(darray_iterator_init(code_lines,&it,ITI_BEGIN); ! darray_iterator_end(&it); darray_iterator_next(&it))
-    {
-        darray_iterator_get_data(&it, (void*)&temp);
-        FREE(temp);
+        PHASE_END(PHASE_SEMANTIC, mark);
     }
 
-    fclose(f);
+    /* clean up */
+    source_unmap(source_code, source_size);
+    source_code = NULL;
+    source_size = 0;
+
     darray_destroy(code_lines);
+    code_lines = NULL;
 
     *out_tokens = tokens;
 
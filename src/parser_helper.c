@@ -1,16 +1,58 @@
 #include <common.h>
 #include <parser_helper.h>
+#include <arena.h>
+#include <sort.h>
 #include <stdarg.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
-extern Avl *variables;
-extern Darray *code_lines;
+/* the same order as pvar_cmp */
+#define PVAR_LESS(a, b) ( strcmp((*(a))->name, (*(b))->name) < 0 )
 
-int strspl(char *str, const char delimeter, Darray *arr)
+SORT_DEFINE(pvar_sort, Pvar*, PVAR_LESS)
+
+/*
+    Create value of normal variable
+
+    PARAMS
+    @IN name - variable name
+
+    RETURN:
+    NULL iff failure
+    Pointer to value iff success
+*/
+static Value *var_value_create(const char *name);
+
+/*
+    Compare pvar in variables with name
+
+    PARAMS
+    @IN pvar - addr of Parser var
+    @IN name - name of variable
+
+    RETURN:
+    0 iff pvar has this name
+    Non-zero value iff pvar has other name
+*/
+static int pvar_name_cmp(void *pvar, const void *name);
+
+/*
+    Search for pvar with name in variables
+
+    PARAMS
+    @IN name - name of variable
+
+    RETURN:
+    NULL iff variable is not declared
+    Pointer to pvar in map iff success ( valid until variables change )
+*/
+static Pvar **pvar_search_by_name(const char *name);
+
+int line_index(const char *str, uint64_t size, const char delimeter, Darray *arr)
 {
-    char *ptr;
-    char *prev;
-    char *new_str;
-    uint64_t bytes;
+    const char *ptr;
+    const char *end;
+    uint64_t offset;
 
     TRACE("");
 
@@ -18,40 +60,113 @@ int strspl(char *str, const char delimeter, Darray *arr)
         ERROR("str == NULL || arr == NULL\n", 1, "");
 
     ptr = str;
-    prev = str;
+    end = str + size;
 
-    while( *ptr != '\0' )
+    while( ptr < end )
     {
+        /* line starts here */
+        offset = (uint64_t)(ptr - str);
+        if(darray_insert(arr, (void*)&offset))
+            ERROR("darray_insert error\n", 1, "");
+
         /* find delimeter */
-        while( *ptr != '\0' && *ptr != delimeter )
-            ++ptr;
+        ptr = (const char*)memchr(ptr, delimeter, (size_t)(end - ptr));
+        if(ptr == NULL)
+            break;
 
-        /* copy string to new string */
-        bytes = (uint64_t)ptr - (uint64_t)prev + 1;
-        new_str = (char*)malloc(sizeof(char) * bytes);
-        if(new_str == NULL)
-            ERROR("malloc error\n", 1, "");
+        ++ptr;
+    }
 
-        if( memcpy(new_str, prev, bytes - 1) == NULL )
-            ERROR("memcpy error\n", 1, "");
+    return 0;
+}
 
-        new_str[bytes - 1] = '\0';
+const char *code_line(uint64_t i, int *len)
+{
+    const char *line;
+    const char *end;
 
-        /* insert pointer to string to arr */
-        if(darray_insert(arr, (void*)&new_str))
-            ERROR("darray_insert error\n", 1, "");
+    if(code_lines == NULL || i >= (uint64_t)code_lines->num_entries)
+    {
+        *len = 0;
+        return "";
+    }
 
-        ++ptr;
-        prev = ptr;
+    line = source_code + ((uint64_t*)code_lines->array)[i];
+
+    end = (const char*)memchr(line, '\n', source_size - (uint64_t)(line - source_code));
+    if(end == NULL)
+        end = source_code + source_size;
+
+    *len = (int)(end - line);
+
+    return line;
+}
+
+char *source_map(const char *file, uint64_t *size)
+{
+    struct stat st;
+    long page;
+    uint64_t len;
+    char *code;
+    int fd;
+
+    TRACE("");
+
+    fd = open(file, O_RDONLY);
+    if(fd == -1)
+        ERROR("cannot open %s file\n", NULL, file);
+
+    if(fstat(fd, &st) == -1)
+    {
+        close(fd);
+        ERROR("fstat error\n", NULL, "");
     }
 
-    return 0;
+    /* code + 2 '\0', rest of last file page is zeroed by kernel */
+    page = sysconf(_SC_PAGESIZE);
+    *size = (uint64_t)st.st_size;
+    len = (*size + 2 + (uint64_t)page - 1) & ~((uint64_t)page - 1);
+
+    /* anonymous pages after file are zeroed too */
+    code = (char*)mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(code == MAP_FAILED)
+    {
+        close(fd);
+        ERROR("mmap error\n", NULL, "");
+    }
+
+    /* private mapping, lexer writes to buffer but never to file */
+    if(*size != 0 && mmap(code, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED)
+    {
+        munmap(code, len);
+        close(fd);
+        ERROR("mmap error\n", NULL, "");
+    }
+
+    close(fd);
+
+    return code;
+}
+
+void source_unmap(char *code, uint64_t size)
+{
+    long page;
+
+    TRACE("");
+
+    if(code == NULL)
+        return;
+
+    page = sysconf(_SC_PAGESIZE);
+    munmap(code, (size + 2 + (uint64_t)page - 1) & ~((uint64_t)page - 1));
 }
 
 void print_err(uint64_t fl, uint64_t ll, const char *msg, ...)
 {
     uint64_t i;
     va_list args;
+    const char *line;
+    int len;
 
     if(msg == NULL || fl > ll)
     {
@@ -67,7 +182,10 @@ void print_err(uint64_t fl, uint64_t ll, const char *msg, ...)
    	va_end(args);
 
     for(i = fl; i <= ll; ++i)
-        fprintf(stderr, "LINE: %ju\t\t%s\n", i + 1, ((char**)code_lines->array)[i]);
+    {
+        line = code_line(i, &len);
+        fprintf(stderr, "LINE: %ju\t\t%.*s\n", i + 1, len, line);
+    }
 
     fprintf(stderr, "%s\n", RESET);
 }
@@ -127,9 +245,9 @@ Pvar *pvar_create(char *name, uint8_t type, uint64_t array_len)
     if(name == NULL)
         ERROR("name == NULL\n", NULL, "");
 
-    pvar = (Pvar*)malloc(sizeof(Pvar));
+    pvar = (Pvar*)node_alloc(sizeof(Pvar));
     if(pvar == NULL)
-        ERROR("malloc error\n", NULL, "");
+        ERROR("node_alloc error\n", NULL, "");
 
     pvar->set = 0;
     pvar->used = 0;
@@ -142,8 +260,9 @@ Pvar *pvar_create(char *name, uint8_t type, uint64_t array_len)
 
     pvar->padding = 0;
 
-    if(asprintf(&pvar->name, "%s", name) == -1)
-        ERROR("asprintf error\n", NULL, "");
+    pvar->name = node_strdup(name);
+    if(pvar->name == NULL)
+        ERROR("node_strdup error\n", NULL, "");
 
     return pvar;
 }
@@ -159,8 +278,8 @@ void pvar_destroy(Pvar *pvar)
         return;
     }
 
-    FREE(pvar->name);
-    FREE(pvar);
+    NODE_FREE_STR(pvar->name);
+    NODE_FREE(pvar);
 }
 
 int pvar_cmp(void *pvar1, void *pvar2)
@@ -179,26 +298,41 @@ int pvar_cmp(void *pvar1, void *pvar2)
     return 0;
 }
 
-BOOL is_declared(char *name)
+uint64_t pvar_hash(void *pvar)
+{
+    return hashmap_hash_str((*(Pvar**)pvar)->name);
+}
+
+static int pvar_name_cmp(void *pvar, const void *name)
 {
-    Pvar *in;
+    return strcmp((*(Pvar**)pvar)->name, (const char*)name);
+}
 
-    BOOL ret;
+static Pvar **pvar_search_by_name(const char *name)
+{
+    return (Pvar**)hashmap_search_hash(variables, hashmap_hash_str(name), (const void*)name, pvar_name_cmp);
+}
 
+int pvars_sorted(Hashmap *vars, Pvar ***array, int *size)
+{
     TRACE("");
 
-    if(name == NULL)
-        ERROR("name == NULL\n", FALSE, "");
+    if(hashmap_to_array(vars, (void*)array, size))
+        ERROR("hashmap_to_array error\n", 1, "");
 
-    in = pvar_create(name, PTOKEN_VAR, 0);
-    if(in == NULL)
-        ERROR("pvar_create error\n", FALSE, "");
+    (void)pvar_sort(*array, *size);
 
-    ret = avl_key_exist(variables, (void*)&in);
+    return 0;
+}
+
+BOOL is_declared(char *name)
+{
+    TRACE("");
 
-    pvar_destroy(in);
+    if(name == NULL)
+        ERROR("name == NULL\n", FALSE, "");
 
-    return ret;
+    return pvar_search_by_name(name) != NULL;
 }
 
 char *pval_str(Pvalue *val)
@@ -220,7 +354,7 @@ void declare(uint8_t type, parser_token *token, uint64_t array_len)
     }
 
     /* double declaration */
-    if(avl_insert(variables, (void*)&pvar))
+    if(hashmap_insert(variables, (void*)&pvar))
     {
         YY_LOG("[YACC]\tdouble declaration\n", "");
 
@@ -228,7 +362,7 @@ void declare(uint8_t type, parser_token *token, uint64_t array_len)
 
         pvar_destroy(pvar);
 
-        exit(1);
+        compiler_exit(1);
     }
 
     if(type == PTOKEN_ARR && array_len == 0)
@@ -239,33 +373,167 @@ void declare(uint8_t type, parser_token *token, uint64_t array_len)
 
         pvar_destroy(pvar);
 
-        exit(1);
+        compiler_exit(1);
     }
 
 }
 
-void undeclare(char *name)
+static Value *var_value_create(const char *name)
 {
+    var_normal *vn;
+    Variable *var;
+    Value *val;
+
+    vn = var_normal_create(name);
+    if(vn == NULL)
+        ERROR("var_normal_create error\n", NULL, "");
+
+    var = variable_create(VAR_NORMAL, (void*)vn);
+    if(var == NULL)
+        ERROR("variable_create error\n", NULL, "");
+
+    val = value_create(VARIABLE, (void*)var);
+    if(val == NULL)
+        ERROR("value_create error\n", NULL, "");
+
+    return val;
+}
+
+Value *big_const_value(parser_token *token)
+{
+    char *name;
     Pvar *pvar;
+
+    mpz_t big;
+    const_value *cv;
+    Value *val;
+    Value *res;
+
+    token_expr *expr;
+    token_assign *tass;
+    Token *init;
+
+    TRACE("");
+
+    if(asprintf(&name, "%s%s", BIG_CONST_PREFIX, token->str) == -1)
+        ERROR("asprintf error\n", NULL, "");
+
+    /* the same literal has variable already */
+    if(is_declared(name))
+    {
+        res = var_value_create(name);
+        FREE(name);
+
+        return res;
+    }
+
+    pvar = pvar_create(name, PTOKEN_VAR, 0);
+    if(pvar == NULL)
+        ERROR("pvar_create error\n", NULL, "");
+
+    if(hashmap_insert(variables, (void*)&pvar))
+        ERROR("hashmap_insert error\n", NULL, "");
+
+    VAR_SET(pvar);
+    VAR_USE(pvar);
+
+    /* |BIG<literal> := literal */
+    if(mpz_init_set_str(big, token->str, 10))
+        ERROR("mpz_init_set_str error\n", NULL, "");
+
+    cv = const_bigvalue_create(big);
+    mpz_clear(big);
+
+    if(cv == NULL)
+        ERROR("const_bigvalue_create error\n", NULL, "");
+
+    val = value_create(CONST_VAL, (void*)cv);
+    if(val == NULL)
+        ERROR("value_create error\n", NULL, "");
+
+    res = var_value_create(name);
+    if(res == NULL)
+        ERROR("var_value_create error\n", NULL, "");
+
+    expr = token_expr_create(tokens_id.undefined, val, NULL);
+    if(expr == NULL)
+        ERROR("token_expr_create error\n", NULL, "");
+
+    tass = token_assign_create(res, expr);
+    if(tass == NULL)
+        ERROR("token_assign_create error\n", NULL, "");
+
+    init = token_create(TOKEN_ASSIGN, (void*)tass);
+    if(init == NULL)
+        ERROR("token_create error\n", NULL, "");
+
+    token_set_lines(init, token->line, token->line);
+
+    if(big_consts == NULL)
+    {
+        big_consts = vector_create(sizeof(Token*));
+        if(big_consts == NULL)
+            ERROR("vector_create error\n", NULL, "");
+    }
+
+    if(vector_insert_last(big_consts, (void*)&init))
+        ERROR("vector_insert_last error\n", NULL, "");
+
+    res = var_value_create(name);
+    FREE(name);
+
+    return res;
+}
+
+int big_consts_insert(Vector *tokens)
+{
+    Vector_iterator it;
+    Token *token;
+
+    TRACE("");
+
+    if(big_consts == NULL)
+        return 0;
+
+    /* from the last, so order of literals is kept */
+    for(  vector_iterator_init(big_consts, &it, ITI_END);
+        ! vector_iterator_end(&it);
+          vector_iterator_prev(&it))
+        {
+            vector_iterator_get_data(&it, (void*)&token);
+
+            if(vector_insert_first(tokens, (void*)&token))
+                ERROR("vector_insert_first error\n", 1, "");
+        }
+
+    vector_destroy(big_consts);
+    big_consts = NULL;
+
+    return 0;
+}
+
+void undeclare(char *name)
+{
+    Pvar **pvar;
     Pvar *out;
 
     TRACE("");
 
-    pvar = pvar_create(name, 0, 0);
+    pvar = pvar_search_by_name(name);
     if(pvar == NULL)
     {
-        LOG("pvar_create error\n", "");
+        LOG("var %s is not declared\n", name);
         return;
     }
 
-    avl_search(variables, (void*)&pvar, (void*)&out);
+    /* pvar points to node, so copy it before delete */
+    out = *pvar;
 
-    if(avl_delete(variables, (void*)&out))
+    if(hashmap_delete(variables, (void*)&out))
     {
         YY_LOG("[YACC]\tvar %s undeclared\n", name);
     }
 
-    pvar_destroy(pvar);
     pvar_destroy(out);
 
     return;
@@ -273,23 +541,18 @@ void undeclare(char *name)
 
 Pvar *pvar_get_by_name(char *name)
 {
-    Pvar *in;
-    Pvar *out;
+    Pvar **pvar;
 
     TRACE("");
 
     if(name == NULL)
         ERROR("name == NULL\n", NULL, "");
 
-    in = pvar_create(name, PTOKEN_VAR, 0);
-    if(in == NULL)
-        ERROR("pvar_create error\n", NULL, "");
-
-    avl_search(variables, (void*)&in, (void*)&out);
-
-    pvar_destroy(in);
+    pvar = pvar_search_by_name(name);
+    if(pvar == NULL)
+        ERROR("pvar %s doesn't exist\n", NULL, name);
 
-    return out;
+    return *pvar;
 }
 
 BOOL is_set(char *name)
@@ -443,7 +706,7 @@ void pval_check_use(Pvalue *val, uint64_t fl, uint64_t ll)
         {
             print_err(fl, ll, "variable undeclared:\t%s\n", name);
 
-            exit(1);
+            compiler_exit(1);
         }
 
         if( ! is_correct_use(name, type))
@@ -453,7 +716,7 @@ void pval_check_use(Pvalue *val, uint64_t fl, uint64_t ll)
             else
                 print_err(fl, ll, "wrong use, var is not an array:\t%s\n", name);
 
-            exit(1);
+            compiler_exit(1);
         }
 
         /* iff var is array we have another checks */
@@ -465,7 +728,7 @@ void pval_check_use(Pvalue *val, uint64_t fl, uint64_t ll)
                 print_err(fl, ll, "array member out of array range:\t%s[ %ju ]\n",
                             name, val->val->body.var->body.arr->offset);
 
-                exit(1);
+                compiler_exit(1);
             }
 
             /* iff array offset is another var check declaration of this var */
@@ -475,7 +738,7 @@ void pval_check_use(Pvalue *val, uint64_t fl, uint64_t ll)
                     print_err(fl, ll, "variable undeclared:\t%s\n",
                         val->val->body.var->body.arr->var_offset->name);
 
-                    exit(1);
+                    compiler_exit(1);
                 }
         }
     }
@@ -509,7 +772,7 @@ void pval_check_init(Pvalue *val, uint64_t fl, uint64_t ll)
         {
             print_err(fl, ll, "uninitialized variable:\t%s\n", name);
 
-            exit(1);
+            compiler_exit(1);
         }
     }
     else
@@ -520,7 +783,7 @@ void pval_check_init(Pvalue *val, uint64_t fl, uint64_t ll)
                 print_err(fl, ll, "uninitialized variable:\t%s\n",
                         val->val->body.var->body.arr->var_offset->name);
 
-                exit(1);
+                compiler_exit(1);
             }
     }
 }
@@ -557,7 +820,7 @@ void check_use_it(Value *it, Token *token, uint64_t fl, uint64_t ll)
                     {
                         print_err(fl, ll, "iterator overwrite:\t%s\n", variable_get_name(it->body.var));
 
-                        exit(1);
+                        compiler_exit(1);
                     }
                 break;
             }
@@ -571,7 +834,7 @@ void check_use_it(Value *it, Token *token, uint64_t fl, uint64_t ll)
 
                     print_err(fl, ll, "iterator overwrite:\t%s\n", variable_get_name(it->body.var));
 
-                    exit(1);
+                    compiler_exit(1);
                 }
 
                 break;
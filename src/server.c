@@ -0,0 +1,359 @@
+#include <server.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+/*
+    Parse request flags to options
+
+    PARAMS
+    @IN flags - '-' or letters a, e, t and optimalization digit
+    @OUT opt - options
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int flags_parse(const char *flags, Option *opt) __nonull__(1, 2);
+
+/*
+    Write error message of response
+
+    PARAMS
+    @OUT out - message ( don't forget to free ), NULL iff message can't be allocated
+    @OUT len - length of message, 0 iff message can't be allocated
+    @IN fmt - printf format of message
+
+    RETURN:
+    This is a void function
+*/
+static void message_set(char **out, size_t *len, const char *fmt, ...) __nonull__(1, 2, 3);
+
+/*
+    Compile one file and read generated code
+
+    PARAMS
+    @IN flags - request flags
+    @IN path - input file
+    @IN arena - compile arena of thread
+    @OUT out - generated code or error message ( don't forget to free )
+    @OUT len - length of out
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure ( out contains error message or NULL )
+*/
+static int server_compile(const char *flags, char *path, Arena *arena, char **out, size_t *len) __nonull__(1, 2, 3, 4, 5);
+
+/*
+    Serve requests until EOF, requests share one compile arena
+
+    PARAMS
+    @IN in - request stream
+    @IN out - response stream
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int serve(FILE *in, FILE *out) __nonull__(1, 2);
+
+/*
+    Connection thread, serve requests from socket and close it
+
+    PARAMS
+    @IN arg - socket descriptor
+
+    RETURN:
+    NULL
+*/
+static void *connection_thread(void *arg);
+
+static int flags_parse(const char *flags, Option *opt)
+{
+    TRACE("");
+
+    if(strcmp(flags, "-") == 0)
+        return 0;
+
+    for(; *flags; ++flags)
+        switch(*flags)
+        {
+            case 'a':
+            {
+                opt->wall = 1;
+                break;
+            }
+            case 'e':
+            {
+                opt->werr = 1;
+                break;
+            }
+            case 't':
+            {
+                opt->tokens = 1;
+                break;
+            }
+            case '0': case '1': case '2': case '3':
+            {
+                opt->optimal = (uint8_t)(*flags - '0');
+                break;
+            }
+            default:
+                ERROR("unknown flag %c\n", 1, *flags);
+        }
+
+    return 0;
+}
+
+static void message_set(char **out, size_t *len, const char *fmt, ...)
+{
+    va_list args;
+    int ret;
+
+    va_start(args, fmt);
+    ret = vasprintf(out, fmt, args);
+    va_end(args);
+
+    /* content of out is undefined after failure */
+    if(ret == -1)
+    {
+        *out = NULL;
+        *len = 0;
+    }
+    else
+        *len = (size_t)ret;
+}
+
+static int server_compile(const char *flags, char *path, Arena *arena, char **out, size_t *len)
+{
+    CompilerContext ctx;
+    char tmp[] = SERVER_TMP_TEMPLATE;
+    struct stat st;
+    ssize_t r;
+    size_t i;
+    int fd;
+
+    TRACE("");
+
+    *out = NULL;
+    *len = 0;
+
+    (void)memset(&ctx, 0, sizeof(ctx));
+    if(flags_parse(flags, &ctx.option))
+    {
+        message_set(out, len, "bad flags %s", flags);
+        return 1;
+    }
+
+    if(stat(path, &st))
+    {
+        message_set(out, len, "%s No such file", path);
+        return 1;
+    }
+
+    /* compiler writes code via file buffer, so give it private file */
+    fd = mkstemp(tmp);
+    if(fd == -1)
+    {
+        message_set(out, len, "cannot create temp file");
+        return 1;
+    }
+
+    ctx.option.input_file = path;
+    ctx.option.output_file = tmp;
+    ctx.arena = arena;
+
+    if(compile_context(&ctx))
+    {
+        close(fd);
+        (void)unlink(tmp);
+
+        message_set(out, len, "%s not compiled", path);
+        return 1;
+    }
+
+    /* output was truncated and written by compiler, read it by our descriptor */
+    if(fstat(fd, &st) || (*out = (char*)malloc((size_t)st.st_size + 1)) == NULL)
+    {
+        close(fd);
+        (void)unlink(tmp);
+
+        message_set(out, len, "cannot read output");
+        return 1;
+    }
+
+    for(i = 0; i < (size_t)st.st_size; i += (size_t)r)
+    {
+        r = pread(fd, *out + i, (size_t)st.st_size - i, (off_t)i);
+        if(r <= 0)
+            break;
+    }
+
+    close(fd);
+    (void)unlink(tmp);
+
+    *len = i;
+
+    return 0;
+}
+
+static int serve(FILE *in, FILE *out)
+{
+    char *line = NULL;
+    size_t size = 0;
+    ssize_t n;
+
+    char *flags;
+    char *path;
+    char *code;
+    const char *msg;
+    size_t len;
+    int ret;
+
+    Arena *arena;
+
+    TRACE("");
+
+    /* tokens and variables of requests are taken from this arena, it is reset after each request */
+    arena = arena_create();
+    if(arena == NULL)
+        ERROR("arena_create error\n", 1, "");
+
+    while((n = getline(&line, &size, in)) != -1)
+    {
+        if(n > 0 && line[n - 1] == '\n')
+            line[--n] = '\0';
+
+        /* COMPILE <flags> <path> */
+        flags = NULL;
+        path = NULL;
+        if(strncmp(line, SERVER_REQ_COMPILE " ", sizeof(SERVER_REQ_COMPILE)) == 0)
+        {
+            flags = line + sizeof(SERVER_REQ_COMPILE);
+            path = strchr(flags, ' ');
+        }
+
+        if(path == NULL)
+        {
+            message_set(&code, &len, "bad request");
+            ret = 1;
+        }
+        else
+        {
+            *path++ = '\0';
+            ret = server_compile(flags, path, arena, &code, &len);
+        }
+
+        msg = code;
+
+        /* framing needs length, so send fixed message */
+        if(ret && code == NULL)
+        {
+            msg = SERVER_MSG_NO_MEMORY;
+            len = sizeof(SERVER_MSG_NO_MEMORY) - 1;
+        }
+
+        fprintf(out, "%s %zu\n", ret ? SERVER_RES_ERROR : SERVER_RES_OK, len);
+        if(len)
+            (void)fwrite(msg, sizeof(char), len, out);
+
+        FREE(code);
+
+        if(fflush(out))
+            break;
+    }
+
+    FREE(line);
+    arena_destroy(arena);
+
+    return 0;
+}
+
+static void *connection_thread(void *arg)
+{
+    int fd = (int)(intptr_t)arg;
+    FILE *in;
+    FILE *out;
+
+    in = fdopen(fd, "r");
+    out = fdopen(dup(fd), "w");
+    if(in == NULL || out == NULL)
+    {
+        LOG("fdopen error\n", "");
+
+        if(in != NULL)
+            fclose(in);
+        else
+            close(fd);
+
+        if(out != NULL)
+            fclose(out);
+
+        return NULL;
+    }
+
+    (void)serve(in, out);
+
+    fclose(out);
+    fclose(in);
+
+    return NULL;
+}
+
+int server_run(const char *path)
+{
+    struct sockaddr_un addr;
+    pthread_attr_t attr;
+    pthread_t thread;
+    int sock;
+    int fd;
+
+    TRACE("");
+
+    if(strcmp(path, SERVER_STDIO) == 0)
+        return serve(stdin, stdout);
+
+    if(strlen(path) >= sizeof(addr.sun_path))
+        ERROR("socket path %s is too long\n", 1, path);
+
+    /* client can go away before response */
+    (void)signal(SIGPIPE, SIG_IGN);
+
+    sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(sock == -1)
+        ERROR("socket error\n", 1, "");
+
+    (void)memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    (void)strcpy(addr.sun_path, path);
+
+    (void)unlink(path);
+    if(bind(sock, (struct sockaddr*)&addr, sizeof(addr)) || listen(sock, SERVER_BACKLOG))
+    {
+        close(sock);
+        ERROR("cannot listen on %s\n", 1, path);
+    }
+
+    (void)pthread_attr_init(&attr);
+    (void)pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+
+    for(;;)
+    {
+        fd = accept(sock, NULL, NULL);
+        if(fd == -1)
+            continue;
+
+        if(pthread_create(&thread, &attr, connection_thread, (void*)(intptr_t)fd))
+        {
+            LOG("pthread_create error\n", "");
+            close(fd);
+        }
+    }
+
+    /* never reached */
+    return 0;
+}
@@ -0,0 +1,272 @@
+#include <time_report.h>
+#include <time.h>
+#include <stdarg.h>
+#include <sys/resource.h>
+
+/*
+    Author: Michal Kukowski
+    email: michalkukowski10@gmail.com
+*/
+
+/* libc functions, linker gives calls of compiler to __wrap_* ( see ALLOC_WRAP in Makefile ) */
+extern void *__real_malloc(size_t size);
+extern void *__real_calloc(size_t n, size_t size);
+extern void *__real_realloc(void *ptr, size_t size);
+extern char *__real_strdup(const char *str);
+extern void __real_free(void *ptr);
+
+__thread BOOL time_report_on = FALSE;
+
+/* heap allocations of thread, counted only with report */
+static __thread uint64_t heap_allocs = 0;
+static __thread uint64_t heap_frees = 0;
+static __thread uint64_t heap_bytes = 0;
+
+static __thread Phase_stat phases[PHASES_NUM];
+
+/* parts of code generation are printed under it */
+static const struct
+{
+    const char *name;
+    BOOL part;
+
+}phase_info[PHASES_NUM] =
+{
+    [PHASE_SOURCE]          = {"read source", FALSE},
+    [PHASE_PARSE]           = {"lexer and parser", FALSE},
+    [PHASE_SEMANTIC]        = {"semantic checks", FALSE},
+    [PHASE_OPTIMIZER]       = {"optimizer", FALSE},
+    [PHASE_MEM_SECTIONS]    = {"memory sections", FALSE},
+    [PHASE_ALLOC_VARIABLES] = {"alloc variables", FALSE},
+    [PHASE_CODEGEN]         = {"code generation", FALSE},
+    [PHASE_CODEGEN_ASSIGN]  = {"ASSIGN", TRUE},
+    [PHASE_CODEGEN_IO]      = {"READ / WRITE", TRUE},
+    [PHASE_CODEGEN_IF]      = {"IF", TRUE},
+    [PHASE_CODEGEN_WHILE]   = {"WHILE", TRUE},
+    [PHASE_CODEGEN_FOR]     = {"FOR", TRUE},
+    [PHASE_CODEGEN_GUARD]   = {"ELSE / END / SKIP", TRUE},
+    [PHASE_LABELS]          = {"label resolution", TRUE},
+    [PHASE_COST_REPORT]     = {"cost report", FALSE},
+    [PHASE_LAYOUT]          = {"code layout", FALSE},
+    [PHASE_MAPS]            = {"line and emitter maps", FALSE},
+    [PHASE_OUTPUT]          = {"output", FALSE}
+};
+
+/*
+    Get time of clock
+
+    PARAMS
+    @IN clock - clock id
+
+    RETURN:
+    Time in nanoseconds
+*/
+static __inline__ uint64_t clock_ns(clockid_t clock);
+
+/*
+    Get peak RSS of process
+
+    PARAMS
+    NO PARAMS
+
+    RETURN:
+    Peak RSS in KB
+*/
+static uint64_t max_rss_kb(void);
+
+/*
+    Print one row of table
+
+    PARAMS
+    @IN f - output stream
+    @IN name - name of row
+    @IN stat - stats of row
+
+    RETURN:
+    This is a void function
+*/
+static void row_print(FILE *f, const char *name, const Phase_stat *stat) __nonull__(1, 2, 3);
+
+static __inline__ uint64_t clock_ns(clockid_t clock)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(clock, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t max_rss_kb(void)
+{
+    struct rusage usage;
+
+    if(getrusage(RUSAGE_SELF, &usage))
+        return 0;
+
+    /* on linux ru_maxrss is in KB */
+    return (uint64_t)usage.ru_maxrss;
+}
+
+static void row_print(FILE *f, const char *name, const Phase_stat *stat)
+{
+    fprintf(f, "%-24s %8ju %10.2f %10.2f %10ju %12ju ", name, stat->calls,
+            (double)stat->wall_ns / 1000000.0, (double)stat->cpu_ns / 1000000.0,
+            stat->allocs, stat->alloc_bytes);
+
+    if(stat->max_rss_kb)
+        fprintf(f, "%12ju\n", stat->max_rss_kb);
+    else
+        fprintf(f, "%12s\n", "-");
+}
+
+void time_report_reset(BOOL on)
+{
+    TRACE("");
+
+    (void)memset(phases, 0, sizeof(phases));
+    time_report_on = on;
+}
+
+void time_report_begin(Phase_mark *mark)
+{
+    mark->wall_ns = clock_ns(CLOCK_MONOTONIC);
+    mark->cpu_ns = clock_ns(CLOCK_THREAD_CPUTIME_ID);
+    mark->allocs = heap_allocs;
+    mark->alloc_bytes = heap_bytes;
+    mark->frees = heap_frees;
+}
+
+void time_report_end(int phase, const Phase_mark *mark)
+{
+    Phase_stat *stat;
+
+    stat = &phases[phase];
+
+    ++stat->calls;
+    stat->wall_ns += clock_ns(CLOCK_MONOTONIC) - mark->wall_ns;
+    stat->cpu_ns += clock_ns(CLOCK_THREAD_CPUTIME_ID) - mark->cpu_ns;
+    stat->allocs += heap_allocs - mark->allocs;
+    stat->alloc_bytes += heap_bytes - mark->alloc_bytes;
+
+    /* getrusage for every token would be slower than code generation of token */
+    if( ! phase_info[phase].part )
+        stat->max_rss_kb = max_rss_kb();
+}
+
+int time_report_print(FILE *f, const char *file, const Phase_mark *total)
+{
+    Phase_stat sum;
+    Phase_mark now;
+    char name[32];
+    int i;
+
+    TRACE("");
+
+    time_report_begin(&now);
+
+    sum.calls = 1;
+    sum.wall_ns = now.wall_ns - total->wall_ns;
+    sum.cpu_ns = now.cpu_ns - total->cpu_ns;
+    sum.allocs = now.allocs - total->allocs;
+    sum.alloc_bytes = now.alloc_bytes - total->alloc_bytes;
+    sum.max_rss_kb = max_rss_kb();
+
+    /* jobs on other threads print own reports */
+    flockfile(f);
+
+    fprintf(f, "TIME REPORT: %s\n", file);
+    fprintf(f, "%-24s %8s %10s %10s %10s %12s %12s\n",
+            "phase", "calls", "wall ms", "cpu ms", "allocs", "alloc B", "max rss KB");
+
+    for(i = 0; i < PHASES_NUM; ++i)
+    {
+        if(phases[i].calls == 0)
+            continue;
+
+        if(phase_info[i].part)
+        {
+            snprintf(name, sizeof(name), "  %s", phase_info[i].name);
+            row_print(f, name, &phases[i]);
+        }
+        else
+            row_print(f, phase_info[i].name, &phases[i]);
+    }
+
+    row_print(f, "total", &sum);
+    fprintf(f, "heap frees: %ju\n", now.frees - total->frees);
+
+    funlockfile(f);
+
+    return 0;
+}
+
+/* called instead of libc functions by code linked with ALLOC_WRAP */
+void *__wrap_malloc(size_t size)
+{
+    if(time_report_on)
+    {
+        ++heap_allocs;
+        heap_bytes += size;
+    }
+
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t n, size_t size)
+{
+    if(time_report_on)
+    {
+        ++heap_allocs;
+        heap_bytes += n * size;
+    }
+
+    return __real_calloc(n, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    if(time_report_on)
+    {
+        ++heap_allocs;
+        heap_bytes += size;
+    }
+
+    return __real_realloc(ptr, size);
+}
+
+char *__wrap_strdup(const char *str)
+{
+    if(time_report_on)
+    {
+        ++heap_allocs;
+        heap_bytes += strlen(str) + 1;
+    }
+
+    return __real_strdup(str);
+}
+
+int __wrap_asprintf(char **str, const char *fmt, ...)
+{
+    va_list args;
+    int ret;
+
+    va_start(args, fmt);
+    ret = vasprintf(str, fmt, args);
+    va_end(args);
+
+    if(time_report_on && ret != -1)
+    {
+        ++heap_allocs;
+        heap_bytes += (uint64_t)ret + 1;
+    }
+
+    return ret;
+}
+
+void __wrap_free(void *ptr)
+{
+    if(time_report_on && ptr != NULL)
+        ++heap_frees;
+
+    __real_free(ptr);
+}
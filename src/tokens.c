@@ -1,4 +1,5 @@
 #include <tokens.h>
+#include <arena.h>
 
 token_id tokens_id =
 {
@@ -38,9 +39,9 @@ token_io *token_io_create(uint8_t type, Value *val)
         ERROR(  "(type != tokens_id.read && type != tokens_id.write) || val == NULL\n"
                 "|| (type == tokens_id.read && val->type != VARIABLE)\n", NULL, "");
 
-    token = (token_io*)malloc(sizeof(token_io));
+    token = (token_io*)node_alloc(sizeof(token_io));
     if(token == NULL)
-        ERROR("malloc error\n", NULL, "");
+        ERROR("node_alloc error\n", NULL, "");
 
     token->op = type;
     token->res = val;
@@ -60,7 +61,7 @@ void token_io_destroy(token_io *token)
 
     value_destroy(token->res);
 
-    FREE(token);
+    NODE_FREE(token);
 }
 
 void token_io_print(token_io *token)
@@ -123,9 +124,9 @@ token_guard *token_guard_create(uint8_t type)
                 "type != tokens_id.end_if && type != tokens_id.end_while"
                 "&& type != tokens_id.else_cond \n", NULL, "");
 
-    token = (token_guard*)malloc(sizeof(token_guard));
+    token = (token_guard*)node_alloc(sizeof(token_guard));
     if(token == NULL)
-        ERROR("malloc error\n", NULL, "");
+        ERROR("node_alloc error\n", NULL, "");
 
     token->type = type;
 
@@ -142,7 +143,7 @@ void token_guard_destroy(token_guard *token)
         return;
     }
 
-    FREE(token);
+    NODE_FREE(token);
 }
 
 void token_guard_print(token_guard *token)
@@ -202,9 +203,9 @@ token_expr *token_expr_create(uint8_t op, Value *left, Value *right)
                 "&& op != tokens_id.mod && op != tokens_id.div && op != tokens_id.undefined\n"
                 ") || left == NULL\n", NULL, "");
 
-    token = (token_expr*)malloc(sizeof(token_expr));
+    token = (token_expr*)node_alloc(sizeof(token_expr));
     if(token == NULL)
-        ERROR("malloc error\n", NULL, "");
+        ERROR("node_alloc error\n", NULL, "");
 
     token->op = op;
     token->left = left;
@@ -228,7 +229,7 @@ void token_expr_destroy(token_expr *token)
     if(token->op != tokens_id.undefined)
         value_destroy(token->right);
 
-    FREE(token);
+    NODE_FREE(token);
 }
 
 void token_expr_print(token_expr *token)
@@ -292,9 +293,9 @@ token_assign *token_assign_create(Value *res, token_expr *expr)
     if( res == NULL || expr == NULL )
         ERROR( " res == NULL || expr == NULL\n", NULL, "");
 
-    token = (token_assign*)malloc(sizeof(token_assign));
+    token = (token_assign*)node_alloc(sizeof(token_assign));
     if(token == NULL)
-        ERROR("malloc error\n", NULL, "");
+        ERROR("node_alloc error\n", NULL, "");
 
     token->res = res;
     token->expr = expr;
@@ -315,7 +316,7 @@ void token_assign_destroy(token_assign *token)
     value_destroy(token->res);
     token_expr_destroy(token->expr);
 
-    FREE(token);
+    NODE_FREE(token);
 }
 
 void token_assign_print(token_assign *token)
@@ -371,9 +372,9 @@ token_cond *token_cond_create(uint8_t r, Value *left, Value *right)
                 "&& r != tokens_id.gt && r != tokens_id.le && r != tokens_id.ge\n"
                 ")  || left == NULL || right == NULL\n", NULL, "");
 
-    token = (token_cond*)malloc(sizeof(token_cond));
+    token = (token_cond*)node_alloc(sizeof(token_cond));
     if(token == NULL)
-        ERROR("malloc error\n", NULL, "");
+        ERROR("node_alloc error\n", NULL, "");
 
     token->r = r;
     token->left = left;
@@ -395,7 +396,7 @@ void token_cond_destroy(token_cond *token)
     value_destroy(token->left);
     value_destroy(token->right);
 
-    FREE(token);
+    NODE_FREE(token);
 }
 
 void token_cond_print(token_cond *token)
@@ -445,9 +446,9 @@ token_if *token_if_create(token_cond *cond)
     if(cond == NULL)
         ERROR("cond == NULL\n", NULL, "");
 
-    token = (token_if*)malloc(sizeof(token_if));
+    token = (token_if*)node_alloc(sizeof(token_if));
     if(token == NULL)
-        ERROR("malloc error\n", NULL, "");
+        ERROR("node_alloc error\n", NULL, "");
 
     token->cond = cond;
 
@@ -467,7 +468,7 @@ void token_if_destroy(token_if *token)
 
     token_cond_destroy(token->cond);
 
-    FREE(token);
+    NODE_FREE(token);
 }
 
 void token_if_print(token_if *token)
@@ -510,9 +511,9 @@ token_while *token_while_create(token_cond *cond)
     if(cond == NULL)
         ERROR("cond == NULL\n", NULL, "");
 
-    token = (token_while*)malloc(sizeof(token_while));
+    token = (token_while*)node_alloc(sizeof(token_while));
     if(token == NULL)
-        ERROR("malloc error\n", NULL, "");
+        ERROR("node_alloc error\n", NULL, "");
 
     token->cond = cond;
 
@@ -531,7 +532,7 @@ void token_while_destroy(token_while *token)
 
     token_cond_destroy(token->cond);
 
-    FREE(token);
+    NODE_FREE(token);
 }
 
 void token_while_print(token_while *token)
@@ -581,9 +582,9 @@ token_for *token_for_create(uint8_t type, Value *it, Value *begin, Value *end)
                 "begin == NULL || end == NULL\n", NULL, "");
 
 
-    token = (token_for*)malloc(sizeof(token_for));
+    token = (token_for*)node_alloc(sizeof(token_for));
     if(token == NULL)
-        ERROR("malloc error\n", NULL, "");
+        ERROR("node_alloc error\n", NULL, "");
 
     token->type = type;
     token->iterator = it;
@@ -607,7 +608,7 @@ void token_for_destroy(token_for *token)
     value_destroy(token->begin_value);
     value_destroy(token->end_value);
 
-    FREE(token);
+    NODE_FREE(token);
 }
 
 void token_for_print(token_for *token)
@@ -679,11 +680,13 @@ Token *token_create(TOKEN_TYPE type, void *token)
     if(token == NULL)
         ERROR("token == NULL\n", NULL, "");
 
-    _token = (Token*)malloc(sizeof(Token));
+    _token = (Token*)node_alloc(sizeof(Token));
     if(_token == NULL)
-        ERROR("malloc error\n", NULL, "");
+        ERROR("node_alloc error\n", NULL, "");
 
     _token->type = type;
+    _token->first_line = 0;
+    _token->last_line = 0;
 
     switch(type)
     {
@@ -719,8 +722,6 @@ Token *token_create(TOKEN_TYPE type, void *token)
         }
         default:
         {
-            FREE(_token);
-
             ERROR("unrecognized token\n", NULL, "");
         }
     }
@@ -772,13 +773,13 @@ void token_destroy(Token *token)
         }
         default:
         {
-            FREE(token);
+            NODE_FREE(token);
 
             LOG("unrecognized token\n", "");
         }
     }
 
-    FREE(token);
+    NODE_FREE(token);
 }
 
 void token_print(Token *token)
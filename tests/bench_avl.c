@@ -0,0 +1,166 @@
+#include <avl.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+/*
+    Benchmark of AVL used by compiler: insert, search and iteration
+
+    Author: Michal Kukowski
+    email: michalkukowski10@gmail.com
+
+    Usage: bench_avl.out [number of elements] ( default 10^6 )
+*/
+
+#define BENCH_DEFAULT_N     1000000ull
+
+/* odd multiplier, so keys are unique and not sorted */
+#define BENCH_KEY(i)        ((uint64_t)(i) * 0x9E3779B97F4A7C15ull)
+
+/* compare keys in tree with key, the same order as key_cmp */
+#define KEY_CMP(data, key)  (*(data) < (key) ? -1 : *(data) > (key) ? 1 : 0)
+
+AVL_SEARCH_DEFINE(key_search, uint64_t, uint64_t, KEY_CMP)
+
+/*
+    Compare function of tree
+
+    PARAMS
+    @IN a - addr of first key
+    @IN b - addr of second key
+
+    RETURN:
+    -1 iff a < b
+    0 iff a == b
+    1 iff a > b
+*/
+static int key_cmp(void *a, void *b);
+
+/*
+    Get time in seconds
+
+    PARAMS
+    NO PARAMS
+
+    RETURN:
+    Monotonic time in seconds
+*/
+static double now(void);
+
+static int key_cmp(void *a, void *b)
+{
+    uint64_t _a = *(uint64_t*)a;
+    uint64_t _b = *(uint64_t*)b;
+
+    if(_a < _b)
+        return -1;
+
+    if(_a > _b)
+        return 1;
+
+    return 0;
+}
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv)
+{
+    Avl *tree;
+    Avl_iterator it;
+
+    uint64_t n = BENCH_DEFAULT_N;
+    uint64_t i;
+    uint64_t key;
+    uint64_t out;
+    uint64_t sum = 0;
+    uint64_t prev = 0;
+
+    double start;
+
+    if(argc > 1)
+        n = strtoull(argv[1], NULL, 10);
+
+    tree = avl_create(sizeof(uint64_t), key_cmp);
+    if(tree == NULL)
+        return 1;
+
+    printf("elements:       %ju\n", n);
+
+    start = now();
+    for(i = 0; i < n; ++i)
+    {
+        key = BENCH_KEY(i);
+        if(avl_insert(tree, (void*)&key))
+            return 1;
+    }
+    printf("insert:         %.3f s\n", now() - start);
+
+    start = now();
+    for(i = 0; i < n; ++i)
+    {
+        key = BENCH_KEY(i);
+        if(avl_search(tree, (void*)&key, (void*)&out))
+            return 1;
+
+        sum += out;
+    }
+    printf("search:         %.3f s\n", now() - start);
+
+    start = now();
+    for(i = 0; i < n; ++i)
+    {
+        if(key_search(tree, BENCH_KEY(i)) == NULL)
+            return 1;
+
+        sum += *key_search(tree, BENCH_KEY(i));
+    }
+    printf("search ( CMP ): %.3f s\n", (now() - start) / 2.0);
+
+    start = now();
+    for(  avl_iterator_init(tree, &it, ITI_BEGIN);
+        ! avl_iterator_end(&it);
+          avl_iterator_next(&it))
+        {
+            avl_iterator_get_data(&it, (void*)&out);
+
+            /* keys have to be sorted */
+            if(out < prev)
+                return 1;
+
+            prev = out;
+        }
+    printf("iteration:      %.3f s\n", now() - start);
+
+    start = now();
+    for(i = 0; i < n; i += 2)
+    {
+        key = BENCH_KEY(i);
+        if(avl_delete(tree, (void*)&key))
+            return 1;
+    }
+    for(i = 0; i < n; i += 2)
+    {
+        key = BENCH_KEY(i);
+        if(avl_insert(tree, (void*)&key))
+            return 1;
+    }
+    printf("delete+insert:  %.3f s ( half of elements )\n", now() - start);
+
+    start = now();
+    avl_destroy(tree);
+    printf("destroy:        %.3f s\n", now() - start);
+
+    /* sum is printed, so searches are not optimized out */
+    printf("checksum:       %ju\n", sum);
+
+    return 0;
+}
@@ -0,0 +1,553 @@
+#include <common.h>
+#include <getopt.h>
+#include <time.h>
+#include <sys/wait.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+
+/*
+    BENCHMARK OF COMPILER THROUGHPUT
+
+    Author: Michal Kukowski
+    email: michalkukowski10@gmail.com
+
+    Programs of growing size ( size is doubled in every step ) are generated by gen_program.out
+    and compiled by compiler.out in own process. For every size benchmark reports:
+        wall and cpu time of compiler, ratio of time to time of previous size,
+        peak memory ( max RSS ) and number of heap allocations.
+
+    Ratio near 2 means linear scaling, near 4 quadratic.
+    Allocations are taken from total of --time-report of compiler.
+
+    Results file format ( CSV ):
+
+    # comment
+    size,source_bytes,asm_lines,wall_us,cpu_us,max_rss_kb,allocs,frees,alloc_bytes
+*/
+
+#define BENCH_COMP_EXEC     "./compiler.out"
+#define BENCH_GEN_EXEC      "./gen_program.out"
+
+/* CPU seconds for compiler of one program */
+#define BENCH_TIMEOUT       300
+
+#define BENCH_DEFAULT_START 1000
+#define BENCH_DEFAULT_STEPS 6
+
+/* options of gen_program.out as strings, NULL iff default of generator */
+typedef struct Gen_options
+{
+    char *depth;
+    char *vars;
+    char *arrays;
+    char *array_size;
+    char *seed;
+
+}Gen_options;
+
+typedef struct Step
+{
+    uint64_t size;          /* commands in program */
+    uint64_t source_bytes;
+    uint64_t asm_lines;
+
+    uint64_t wall_us;
+    uint64_t cpu_us;
+    uint64_t max_rss_kb;
+
+    uint64_t allocs;
+    uint64_t frees;
+    uint64_t alloc_bytes;
+
+}Step;
+
+static const char *comp_exec = BENCH_COMP_EXEC;
+static const char *gen_exec = BENCH_GEN_EXEC;
+
+/*
+    Get monotonic time
+
+    PARAMS
+    NO PARAMS
+
+    RETURN:
+    Time in microseconds
+*/
+static uint64_t now_us(void);
+
+/*
+    Run process with stdout and stderr redirected to files and wait for it
+
+    PARAMS
+    @IN argv - argv of process, argv[0] is path to executable
+    @IN out - stdout of process ( NULL -> /dev/null )
+    @IN err - stderr of process ( NULL -> /dev/null )
+    @OUT us - wall time of process in microseconds
+    @OUT usage - resources used by process
+
+    RETURN:
+    0 iff process exited with 0
+    Non-zero value iff failure
+*/
+static int run_process(char *const argv[], const char *out, const char *err,
+                        uint64_t *us, struct rusage *usage) __nonull__(1, 4, 5);
+
+/*
+    Count lines in file
+
+    PARAMS
+    @IN path - path to file
+    @OUT lines - number of lines
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int file_lines(const char *path, uint64_t *lines) __nonull__(1, 2);
+
+/*
+    Read allocations from time report of compiler
+
+    PARAMS
+    @IN path - time report
+    @OUT step - step with allocations
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int report_read(const char *path, Step *step) __nonull__(1, 2);
+
+/*
+    Generate program of step size and compile it
+
+    PARAMS
+    @IN dir - temp directory for program and asm
+    @IN gen - options of generator
+    @IN/OUT step - step with size, results are set
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int step_run(const char *dir, const Gen_options *gen, Step *step) __nonull__(1, 2, 3);
+
+/*
+    Write results to file in CSV
+
+    PARAMS
+    @IN file - results file
+    @IN steps - steps
+    @IN n - number of steps
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int results_write(const char *file, Step *steps, int n) __nonull__(1, 2);
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000ull + (uint64_t)ts.tv_nsec / 1000ull;
+}
+
+static int run_process(char *const argv[], const char *out, const char *err,
+                        uint64_t *us, struct rusage *usage)
+{
+    struct rlimit limit;
+    pid_t pid;
+    int status;
+    int fd;
+    uint64_t start;
+
+    TRACE("");
+
+    start = now_us();
+
+    pid = fork();
+    if(pid == -1)
+        ERROR("fork error\n", 1, "");
+
+    if(pid == 0)
+    {
+        limit.rlim_cur = BENCH_TIMEOUT;
+        limit.rlim_max = BENCH_TIMEOUT;
+        (void)setrlimit(RLIMIT_CPU, &limit);
+
+        fd = open(out == NULL ? "/dev/null" : out, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if(fd == -1 || dup2(fd, STDOUT_FILENO) == -1)
+            _exit(127);
+
+        close(fd);
+
+        fd = open(err == NULL ? "/dev/null" : err, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if(fd == -1 || dup2(fd, STDERR_FILENO) == -1)
+            _exit(127);
+
+        close(fd);
+
+        execv(argv[0], argv);
+        _exit(127);
+    }
+
+    if(wait4(pid, &status, 0, usage) == -1)
+        ERROR("wait4 error\n", 1, "");
+
+    *us = now_us() - start;
+
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0 ? 0 : 1;
+}
+
+static int file_lines(const char *path, uint64_t *lines)
+{
+    FILE *f;
+    int c;
+
+    TRACE("");
+
+    f = fopen(path, "re");
+    if(f == NULL)
+        ERROR("cannot open %s\n", 1, path);
+
+    *lines = 0;
+    while((c = getc_unlocked(f)) != EOF)
+        if(c == '\n')
+            ++*lines;
+
+    fclose(f);
+
+    return 0;
+}
+
+static int report_read(const char *path, Step *step)
+{
+    FILE *f;
+    char line[256];
+    int found = 0;
+
+    TRACE("");
+
+    f = fopen(path, "re");
+    if(f == NULL)
+        ERROR("cannot open %s\n", 1, path);
+
+    /* total     calls wall cpu allocs alloc_bytes max_rss */
+    while(fgets(line, sizeof(line), f) != NULL)
+    {
+        if(sscanf(line, "total %*u %*f %*f %ju %ju", &step->allocs, &step->alloc_bytes) == 2)
+            ++found;
+        else if(sscanf(line, "heap frees: %ju", &step->frees) == 1)
+            ++found;
+    }
+
+    fclose(f);
+
+    return found == 2 ? 0 : 1;
+}
+
+static int step_run(const char *dir, const Gen_options *gen, Step *step)
+{
+    char *program = NULL;
+    char *asm_file = NULL;
+    char *report = NULL;
+    char size[32];
+    char *gen_argv[14];
+    char *comp_argv[7];
+    int argc = 0;
+    int ret = 1;
+    uint64_t us;
+    struct rusage usage;
+    struct stat st;
+
+    TRACE("");
+
+    if(asprintf(&program, "%s/program", dir) == -1 || asprintf(&asm_file, "%s/asm", dir) == -1
+        || asprintf(&report, "%s/report", dir) == -1)
+        goto clean;
+
+    snprintf(size, sizeof(size), "%ju", step->size);
+
+    gen_argv[argc++] = (char*)gen_exec;
+    gen_argv[argc++] = "--size";
+    gen_argv[argc++] = size;
+
+    if(gen->depth != NULL)
+    {
+        gen_argv[argc++] = "--depth";
+        gen_argv[argc++] = gen->depth;
+    }
+
+    if(gen->vars != NULL)
+    {
+        gen_argv[argc++] = "--vars";
+        gen_argv[argc++] = gen->vars;
+    }
+
+    if(gen->arrays != NULL)
+    {
+        gen_argv[argc++] = "--arrays";
+        gen_argv[argc++] = gen->arrays;
+    }
+
+    if(gen->array_size != NULL)
+    {
+        gen_argv[argc++] = "--array-size";
+        gen_argv[argc++] = gen->array_size;
+    }
+
+    if(gen->seed != NULL)
+    {
+        gen_argv[argc++] = "--seed";
+        gen_argv[argc++] = gen->seed;
+    }
+
+    gen_argv[argc] = NULL;
+
+    if(run_process(gen_argv, program, NULL, &us, &usage))
+    {
+        fprintf(stderr, "%sERROR: %s failed%s\n", RED, gen_exec, RESET);
+        goto clean;
+    }
+
+    if(stat(program, &st))
+        goto clean;
+
+    step->source_bytes = (uint64_t)st.st_size;
+
+    comp_argv[0] = (char*)comp_exec;
+    comp_argv[1] = "--input";
+    comp_argv[2] = program;
+    comp_argv[3] = "--output";
+    comp_argv[4] = asm_file;
+    comp_argv[5] = "--time-report";
+    comp_argv[6] = NULL;
+
+    if(run_process(comp_argv, NULL, report, &step->wall_us, &usage))
+    {
+        fprintf(stderr, "%sERROR: %s failed on program of size %ju, program in %s%s\n",
+                RED, comp_exec, step->size, program, RESET);
+        goto clean;
+    }
+
+    step->cpu_us = (uint64_t)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000ull
+                    + (uint64_t)(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+
+    /* on linux ru_maxrss is in KB */
+    step->max_rss_kb = (uint64_t)usage.ru_maxrss;
+
+    if(file_lines(asm_file, &step->asm_lines))
+        goto clean;
+
+    if(report_read(report, step))
+    {
+        fprintf(stderr, "%sERROR: no time report in %s%s\n", RED, report, RESET);
+        goto clean;
+    }
+
+    (void)unlink(program);
+    (void)unlink(asm_file);
+    (void)unlink(report);
+
+    ret = 0;
+
+clean:
+    FREE(program);
+    FREE(asm_file);
+    FREE(report);
+
+    return ret;
+}
+
+static int results_write(const char *file, Step *steps, int n)
+{
+    FILE *f;
+    int i;
+
+    TRACE("");
+
+    f = fopen(file, "w");
+    if(f == NULL)
+        ERROR("cannot open %s\n", 1, file);
+
+    fprintf(f, "# size,source_bytes,asm_lines,wall_us,cpu_us,max_rss_kb,allocs,frees,alloc_bytes\n");
+
+    for(i = 0; i < n; ++i)
+        fprintf(f, "%ju,%ju,%ju,%ju,%ju,%ju,%ju,%ju,%ju\n", steps[i].size, steps[i].source_bytes,
+                steps[i].asm_lines, steps[i].wall_us, steps[i].cpu_us, steps[i].max_rss_kb,
+                steps[i].allocs, steps[i].frees, steps[i].alloc_bytes);
+
+    fclose(f);
+
+    return 0;
+}
+
+void usage()
+{
+    printf( "Benchmark of compiler throughput on generated programs\n\n"
+            "ARGS:\n"
+            "OPTIONAL:\n"
+            "--start[-n]\t\tnumber of commands in first program ( default %d )\n"
+            "--steps[-k]\t\tnumber of programs, size is doubled in every step ( default %d )\n"
+            "--depth[-d]\t\tmax nesting of IF, FOR and WHILE ( default of generator )\n"
+            "--vars[-v]\t\tnumber of variables ( default of generator )\n"
+            "--arrays[-a]\t\tnumber of arrays ( default of generator )\n"
+            "--array-size[-l]\tsize of array ( default of generator )\n"
+            "--seed[-s]\t\tseed of generator\n"
+            "--results[-r]\t\twrite results in CSV to file\n"
+            "--compiler[-c]\t\tcompiler executable ( default %s )\n"
+            "--generator[-g]\t\tgenerator executable ( default %s )\n\n"
+            "Examples:\n"
+            "./bench_compiler.out\n"
+            "./bench_compiler.out --start 500 --steps 8 --depth 6 --results bench.csv\n\n",
+            BENCH_DEFAULT_START, BENCH_DEFAULT_STEPS, BENCH_COMP_EXEC, BENCH_GEN_EXEC);
+
+    exit(0);
+}
+
+int main(int argc, char **argv)
+{
+	static struct option long_option[] =
+	{
+        {"start",       required_argument,  0,  'n'},
+        {"steps",       required_argument,  0,  'k'},
+        {"depth",       required_argument,  0,  'd'},
+        {"vars",        required_argument,  0,  'v'},
+        {"arrays",      required_argument,  0,  'a'},
+        {"array-size",  required_argument,  0,  'l'},
+        {"seed",        required_argument,  0,  's'},
+        {"results",     required_argument,  0,  'r'},
+        {"compiler",    required_argument,  0,  'c'},
+        {"generator",   required_argument,  0,  'g'},
+        {"help",        no_argument,        0,  'h'},
+		{NULL,		    0,				    0,	'\0'}
+
+    };
+
+    char tmp[] = "/tmp/flatt_bench_XXXXXX";
+    Gen_options gen = {NULL, NULL, NULL, NULL, NULL};
+    Step *steps;
+    char *results = NULL;
+    uint64_t start = BENCH_DEFAULT_START;
+    int nsteps = BENCH_DEFAULT_STEPS;
+    int done = 0;
+    int opt;
+    int i;
+
+    while ((opt = getopt_long_only(argc, argv, "n:k:d:v:a:l:s:r:c:g:h", long_option, NULL )) != -1)
+    {
+        switch(opt)
+        {
+            case 'n':
+            {
+                start = strtoull(argv[optind - 1], NULL, 10);
+                break;
+            }
+            case 'k':
+            {
+                nsteps = atoi(argv[optind - 1]);
+                break;
+            }
+            case 'd':
+            {
+                gen.depth = argv[optind - 1];
+                break;
+            }
+            case 'v':
+            {
+                gen.vars = argv[optind - 1];
+                break;
+            }
+            case 'a':
+            {
+                gen.arrays = argv[optind - 1];
+                break;
+            }
+            case 'l':
+            {
+                gen.array_size = argv[optind - 1];
+                break;
+            }
+            case 's':
+            {
+                gen.seed = argv[optind - 1];
+                break;
+            }
+            case 'r':
+            {
+                results = argv[optind - 1];
+                break;
+            }
+            case 'c':
+            {
+                comp_exec = argv[optind - 1];
+                break;
+            }
+            case 'g':
+            {
+                gen_exec = argv[optind - 1];
+                break;
+            }
+            default:
+            {
+                usage();
+            }
+        }
+    }
+
+    if(start == 0 || nsteps <= 0)
+        usage();
+
+    steps = (Step*)calloc((size_t)nsteps, sizeof(Step));
+    if(steps == NULL)
+        ERROR("calloc error\n", 1, "");
+
+    if(mkdtemp(tmp) == NULL)
+    {
+        FREE(steps);
+        ERROR("mkdtemp error\n", 1, "");
+    }
+
+    printf("%10s %12s %10s %12s %12s %8s %12s %12s %14s\n",
+            "size", "source B", "asm lines", "wall ms", "cpu ms", "x prev", "max rss KB", "allocs", "alloc B");
+
+    for(i = 0; i < nsteps; ++i)
+    {
+        steps[i].size = start << i;
+
+        if(step_run(tmp, &gen, &steps[i]))
+            break;
+
+        ++done;
+
+        printf("%10ju %12ju %10ju %12.2f %12.2f ", steps[i].size, steps[i].source_bytes,
+                steps[i].asm_lines, (double)steps[i].wall_us / 1000.0, (double)steps[i].cpu_us / 1000.0);
+
+        if(i > 0 && steps[i - 1].wall_us > 0)
+            printf("%8.2f ", (double)steps[i].wall_us / (double)steps[i - 1].wall_us);
+        else
+            printf("%8s ", "-");
+
+        printf("%12ju %12ju %14ju\n", steps[i].max_rss_kb, steps[i].allocs, steps[i].alloc_bytes);
+
+        fflush(stdout);
+    }
+
+    /* files of failed step are kept */
+    if(done == nsteps)
+        (void)rmdir(tmp);
+
+    if(results != NULL && done > 0)
+        if(results_write(results, steps, done))
+        {
+            FREE(steps);
+            return 1;
+        }
+
+    FREE(steps);
+
+    return done == nsteps ? 0 : 1;
+}
@@ -0,0 +1,50 @@
+#!/bin/bash
+
+# Throughput of compile server against one compiler process per file
+# Compiles every tests/asm_correct/exN program $1 times ( default 5 )
+# Author Michal Kukowski
+
+ROUNDS=${1:-5}
+DIR=$(mktemp -d)
+SOCK=$DIR/flatt.sock
+
+for i in $(seq 1 $ROUNDS); do
+	for f in tests/asm_correct/ex*; do
+		cp $f $DIR/r${i}_$(basename $f)
+	done
+done
+
+# only programs which compile, crash of one request would stop the server
+FILES=""
+for f in $(ls $DIR/r*_ex*); do
+	(./compiler.out --input $f --output $f.asm) >/dev/null 2>&1 && FILES="$FILES $f"
+done
+N=$(echo $FILES | wc -w)
+
+# one process per file
+START=$(date +%s.%N)
+for f in $FILES; do
+	./compiler.out --input $f --output $f.asm 2>/dev/null
+done
+END=$(date +%s.%N)
+PROC=$(awk "BEGIN { print $END - $START }")
+
+# one server, one client connection for all files
+./compiler.out --server $SOCK 2>/dev/null &
+SERVER=$!
+while [ ! -S $SOCK ]; do
+	sleep 0.01
+done
+
+START=$(date +%s.%N)
+./client.out --socket $SOCK $FILES 2>/dev/null
+END=$(date +%s.%N)
+SERV=$(awk "BEGIN { print $END - $START }")
+
+kill $SERVER
+rm -rf $DIR
+
+echo "files:              $N"
+echo "process per file:   ${PROC}s"
+echo "server:             ${SERV}s"
+echo "speedup:            $(awk "BEGIN { printf \"%.2f\", $PROC / $SERV }")x"
@@ -0,0 +1,346 @@
+#include <sort.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+/*
+    Benchmark of sorts from darray lib on integers with different distributions,
+    every result is compared with result of qsort from libc
+
+    Author: Michal Kukowski
+    email: michalkukowski10@gmail.com
+
+    Usage: bench_sort.out [number of elements] ( default 10^6 )
+*/
+
+#define BENCH_DEFAULT_N     1000000
+
+/* number of different keys in few_unique */
+#define BENCH_FEW_UNIQUE    16
+
+/* length of run in sawtooth */
+#define BENCH_SAWTOOTH      1000
+
+/* every BENCH_NEARLY element is swapped in nearly sorted */
+#define BENCH_NEARLY        100
+
+#define ARRAY_SIZE(A)       (sizeof(A) / sizeof((A)[0]))
+
+#define KEY_LESS(a, b)      ( *(a) < *(b) )
+
+SORT_DEFINE(key_sort, uint64_t, KEY_LESS)
+
+typedef struct Distribution
+{
+    const char *name;
+    void (*fill)(uint64_t *t, int n);
+}Distribution;
+
+typedef struct Algorithm
+{
+    const char *name;
+    int (*sort)(uint64_t *t, int n);
+}Algorithm;
+
+static uint64_t rand_state;
+
+/*
+    Pseudo random number ( xorshift64 ), the same sequence in every run
+
+    PARAMS
+    NO PARAMS
+
+    RETURN:
+    Pseudo random number
+*/
+static uint64_t bench_rand(void);
+
+/*
+    Compare function of sorts
+
+    PARAMS
+    @IN a - addr of first key
+    @IN b - addr of second key
+
+    RETURN:
+    -1 iff a < b
+    0 iff a == b
+    1 iff a > b
+*/
+static int key_cmp(void *a, void *b);
+
+/*
+    Get time in seconds
+
+    PARAMS
+    NO PARAMS
+
+    RETURN:
+    Monotonic time in seconds
+*/
+static double now(void);
+
+/*
+    qsort wrapper of key_cmp
+*/
+static int qsort_cmp(const void *a, const void *b);
+
+/*
+    Fill array @t of @n elements with distribution
+*/
+static void fill_random(uint64_t *t, int n);
+static void fill_sorted(uint64_t *t, int n);
+static void fill_reversed(uint64_t *t, int n);
+static void fill_few_unique(uint64_t *t, int n);
+static void fill_organ_pipe(uint64_t *t, int n);
+static void fill_sawtooth(uint64_t *t, int n);
+static void fill_nearly_sorted(uint64_t *t, int n);
+
+/*
+    Sort array @t of @n elements, 0 iff success
+*/
+static int run_qsort(uint64_t *t, int n);
+static int run_quicksort(uint64_t *t, int n);
+static int run_mergesort(uint64_t *t, int n);
+static int run_heapsort(uint64_t *t, int n);
+static int run_introsort(uint64_t *t, int n);
+static int run_sort(uint64_t *t, int n);
+static int run_radixsort(uint64_t *t, int n);
+static int run_typed(uint64_t *t, int n);
+
+static uint64_t bench_rand(void)
+{
+    rand_state ^= rand_state << 13;
+    rand_state ^= rand_state >> 7;
+    rand_state ^= rand_state << 17;
+
+    return rand_state;
+}
+
+static int key_cmp(void *a, void *b)
+{
+    uint64_t _a = *(uint64_t*)a;
+    uint64_t _b = *(uint64_t*)b;
+
+    if(_a < _b)
+        return -1;
+
+    if(_a > _b)
+        return 1;
+
+    return 0;
+}
+
+static int qsort_cmp(const void *a, const void *b)
+{
+    return key_cmp((void*)a, (void*)b);
+}
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void fill_random(uint64_t *t, int n)
+{
+    int i;
+
+    for(i = 0; i < n; ++i)
+        t[i] = bench_rand();
+}
+
+static void fill_sorted(uint64_t *t, int n)
+{
+    int i;
+
+    for(i = 0; i < n; ++i)
+        t[i] = (uint64_t)i;
+}
+
+static void fill_reversed(uint64_t *t, int n)
+{
+    int i;
+
+    for(i = 0; i < n; ++i)
+        t[i] = (uint64_t)(n - i);
+}
+
+static void fill_few_unique(uint64_t *t, int n)
+{
+    int i;
+
+    for(i = 0; i < n; ++i)
+        t[i] = bench_rand() % BENCH_FEW_UNIQUE;
+}
+
+static void fill_organ_pipe(uint64_t *t, int n)
+{
+    int i;
+
+    for(i = 0; i < n; ++i)
+        t[i] = (uint64_t)(i < n / 2 ? i : n - i);
+}
+
+static void fill_sawtooth(uint64_t *t, int n)
+{
+    int i;
+
+    for(i = 0; i < n; ++i)
+        t[i] = (uint64_t)(i % BENCH_SAWTOOTH);
+}
+
+static void fill_nearly_sorted(uint64_t *t, int n)
+{
+    uint64_t temp;
+    int i;
+    int j;
+
+    fill_sorted(t, n);
+    for(i = 0; i < n; i += BENCH_NEARLY)
+    {
+        j = (int)(bench_rand() % (uint64_t)n);
+
+        temp = t[i];
+        t[i] = t[j];
+        t[j] = temp;
+    }
+}
+
+static int run_qsort(uint64_t *t, int n)
+{
+    qsort(t, (size_t)n, sizeof(uint64_t), qsort_cmp);
+
+    return 0;
+}
+
+static int run_quicksort(uint64_t *t, int n)
+{
+    return QUICKSORT(t, n, key_cmp, uint64_t);
+}
+
+static int run_mergesort(uint64_t *t, int n)
+{
+    return MERGESORT(t, n, key_cmp, uint64_t);
+}
+
+static int run_heapsort(uint64_t *t, int n)
+{
+    return HEAPSORT(t, n, key_cmp, uint64_t);
+}
+
+static int run_introsort(uint64_t *t, int n)
+{
+    return INTROSORT(t, n, key_cmp, uint64_t);
+}
+
+static int run_sort(uint64_t *t, int n)
+{
+    return SORT(t, n, key_cmp, uint64_t);
+}
+
+static int run_radixsort(uint64_t *t, int n)
+{
+    return RADIXSORT(t, n, uint64_t, FALSE);
+}
+
+static int run_typed(uint64_t *t, int n)
+{
+    return key_sort(t, n);
+}
+
+int main(int argc, char **argv)
+{
+    const Distribution dists[] =
+    {
+        {"random", fill_random},
+        {"sorted", fill_sorted},
+        {"reversed", fill_reversed},
+        {"few_unique", fill_few_unique},
+        {"organ_pipe", fill_organ_pipe},
+        {"sawtooth", fill_sawtooth},
+        {"nearly_sorted", fill_nearly_sorted}
+    };
+
+    const Algorithm algos[] =
+    {
+        {"qsort", run_qsort},
+        {"quicksort", run_quicksort},
+        {"mergesort", run_mergesort},
+        {"heapsort", run_heapsort},
+        {"introsort", run_introsort},
+        {"sort", run_sort},
+        {"radix", run_radixsort},
+        {"typed", run_typed}
+    };
+
+    uint64_t *input;
+    uint64_t *expected;
+    uint64_t *t;
+
+    int n = BENCH_DEFAULT_N;
+    size_t d;
+    size_t a;
+
+    double start;
+
+    if(argc > 1)
+        n = atoi(argv[1]);
+
+    if(n < 1)
+        return 1;
+
+    input = (uint64_t*)malloc((size_t)n * sizeof(uint64_t));
+    expected = (uint64_t*)malloc((size_t)n * sizeof(uint64_t));
+    t = (uint64_t*)malloc((size_t)n * sizeof(uint64_t));
+    if(input == NULL || expected == NULL || t == NULL)
+        return 1;
+
+    printf("elements: %d, time in seconds\n\n", n);
+
+    printf("%-14s", "");
+    for(a = 0; a < ARRAY_SIZE(algos); ++a)
+        printf("%11s", algos[a].name);
+    printf("\n");
+
+    for(d = 0; d < ARRAY_SIZE(dists); ++d)
+    {
+        rand_state = 0x9E3779B97F4A7C15ull;
+        dists[d].fill(input, n);
+
+        memcpy(expected, input, (size_t)n * sizeof(uint64_t));
+        if(run_qsort(expected, n))
+            return 1;
+
+        printf("%-14s", dists[d].name);
+        for(a = 0; a < ARRAY_SIZE(algos); ++a)
+        {
+            memcpy(t, input, (size_t)n * sizeof(uint64_t));
+
+            start = now();
+            if(algos[a].sort(t, n))
+                return 1;
+            printf("%11.3f", now() - start);
+            fflush(stdout);
+
+            if(memcmp(t, expected, (size_t)n * sizeof(uint64_t)))
+            {
+                printf("\n%s: wrong result on %s\n", algos[a].name, dists[d].name);
+                return 1;
+            }
+        }
+        printf("\n");
+    }
+
+    free(input);
+    free(expected);
+    free(t);
+
+    return 0;
+}
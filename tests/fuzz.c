@@ -0,0 +1,852 @@
+#include <common.h>
+#include <getopt.h>
+#include <time.h>
+#include <sys/wait.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+
+/*
+    DIFFERENTIAL FUZZER OF COMPILER
+
+    Author: Michal Kukowski
+    email: michalkukowski10@gmail.com
+
+    Every case is a random program from gen_program.out ( seed of case ) with random input.
+    Reference output is taken from evaluator of token list ( compiler.out --eval ),
+    then program is compiled and run by interpreter, outputs must be the same.
+    Evaluator runs tokens from parser, so -O is given only to compiler.
+    Evaluator and compiler are separate options, so older compiler can be checked too.
+
+    Case status:
+        PASSED      outputs are the same
+        FAILED      outputs are different ( miscompile )
+        COMPILE     evaluator runs program, but compiler failed
+        ERROR       interpreter failed ( i.e timeout ) or fuzzer error
+        SKIPPED     evaluator failed, program is not a valid case
+
+    Files of not passed case are kept in temp directory, case is repeated by the same
+    seed and options ( --seed S --cases 1 ).
+
+    Cost of program from interpreter can be compared with results of older compiler
+    ( --baseline ), case is regression iff its cost is bigger by more than threshold.
+
+    Results file format ( CSV ):
+
+    # comment
+    seed,status,compile_us,run_us,cost
+*/
+
+#define FUZZ_COMP_EXEC      "./compiler.out"
+#define FUZZ_EVAL_EXEC      "./compiler.out"
+#define FUZZ_INT_EXEC       "./interpreter-cln.out"
+#define FUZZ_GEN_EXEC       "./gen_program.out"
+
+/* CPU seconds for evaluator, compiler and interpreter of one case */
+#define FUZZ_TIMEOUT        30
+
+#define FUZZ_DEFAULT_CASES  100
+#define FUZZ_DEFAULT_SIZE   40
+#define FUZZ_DEFAULT_VARS   8
+
+/* input numbers are small ( loops, indexes ) or big ( up to 2^FUZZ_BIG_BITS ) */
+#define FUZZ_SMALL_MAX      100
+#define FUZZ_BIG_BITS       40
+
+/* default threshold of cost regression in % */
+#define FUZZ_THRESHOLD      1.0
+
+#define CASE_PASSED     0
+#define CASE_FAILED     1
+#define CASE_COMPILE    2
+#define CASE_ERROR      3
+#define CASE_SKIPPED    4
+#define CASE_STATUS_NUM 5
+
+/* options of gen_program.out as strings, NULL iff default of generator */
+typedef struct Gen_options
+{
+    char *size;
+    char *depth;
+    char *vars;
+    char *arrays;
+    char *array_size;
+
+}Gen_options;
+
+typedef struct Case
+{
+    uint64_t seed;
+
+    int status;
+    uint64_t compile_us;
+    uint64_t run_us;
+    uint64_t cost;
+
+    char *tmp_dir; /* NULL iff case passed */
+
+}Case;
+
+static const char *status_str[] = {"PASSED", "FAILED", "COMPILE", "ERROR", "SKIPPED"};
+
+static const char *comp_exec = FUZZ_COMP_EXEC;
+static const char *eval_exec = FUZZ_EVAL_EXEC;
+static const char *int_exec = FUZZ_INT_EXEC;
+static const char *gen_exec = FUZZ_GEN_EXEC;
+
+/* -O of compiler, evaluator runs tokens before optimizer, NULL iff not used */
+static char *optimal = NULL;
+
+static uint64_t rand_state;
+
+/*
+    Get monotonic time
+
+    PARAMS
+    NO PARAMS
+
+    RETURN:
+    Time in microseconds
+*/
+static uint64_t now_us(void);
+
+/*
+    Pseudo random number ( xorshift64 ), the same sequence for the same seed
+
+    PARAMS
+    NO PARAMS
+
+    RETURN:
+    Pseudo random number
+*/
+static uint64_t fuzz_rand(void);
+
+/*
+    Run process with redirected streams and wait for it
+
+    PARAMS
+    @IN argv - argv of process, argv[0] is path to executable
+    @IN in - file for stdin ( NULL -> /dev/null )
+    @IN out - file for stdout ( NULL -> /dev/null )
+    @IN err - file for stderr ( NULL -> /dev/null )
+    @OUT us - wall time of process
+
+    RETURN:
+    0 iff process exited with 0
+    Non-zero value iff failure
+*/
+static int run_process(char *const argv[], const char *in, const char *out, const char *err,
+                        uint64_t *us) __nonull__(1, 5);
+
+/*
+    Read whole file
+
+    PARAMS
+    @IN path - path to file
+    @OUT len - length of data
+
+    RETURN:
+    NULL iff failure
+    Pointer to data iff success
+*/
+static char *file_read(const char *path, size_t *len) __nonull__(1, 2);
+
+/*
+    Write random input of case: one number for every variable
+
+    PARAMS
+    @IN path - input file
+    @IN vars - number of variables
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int input_write(const char *path, int vars) __nonull__(1);
+
+/*
+    Get cost of program from messages of interpreter
+
+    PARAMS
+    @IN path - stderr of interpreter
+
+    RETURN:
+    Cost of program ( 0 iff program didn't finish )
+*/
+static uint64_t cost_read(const char *path) __nonull__(1);
+
+/*
+    Generate, evaluate, compile and run one case
+
+    PARAMS
+    @IN gen - options of generator
+    @IN/OUT c - case with seed, results are set
+
+    RETURN:
+    This is a void function
+*/
+static void case_run(const Gen_options *gen, Case *c) __nonull__(1, 2);
+
+/*
+    Read results of older run as baseline
+
+    PARAMS
+    @IN file - results file
+    @OUT base - cases from file
+    @OUT n - number of cases
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int baseline_read(const char *file, Case **base, int *n) __nonull__(1, 2, 3);
+
+/*
+    Write results to file in CSV
+
+    PARAMS
+    @IN file - results file
+    @IN cases - cases
+    @IN n - number of cases
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int results_write(const char *file, Case *cases, int n) __nonull__(1, 2);
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000ull + (uint64_t)ts.tv_nsec / 1000ull;
+}
+
+static uint64_t fuzz_rand(void)
+{
+    rand_state ^= rand_state << 13;
+    rand_state ^= rand_state >> 7;
+    rand_state ^= rand_state << 17;
+
+    return rand_state;
+}
+
+static int run_process(char *const argv[], const char *in, const char *out, const char *err,
+                        uint64_t *us)
+{
+    struct rlimit limit;
+    pid_t pid;
+    int status;
+    int fd;
+    uint64_t start;
+
+    TRACE("");
+
+    start = now_us();
+
+    pid = fork();
+    if(pid == -1)
+        ERROR("fork error\n", 1, "");
+
+    if(pid == 0)
+    {
+        /* infinite loop in program or compiler must not stop fuzzing */
+        limit.rlim_cur = FUZZ_TIMEOUT;
+        limit.rlim_max = FUZZ_TIMEOUT;
+        (void)setrlimit(RLIMIT_CPU, &limit);
+
+        fd = open(in == NULL ? "/dev/null" : in, O_RDONLY);
+        if(fd == -1 || dup2(fd, STDIN_FILENO) == -1)
+            _exit(127);
+
+        close(fd);
+
+        fd = open(out == NULL ? "/dev/null" : out, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if(fd == -1 || dup2(fd, STDOUT_FILENO) == -1)
+            _exit(127);
+
+        close(fd);
+
+        fd = open(err == NULL ? "/dev/null" : err, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if(fd == -1 || dup2(fd, STDERR_FILENO) == -1)
+            _exit(127);
+
+        close(fd);
+
+        execv(argv[0], argv);
+        _exit(127);
+    }
+
+    if(waitpid(pid, &status, 0) == -1)
+        ERROR("waitpid error\n", 1, "");
+
+    *us = now_us() - start;
+
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0 ? 0 : 1;
+}
+
+static char *file_read(const char *path, size_t *len)
+{
+    FILE *f;
+    char *data;
+    long size;
+
+    TRACE("");
+
+    f = fopen(path, "re");
+    if(f == NULL)
+        return NULL;
+
+    if(fseek(f, 0, SEEK_END) || (size = ftell(f)) < 0 || fseek(f, 0, SEEK_SET))
+    {
+        fclose(f);
+        return NULL;
+    }
+
+    data = (char*)malloc((size_t)size + 1);
+    if(data == NULL)
+    {
+        fclose(f);
+        return NULL;
+    }
+
+    *len = fread(data, sizeof(char), (size_t)size, f);
+    data[*len] = '\0';
+
+    fclose(f);
+
+    return data;
+}
+
+static int input_write(const char *path, int vars)
+{
+    FILE *f;
+    int i;
+
+    TRACE("");
+
+    f = fopen(path, "w");
+    if(f == NULL)
+        ERROR("cannot open %s\n", 1, path);
+
+    /* every 4th number is big, so arithmetic of big numbers is tested too */
+    for(i = 0; i < vars; ++i)
+        if(fuzz_rand() % 4)
+            fprintf(f, "%ju\n", fuzz_rand() % FUZZ_SMALL_MAX);
+        else
+            fprintf(f, "%ju\n", fuzz_rand() >> (64 - FUZZ_BIG_BITS));
+
+    fclose(f);
+
+    return 0;
+}
+
+static uint64_t cost_read(const char *path)
+{
+    char *data;
+    char *cost;
+    size_t len;
+    uint64_t res = 0;
+
+    TRACE("");
+
+    data = file_read(path, &len);
+    if(data == NULL)
+        return 0;
+
+    /* Skończono program (czas: N). */
+    cost = strstr(data, "czas: ");
+    if(cost != NULL)
+        res = strtoull(cost + strlen("czas: "), NULL, 10);
+
+    FREE(data);
+
+    return res;
+}
+
+static void case_run(const Gen_options *gen, Case *c)
+{
+    char tmp[] = "/tmp/flatt_fuzz_XXXXXX";
+    char *program = NULL;
+    char *input = NULL;
+    char *expected = NULL;
+    char *asm_file = NULL;
+    char *result = NULL;
+    char *err = NULL;
+    char *expected_data = NULL;
+    char *result_data = NULL;
+    size_t expected_len;
+    size_t result_len;
+    char seed[32];
+    char *gen_argv[16];
+    char *comp_argv[8];
+    char *int_argv[4];
+    int argc = 0;
+    int vars;
+    uint64_t us;
+
+    TRACE("");
+
+    c->status = CASE_ERROR;
+
+    if(mkdtemp(tmp) == NULL)
+        return;
+
+    c->tmp_dir = strdup(tmp);
+    if(c->tmp_dir == NULL)
+        return;
+
+    if(asprintf(&program, "%s/program", tmp) == -1 || asprintf(&input, "%s/input", tmp) == -1
+        || asprintf(&expected, "%s/expected", tmp) == -1 || asprintf(&asm_file, "%s/asm", tmp) == -1
+        || asprintf(&result, "%s/result", tmp) == -1 || asprintf(&err, "%s/err", tmp) == -1)
+        goto clean;
+
+    snprintf(seed, sizeof(seed), "%ju", c->seed);
+
+    /* program reads all variables at begin */
+    gen_argv[argc++] = (char*)gen_exec;
+    gen_argv[argc++] = "--seed";
+    gen_argv[argc++] = seed;
+    gen_argv[argc++] = "--size";
+    gen_argv[argc++] = gen->size;
+    gen_argv[argc++] = "--vars";
+    gen_argv[argc++] = gen->vars;
+
+    if(gen->depth != NULL)
+    {
+        gen_argv[argc++] = "--depth";
+        gen_argv[argc++] = gen->depth;
+    }
+
+    if(gen->arrays != NULL)
+    {
+        gen_argv[argc++] = "--arrays";
+        gen_argv[argc++] = gen->arrays;
+    }
+
+    if(gen->array_size != NULL)
+    {
+        gen_argv[argc++] = "--array-size";
+        gen_argv[argc++] = gen->array_size;
+    }
+
+    gen_argv[argc] = NULL;
+
+    if(run_process(gen_argv, NULL, program, NULL, &us))
+        goto clean;
+
+    /* input depends only on seed of case */
+    rand_state = c->seed * 0x9E3779B97F4A7C15ull + 1;
+    vars = atoi(gen->vars);
+
+    if(input_write(input, vars))
+        goto clean;
+
+    /* evaluator without -O, so output of optimizer is checked too */
+    comp_argv[0] = (char*)eval_exec;
+    comp_argv[1] = "--input";
+    comp_argv[2] = program;
+    comp_argv[3] = "--eval";
+    comp_argv[4] = NULL;
+
+    if(run_process(comp_argv, input, expected, err, &us))
+    {
+        c->status = CASE_SKIPPED;
+        goto clean;
+    }
+
+    /* compiler */
+    argc = 0;
+    comp_argv[argc++] = (char*)comp_exec;
+    comp_argv[argc++] = "--input";
+    comp_argv[argc++] = program;
+
+    if(optimal != NULL)
+    {
+        comp_argv[argc++] = "-O";
+        comp_argv[argc++] = optimal;
+    }
+
+    comp_argv[argc] = "--output";
+    comp_argv[argc + 1] = asm_file;
+    comp_argv[argc + 2] = NULL;
+
+    if(run_process(comp_argv, NULL, NULL, err, &c->compile_us))
+    {
+        c->status = CASE_COMPILE;
+        goto clean;
+    }
+
+    /* only numbers on stdout, messages with cost on stderr */
+    int_argv[0] = (char*)int_exec;
+    int_argv[1] = "--fast";
+    int_argv[2] = asm_file;
+    int_argv[3] = NULL;
+
+    if(run_process(int_argv, input, result, err, &c->run_us))
+        goto clean;
+
+    c->cost = cost_read(err);
+
+    expected_data = file_read(expected, &expected_len);
+    result_data = file_read(result, &result_len);
+    if(expected_data == NULL || result_data == NULL)
+        goto clean;
+
+    if(result_len != expected_len || memcmp(result_data, expected_data, result_len) != 0)
+        c->status = CASE_FAILED;
+    else
+        c->status = CASE_PASSED;
+
+clean:
+    /* keep files of not passed case */
+    if(c->status == CASE_PASSED || c->status == CASE_SKIPPED)
+    {
+        if(program != NULL)
+            (void)unlink(program);
+
+        if(input != NULL)
+            (void)unlink(input);
+
+        if(expected != NULL)
+            (void)unlink(expected);
+
+        if(asm_file != NULL)
+            (void)unlink(asm_file);
+
+        if(result != NULL)
+            (void)unlink(result);
+
+        if(err != NULL)
+            (void)unlink(err);
+
+        (void)rmdir(c->tmp_dir);
+        FREE(c->tmp_dir);
+    }
+
+    FREE(program);
+    FREE(input);
+    FREE(expected);
+    FREE(asm_file);
+    FREE(result);
+    FREE(err);
+    FREE(expected_data);
+    FREE(result_data);
+}
+
+static int baseline_read(const char *file, Case **base, int *n)
+{
+    FILE *f;
+    char line[256];
+    char status[16];
+    Case c;
+    Case *tmp;
+    int size = 0;
+
+    TRACE("");
+
+    f = fopen(file, "re");
+    if(f == NULL)
+    {
+        fprintf(stderr, "%sERROR: %s No such file%s\n", RED, file, RESET);
+        return 1;
+    }
+
+    *base = NULL;
+    *n = 0;
+
+    while(fgets(line, sizeof(line), f) != NULL)
+    {
+        if(line[0] == '#')
+            continue;
+
+        memset(&c, 0, sizeof(Case));
+        if(sscanf(line, "%ju,%15[^,],%ju,%ju,%ju", &c.seed, status, &c.compile_us, &c.run_us, &c.cost) != 5)
+            continue;
+
+        c.status = strcmp(status, status_str[CASE_PASSED]) ? CASE_FAILED : CASE_PASSED;
+
+        if(*n == size)
+        {
+            size = size ? size << 1 : 64;
+            tmp = (Case*)realloc(*base, sizeof(Case) * (size_t)size);
+            if(tmp == NULL)
+            {
+                FREE(*base);
+                fclose(f);
+                ERROR("realloc error\n", 1, "");
+            }
+
+            *base = tmp;
+        }
+
+        (*base)[(*n)++] = c;
+    }
+
+    fclose(f);
+
+    return 0;
+}
+
+static int results_write(const char *file, Case *cases, int n)
+{
+    FILE *f;
+    int i;
+
+    TRACE("");
+
+    f = fopen(file, "w");
+    if(f == NULL)
+        ERROR("cannot open %s\n", 1, file);
+
+    fprintf(f, "# seed,status,compile_us,run_us,cost\n");
+
+    for(i = 0; i < n; ++i)
+        fprintf(f, "%ju,%s,%ju,%ju,%ju\n", cases[i].seed, status_str[cases[i].status],
+                cases[i].compile_us, cases[i].run_us, cases[i].cost);
+
+    fclose(f);
+
+    return 0;
+}
+
+void usage()
+{
+    printf( "Differential fuzzer of compiler: evaluator of tokens against compiled code\n\n"
+            "ARGS:\n"
+            "OPTIONAL:\n"
+            "--cases[-k]\t\tnumber of cases ( default %d )\n"
+            "--seed[-s]\t\tseed of the first case, next cases have next seeds ( default time )\n"
+            "--size[-n]\t\tnumber of commands in program ( default %d )\n"
+            "--depth[-d]\t\tmax nesting of IF, FOR and WHILE ( default of generator )\n"
+            "--vars[-v]\t\tnumber of variables ( default %d )\n"
+            "--arrays[-a]\t\tnumber of arrays ( default of generator )\n"
+            "--array-size[-l]\tsize of array ( default of generator )\n"
+            "--O[-O]\t\t\toptimalization level of compiler\n"
+            "--results[-r]\t\twrite results in CSV to file\n"
+            "--baseline[-b]\t\tcompare cost of cases with results of older run, fail on regression\n"
+            "--threshold[-t]\t\tregression threshold in %% ( default %.1f )\n"
+            "--compiler[-c]\t\tcompiler executable ( default %s )\n"
+            "--evaluator[-e]\t\tcompiler executable with --eval ( default %s )\n"
+            "--interpreter[-i]\tinterpreter executable ( default %s )\n"
+            "--generator[-g]\t\tgenerator executable ( default %s )\n\n"
+            "Examples:\n"
+            "./fuzz.out --cases 1000\n"
+            "./fuzz.out --seed 42 --cases 1 --size 200 --depth 5\n"
+            "./fuzz.out --seed 1 --cases 500 --results old.csv\n"
+            "./fuzz.out --seed 1 --cases 500 --baseline old.csv --threshold 0.5\n"
+            "./fuzz.out --compiler ./old_compiler.out --cases 1000\n\n",
+            FUZZ_DEFAULT_CASES, FUZZ_DEFAULT_SIZE, FUZZ_DEFAULT_VARS, FUZZ_THRESHOLD,
+            FUZZ_COMP_EXEC, FUZZ_EVAL_EXEC, FUZZ_INT_EXEC, FUZZ_GEN_EXEC);
+
+    exit(0);
+}
+
+int main(int argc, char **argv)
+{
+	static struct option long_option[] =
+	{
+        {"cases",       required_argument,  0,  'k'},
+        {"seed",        required_argument,  0,  's'},
+        {"size",        required_argument,  0,  'n'},
+        {"depth",       required_argument,  0,  'd'},
+        {"vars",        required_argument,  0,  'v'},
+        {"arrays",      required_argument,  0,  'a'},
+        {"array-size",  required_argument,  0,  'l'},
+        {"O",           required_argument,  0,  'O'},
+        {"results",     required_argument,  0,  'r'},
+        {"baseline",    required_argument,  0,  'b'},
+        {"threshold",   required_argument,  0,  't'},
+        {"compiler",    required_argument,  0,  'c'},
+        {"evaluator",   required_argument,  0,  'e'},
+        {"interpreter", required_argument,  0,  'i'},
+        {"generator",   required_argument,  0,  'g'},
+        {"help",        no_argument,        0,  'h'},
+		{NULL,		    0,				    0,	'\0'}
+
+    };
+
+    char size[32];
+    char vars[32];
+    Gen_options gen = {NULL, NULL, NULL, NULL, NULL};
+    uint64_t seed = (uint64_t)time(NULL);
+    int ncases = FUZZ_DEFAULT_CASES;
+    char *results = NULL;
+    char *baseline = NULL;
+    double threshold = FUZZ_THRESHOLD;
+
+    Case *cases;
+    Case *base = NULL;
+    int nbase = 0;
+    int count[CASE_STATUS_NUM] = {0};
+    int regressions = 0;
+    uint64_t cost = 0;
+    uint64_t base_cost = 0;
+
+    int opt;
+    int i;
+    int j;
+
+    snprintf(size, sizeof(size), "%d", FUZZ_DEFAULT_SIZE);
+    snprintf(vars, sizeof(vars), "%d", FUZZ_DEFAULT_VARS);
+    gen.size = size;
+    gen.vars = vars;
+
+    while ((opt = getopt_long_only(argc, argv, "k:s:n:d:v:a:l:O:r:b:t:c:e:i:g:h", long_option, NULL )) != -1)
+    {
+        switch(opt)
+        {
+            case 'k':
+            {
+                ncases = atoi(argv[optind - 1]);
+                break;
+            }
+            case 's':
+            {
+                seed = strtoull(argv[optind - 1], NULL, 10);
+                break;
+            }
+            case 'n':
+            {
+                gen.size = argv[optind - 1];
+                break;
+            }
+            case 'd':
+            {
+                gen.depth = argv[optind - 1];
+                break;
+            }
+            case 'v':
+            {
+                gen.vars = argv[optind - 1];
+                break;
+            }
+            case 'a':
+            {
+                gen.arrays = argv[optind - 1];
+                break;
+            }
+            case 'l':
+            {
+                gen.array_size = argv[optind - 1];
+                break;
+            }
+            case 'O':
+            {
+                optimal = argv[optind - 1];
+                break;
+            }
+            case 'r':
+            {
+                results = argv[optind - 1];
+                break;
+            }
+            case 'b':
+            {
+                baseline = argv[optind - 1];
+                break;
+            }
+            case 't':
+            {
+                threshold = atof(argv[optind - 1]);
+                break;
+            }
+            case 'c':
+            {
+                comp_exec = argv[optind - 1];
+                break;
+            }
+            case 'e':
+            {
+                eval_exec = argv[optind - 1];
+                break;
+            }
+            case 'i':
+            {
+                int_exec = argv[optind - 1];
+                break;
+            }
+            case 'g':
+            {
+                gen_exec = argv[optind - 1];
+                break;
+            }
+            default:
+            {
+                usage();
+            }
+        }
+    }
+
+    if(ncases <= 0 || atoi(gen.vars) <= 0)
+        usage();
+
+    /* check baseline before long run */
+    if(baseline != NULL)
+        if(baseline_read(baseline, &base, &nbase))
+            return 1;
+
+    cases = (Case*)calloc((size_t)ncases, sizeof(Case));
+    if(cases == NULL)
+        ERROR("calloc error\n", 1, "");
+
+    printf("seeds %ju .. %ju\n\n", seed, seed + (uint64_t)ncases - 1);
+
+    for(i = 0; i < ncases; ++i)
+    {
+        cases[i].seed = seed + (uint64_t)i;
+        case_run(&gen, &cases[i]);
+
+        ++count[cases[i].status];
+
+        if(cases[i].status != CASE_PASSED)
+            printf("[FUZZ]\tseed %-12ju\t%s%s%s%s%s\n", cases[i].seed,
+                    cases[i].status == CASE_SKIPPED ? YELLOW : RED, status_str[cases[i].status], RESET,
+                    cases[i].tmp_dir != NULL ? "\tfiles in " : "",
+                    cases[i].tmp_dir != NULL ? cases[i].tmp_dir : "");
+
+        if(cases[i].status != CASE_PASSED)
+            continue;
+
+        /* cost of the same program in older run */
+        for(j = 0; j < nbase; ++j)
+            if(base[j].seed == cases[i].seed && base[j].status == CASE_PASSED)
+            {
+                cost += cases[i].cost;
+                base_cost += base[j].cost;
+
+                if((double)cases[i].cost > (double)base[j].cost * (1.0 + threshold / 100.0))
+                {
+                    ++regressions;
+                    printf("[FUZZ]\tseed %-12ju\t%sREGRESSION%s\tcost %ju -> %ju\n", cases[i].seed,
+                            RED, RESET, base[j].cost, cases[i].cost);
+                }
+
+                break;
+            }
+    }
+
+    printf("\n%d cases: %s%d passed%s, %s%d failed%s, %s%d compile%s, %s%d error%s, %s%d skipped%s\n",
+            ncases, GREEN, count[CASE_PASSED], RESET,
+            count[CASE_FAILED] ? RED : GREEN, count[CASE_FAILED], RESET,
+            count[CASE_COMPILE] ? RED : GREEN, count[CASE_COMPILE], RESET,
+            count[CASE_ERROR] ? RED : GREEN, count[CASE_ERROR], RESET,
+            count[CASE_SKIPPED] ? YELLOW : GREEN, count[CASE_SKIPPED], RESET);
+
+    if(baseline != NULL)
+        printf("cost of cases in baseline %ju -> %ju, %s%d regressions%s\n", base_cost, cost,
+                regressions ? RED : GREEN, regressions, RESET);
+
+    if(results != NULL)
+        if(results_write(results, cases, ncases))
+            fprintf(stderr, "%sERROR: cannot write %s%s\n", RED, results, RESET);
+
+    for(i = 0; i < ncases; ++i)
+        FREE(cases[i].tmp_dir);
+
+    FREE(cases);
+    FREE(base);
+
+    return count[CASE_FAILED] || count[CASE_COMPILE] || count[CASE_ERROR] || regressions ? 1 : 0;
+}
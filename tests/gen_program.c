@@ -0,0 +1,467 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <getopt.h>
+
+/*
+    Generator of valid programs with tunable size for benchmarks of compiler
+
+    Author: Michal Kukowski
+    email: michalkukowski10@gmail.com
+
+    Program reads all variables at begin ( input has --vars numbers ), fills arrays in FOR
+    and then has random commands: assignments, WRITE, IF, FOR and WHILE nested up to depth.
+
+    Generated program is correct in runtime too:
+        variables are set before use,
+        index of array is a number or iterator of FOR with bounds inside array,
+        WHILE is driven by own counter which is changed only at the end of loop.
+    The same seed and options give the same program.
+
+    Usage: gen_program.out [options] ( see --help )
+*/
+
+#define GEN_DEFAULT_SIZE        100
+#define GEN_DEFAULT_DEPTH       3
+#define GEN_DEFAULT_VARS        8
+#define GEN_DEFAULT_ARRAYS      2
+#define GEN_DEFAULT_ARRAY_SIZE  16
+
+/* max number of times WHILE loop is executed */
+#define GEN_WHILE_MAX           4
+
+/* max number in commands */
+#define GEN_NUM_MAX             100
+
+/* variable names are letters only, so number is written in base 26 */
+#define GEN_NAME_LEN            16
+
+#define ARRAY_SIZE(A)           (sizeof(A) / sizeof((A)[0]))
+#define MIN(a, b)               ((a) < (b) ? (a) : (b))
+
+typedef struct Gen
+{
+    uint64_t size;      /* commands still to generate */
+    int depth;          /* max nesting of IF, FOR, WHILE */
+    int vars;
+    int arrays;
+    int array_size;
+
+    int iterators;      /* number of FOR around current command */
+    int loops;          /* number of FOR and WHILE around current command */
+
+}Gen;
+
+static uint64_t rand_state = 88172645463325252ull;
+
+/*
+    Pseudo random number ( xorshift64 ), the same sequence for the same seed
+
+    PARAMS
+    @IN n - numbers are from [0, n)
+
+    RETURN:
+    Pseudo random number from [0, n)
+*/
+static uint64_t gen_rand(uint64_t n);
+
+/*
+    Get name: prefix and number in letters
+
+    PARAMS
+    @IN prefix - first letter of name
+    @IN num - number of variable
+    @OUT name - buffer for name ( GEN_NAME_LEN )
+
+    RETURN:
+    Pointer to name
+*/
+static char *gen_name(char prefix, int num, char *name);
+
+/*
+    Write indentation of command
+
+    PARAMS
+    @IN level - nesting level
+
+    RETURN:
+    This is a void function
+*/
+static void gen_indent(int level);
+
+/*
+    Write random value: number, variable, iterator or array element
+
+    PARAMS
+    @IN gen - generator state
+    @IN number - TRUE iff value can be a number
+
+    RETURN:
+    This is a void function
+*/
+static void gen_value(Gen *gen, int number);
+
+/*
+    Write random variable or array element which can be changed
+
+    PARAMS
+    @IN gen - generator state
+
+    RETURN:
+    This is a void function
+*/
+static void gen_target(Gen *gen);
+
+/*
+    Write random commands
+
+    PARAMS
+    @IN gen - generator state
+    @IN level - nesting level
+    @IN n - number of commands
+
+    RETURN:
+    This is a void function
+*/
+static void gen_commands(Gen *gen, int level, uint64_t n);
+
+/*
+    Write random command ( with nested commands )
+
+    PARAMS
+    @IN gen - generator state
+    @IN level - nesting level
+
+    RETURN:
+    This is a void function
+*/
+static void gen_command(Gen *gen, int level);
+
+static uint64_t gen_rand(uint64_t n)
+{
+    rand_state ^= rand_state << 13;
+    rand_state ^= rand_state >> 7;
+    rand_state ^= rand_state << 17;
+
+    return rand_state % n;
+}
+
+static char *gen_name(char prefix, int num, char *name)
+{
+    int len = 1;
+    int i;
+    char c;
+
+    name[0] = prefix;
+
+    do
+    {
+        name[len++] = (char)('a' + num % 26);
+        num /= 26;
+    } while(num && len < GEN_NAME_LEN - 1);
+
+    name[len] = '\0';
+
+    /* letters are from the lowest digit, reverse them */
+    for(i = 1; i < len - i; ++i)
+    {
+        c = name[i];
+        name[i] = name[len - i];
+        name[len - i] = c;
+    }
+
+    return name;
+}
+
+static void gen_indent(int level)
+{
+    printf("%*s", level << 2, "");
+}
+
+static void gen_value(Gen *gen, int number)
+{
+    char name[GEN_NAME_LEN];
+    char index[GEN_NAME_LEN];
+    uint64_t r = gen_rand(10);
+
+    if(number && r < 3)
+        printf("%ju", gen_rand(GEN_NUM_MAX));
+    else if(gen->iterators && r < 5)
+        printf("%s", gen_name('i', (int)gen_rand((uint64_t)gen->iterators), name));
+    else if(gen->arrays && r < 7)
+    {
+        /* iterator is always inside array, bounds of FOR are from [0, array_size) */
+        if(gen->iterators && gen_rand(2))
+            printf("%s[%s]", gen_name('t', (int)gen_rand((uint64_t)gen->arrays), name),
+                    gen_name('i', (int)gen_rand((uint64_t)gen->iterators), index));
+        else
+            printf("%s[%ju]", gen_name('t', (int)gen_rand((uint64_t)gen->arrays), name),
+                    gen_rand((uint64_t)gen->array_size));
+    }
+    else
+        printf("%s", gen_name('v', (int)gen_rand((uint64_t)gen->vars), name));
+}
+
+static void gen_target(Gen *gen)
+{
+    char name[GEN_NAME_LEN];
+    char index[GEN_NAME_LEN];
+
+    if(gen->arrays && gen_rand(3) == 0)
+    {
+        if(gen->iterators && gen_rand(2))
+            printf("%s[%s]", gen_name('t', (int)gen_rand((uint64_t)gen->arrays), name),
+                    gen_name('i', (int)gen_rand((uint64_t)gen->iterators), index));
+        else
+            printf("%s[%ju]", gen_name('t', (int)gen_rand((uint64_t)gen->arrays), name),
+                    gen_rand((uint64_t)gen->array_size));
+    }
+    else
+        printf("%s", gen_name('v', (int)gen_rand((uint64_t)gen->vars), name));
+}
+
+static void gen_commands(Gen *gen, int level, uint64_t n)
+{
+    uint64_t i;
+
+    /* at least one command, block can't be empty */
+    if(n == 0 || gen->size == 0)
+    {
+        gen_indent(level);
+        printf("SKIP;\n");
+        return;
+    }
+
+    for(i = 0; i < n && gen->size; ++i)
+        gen_command(gen, level);
+}
+
+static void gen_command(Gen *gen, int level)
+{
+    static const char *ops[] = {"+", "-", "*", "/", "%"};
+    static const char *rels[] = {"=", "<>", "<", ">", "<=", ">="};
+
+    char name[GEN_NAME_LEN];
+    uint64_t r = gen_rand(100);
+    uint64_t body;
+    uint64_t lo;
+    uint64_t hi;
+
+    --gen->size;
+
+    /* body of nested command takes part of commands left */
+    body = gen->size ? 1 + gen_rand(MIN(gen->size, 8)) : 0;
+
+    gen_indent(level);
+
+    if(level <= gen->depth && r < 12 && gen->array_size)
+    {
+        lo = gen_rand((uint64_t)gen->array_size);
+        hi = lo + gen_rand((uint64_t)gen->array_size - lo);
+
+        gen_name('i', gen->iterators, name);
+        if(gen_rand(2))
+            printf("FOR %s FROM %ju TO %ju DO\n", name, lo, hi);
+        else
+            printf("FOR %s FROM %ju DOWNTO %ju DO\n", name, hi, lo);
+
+        ++gen->iterators;
+        ++gen->loops;
+        gen_commands(gen, level + 1, body);
+        --gen->loops;
+        --gen->iterators;
+
+        gen_indent(level);
+        printf("ENDFOR\n");
+    }
+    else if(level <= gen->depth && r < 24)
+    {
+        printf("IF ");
+        gen_value(gen, 0);
+        printf(" %s ", rels[gen_rand(ARRAY_SIZE(rels))]);
+        gen_value(gen, 1);
+        printf(" THEN\n");
+
+        gen_commands(gen, level + 1, body);
+
+        gen_indent(level);
+        printf("ELSE\n");
+
+        gen_commands(gen, level + 1, gen->size ? gen_rand(MIN(gen->size, 4)) : 0);
+
+        gen_indent(level);
+        printf("ENDIF\n");
+    }
+    else if(level <= gen->depth && r < 30)
+    {
+        /* counter of loop is changed only here and at the end of loop */
+        gen_name('w', gen->loops, name);
+        printf("%s := 0;\n", name);
+        gen_indent(level);
+        printf("WHILE %s < %ju DO\n", name, 1 + gen_rand(GEN_WHILE_MAX));
+
+        ++gen->loops;
+        gen_commands(gen, level + 1, body);
+        --gen->loops;
+
+        gen_indent(level + 1);
+        printf("%s := %s + 1;\n", name, name);
+        gen_indent(level);
+        printf("ENDWHILE\n");
+    }
+    else if(r < 45)
+    {
+        printf("WRITE ");
+        gen_value(gen, 1);
+        printf(";\n");
+    }
+    else
+    {
+        gen_target(gen);
+        printf(" := ");
+        gen_value(gen, 1);
+        if(gen_rand(4))
+        {
+            printf(" %s ", ops[gen_rand(ARRAY_SIZE(ops))]);
+            gen_value(gen, 1);
+        }
+
+        printf(";\n");
+    }
+}
+
+void usage()
+{
+    printf( "Generator of programs for benchmarks of compiler\n\n"
+            "ARGS:\n"
+            "OPTIONAL:\n"
+            "--size[-n]\t\tnumber of commands ( default %d )\n"
+            "--depth[-d]\t\tmax nesting of IF, FOR and WHILE ( default %d )\n"
+            "--vars[-v]\t\tnumber of variables ( default %d )\n"
+            "--arrays[-a]\t\tnumber of arrays ( default %d )\n"
+            "--array-size[-l]\tsize of array ( default %d )\n"
+            "--seed[-s]\t\tseed of random generator\n\n"
+            "Examples:\n"
+            "./gen_program.out --size 10000 > big_program\n"
+            "./gen_program.out --size 1000 --depth 8 --vars 100 --arrays 10 --array-size 1000\n\n",
+            GEN_DEFAULT_SIZE, GEN_DEFAULT_DEPTH, GEN_DEFAULT_VARS, GEN_DEFAULT_ARRAYS,
+            GEN_DEFAULT_ARRAY_SIZE);
+
+    exit(0);
+}
+
+int main(int argc, char **argv)
+{
+	static struct option long_option[] =
+	{
+        {"size",        required_argument,  0,  'n'},
+        {"depth",       required_argument,  0,  'd'},
+        {"vars",        required_argument,  0,  'v'},
+        {"arrays",      required_argument,  0,  'a'},
+        {"array-size",  required_argument,  0,  'l'},
+        {"seed",        required_argument,  0,  's'},
+        {"help",        no_argument,        0,  'h'},
+		{NULL,		    0,				    0,	'\0'}
+
+    };
+
+    Gen gen;
+    char name[GEN_NAME_LEN];
+    char index[GEN_NAME_LEN];
+    char var[GEN_NAME_LEN];
+    uint64_t seed = 0;
+    int opt;
+    int i;
+
+    gen.size = GEN_DEFAULT_SIZE;
+    gen.depth = GEN_DEFAULT_DEPTH;
+    gen.vars = GEN_DEFAULT_VARS;
+    gen.arrays = GEN_DEFAULT_ARRAYS;
+    gen.array_size = GEN_DEFAULT_ARRAY_SIZE;
+    gen.iterators = 0;
+    gen.loops = 0;
+
+    while ((opt = getopt_long_only(argc, argv, "n:d:v:a:l:s:h", long_option, NULL )) != -1)
+    {
+        switch(opt)
+        {
+            case 'n':
+            {
+                gen.size = strtoull(argv[optind - 1], NULL, 10);
+                break;
+            }
+            case 'd':
+            {
+                gen.depth = atoi(argv[optind - 1]);
+                break;
+            }
+            case 'v':
+            {
+                gen.vars = atoi(argv[optind - 1]);
+                break;
+            }
+            case 'a':
+            {
+                gen.arrays = atoi(argv[optind - 1]);
+                break;
+            }
+            case 'l':
+            {
+                gen.array_size = atoi(argv[optind - 1]);
+                break;
+            }
+            case 's':
+            {
+                seed = strtoull(argv[optind - 1], NULL, 10);
+                break;
+            }
+            default:
+            {
+                usage();
+            }
+        }
+    }
+
+    /* program needs variable, array without elements can't be declared */
+    if(gen.vars <= 0 || gen.depth < 0 || gen.arrays < 0 || gen.array_size <= 0)
+        usage();
+
+    /* xorshift can't start from 0 */
+    rand_state ^= seed * 0x9E3779B97F4A7C15ull;
+    if(rand_state == 0)
+        rand_state = 1;
+
+    printf("{ gen_program.out --size %ju --depth %d --vars %d --arrays %d --array-size %d --seed %ju }\n\n",
+            gen.size, gen.depth, gen.vars, gen.arrays, gen.array_size, seed);
+
+    printf("VAR\n");
+    for(i = 0; i < gen.vars; ++i)
+        printf("    %s\n", gen_name('v', i, name));
+
+    for(i = 0; i < gen.arrays; ++i)
+        printf("    %s[%d]\n", gen_name('t', i, name), gen.array_size);
+
+    /* counters of WHILE, one for each level of loops */
+    for(i = 0; i <= gen.depth; ++i)
+        printf("    %s\n", gen_name('w', i, name));
+
+    printf("BEGIN\n");
+
+    for(i = 0; i < gen.vars; ++i)
+        printf("    READ %s;\n", gen_name('v', i, name));
+
+    for(i = 0; i < gen.arrays; ++i)
+    {
+        printf("    FOR %s FROM 0 TO %d DO\n", gen_name('i', 0, index), gen.array_size - 1);
+        printf("        %s[%s] := %s + %s;\n", gen_name('t', i, name), index, index,
+                gen_name('v', (int)gen_rand((uint64_t)gen.vars), var));
+        printf("    ENDFOR\n");
+    }
+
+    gen_commands(&gen, 1, gen.size);
+
+    printf("END\n");
+
+    return 0;
+}
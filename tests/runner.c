@@ -0,0 +1,1234 @@
+#include <common.h>
+#include <getopt.h>
+#include <limits.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/wait.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+
+/*
+    PARALLEL RUNNER OF COMPILED CODE TESTS
+
+    Author: Michal Kukowski
+    email: michalkukowski10@gmail.com
+
+    Cases are found in test directories:
+        exN             <- program
+        inN, inN.K      <- input of program
+        outN, outN.K    <- expected output for inN, inN.K
+
+    Every case is compiled and run by interpreter in own temp directory,
+    so cases are run in parallel on worker threads.
+    Temp directory of failed case is kept and printed in report.
+
+    Results file format ( CSV ):
+
+    # comment
+    case,status,compile_us,run_us,cost
+
+    status is PASSED, FAILED ( wrong output ), COMPILE ( compilation failed ), ERROR ( runner error )
+    cost is time of program from interpreter ( 0 iff program didn't finish )
+
+    Cost benchmark ( --baseline, --write-baseline ):
+    code is compiled with --emitter-map and run with profile, cost of each asm line
+    ( executions * cost of instruction ) is added to emitter which generated the line.
+    Costs are compared with baseline, case is regression iff its cost or length of code
+    is bigger than in baseline by more than threshold.
+
+    Baseline file format ( CSV ):
+
+    # comment
+    case,cost,length,do_mult,do_div,do_mod,do_set_val_addr,do_pump,do_pump_bigvalue,other
+*/
+
+#define RUNNER_COMP_EXEC    "./compiler.out"
+#define RUNNER_INT_EXEC     "./interpreter-cln.out"
+
+/* CPU seconds for compiler and interpreter of one case */
+#define RUNNER_TIMEOUT      60
+
+/* interpreter prints 3 lines before program output */
+#define RUNNER_HEADER_LINES 3
+
+/* default threshold of cost regression in % */
+#define RUNNER_THRESHOLD    1.0
+
+/* index of code not generated by emitter in emitter costs */
+#define EMITTER_OTHER       6
+#define EMITTERS_NUM        (EMITTER_OTHER + 1)
+
+#define CASE_PASSED     0
+#define CASE_FAILED     1
+#define CASE_COMPILE    2
+#define CASE_ERROR      3
+
+typedef struct Case
+{
+    char *name;     /* dir/exN or dir/exN.K */
+    char *program;
+    char *input;
+    char *output;
+
+    uint64_t num;   /* N */
+    uint64_t sub;   /* K, 0 iff case has only one input */
+
+    int status;
+    uint64_t compile_us;
+    uint64_t run_us;
+    uint64_t cost;
+
+    uint64_t length;    /* asm lines, only in benchmark */
+    uint64_t emitter_cost[EMITTERS_NUM];  /* cost of code from each emitter, only in benchmark */
+
+    char *tmp_dir;  /* NULL iff removed */
+
+}Case;
+
+/* cases shared by worker threads */
+typedef struct Runner
+{
+    Case *cases;
+    int ncases;
+
+    int next; /* next case to take */
+
+}Runner;
+
+static const char *default_dirs[] =
+{
+    "./tests/asm_correct",
+    "./tests/gebala",
+    "./tests/gotfryd",
+    "./tests/gotfryd2"
+};
+
+static const char *status_str[] = {"PASSED", "FAILED", "COMPILE", "ERROR"};
+
+/* names of emitters from --emitter-map of compiler */
+static const char *emitters[EMITTERS_NUM] =
+{
+    "do_mult",
+    "do_div",
+    "do_mod",
+    "do_set_val_addr",
+    "do_pump",
+    "do_pump_bigvalue",
+    "other"
+};
+
+/* compile with emitter map and run with profile */
+static BOOL bench = FALSE;
+
+static const char *comp_exec = RUNNER_COMP_EXEC;
+static const char *int_exec = RUNNER_INT_EXEC;
+
+/*
+    Get monotonic time
+
+    PARAMS
+    NO PARAMS
+
+    RETURN:
+    Time in microseconds
+*/
+static uint64_t now_us(void);
+
+/*
+    Run process with redirected streams and wait for it
+
+    PARAMS
+    @IN argv - argv of process, argv[0] is path to executable
+    @IN in - file for stdin ( NULL -> /dev/null )
+    @IN out - file for stdout ( NULL -> /dev/null )
+    @OUT us - wall time of process
+
+    RETURN:
+    0 iff process exited with 0
+    Non-zero value iff failure
+*/
+static int run_process(char *const argv[], const char *in, const char *out, uint64_t *us) __nonull__(1, 4);
+
+/*
+    Read whole file
+
+    PARAMS
+    @IN path - path to file
+    @OUT len - length of data
+
+    RETURN:
+    NULL iff failure
+    Pointer to data ( ended by '\0' ) iff success
+*/
+static char *file_read(const char *path, size_t *len) __nonull__(1, 2);
+
+/*
+    Get program output from interpreter output ( the same format as tests/edit_file.sh )
+
+    PARAMS
+    @IN data - interpreter output, changed in place
+    @OUT len - length of program output
+    @OUT cost - time of program ( 0 iff program didn't finish )
+
+    RETURN:
+    Pointer to program output in data
+*/
+static char *program_output(char *data, size_t *len, uint64_t *cost) __nonull__(1, 2, 3);
+
+/*
+    Get cost of asm instruction ( the same as in interpreter )
+
+    PARAMS
+    @IN line - asm line
+
+    RETURN:
+    Cost of instruction
+*/
+static uint64_t op_cost(const char *line) __nonull__(1);
+
+/*
+    Compute length of code and cost of each emitter from profile of case
+
+    PARAMS
+    @IN c - case
+    @IN asm_file - compiled code
+    @IN emit_file - emitter map of code
+    @IN prof_file - profile of run
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int case_costs(Case *c, const char *asm_file, const char *emit_file,
+                      const char *prof_file) __nonull__(1, 2, 3, 4);
+
+/*
+    Compile case, run it and compare output with expected one
+
+    PARAMS
+    @IN c - case
+
+    RETURN:
+    This is a void function
+*/
+static void case_run(Case *c) __nonull__(1);
+
+/*
+    Worker thread, run cases until all are taken
+
+    PARAMS
+    @IN arg - pointer to Runner
+
+    RETURN:
+    NULL
+*/
+static void *runner_worker(void *arg);
+
+/*
+    Find cases in directory and add them to array
+
+    PARAMS
+    @IN dir - test directory
+    @IN cases - pointer to array of cases
+    @IN n - pointer to number of cases
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int cases_find(const char *dir, Case **cases, int *n) __nonull__(1, 2, 3);
+
+/*
+    Order of cases from one directory: by N, then by K
+
+    PARAMS
+    @IN a - pointer to Case
+    @IN b - pointer to Case
+
+    RETURN:
+    < 0 iff a < b
+    0 iff a == b
+    > 0 iff a > b
+*/
+static int case_cmp(const void *a, const void *b);
+
+/*
+    Read baseline file
+
+    PARAMS
+    @IN file - path to baseline file
+    @OUT base - array of cases from baseline ( only name, cost, length and emitter costs )
+    @OUT n - number of cases
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int baseline_read(const char *file, Case **base, int *n) __nonull__(1, 2, 3);
+
+/*
+    Write baseline file from passed cases
+
+    PARAMS
+    @IN file - path to baseline file
+    @IN cases - array of cases
+    @IN n - number of cases
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int baseline_write(const char *file, Case *cases, int n) __nonull__(1, 2);
+
+/*
+    Compare costs of cases with baseline, print table of deltas
+
+    PARAMS
+    @IN cases - array of cases
+    @IN n - number of cases
+    @IN base - array of cases from baseline
+    @IN nbase - number of cases in baseline
+    @IN threshold - regression threshold in %
+
+    RETURN:
+    Number of regressions
+*/
+static int baseline_compare(Case *cases, int n, Case *base, int nbase, double threshold) __nonull__(1);
+
+/*
+    Write results file
+
+    PARAMS
+    @IN file - path to results file
+    @IN cases - array of cases
+    @IN n - number of cases
+
+    RETURN:
+    0 iff success
+    Non-zero value iff failure
+*/
+static int results_write(const char *file, Case *cases, int n) __nonull__(1, 2);
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000ull + (uint64_t)ts.tv_nsec / 1000ull;
+}
+
+static int run_process(char *const argv[], const char *in, const char *out, uint64_t *us)
+{
+    struct rlimit limit;
+    pid_t pid;
+    int status;
+    int fd;
+    uint64_t start;
+
+    TRACE("");
+
+    start = now_us();
+
+    pid = fork();
+    if(pid == -1)
+        ERROR("fork error\n", 1, "");
+
+    if(pid == 0)
+    {
+        /* infinite loop in program or compiler must not stop all tests */
+        limit.rlim_cur = RUNNER_TIMEOUT;
+        limit.rlim_max = RUNNER_TIMEOUT;
+        (void)setrlimit(RLIMIT_CPU, &limit);
+
+        fd = open(in == NULL ? "/dev/null" : in, O_RDONLY);
+        if(fd == -1 || dup2(fd, STDIN_FILENO) == -1)
+            _exit(127);
+
+        close(fd);
+
+        fd = open(out == NULL ? "/dev/null" : out, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if(fd == -1 || dup2(fd, STDOUT_FILENO) == -1)
+            _exit(127);
+
+        close(fd);
+
+        fd = open("/dev/null", O_WRONLY);
+        if(fd == -1 || dup2(fd, STDERR_FILENO) == -1)
+            _exit(127);
+
+        close(fd);
+
+        execv(argv[0], argv);
+        _exit(127);
+    }
+
+    if(waitpid(pid, &status, 0) == -1)
+        ERROR("waitpid error\n", 1, "");
+
+    *us = now_us() - start;
+
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0 ? 0 : 1;
+}
+
+static char *file_read(const char *path, size_t *len)
+{
+    FILE *f;
+    char *data;
+    long size;
+
+    TRACE("");
+
+    f = fopen(path, "re");
+    if(f == NULL)
+        return NULL;
+
+    if(fseek(f, 0, SEEK_END) || (size = ftell(f)) < 0 || fseek(f, 0, SEEK_SET))
+    {
+        fclose(f);
+        return NULL;
+    }
+
+    data = (char*)malloc((size_t)size + 1);
+    if(data == NULL)
+    {
+        fclose(f);
+        return NULL;
+    }
+
+    *len = fread(data, sizeof(char), (size_t)size, f);
+    data[*len] = '\0';
+
+    fclose(f);
+
+    return data;
+}
+
+static char *program_output(char *data, size_t *len, uint64_t *cost)
+{
+    char *begin = data;
+    char *end;
+    char *last;
+    char *czas;
+    char *src;
+    char *dst;
+    int i;
+
+    TRACE("");
+
+    *cost = 0;
+
+    /* skip header of interpreter */
+    for(i = 0; i < RUNNER_HEADER_LINES && *begin != '\0'; ++i)
+    {
+        begin = strchr(begin, '\n');
+        if(begin == NULL)
+        {
+            *len = 0;
+            return data;
+        }
+
+        ++begin;
+    }
+
+    /* last line is summary of interpreter, cut it */
+    end = begin + strlen(begin);
+    if(end > begin && end[-1] == '\n')
+        --end;
+
+    last = end;
+    while(last > begin && last[-1] != '\n')
+        --last;
+
+    czas = strstr(last, "czas: ");
+    if(czas != NULL)
+        *cost = strtoull(czas + strlen("czas: "), NULL, 10);
+
+    /* delete "? " and "> " */
+    for(src = dst = begin; src < last; )
+    {
+        if((src[0] == '?' || src[0] == '>') && src + 1 < last && src[1] == ' ')
+            src += 2;
+        else
+            *dst++ = *src++;
+    }
+
+    *len = (size_t)(dst - begin);
+
+    return begin;
+}
+
+static uint64_t op_cost(const char *line)
+{
+#define OP_IS(OP) (strncmp(line, OP, sizeof(OP) - 1) == 0 && ! isalpha((unsigned char)line[sizeof(OP) - 1]))
+
+    if(OP_IS("GET") || OP_IS("PUT"))
+        return 100;
+
+    if(OP_IS("LOAD") || OP_IS("STORE") || OP_IS("ADD") || OP_IS("SUB"))
+        return 10;
+
+    if(OP_IS("HALT"))
+        return 0;
+
+    return 1;
+
+#undef OP_IS
+}
+
+static int case_costs(Case *c, const char *asm_file, const char *emit_file, const char *prof_file)
+{
+    char *code = NULL;
+    char *map = NULL;
+    char *prof = NULL;
+    size_t len;
+
+    uint64_t *line_cost = NULL;
+    int *owner = NULL;
+    char *line;
+    char *save;
+    char *end;
+
+    uint64_t first;
+    uint64_t last;
+    uint64_t count;
+    uint64_t i;
+    int e;
+    int ret = 1;
+
+    TRACE("");
+
+    code = file_read(asm_file, &len);
+    map = file_read(emit_file, &len);
+    prof = file_read(prof_file, &len);
+    if(code == NULL || map == NULL || prof == NULL)
+        goto clean;
+
+    /* each asm line has one instruction */
+    count = 1;
+    for(line = code; (line = strchr(line, '\n')) != NULL; ++line)
+        ++count;
+
+    line_cost = (uint64_t*)malloc(sizeof(uint64_t) * (size_t)count);
+    owner = (int*)malloc(sizeof(int) * (size_t)count);
+    if(line_cost == NULL || owner == NULL)
+        goto clean;
+
+    c->length = 0;
+    for(line = strtok_r(code, "\n", &save); line != NULL; line = strtok_r(NULL, "\n", &save))
+        line_cost[c->length++] = op_cost(line);
+
+    for(i = 0; i < c->length; ++i)
+        owner[i] = EMITTER_OTHER;
+
+    /* asm_first,asm_last,emitter */
+    for(line = strtok_r(map, "\n", &save); line != NULL; line = strtok_r(NULL, "\n", &save))
+    {
+        if(line[0] == '#')
+            continue;
+
+        first = strtoull(line, &end, 10);
+        last = strtoull(end + 1, &end, 10);
+
+        for(e = 0; e < EMITTER_OTHER; ++e)
+            if(strcmp(end + 1, emitters[e]) == 0)
+                break;
+
+        for(i = first; i <= last && i < c->length; ++i)
+            owner[i] = e;
+    }
+
+    /* line,count,taken ( other lines of profile start with name ) */
+    for(line = strtok_r(prof, "\n", &save); line != NULL; line = strtok_r(NULL, "\n", &save))
+    {
+        if(! isdigit((unsigned char)line[0]))
+            continue;
+
+        i = strtoull(line, &end, 10);
+        count = strtoull(end + 1, &end, 10);
+
+        if(i < c->length)
+            c->emitter_cost[owner[i]] += count * line_cost[i];
+    }
+
+    ret = 0;
+
+clean:
+    FREE(code);
+    FREE(map);
+    FREE(prof);
+    FREE(line_cost);
+    FREE(owner);
+
+    return ret;
+}
+
+static void case_run(Case *c)
+{
+    char tmp[] = "/tmp/flatt_test_XXXXXX";
+    char *asm_file = NULL;
+    char *result_file = NULL;
+    char *emit_file = NULL;
+    char *prof_file = NULL;
+    char *expected = NULL;
+    char *result = NULL;
+    char *out;
+    size_t expected_len;
+    size_t result_len;
+    size_t out_len;
+
+    char *comp_argv[8];
+    char *int_argv[4];
+
+    TRACE("");
+
+    c->status = CASE_ERROR;
+
+    if(mkdtemp(tmp) == NULL)
+        return;
+
+    c->tmp_dir = strdup(tmp);
+    if(c->tmp_dir == NULL)
+        return;
+
+    if(asprintf(&asm_file, "%s/asm", tmp) == -1 || asprintf(&result_file, "%s/result", tmp) == -1)
+        goto clean;
+
+    if(bench && (asprintf(&emit_file, "%s/emit", tmp) == -1 || asprintf(&prof_file, "%s/prof", tmp) == -1))
+        goto clean;
+
+    comp_argv[0] = (char*)comp_exec;
+    comp_argv[1] = "--input";
+    comp_argv[2] = c->program;
+    comp_argv[3] = "--output";
+    comp_argv[4] = asm_file;
+    comp_argv[5] = bench ? "--emitter-map" : NULL;
+    comp_argv[6] = emit_file;
+    comp_argv[7] = NULL;
+
+    if(run_process(comp_argv, NULL, NULL, &c->compile_us))
+    {
+        c->status = CASE_COMPILE;
+        goto clean;
+    }
+
+    int_argv[0] = (char*)int_exec;
+    int_argv[1] = asm_file;
+    int_argv[2] = prof_file;
+    int_argv[3] = NULL;
+
+    /* output is checked, so exit code of interpreter doesn't matter */
+    (void)run_process(int_argv, c->input, result_file, &c->run_us);
+
+    expected = file_read(c->output, &expected_len);
+    result = file_read(result_file, &result_len);
+    if(expected == NULL || result == NULL)
+        goto clean;
+
+    out = program_output(result, &out_len, &c->cost);
+
+    if(out_len != expected_len || memcmp(out, expected, out_len) != 0)
+        c->status = CASE_FAILED;
+    else if(! bench || case_costs(c, asm_file, emit_file, prof_file) == 0)
+        c->status = CASE_PASSED;
+
+clean:
+    /* keep files of failed case */
+    if(c->status == CASE_PASSED)
+    {
+        if(asm_file != NULL)
+            (void)unlink(asm_file);
+
+        if(result_file != NULL)
+            (void)unlink(result_file);
+
+        if(emit_file != NULL)
+            (void)unlink(emit_file);
+
+        if(prof_file != NULL)
+            (void)unlink(prof_file);
+
+        (void)rmdir(c->tmp_dir);
+        FREE(c->tmp_dir);
+    }
+
+    FREE(asm_file);
+    FREE(result_file);
+    FREE(emit_file);
+    FREE(prof_file);
+    FREE(expected);
+    FREE(result);
+}
+
+static void *runner_worker(void *arg)
+{
+    Runner *runner = (Runner*)arg;
+    int i;
+
+    while((i = __sync_fetch_and_add(&runner->next, 1)) < runner->ncases)
+        case_run(&runner->cases[i]);
+
+    return NULL;
+}
+
+static int cases_find(const char *dir, Case **cases, int *n)
+{
+    DIR *d;
+    struct dirent *entry;
+    struct stat st;
+
+    const char *base;
+    char *dot;
+    char *end;
+    char *program = NULL;
+    char *output = NULL;
+    char *input = NULL;
+    Case *c;
+    Case *temp;
+    int first = *n;
+
+    TRACE("");
+
+    d = opendir(dir);
+    if(d == NULL)
+    {
+        fprintf(stderr, "%sERROR: cannot open %s%s\n", RED, dir, RESET);
+        return 1;
+    }
+
+    base = strrchr(dir, '/');
+    base = base == NULL ? dir : base + 1;
+
+    while((entry = readdir(d)) != NULL)
+    {
+        /* case is defined by input file: inN or inN.K */
+        if(strncmp(entry->d_name, "in", 2) || ! isdigit((unsigned char)entry->d_name[2]))
+            continue;
+
+        temp = (Case*)realloc(*cases, sizeof(Case) * (size_t)(*n + 1));
+        if(temp == NULL)
+            ERROR("realloc error\n", 1, "");
+
+        *cases = temp;
+        c = &(*cases)[*n];
+
+        (void)memset(c, 0, sizeof(Case));
+
+        c->num = strtoull(&entry->d_name[2], &end, 10);
+        dot = end;
+        if(*dot == '.')
+            c->sub = strtoull(dot + 1, &end, 10);
+
+        /* not a case, e.g. input1 */
+        if(*end != '\0' || (*dot == '.' && c->sub == 0))
+            continue;
+
+        if(asprintf(&program, "%s/ex%ju", dir, c->num) == -1
+            || asprintf(&input, "%s/%s", dir, entry->d_name) == -1
+            || asprintf(&output, "%s/out%s", dir, &entry->d_name[2]) == -1)
+            ERROR("asprintf error\n", 1, "");
+
+        if(stat(program, &st) || stat(output, &st))
+        {
+            fprintf(stderr, "%sWARNING: %s has no program or expected output%s\n", YELLOW, input, RESET);
+
+            FREE(program);
+            FREE(input);
+            FREE(output);
+
+            continue;
+        }
+
+        c->program = program;
+        c->input = input;
+        c->output = output;
+
+        if(asprintf(&c->name, "%s/ex%s", base, &entry->d_name[2]) == -1)
+            ERROR("asprintf error\n", 1, "");
+
+        program = NULL;
+        input = NULL;
+        output = NULL;
+
+        ++(*n);
+    }
+
+    closedir(d);
+
+    /* readdir order is random */
+    qsort(&(*cases)[first], (size_t)(*n - first), sizeof(Case), case_cmp);
+
+    return 0;
+}
+
+static int case_cmp(const void *a, const void *b)
+{
+    const Case *c1 = (const Case*)a;
+    const Case *c2 = (const Case*)b;
+
+    if(c1->num != c2->num)
+        return c1->num < c2->num ? -1 : 1;
+
+    return c1->sub < c2->sub ? -1 : c1->sub > c2->sub;
+}
+
+static int baseline_read(const char *file, Case **base, int *n)
+{
+    char *data;
+    size_t len;
+
+    char *line;
+    char *save;
+    char *end;
+    char *col;
+    Case *temp;
+    Case *c;
+    int e;
+
+    TRACE("");
+
+    data = file_read(file, &len);
+    if(data == NULL)
+    {
+        fprintf(stderr, "%sERROR: cannot open %s%s\n", RED, file, RESET);
+        return 1;
+    }
+
+    for(line = strtok_r(data, "\n", &save); line != NULL; line = strtok_r(NULL, "\n", &save))
+    {
+        /* costs of emitters are in order of emitters table */
+        if(line[0] == '#')
+        {
+            col = strstr(line, "length");
+            for(e = 0; e < EMITTERS_NUM && col != NULL; ++e)
+            {
+                col = strchr(col, ',');
+                if(col != NULL && (strncmp(++col, emitters[e], strlen(emitters[e]))
+                    || (col[strlen(emitters[e])] != ',' && col[strlen(emitters[e])] != '\0')))
+                    col = NULL;
+            }
+
+            if(col == NULL)
+            {
+                fprintf(stderr, "%sERROR: %s has other emitters, write it again%s\n", RED, file, RESET);
+                FREE(data);
+                return 1;
+            }
+
+            continue;
+        }
+
+        col = strchr(line, ',');
+        if(col == NULL)
+            continue;
+
+        temp = (Case*)realloc(*base, sizeof(Case) * (size_t)(*n + 1));
+        if(temp == NULL)
+            ERROR("realloc error\n", 1, "");
+
+        *base = temp;
+        c = &(*base)[*n];
+
+        (void)memset(c, 0, sizeof(Case));
+
+        c->name = strndup(line, (size_t)(col - line));
+        if(c->name == NULL)
+            ERROR("strndup error\n", 1, "");
+
+        c->cost = strtoull(col + 1, &end, 10);
+        c->length = strtoull(end + 1, &end, 10);
+        for(e = 0; e < EMITTERS_NUM; ++e)
+            c->emitter_cost[e] = strtoull(end + 1, &end, 10);
+
+        ++(*n);
+    }
+
+    FREE(data);
+
+    return 0;
+}
+
+static int baseline_write(const char *file, Case *cases, int n)
+{
+    FILE *f;
+    int i;
+    int e;
+
+    TRACE("");
+
+    f = fopen(file, "w");
+    if(f == NULL)
+        ERROR("cannot open %s\n", 1, file);
+
+    fprintf(f, "# case,cost,length");
+    for(e = 0; e < EMITTERS_NUM; ++e)
+        fprintf(f, ",%s", emitters[e]);
+
+    fprintf(f, "\n");
+
+    for(i = 0; i < n; ++i)
+    {
+        if(cases[i].status != CASE_PASSED)
+            continue;
+
+        fprintf(f, "%s,%ju,%ju", cases[i].name, cases[i].cost, cases[i].length);
+        for(e = 0; e < EMITTERS_NUM; ++e)
+            fprintf(f, ",%ju", cases[i].emitter_cost[e]);
+
+        fprintf(f, "\n");
+    }
+
+    fclose(f);
+
+    return 0;
+}
+
+static int baseline_compare(Case *cases, int n, Case *base, int nbase, double threshold)
+{
+#define PERCENT(NEW, OLD) ((OLD) ? 100.0 * ((double)(NEW) - (double)(OLD)) / (double)(OLD) : 0.0)
+
+    Case *c;
+    Case *b;
+    const char *color;
+
+    int64_t delta;
+    int64_t score;
+    int64_t worst_score;
+    int64_t emitter_delta[EMITTERS_NUM] = {0};
+    int sign;
+    int worst;
+
+    uint64_t cost_base = 0;
+    uint64_t cost_new = 0;
+
+    int i;
+    int j;
+    int e;
+    int regressions = 0;
+    int improvements = 0;
+    int missing = 0;
+
+    TRACE("");
+
+    printf("\n[BENCH]\t%-24s\t%12s %12s %9s\t%8s %8s %9s\t%s\n", "case", "base cost", "cost", "delta",
+            "base len", "length", "delta", "emitter of biggest delta");
+
+    for(i = 0; i < n; ++i)
+    {
+        c = &cases[i];
+        if(c->status != CASE_PASSED)
+            continue;
+
+        b = NULL;
+        for(j = 0; j < nbase && b == NULL; ++j)
+            if(strcmp(base[j].name, c->name) == 0)
+                b = &base[j];
+
+        if(b == NULL)
+        {
+            ++missing;
+            printf("[BENCH]\t%-24s\t%sno baseline%s\n", c->name, YELLOW, RESET);
+            continue;
+        }
+
+        if((double)c->cost > (double)b->cost * (1.0 + threshold / 100.0)
+            || (double)c->length > (double)b->length * (1.0 + threshold / 100.0))
+        {
+            ++regressions;
+            color = RED;
+        }
+        else if(c->cost < b->cost)
+        {
+            ++improvements;
+            color = GREEN;
+        }
+        else if(c->cost > b->cost)
+            color = YELLOW;
+        else
+            color = RESET;
+
+        /* emitter which moved cost the most in the same way as whole cost */
+        sign = c->cost > b->cost ? 1 : c->cost < b->cost ? -1 : 0;
+        worst = -1;
+        worst_score = 0;
+        for(e = 0; e < EMITTERS_NUM; ++e)
+        {
+            delta = (int64_t)c->emitter_cost[e] - (int64_t)b->emitter_cost[e];
+            emitter_delta[e] += delta;
+
+            score = sign ? delta * sign : llabs(delta);
+            if(score > worst_score)
+            {
+                worst = e;
+                worst_score = score;
+            }
+        }
+
+        printf("[BENCH]\t%-24s\t%12ju %12ju %s%+8.2f%%%s\t%8ju %8ju %+8.2f%%", c->name,
+                b->cost, c->cost, color, PERCENT(c->cost, b->cost), RESET,
+                b->length, c->length, PERCENT(c->length, b->length));
+
+        if(worst != -1)
+            printf("\t%s %+jd", emitters[worst],
+                    (intmax_t)((int64_t)c->emitter_cost[worst] - (int64_t)b->emitter_cost[worst]));
+
+        printf("\n");
+
+        cost_base += b->cost;
+        cost_new += c->cost;
+    }
+
+    printf("\ncost of cases %ju -> %ju ( %+.2f%% )\ncost delta of emitters:", cost_base, cost_new,
+            PERCENT(cost_new, cost_base));
+
+    for(e = 0; e < EMITTERS_NUM; ++e)
+        printf(" %s %+jd", emitters[e], (intmax_t)emitter_delta[e]);
+
+    printf("\n%s%d regressions%s over %.2f%%, %s%d improvements%s, %d cases without baseline\n",
+            regressions ? RED : GREEN, regressions, RESET, threshold, GREEN, improvements, RESET, missing);
+
+    return regressions;
+
+#undef PERCENT
+}
+
+static int results_write(const char *file, Case *cases, int n)
+{
+    FILE *f;
+    int i;
+
+    TRACE("");
+
+    f = fopen(file, "w");
+    if(f == NULL)
+        ERROR("cannot open %s\n", 1, file);
+
+    fprintf(f, "# case,status,compile_us,run_us,cost\n");
+
+    for(i = 0; i < n; ++i)
+        fprintf(f, "%s,%s,%ju,%ju,%ju\n", cases[i].name, status_str[cases[i].status],
+                cases[i].compile_us, cases[i].run_us, cases[i].cost);
+
+    fclose(f);
+
+    return 0;
+}
+
+void usage()
+{
+    printf( "Parallel runner of compiled code tests\n\n"
+            "ARGS:\n"
+            "OPTIONAL:\n"
+            "--jobs[-j]\t\tnumber of worker threads ( default number of cpus )\n"
+            "--results[-r]\t\twrite results in CSV to file\n"
+            "--compiler[-c]\t\tcompiler executable ( default %s )\n"
+            "--interpreter[-i]\tinterpreter executable ( default %s )\n"
+            "--baseline[-b]\t\tcompare cost of cases with baseline file, fail on regression\n"
+            "--threshold[-t]\t\tregression threshold in %% ( default %.1f )\n"
+            "--write-baseline[-w]\twrite cost of cases to baseline file\n"
+            "test directories after options ( default tests of compiled code )\n\n"
+            "Examples:\n"
+            "./runner.out --jobs 8 --results results.csv\n"
+            "./runner.out ./tests/gebala ./tests/gotfryd\n"
+            "./runner.out --baseline tests/cost_baseline.csv --threshold 0.5\n"
+            "./runner.out --write-baseline tests/cost_baseline.csv\n\n",
+            RUNNER_COMP_EXEC, RUNNER_INT_EXEC, RUNNER_THRESHOLD);
+
+    exit(0);
+}
+
+int main(int argc, char **argv)
+{
+	static struct option long_option[] =
+	{
+        {"jobs",        required_argument,  0,  'j'},
+        {"results",     required_argument,  0,  'r'},
+        {"compiler",    required_argument,  0,  'c'},
+        {"interpreter", required_argument,  0,  'i'},
+        {"baseline",    required_argument,  0,  'b'},
+        {"threshold",   required_argument,  0,  't'},
+        {"write-baseline", required_argument, 0, 'w'},
+        {"help",        no_argument,        0,  'h'},
+		{NULL,		    0,				    0,	'\0'}
+
+    };
+
+    int opt;
+    int jobs = 0;
+    char *results = NULL;
+    char *baseline = NULL;
+    char *new_baseline = NULL;
+    double threshold = RUNNER_THRESHOLD;
+
+    Case *base = NULL;
+    int nbase = 0;
+    int regressions = 0;
+
+    Runner runner;
+    pthread_t *threads;
+    Case *c;
+
+    int i;
+    int passed = 0;
+    uint64_t start;
+    uint64_t wall;
+    uint64_t work = 0;
+
+    while ((opt = getopt_long_only(argc, argv, "j:r:c:i:b:t:w:h", long_option, NULL )) != -1)
+    {
+        switch(opt)
+        {
+            case 'j':
+            {
+                jobs = atoi(argv[optind - 1]);
+                break;
+            }
+            case 'r':
+            {
+                results = argv[optind - 1];
+                break;
+            }
+            case 'c':
+            {
+                comp_exec = argv[optind - 1];
+                break;
+            }
+            case 'i':
+            {
+                int_exec = argv[optind - 1];
+                break;
+            }
+            case 'b':
+            {
+                baseline = argv[optind - 1];
+                break;
+            }
+            case 't':
+            {
+                threshold = atof(argv[optind - 1]);
+                break;
+            }
+            case 'w':
+            {
+                new_baseline = argv[optind - 1];
+                break;
+            }
+            default:
+            {
+                usage();
+            }
+        }
+    }
+
+    if(jobs <= 0)
+        jobs = (int)MAX(sysconf(_SC_NPROCESSORS_ONLN), 1);
+
+    bench = baseline != NULL || new_baseline != NULL;
+
+    /* check baseline before long run */
+    if(baseline != NULL)
+        if(baseline_read(baseline, &base, &nbase))
+            return 1;
+
+    runner.cases = NULL;
+    runner.ncases = 0;
+    runner.next = 0;
+
+    if(optind == argc)
+    {
+        for(i = 0; i < (int)ARRAY_SIZE(default_dirs); ++i)
+            if(cases_find(default_dirs[i], &runner.cases, &runner.ncases))
+                return 1;
+    }
+    else
+    {
+        for(i = optind; i < argc; ++i)
+            if(cases_find(argv[i], &runner.cases, &runner.ncases))
+                return 1;
+    }
+
+    if(runner.ncases == 0)
+    {
+        fprintf(stderr, "%sERROR: no cases found%s\n", RED, RESET);
+        return 1;
+    }
+
+    jobs = MIN(jobs, runner.ncases);
+    threads = (pthread_t*)malloc(sizeof(pthread_t) * (size_t)jobs);
+    if(threads == NULL)
+        ERROR("malloc error\n", 1, "");
+
+    start = now_us();
+
+    for(i = 0; i < jobs; ++i)
+        if(pthread_create(&threads[i], NULL, runner_worker, (void*)&runner))
+            ERROR("pthread_create error\n", 1, "");
+
+    for(i = 0; i < jobs; ++i)
+        pthread_join(threads[i], NULL);
+
+    wall = now_us() - start;
+
+    for(i = 0; i < runner.ncases; ++i)
+    {
+        c = &runner.cases[i];
+
+        if(c->status == CASE_PASSED)
+        {
+            ++passed;
+            printf("[TEST]\t%-24s\t%sPASSED%s", c->name, GREEN, RESET);
+        }
+        else
+            printf("[TEST]\t%-24s\t%s%s%s", c->name, RED, status_str[c->status], RESET);
+
+        printf("\tcompile %8.2f ms\trun %8.2f ms\tcost %ju",
+                (double)c->compile_us / 1000.0, (double)c->run_us / 1000.0, c->cost);
+
+        if(c->tmp_dir != NULL)
+            printf("\tfiles in %s", c->tmp_dir);
+
+        printf("\n");
+
+        work += c->compile_us + c->run_us;
+    }
+
+    printf("\n%d cases: %s%d passed%s, %s%d failed%s\n", runner.ncases,
+            GREEN, passed, RESET, passed == runner.ncases ? GREEN : RED, runner.ncases - passed, RESET);
+    printf("wall time %.2f s, time of cases %.2f s on %d workers\n",
+            (double)wall / 1000000.0, (double)work / 1000000.0, jobs);
+
+    if(results != NULL)
+        if(results_write(results, runner.cases, runner.ncases))
+            return 1;
+
+    if(baseline != NULL)
+        regressions = baseline_compare(runner.cases, runner.ncases, base, nbase, threshold);
+
+    if(new_baseline != NULL)
+    {
+        /* baseline without some cases hides their regressions */
+        if(passed != runner.ncases)
+            fprintf(stderr, "%sERROR: not all cases passed, baseline is not written%s\n", RED, RESET);
+        else if(baseline_write(new_baseline, runner.cases, runner.ncases))
+            return 1;
+    }
+
+    for(i = 0; i < runner.ncases; ++i)
+    {
+        FREE(runner.cases[i].name);
+        FREE(runner.cases[i].program);
+        FREE(runner.cases[i].input);
+        FREE(runner.cases[i].output);
+        FREE(runner.cases[i].tmp_dir);
+    }
+
+    for(i = 0; i < nbase; ++i)
+        FREE(base[i].name);
+
+    FREE(runner.cases);
+    FREE(base);
+    FREE(threads);
+
+    return passed == runner.ncases && regressions == 0 ? 0 : 1;
+}
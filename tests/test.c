@@ -5,6 +5,10 @@
 #include <darray.h>
 #include <avl.h>
 #include <parser_helper.h>
+#include <layout.h>
+#include <cost.h>
+#include <arena.h>
+#include <dirent.h>
 
 /*
     TEST COMPILER CODE AND GENERATED CODE
@@ -48,7 +52,12 @@ static int test_tokens_str(void);
 static int test_pump_algo(void);
 static int test_mult_algo(void);
 
+static int test_layout_code(void);
+static int test_cost_report(void);
+
 static int test_memory_managment(void);
+static int test_arena(void);
+static int test_avl_delete(void);
 static int test_regs_managment1(void);
 static int test_regs_managment2(void);
 static int test_regs_managment3(void);
@@ -61,6 +70,10 @@ static int test_correct_semantic(void);
 static int test_correct_tokens(void);
 
 static int test_compiled_code(void);
+static int test_batch_compile(void);
+static int test_compile_server(void);
+static int test_failed_job_clean(void);
+static int test_compile_cache(void);
 static int test_gebala_code(void);
 static int test_gotfryd_code(void);
 static int test_gotfryd_code2(void);
@@ -78,7 +91,6 @@ static int test_create_variables(void)
     Value *val;
     Array *arr;
 
-    Darray_iterator it;
     uint64_t i;
 
     mpz_t bigvalue;
@@ -114,25 +126,37 @@ static int test_create_variables(void)
     if(strcmp(vn2->name,"b"))
         return FAILED;
 
-    arr = array_create("t", 100ull);
+    arr = array_create("t", 100ull, ARRAY_MAX_LEN);
     if(arr == NULL)
         return FAILED;
 
-    if(strcmp(arr->name, "t") || arr->len != 100ull)
+    if(strcmp(arr->name, "t") || arr->len != 100ull || arr->type != ARRAY)
+        return FAILED;
+
+    /* elements are created on first touch */
+    if(arr->elems != NULL || array_elem_get(arr, 0) != NULL)
         return FAILED;
 
-    for(darray_iterator_init(arr->arr, &it, ITI_BEGIN), i = 0; \
-        ! darray_iterator_end(&it); \
-        darray_iterator_next(&it), ++i)
+    for(i = 0; i < 100ull; i += 3)
     {
-        darray_iterator_get_data(&it, (void*)&va);
+        va = array_elem_touch(arr, i);
+        if(va == NULL)
+            return FAILED;
+
         if(va->arr != arr || i != va->offset || strcmp(va->var->name, arr->name))
             return FAILED;
 
-        if(va != ((var_arr**)it.array)[it.index])
+        if(va != array_elem_touch(arr, i) || va != array_elem_get(arr, i))
             return FAILED;
     }
 
+    if(arr->elems->length != 34 || array_elem_get(arr, 1) != NULL)
+        return FAILED;
+
+    /* out of array */
+    if(array_elem_touch(arr, 100ull) != NULL)
+        return FAILED;
+
     va = var_arr_create(vn2, arr, 200ull);
     if(va == NULL)
         return FAILED;
@@ -179,7 +203,7 @@ static int test_big_array_create(void)
 
     len = ARRAY_MAX_LEN;
 
-    arr = array_create("t", len);
+    arr = array_create("t", len, ARRAY_MAX_LEN);
     if(arr == NULL)
         return FAILED;
 
@@ -189,7 +213,7 @@ static int test_big_array_create(void)
     array_destroy(arr);
 
     len = 1ull << 40;
-    arr = array_create("t", len);
+    arr = array_create("t", len, ARRAY_MAX_LEN);
     if(arr == NULL)
         return FAILED;
 
@@ -377,6 +401,20 @@ static int test_create_tokens(void)
         tokens[5]->body.while_loop != twhile)
         return FAILED;
 
+    /* source span */
+    for(i = 0; i < M; ++i)
+        if(tokens[i]->first_line != 0 || tokens[i]->last_line != 0)
+            return FAILED;
+
+    token_set_lines(tokens[5], 3, 4);
+    if(tokens[5]->first_line != 3 || tokens[5]->last_line != 4)
+        return FAILED;
+
+    if( strcmp(token_kind_str(tokens[0]), "READ") || strcmp(token_kind_str(tokens[1]), "ASSIGN")
+        || strcmp(token_kind_str(tokens[2]), "SKIP") || strcmp(token_kind_str(tokens[3]), "IF")
+        || strcmp(token_kind_str(tokens[4]), "FOR") || strcmp(token_kind_str(tokens[5]), "WHILE"))
+        return FAILED;
+
     for(i = 0; i < M; ++i)
         token_destroy(tokens[i]);
 
@@ -1384,6 +1422,171 @@ static int test_mult_algo(void)
 #undef LOAD
 #undef STORE
 
+static int test_layout_code(void)
+{
+    /* while n: if flag: (rare) then else (hot) */
+    const char *in[] =
+    {
+        "GET 1\n", "ZERO 2\n", "JZERO 1 11\n", "JZERO 2 5\n", "JUMP 8\n",
+        "INC 3\n", "INC 2\n", "JUMP 9\n", "INC 4\n", "DEC 1\n",
+        "JUMP 2\n", "PUT 3\n", "PUT 4\n", "HALT\n"
+    };
+
+    /* else arm is fall through now, then arm is moved out of loop */
+    const char *out[] =
+    {
+        "GET 1\n", "ZERO 2\n", "JUMP 6\n", "INC 3\n", "INC 2\n",
+        "DEC 1\n", "JZERO 1 10\n", "JZERO 2 3\n", "INC 4\n", "JUMP 5\n",
+        "PUT 3\n", "PUT 4\n", "HALT\n"
+    };
+
+    uint64_t count[] = {1, 1, 101, 100, 99, 1, 1, 1, 99, 100, 100, 1, 1, 1};
+    uint64_t taken[] = {0, 0, 1, 1, 99, 0, 0, 1, 0, 0, 100, 0, 0, 0};
+
+    Profile profile;
+    Vector *code;
+    Vector *res;
+    char *line;
+
+    int i;
+    int err = 0;
+
+    profile.lines = ARRAY_SIZE(in);
+    profile.count = count;
+    profile.taken = taken;
+
+    code = vector_create(sizeof(char*));
+    if(code == NULL)
+        return FAILED;
+
+    for(i = 0; i < ARRAY_SIZE(in); ++i)
+    {
+        line = strdup(in[i]);
+        if(vector_insert_last(code, (void*)&line))
+            return FAILED;
+    }
+
+    if(layout_code(code, &profile, &res, NULL))
+        return FAILED;
+
+    vector_destroy(code);
+
+    if(res->length != ARRAY_SIZE(out))
+        err = 1;
+
+    for(i = 0; i < res->length; ++i)
+    {
+        vector_get_pos(res, i, (void*)&line);
+        if(i < ARRAY_SIZE(out) && strcmp(line, out[i]))
+            err = 1;
+
+        FREE(line);
+    }
+
+    vector_destroy(res);
+
+    return err ? FAILED : PASSED;
+}
+
+static int test_cost_report(void)
+{
+    /* FOR i FROM 1 TO n DO a := a * b; ENDFOR WRITE a; */
+    const char *in[] =
+    {
+        "ZERO 1\n", "INC 1\n", "JZERO 1 9\n", "LOAD 2\n", "ADD 2\n",
+        "JODD 3 4\n", "STORE 2\n", "DEC 1\n", "JUMP 2\n", "PUT 2\n",
+        "HALT\n"
+    };
+
+    const uint64_t ranges[][2] = { {0, 2}, {3, 6}, {7, 8}, {9, 9} };
+
+    const char *total = "TOTAL COST: 3 + n + n*(20 + 11*min(bits(a), bits(b)) + 2) + 100\n";
+
+    Vector *code;
+    Vector *tokens;
+    Darray *line_map;
+    Token *token[4];
+    Line_map map;
+
+    Value *val[7];
+    char *line;
+    char buf[128];
+    FILE *f;
+
+    int i;
+    int err = 0;
+
+    const char *names[] = {"i", "n", "a", "a", "b", "a"};
+
+    for(i = 0; i < ARRAY_SIZE(names); ++i)
+        val[i] = value_create(VARIABLE, variable_create(VAR_NORMAL, var_normal_create(names[i])));
+
+    val[6] = value_create(CONST_VAL, const_value_create(1));
+
+    token[0] = token_create(TOKEN_FOR, token_for_create(tokens_id.for_inc, val[0], val[6], val[1]));
+    token[1] = token_create(TOKEN_ASSIGN,
+                            token_assign_create(val[2], token_expr_create(tokens_id.mult, val[3], val[4])));
+    token[2] = token_create(TOKEN_GUARD, token_guard_create(tokens_id.end_for));
+    token[3] = token_create(TOKEN_IO, token_io_create(tokens_id.write, val[5]));
+
+    code = vector_create(sizeof(char*));
+    tokens = vector_create(sizeof(Token*));
+    line_map = darray_create(UNSORTED, 0, sizeof(Line_map), NULL);
+    if(code == NULL || tokens == NULL || line_map == NULL)
+        return FAILED;
+
+    for(i = 0; i < ARRAY_SIZE(in); ++i)
+    {
+        line = strdup(in[i]);
+        if(vector_insert_last(code, (void*)&line))
+            return FAILED;
+    }
+
+    for(i = 0; i < ARRAY_SIZE(token); ++i)
+    {
+        token_set_lines(token[i], i + 1, i + 1);
+        if(vector_insert_last(tokens, (void*)&token[i]))
+            return FAILED;
+
+        map.asm_first = ranges[i][0];
+        map.asm_last = ranges[i][1];
+        map.token = token[i];
+        if(darray_insert(line_map, (void*)&map))
+            return FAILED;
+    }
+
+    if(cost_report("./tests/cost_report", code, tokens, line_map))
+        return FAILED;
+
+    f = fopen("./tests/cost_report", "r");
+    if(f == NULL)
+        return FAILED;
+
+    if(fgets(buf, sizeof(buf), f) == NULL || strcmp(buf, total))
+        err = 1;
+
+    if(fgets(buf, sizeof(buf), f) == NULL || strcmp(buf, "ESTIMATE: 72803\n"))
+        err = 1;
+
+    fclose(f);
+    remove("./tests/cost_report");
+
+    for(i = 0; i < code->length; ++i)
+    {
+        vector_get_pos(code, i, (void*)&line);
+        FREE(line);
+    }
+
+    vector_destroy(code);
+    vector_destroy(tokens);
+    darray_destroy(line_map);
+
+    for(i = 0; i < ARRAY_SIZE(token); ++i)
+        token_destroy(token[i]);
+
+    return err ? FAILED : PASSED;
+}
+
 static int test_memory_managment(void)
 {
 #define VARS        20
@@ -1405,14 +1608,14 @@ static int test_memory_managment(void)
     Variable *var_it[ITERATORS];
     Value *val_it[ITERATORS];
 
-    Avl *__variables;
-    Arraylist *__tokens;
+    Hashmap *__variables;
+    Vector *__tokens;
 
     int i;
 
     i = 0;
 
-    __variables = avl_create(sizeof(Pvar*), pvar_cmp);
+    __variables = hashmap_create(sizeof(Pvar*), pvar_hash, pvar_cmp);
     if(__variables == NULL)
         return FAILED;
 
@@ -1428,7 +1631,7 @@ static int test_memory_managment(void)
     if(vars[i] == NULL)
         return FAILED;
 
-    if(avl_insert(__variables, (void*)&vars[i]))
+    if(hashmap_insert(__variables, (void*)&vars[i]))
         return FAILED;
 
     ++i;
@@ -1437,7 +1640,7 @@ static int test_memory_managment(void)
     if(vars[i] == NULL)
         return FAILED;
 
-    if(avl_insert(__variables, (void*)&vars[i]))
+    if(hashmap_insert(__variables, (void*)&vars[i]))
         return FAILED;
 
     ++i;
@@ -1446,7 +1649,7 @@ static int test_memory_managment(void)
     if(vars[i] == NULL)
         return FAILED;
 
-    if(avl_insert(__variables, (void*)&vars[i]))
+    if(hashmap_insert(__variables, (void*)&vars[i]))
         return FAILED;
     ++i;
 
@@ -1454,7 +1657,7 @@ static int test_memory_managment(void)
     if(vars[i] == NULL)
         return FAILED;
 
-    if(avl_insert(__variables, (void*)&vars[i]))
+    if(hashmap_insert(__variables, (void*)&vars[i]))
         return FAILED;
     ++i;
 
@@ -1462,7 +1665,7 @@ static int test_memory_managment(void)
     if(vars[i] == NULL)
         return FAILED;
 
-    if(avl_insert(__variables, (void*)&vars[i]))
+    if(hashmap_insert(__variables, (void*)&vars[i]))
         return FAILED;
 
     ++i;
@@ -1471,7 +1674,7 @@ static int test_memory_managment(void)
     if(vars[i] == NULL)
         return FAILED;
 
-    if(avl_insert(__variables, (void*)&vars[i]))
+    if(hashmap_insert(__variables, (void*)&vars[i]))
         return FAILED;
 
     ++i;
@@ -1480,7 +1683,7 @@ static int test_memory_managment(void)
     if(vars[i] == NULL)
         return FAILED;
 
-    if(avl_insert(__variables, (void*)&vars[i]))
+    if(hashmap_insert(__variables, (void*)&vars[i]))
         return FAILED;
 
     ++i;
@@ -1489,7 +1692,7 @@ static int test_memory_managment(void)
     if(vars[i] == NULL)
         return FAILED;
 
-    if(avl_insert(__variables, (void*)&vars[i]))
+    if(hashmap_insert(__variables, (void*)&vars[i]))
         return FAILED;
 
     ++i;
@@ -1498,7 +1701,7 @@ static int test_memory_managment(void)
     if(vars[i] == NULL)
         return FAILED;
 
-    if(avl_insert(__variables, (void*)&vars[i]))
+    if(hashmap_insert(__variables, (void*)&vars[i]))
         return FAILED;
 
     ++i;
@@ -1507,7 +1710,7 @@ static int test_memory_managment(void)
     if(vars[i] == NULL)
         return FAILED;
 
-    if(avl_insert(__variables, (void*)&vars[i]))
+    if(hashmap_insert(__variables, (void*)&vars[i]))
         return FAILED;
 
     ++i;
@@ -1516,7 +1719,7 @@ static int test_memory_managment(void)
     if(vars[i] == NULL)
         return FAILED;
 
-    if(avl_insert(__variables, (void*)&vars[i]))
+    if(hashmap_insert(__variables, (void*)&vars[i]))
         return FAILED;
 
 
@@ -1526,7 +1729,7 @@ static int test_memory_managment(void)
     if(vars[i] == NULL)
         return FAILED;
 
-    if(avl_insert(__variables, (void*)&vars[i]))
+    if(hashmap_insert(__variables, (void*)&vars[i]))
         return FAILED;
 
     ++i;
@@ -1535,7 +1738,7 @@ static int test_memory_managment(void)
     if(vars[i] == NULL)
         return FAILED;
 
-    if(avl_insert(__variables, (void*)&vars[i]))
+    if(hashmap_insert(__variables, (void*)&vars[i]))
         return FAILED;
 
     ++i;
@@ -1544,7 +1747,7 @@ static int test_memory_managment(void)
     if(vars[i] == NULL)
         return FAILED;
 
-    if(avl_insert(__variables, (void*)&vars[i]))
+    if(hashmap_insert(__variables, (void*)&vars[i]))
         return FAILED;
 
     ++i;
@@ -1553,7 +1756,7 @@ static int test_memory_managment(void)
     if(vars[i] == NULL)
         return FAILED;
 
-    if(avl_insert(__variables, (void*)&vars[i]))
+    if(hashmap_insert(__variables, (void*)&vars[i]))
         return FAILED;
 
     ++i;
@@ -1562,7 +1765,7 @@ static int test_memory_managment(void)
     if(vars[i] == NULL)
         return FAILED;
 
-    if(avl_insert(__variables, (void*)&vars[i]))
+    if(hashmap_insert(__variables, (void*)&vars[i]))
         return FAILED;
 
     ++i;
@@ -1571,7 +1774,7 @@ static int test_memory_managment(void)
     if(vars[i] == NULL)
         return FAILED;
 
-    if(avl_insert(__variables, (void*)&vars[i]))
+    if(hashmap_insert(__variables, (void*)&vars[i]))
         return FAILED;
 
     ++i;
@@ -1580,7 +1783,7 @@ static int test_memory_managment(void)
     if(vars[i] == NULL)
         return FAILED;
 
-    if(avl_insert(__variables, (void*)&vars[i]))
+    if(hashmap_insert(__variables, (void*)&vars[i]))
         return FAILED;
 
     ++i;
@@ -1589,7 +1792,7 @@ static int test_memory_managment(void)
     if(vars[i] == NULL)
         return FAILED;
 
-    if(avl_insert(__variables, (void*)&vars[i]))
+    if(hashmap_insert(__variables, (void*)&vars[i]))
         return FAILED;
 
     ++i;
@@ -1598,7 +1801,7 @@ static int test_memory_managment(void)
     if(vars[i] == NULL)
         return FAILED;
 
-    if(avl_insert(__variables, (void*)&vars[i]))
+    if(hashmap_insert(__variables, (void*)&vars[i]))
         return FAILED;
 
     ++i;
@@ -1635,7 +1838,7 @@ static int test_memory_managment(void)
         ENDFOR
     */
 
-    __tokens = arraylist_create(sizeof(Token*));
+    __tokens = vector_create(sizeof(Token*));
     if(__tokens == NULL)
         return FAILED;
 
@@ -1645,7 +1848,7 @@ static int test_memory_managment(void)
     if(token[i] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(__tokens, (void*)&token[i]))
+    if(vector_insert_last(__tokens, (void*)&token[i]))
         return FAILED;
 
     ++i;
@@ -1654,7 +1857,7 @@ static int test_memory_managment(void)
     if(token[i] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(__tokens, (void*)&token[i]))
+    if(vector_insert_last(__tokens, (void*)&token[i]))
         return FAILED;
 
     ++i;
@@ -1663,7 +1866,7 @@ static int test_memory_managment(void)
     if(token[i] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(__tokens, (void*)&token[i]))
+    if(vector_insert_last(__tokens, (void*)&token[i]))
         return FAILED;
 
     ++i;
@@ -1672,7 +1875,7 @@ static int test_memory_managment(void)
     if(token[i] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(__tokens, (void*)&token[i]))
+    if(vector_insert_last(__tokens, (void*)&token[i]))
         return FAILED;
 
     ++i;
@@ -1681,7 +1884,7 @@ static int test_memory_managment(void)
     if(token[i] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(__tokens, (void*)&token[i]))
+    if(vector_insert_last(__tokens, (void*)&token[i]))
         return FAILED;
 
     ++i;
@@ -1690,7 +1893,7 @@ static int test_memory_managment(void)
     if(token[i] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(__tokens, (void*)&token[i]))
+    if(vector_insert_last(__tokens, (void*)&token[i]))
         return FAILED;
 
     board_init();
@@ -1797,8 +2000,217 @@ static int test_memory_managment(void)
 
     value_destroy(val);
 
-    avl_destroy(__variables);
-    arraylist_destroy(__tokens);
+    hashmap_destroy(__variables);
+    vector_destroy(__tokens);
+
+    return PASSED;
+
+#undef N
+}
+
+static int test_arena(void)
+{
+#define N 1000
+
+    var_normal *vn[N];
+    Value *val;
+    const_value *cv;
+    mpz_t big;
+    void *ptr;
+    char name[16];
+    int i;
+
+    compile_arena = arena_create();
+    if(compile_arena == NULL)
+        return FAILED;
+
+    /* aligned memory, bigger than chunk too */
+    for(i = 1; i < N; i += 37)
+    {
+        ptr = node_alloc((size_t)i * 100);
+        if(ptr == NULL || (uintptr_t)ptr % ARENA_ALIGN)
+            return FAILED;
+
+        memset(ptr, 0xff, (size_t)i * 100);
+    }
+
+    for(i = 0; i < N; ++i)
+    {
+        (void)snprintf(name, sizeof(name), "var%d", i);
+        vn[i] = var_normal_create(name);
+        if(vn[i] == NULL)
+            return FAILED;
+
+        mpz_set_ui(vn[i]->value, (unsigned long)i + 1);
+    }
+
+    for(i = 0; i < N; ++i)
+        var_normal_destroy(vn[i]);
+
+    /* destroyed variables are reused with clear value */
+    for(i = 0; i < N; ++i)
+    {
+        vn[i] = var_normal_create("x");
+        if(vn[i] == NULL)
+            return FAILED;
+
+        if(mpz_cmp_ui(vn[i]->value, 0) || strcmp(vn[i]->name, "x"))
+            return FAILED;
+    }
+
+    if(compile_arena->reused < N)
+        return FAILED;
+
+    /* big constants live until arena_destroy */
+    mpz_init_set_str(big, "123456789012345678901234567890", 10);
+    cv = const_bigvalue_create(big);
+    if(cv == NULL)
+        return FAILED;
+
+    val = value_create(CONST_VAL, (void*)cv);
+    if(val == NULL)
+        return FAILED;
+
+    value_destroy(val);
+    mpz_clear(big);
+
+    /* objects which are not destroyed are released with arena */
+    arena_destroy(compile_arena);
+    compile_arena = NULL;
+
+    /* without arena objects are malloced */
+    vn[0] = var_normal_create("y");
+    if(vn[0] == NULL)
+        return FAILED;
+
+    var_normal_destroy(vn[0]);
+
+    return PASSED;
+
+#undef N
+}
+
+/*
+    Compare ints in avl
+
+    PARAMS
+    @IN a - pointer to int
+    @IN b - pointer to int
+
+    RETURN:
+    -1 iff a < b
+    0 iff a == b
+    1 iff a > b
+*/
+static int avl_int_cmp(void *a, void *b)
+{
+    if(*(int*)a < *(int*)b)
+        return -1;
+
+    if(*(int*)a > *(int*)b)
+        return 1;
+
+    return 0;
+}
+
+/*
+    Check parent links and balance factors of subtree
+
+    PARAMS
+    @IN node - root of subtree
+    @IN parent - expected parent of node
+    @OUT height - height of subtree
+
+    RETURN:
+    %PASSED iff subtree is AVL tree
+    %FAILED iff not
+*/
+static int avl_subtree_check(Avl_node *node, Avl_node *parent, int *height)
+{
+    int left;
+    int right;
+
+    if(node == NULL)
+    {
+        *height = 0;
+        return PASSED;
+    }
+
+    if(node->parent != parent)
+        return FAILED;
+
+    if(avl_subtree_check(node->left_son, node, &left) || avl_subtree_check(node->right_son, node, &right))
+        return FAILED;
+
+    /* balance factor is height of left - height of right */
+    if(node->bf != left - right || left - right > 1 || right - left > 1)
+        return FAILED;
+
+    *height = MAX(left, right) + 1;
+
+    return PASSED;
+}
+
+static int test_avl_delete(void)
+{
+#define N 2000
+
+    Avl *tree;
+    int *keys;
+    int height;
+    int size;
+    int key;
+    int i;
+
+    tree = avl_create(sizeof(int), avl_int_cmp);
+    if(tree == NULL)
+        return FAILED;
+
+    /* 7 and 13 are coprime with N, so insert and delete orders are permutations */
+    for(i = 0; i < N; ++i)
+    {
+        key = (i * 7) % N;
+        if(avl_insert(tree, (void*)&key))
+            return FAILED;
+    }
+
+    if(avl_subtree_check(tree->root, NULL, &height))
+        return FAILED;
+
+    /* delete of leaf, node with one son and node with two sons keeps tree balanced */
+    for(i = 0; i < N; ++i)
+    {
+        key = (i * 13) % N;
+        if(avl_delete(tree, (void*)&key))
+            return FAILED;
+
+        if(avl_key_exist(tree, (void*)&key))
+            return FAILED;
+
+        if(tree->nodes != (unsigned long long)(N - i - 1))
+            return FAILED;
+
+        if(avl_subtree_check(tree->root, NULL, &height))
+            return FAILED;
+
+        /* the rest of keys is still in order */
+        if(i % 100 == 0 && i < N - 1)
+        {
+            if(avl_to_array(tree, (void*)&keys, &size) || size != N - i - 1)
+                return FAILED;
+
+            for(key = 1; key < size; ++key)
+                if(keys[key - 1] >= keys[key])
+                    return FAILED;
+
+            FREE(keys);
+        }
+    }
+
+    if(tree->root != NULL)
+        return FAILED;
+
+    avl_destroy(tree);
 
     return PASSED;
 
@@ -1849,7 +2261,7 @@ static int test_regs_managment1(void)
     */
 
     Token *tokens[NUM_TOKENS];
-    Arraylist *list;
+    Vector *list;
 
     token_assign    *ass1;
     token_assign    *ass2;
@@ -1877,7 +2289,7 @@ static int test_regs_managment1(void)
     i = 0;
 
     /* create tokens */
-    list = arraylist_create(sizeof(Token*));
+    list = vector_create(sizeof(Token*));
     if(list == NULL)
         return FAILED;
 
@@ -1893,7 +2305,7 @@ static int test_regs_managment1(void)
     if(tokens[j] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(list, (void*)&tokens[j]))
+    if(vector_insert_last(list, (void*)&tokens[j]))
         return FAILED;
 
     i += 3;
@@ -1911,7 +2323,7 @@ static int test_regs_managment1(void)
     if(tokens[j] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(list, (void*)&tokens[j]))
+    if(vector_insert_last(list, (void*)&tokens[j]))
         return FAILED;
 
     i += 3;
@@ -1925,7 +2337,7 @@ static int test_regs_managment1(void)
     if(tokens[j] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(list, (void*)&tokens[j]))
+    if(vector_insert_last(list, (void*)&tokens[j]))
         return FAILED;
 
     ++i;
@@ -1943,7 +2355,7 @@ static int test_regs_managment1(void)
     if(tokens[j] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(list, (void*)&tokens[j]))
+    if(vector_insert_last(list, (void*)&tokens[j]))
         return FAILED;
 
     i += 3;
@@ -2065,7 +2477,7 @@ static int test_regs_managment1(void)
     for(i = 0; i < NUM_TOKENS; ++i)
         token_destroy(tokens[i]);
 
-    arraylist_destroy(list);
+    vector_destroy(list);
     board_destroy();
 
     return PASSED;
@@ -2099,7 +2511,7 @@ static int test_regs_managment2(void)
     */
 
     Token *tokens[NUM_TOKENS];
-    Arraylist *list;
+    Vector *list;
 
     token_assign    *ass1;
     token_assign    *ass2;
@@ -2133,7 +2545,7 @@ static int test_regs_managment2(void)
     i = 0;
 
     /* create tokens */
-    list = arraylist_create(sizeof(Token*));
+    list = vector_create(sizeof(Token*));
     if(list == NULL)
         return FAILED;
 
@@ -2149,7 +2561,7 @@ static int test_regs_managment2(void)
     if(tokens[j] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(list, (void*)&tokens[j]))
+    if(vector_insert_last(list, (void*)&tokens[j]))
         return FAILED;
 
     ++j;
@@ -2163,7 +2575,7 @@ static int test_regs_managment2(void)
     if(tokens[j] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(list, (void*)&tokens[j]))
+    if(vector_insert_last(list, (void*)&tokens[j]))
         return FAILED;
 
     ++j;
@@ -2177,7 +2589,7 @@ static int test_regs_managment2(void)
     if(tokens[j] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(list, (void*)&tokens[j]))
+    if(vector_insert_last(list, (void*)&tokens[j]))
         return FAILED;
 
     ++i;
@@ -2191,7 +2603,7 @@ static int test_regs_managment2(void)
     if(tokens[j] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(list, (void*)&tokens[j]))
+    if(vector_insert_last(list, (void*)&tokens[j]))
         return FAILED;
 
     i += 3;
@@ -2209,7 +2621,7 @@ static int test_regs_managment2(void)
     if(tokens[j] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(list, (void*)&tokens[j]))
+    if(vector_insert_last(list, (void*)&tokens[j]))
         return FAILED;
 
     ++j;
@@ -2223,7 +2635,7 @@ static int test_regs_managment2(void)
     if(tokens[j] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(list, (void*)&tokens[j]))
+    if(vector_insert_last(list, (void*)&tokens[j]))
         return FAILED;
 
     ++j;
@@ -2236,7 +2648,7 @@ static int test_regs_managment2(void)
     if(tokens[j] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(list, (void*)&tokens[j]))
+    if(vector_insert_last(list, (void*)&tokens[j]))
         return FAILED;
 
     ++j;
@@ -2249,7 +2661,7 @@ static int test_regs_managment2(void)
     if(tokens[j] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(list, (void*)&tokens[j]))
+    if(vector_insert_last(list, (void*)&tokens[j]))
         return FAILED;
 
     board_init();
@@ -2426,7 +2838,7 @@ static int test_regs_managment2(void)
     value_destroy(vals[14]);
     value_destroy(vals[15]);
 
-    arraylist_destroy(list);
+    vector_destroy(list);
     board_destroy();
 
     return PASSED;
@@ -2461,7 +2873,7 @@ static int test_regs_managment3(void)
     */
 
     Token *tokens[NUM_TOKENS];
-    Arraylist *list;
+    Vector *list;
 
     token_assign    *ass1;
     token_assign    *ass2;
@@ -2499,7 +2911,7 @@ static int test_regs_managment3(void)
     i = 0;
 
     /* create tokens */
-    list = arraylist_create(sizeof(Token*));
+    list = vector_create(sizeof(Token*));
     if(list == NULL)
         return FAILED;
 
@@ -2515,7 +2927,7 @@ static int test_regs_managment3(void)
     if(tokens[j] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(list, (void*)&tokens[j]))
+    if(vector_insert_last(list, (void*)&tokens[j]))
         return FAILED;
 
     ++j;
@@ -2533,7 +2945,7 @@ static int test_regs_managment3(void)
     if(tokens[j] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(list, (void*)&tokens[j]))
+    if(vector_insert_last(list, (void*)&tokens[j]))
         return FAILED;
 
     ++j;
@@ -2551,7 +2963,7 @@ static int test_regs_managment3(void)
     if(tokens[j] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(list, (void*)&tokens[j]))
+    if(vector_insert_last(list, (void*)&tokens[j]))
         return FAILED;
 
     ++j;
@@ -2565,7 +2977,7 @@ static int test_regs_managment3(void)
     if(tokens[j] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(list, (void*)&tokens[j]))
+    if(vector_insert_last(list, (void*)&tokens[j]))
         return FAILED;
 
     ++i;
@@ -2583,7 +2995,7 @@ static int test_regs_managment3(void)
     if(tokens[j] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(list, (void*)&tokens[j]))
+    if(vector_insert_last(list, (void*)&tokens[j]))
         return FAILED;
 
     ++j;
@@ -2597,7 +3009,7 @@ static int test_regs_managment3(void)
     if(tokens[j] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(list, (void*)&tokens[j]))
+    if(vector_insert_last(list, (void*)&tokens[j]))
         return FAILED;
 
     ++j;
@@ -2610,7 +3022,7 @@ static int test_regs_managment3(void)
     if(tokens[j] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(list, (void*)&tokens[j]))
+    if(vector_insert_last(list, (void*)&tokens[j]))
         return FAILED;
 
     ++i;
@@ -2624,7 +3036,7 @@ static int test_regs_managment3(void)
     if(tokens[j] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(list, (void*)&tokens[j]))
+    if(vector_insert_last(list, (void*)&tokens[j]))
         return FAILED;
 
     ++j;
@@ -2637,7 +3049,7 @@ static int test_regs_managment3(void)
     if(tokens[j] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(list, (void*)&tokens[j]))
+    if(vector_insert_last(list, (void*)&tokens[j]))
         return FAILED;
 
     ++i;
@@ -2651,7 +3063,7 @@ static int test_regs_managment3(void)
     if(tokens[j] == NULL)
         return FAILED;
 
-    if(arraylist_insert_last(list, (void*)&tokens[j]))
+    if(vector_insert_last(list, (void*)&tokens[j]))
         return FAILED;
 
     ++j;
@@ -2825,7 +3237,7 @@ static int test_regs_managment3(void)
     for(i = 0; i < NUM_TOKENS; ++i)
         token_destroy(tokens[i]);
 
-    arraylist_destroy(list);
+    vector_destroy(list);
     board_destroy();
 
     return PASSED;
@@ -3570,6 +3982,156 @@ static int test_correct_tokens(void)
     return err ? FAILED : PASSED;
 }
 
+static int test_batch_compile(void)
+{
+    int err = 0;
+
+    /* the same code as from single compilations, error in one file doesn't stop others */
+    err += !!system("cp ./tests/semantic_errors/err1 ./tests/asm_correct/err >/dev/null 2>&1");
+    err += !system(COMP_EXEC " --jobs 2 ./tests/asm_correct/ex1 ./tests/asm_correct/err"
+                    " ./tests/asm_correct/ex2 ./tests/asm_correct/ex3 >/dev/null 2>&1");
+
+    err += !!system(COMP_EXEC " --input ./tests/asm_correct/ex1 --output ./tests/asm_correct/asm >/dev/null 2>&1");
+    err += !!system("diff ./tests/asm_correct/ex1.asm ./tests/asm_correct/asm >/dev/null");
+
+    err += !!system(COMP_EXEC " --input ./tests/asm_correct/ex2 --output ./tests/asm_correct/asm >/dev/null 2>&1");
+    err += !!system("diff ./tests/asm_correct/ex2.asm ./tests/asm_correct/asm >/dev/null");
+
+    err += !!system(COMP_EXEC " --input ./tests/asm_correct/ex3 --output ./tests/asm_correct/asm >/dev/null 2>&1");
+    err += !!system("diff ./tests/asm_correct/ex3.asm ./tests/asm_correct/asm >/dev/null");
+
+    (void)system("rm -f ./tests/asm_correct/err ./tests/asm_correct/err.asm ./tests/asm_correct/ex[123].asm");
+
+    return err ? FAILED : PASSED;
+}
+
+static int test_compile_server(void)
+{
+    int err = 0;
+
+    /* responses are framed code of single compilations, error in one request doesn't stop server */
+    err += !!system("cp ./tests/semantic_errors/err1 ./tests/asm_correct/err >/dev/null 2>&1");
+    err += !!system(COMP_EXEC " --input ./tests/asm_correct/ex1 --output ./tests/asm_correct/ex1.asm >/dev/null 2>&1");
+    err += !!system(COMP_EXEC " --input ./tests/asm_correct/ex2 --tokens --output ./tests/asm_correct/ex2.tokens >/dev/null 2>&1");
+
+    err += !!system("printf 'COMPILE - ./tests/asm_correct/ex1\\nCOMPILE - ./tests/asm_correct/err\\n"
+                    "BAD\\nCOMPILE t ./tests/asm_correct/ex2\\n' | " COMP_EXEC " --server - "
+                    "> ./tests/asm_correct/result 2>/dev/null");
+
+    err += !!system("(echo \"OK $(wc -c < ./tests/asm_correct/ex1.asm)\"; cat ./tests/asm_correct/ex1.asm;"
+                    " printf 'ERROR 36\\n./tests/asm_correct/err not compiled';"
+                    " printf 'ERROR 11\\nbad request';"
+                    " echo \"OK $(wc -c < ./tests/asm_correct/ex2.tokens)\"; cat ./tests/asm_correct/ex2.tokens)"
+                    " > ./tests/asm_correct/asm");
+    err += !!system("cmp ./tests/asm_correct/result ./tests/asm_correct/asm >/dev/null");
+
+    (void)system("rm -f ./tests/asm_correct/err ./tests/asm_correct/ex1.asm ./tests/asm_correct/ex2.tokens");
+
+    return err ? FAILED : PASSED;
+}
+
+/* number of open descriptors of this process, -1 iff failure */
+static int open_fds(void)
+{
+    DIR *dir;
+    struct dirent *entry;
+    int n = 0;
+
+    dir = opendir("/proc/self/fd");
+    if(dir == NULL)
+        return -1;
+
+    while((entry = readdir(dir)) != NULL)
+        if(entry->d_name[0] != '.')
+            ++n;
+
+    closedir(dir);
+
+    /* descriptor of dir */
+    return n - 1;
+}
+
+/* state of compile and job is released, so next job on this thread starts clean */
+static BOOL job_state_clean(void)
+{
+    return asmcode == NULL && compiler_variables == NULL && labels == NULL && emitter_map == NULL
+            && variables == NULL && compile_arena == NULL && cpu == NULL && memory == NULL;
+}
+
+static int test_failed_job_clean(void)
+{
+    CompilerContext ctx;
+    Arena *arena;
+    int fds;
+    int err = 0;
+
+    /* profile of other code, with --Werror job is stopped by compiler_exit in the middle of compile */
+    err += !!system("printf 'lines,1\n0,1\n' > ./tests/asm_correct/profile");
+    err += !!system(COMP_EXEC " --input ./tests/asm_correct/ex1 --output ./tests/asm_correct/ex1.asm >/dev/null 2>&1");
+
+    /* one arena for both jobs like in thread of server */
+    arena = arena_create();
+    if(arena == NULL)
+        return FAILED;
+
+    (void)memset(&ctx, 0, sizeof(ctx));
+    ctx.option.input_file = "./tests/asm_correct/ex1";
+    ctx.option.output_file = "./tests/asm_correct/asm";
+    ctx.option.profile_file = "./tests/asm_correct/profile";
+    ctx.option.werr = 1;
+    ctx.arena = arena;
+
+    fds = open_fds();
+
+    err += compile_context(&ctx) == 0;
+    err += open_fds() != fds;
+    err += ! job_state_clean();
+
+    /* good job after failed one */
+    ctx.option.profile_file = NULL;
+    ctx.option.werr = 0;
+
+    err += compile_context(&ctx) != 0;
+    err += open_fds() != fds;
+    err += ! job_state_clean();
+    err += !!system("cmp ./tests/asm_correct/ex1.asm ./tests/asm_correct/asm >/dev/null");
+
+    arena_destroy(arena);
+
+    (void)system("rm -f ./tests/asm_correct/profile ./tests/asm_correct/ex1.asm");
+
+    return err ? FAILED : PASSED;
+}
+
+static int test_compile_cache(void)
+{
+    int err = 0;
+
+    (void)system("rm -rf ./tests/asm_correct/cache");
+
+    /* miss, hit and miss for other options, code from cache is the same */
+    err += !!system(COMP_EXEC " --input ./tests/asm_correct/ex1 --output ./tests/asm_correct/asm >/dev/null 2>&1");
+    err += !!system(COMP_EXEC " --input ./tests/asm_correct/ex1 --output ./tests/asm_correct/result"
+                    " --cache ./tests/asm_correct/cache >/dev/null 2>&1");
+    err += !!system(COMP_EXEC " --input ./tests/asm_correct/ex1 --output ./tests/asm_correct/result"
+                    " --cache ./tests/asm_correct/cache >/dev/null 2>&1");
+    err += !!system("cmp ./tests/asm_correct/result ./tests/asm_correct/asm >/dev/null");
+    err += !!system(COMP_EXEC " --input ./tests/asm_correct/ex1 --output ./tests/asm_correct/result --tokens"
+                    " --cache ./tests/asm_correct/cache >/dev/null 2>&1");
+    err += !!system(COMP_EXEC " --cache ./tests/asm_correct/cache --cache-stats | grep -P"
+                    " 'hits:\\t\\t1|misses:\\t\\t2|entries:\\t2' | wc -l | grep -q 3");
+
+    /* cache is bounded by size */
+    err += !!system(COMP_EXEC " --input ./tests/asm_correct/ex2 --output ./tests/asm_correct/result"
+                    " --cache ./tests/asm_correct/cache --cache-size 0 >/dev/null 2>&1");
+    err += !!system(COMP_EXEC " --cache ./tests/asm_correct/cache --cache-stats | grep -P"
+                    " 'evictions:\\t3|entries:\\t0' | wc -l | grep -q 2");
+
+    (void)system("rm -rf ./tests/asm_correct/cache");
+
+    return err ? FAILED : PASSED;
+}
+
 static int test_compiled_code(void)
 {
     int err = 0;
@@ -4274,6 +4836,34 @@ static int test_compiled_code(void)
                     "&& ./tests/edit_file.sh ./tests/asm_correct/result");
     err += !!system("diff ./tests/asm_correct/result ./tests/asm_correct/out100 >/dev/null");
 
+    /* EX101 big literals */
+    fprintf(stderr,"\rEX101");
+    err += !!system(COMP_EXEC " --input ./tests/asm_correct/ex101 --output ./tests/asm_correct/asm >/dev/null 2>&1");
+    err += !!system( INT_EXEC " ./tests/asm_correct/asm < ./tests/asm_correct/in101  > ./tests/asm_correct/result"
+                    "&& ./tests/edit_file.sh ./tests/asm_correct/result");
+    err += !!system("diff ./tests/asm_correct/result ./tests/asm_correct/out101 >/dev/null");
+
+    /* EX102 known values of array elements */
+    fprintf(stderr,"\rEX102");
+    err += !!system(COMP_EXEC " --input ./tests/asm_correct/ex102 --output ./tests/asm_correct/asm >/dev/null 2>&1");
+    err += !!system( INT_EXEC " ./tests/asm_correct/asm < ./tests/asm_correct/in102  > ./tests/asm_correct/result"
+                    "&& ./tests/edit_file.sh ./tests/asm_correct/result");
+    err += !!system("diff ./tests/asm_correct/result ./tests/asm_correct/out102 >/dev/null");
+
+    /* EX103 ranges of variables */
+    fprintf(stderr,"\rEX103");
+    err += !!system(COMP_EXEC " --input ./tests/asm_correct/ex103 --output ./tests/asm_correct/asm >/dev/null 2>&1");
+    err += !!system( INT_EXEC " ./tests/asm_correct/asm < ./tests/asm_correct/in103  > ./tests/asm_correct/result"
+                    "&& ./tests/edit_file.sh ./tests/asm_correct/result");
+    err += !!system("diff ./tests/asm_correct/result ./tests/asm_correct/out103 >/dev/null");
+
+    /* EX104 dead else code with FOR and IF nested in it */
+    fprintf(stderr,"\rEX104");
+    err += !!system(COMP_EXEC " --input ./tests/asm_correct/ex104 --output ./tests/asm_correct/asm >/dev/null 2>&1");
+    err += !!system( INT_EXEC " ./tests/asm_correct/asm < ./tests/asm_correct/in104  > ./tests/asm_correct/result"
+                    "&& ./tests/edit_file.sh ./tests/asm_correct/result");
+    err += !!system("diff ./tests/asm_correct/result ./tests/asm_correct/out104 >/dev/null");
+
     err += !!system("rm -f ./tests/asm_correct/result ./tests/asm_correct/asm");
 
     fprintf(stderr,"\r");
@@ -4774,7 +5364,12 @@ void run(void)
     TEST(test_pump_algo());
     TEST(test_mult_algo());
 
+    TEST(test_layout_code());
+    TEST(test_cost_report());
+
     TEST(test_memory_managment());
+    TEST(test_arena());
+    TEST(test_avl_delete());
     TEST(test_regs_managment1());
     TEST(test_regs_managment2());
     TEST(test_regs_managment3());
@@ -4787,6 +5382,10 @@ void run(void)
     TEST(test_correct_tokens());
 
     TEST(test_compiled_code());
+    TEST(test_batch_compile());
+    TEST(test_compile_server());
+    TEST(test_failed_job_clean());
+    TEST(test_compile_cache());
     TEST(test_gebala_code());
     TEST(test_gotfryd_code());
     TEST(test_gotfryd_code2());